@@ -1,3 +1,5 @@
 #define RENDER_POINT_SHADOW_MAPS false
 #define SHADOWS_BRIGHTNESS 2.143f
 #define BELOW_WATER_HACK true
+// Shadow maps of spot and point lights are bound to t20-t39 and t40-t59, lights beyond that don't cast shadows
+#define MAX_SHADOWED_LIGHTS 20
@@ -0,0 +1,36 @@
+cbuffer object_buffer : register(b0)
+{
+    float4x4 projection_view_model;
+};
+
+// Colors are packed as 0xAABBGGRR
+struct DebugVertex
+{
+    float3 position;
+    uint color;
+};
+
+// Every two vertices form a line
+StructuredBuffer<DebugVertex> debug_vertices : register(t63);
+
+struct VS_Output
+{
+    float4 pos : SV_POSITION;
+    float4 color : COLOR;
+};
+
+VS_Output vs_main(uint vertex_id : SV_VertexID)
+{
+    DebugVertex debug_vertex = debug_vertices[vertex_id];
+
+    VS_Output output;
+    output.pos = mul(projection_view_model, float4(debug_vertex.position, 1.0f));
+    output.color = float4(debug_vertex.color & 0xff, (debug_vertex.color >> 8) & 0xff, (debug_vertex.color >> 16) & 0xff,
+                          debug_vertex.color >> 24) / 255.0f;
+    return output;
+}
+
+float4 ps_main(VS_Output input) : SV_TARGET
+{
+    return input.color;
+}
@@ -51,24 +51,34 @@ float4 ps_main(VS_Output input) : SV_Target
 
     result += 0.1f * fog_value;
 
-    for (int point_light_index = 0; point_light_index < number_of_point_lights; point_light_index++)
+    // Scattering happens along the whole view ray, so it uses the lights of every cluster of the pixel's tile
+    if (!BELOW_WATER_HACK || pos.y > -0.1f)
     {
-        if (!BELOW_WATER_HACK || pos.y > -0.1f)
+        LightCluster tile = get_light_tile(pos.xyz);
+
+        for (uint k = 0; k < tile.point_light_count; k++)
         {
-            scatter.xyz += calculate_scatter(point_lights[point_light_index], pos) * fog_value;
+            scatter.xyz += calculate_scatter(point_lights[get_point_light_index(tile, k)], pos) * fog_value;
         }
 
-        result.xyz += calculate_point_light(point_lights[point_light_index],normal.xyz, pos.xyz, view_dir, diffuse.xyz, point_light_index, RENDER_POINT_SHADOW_MAPS, ambient_occlusion);
+        for (uint l = 0; l < tile.spot_light_count; l++)
+        {
+            scatter.xyz += calculate_scatter(spot_lights[get_spot_light_index(tile, l)], pos) * fog_value;
+        }
     }
 
-    for (int spot_light_index = 0; spot_light_index < number_of_spot_lights; spot_light_index++)
+    LightCluster cluster = get_light_cluster(pos.xyz);
+
+    for (uint i = 0; i < cluster.point_light_count; i++)
     {
-        if (!BELOW_WATER_HACK || pos.y > -0.1f)
-        {
-            scatter.xyz += calculate_scatter(spot_lights[spot_light_index], pos, spot_light_index) * fog_value;
-        }
+        uint point_light_index = get_point_light_index(cluster, i);
+        result.xyz += calculate_point_light(point_lights[point_light_index],normal.xyz, pos.xyz, view_dir, diffuse.xyz, RENDER_POINT_SHADOW_MAPS, ambient_occlusion);
+    }
 
-        result.xyz += calculate_spot_light(spot_lights[spot_light_index], normal.xyz, pos.xyz, view_dir, diffuse.xyz, spot_light_index, true, ambient_occlusion);
+    for (uint j = 0; j < cluster.spot_light_count; j++)
+    {
+        uint spot_light_index = get_spot_light_index(cluster, j);
+        result.xyz += calculate_spot_light(spot_lights[spot_light_index], normal.xyz, pos.xyz, view_dir, diffuse.xyz, true, ambient_occlusion);
     }
 
     // Normal alpha channel stores info whether glow should be applied
@@ -1,8 +1,11 @@
+#include "vertex_decoding.hlsl"
+
 struct VS_Input
 {
     float3 pos: POSITION;
     float3 normal : NORMAL;
     float2 UV : TEXCOORD0;
+    uint instance_id : SV_InstanceID;
 };
 
 struct VS_Output
@@ -41,11 +44,15 @@ SamplerState obj_sampler_state : register(s0);
 VS_Output vs_main(VS_Input input)
 {
     VS_Output output;
+    input.pos = decode_position(input.pos);
+    input.normal = decode_normal(input.normal);
+
+    float4x4 world = get_model_matrix(model, input.instance_id);
 
-    output.world_pos = mul(model, float4(input.pos, 1.0f));
+    output.world_pos = mul(world, float4(input.pos, 1.0f));
     output.UV = input.UV;
-    output.normal = mul((float3x3)model, input.normal);
-    output.pixel_pos = mul(projection_view_model, float4(input.pos, 1.0f));
+    output.normal = mul((float3x3)world, input.normal);
+    output.pixel_pos = mul(get_projection_view_model(projection_view_model, projection_view, world), float4(input.pos, 1.0f));
     return output;
 }
 
@@ -0,0 +1,26 @@
+#version 430 core
+
+// Colors are packed as 0xAABBGGRR
+struct DebugVertex
+{
+    vec3 position;
+    uint color;
+};
+
+// Every two vertices form a line
+layout(std430, binding = 4) readonly buffer debugVerticesBuffer
+{
+    DebugVertex debugVertices[];
+};
+
+uniform mat4 projectionView;
+
+out vec4 ColorVertex;
+
+void main()
+{
+    DebugVertex debugVertex = debugVertices[gl_VertexID];
+
+    gl_Position = projectionView * vec4(debugVertex.position, 1.0);
+    ColorVertex = unpackUnorm4x8(debugVertex.color);
+}
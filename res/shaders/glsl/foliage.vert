@@ -0,0 +1,33 @@
+#version 430 core
+
+layout (location = 0) in vec3 PositionInput;
+layout (location = 1) in vec3 NormalInput;
+layout (location = 2) in vec2 TextureCoordinatesInput;
+
+// Model matrices of instances bound by the drawable's instance buffer, in the order they are drawn
+layout(std430, binding = 0) readonly buffer modelsBuffer
+{
+    mat4 models[];
+};
+
+out vec2 TextureCoordinatesVertex;
+out vec3 FragmentPosition;
+out vec3 NormalVertex;
+
+layout(std140, binding = 0) uniform CameraBlock
+{
+    mat4 PV;
+    mat4 PVnoTranslation;
+    vec3 cameraPosition;
+};
+
+void main()
+{
+    mat4 model = models[gl_InstanceID];
+
+    gl_Position = PV * model * vec4(PositionInput, 1.0);
+    FragmentPosition = vec3(model * vec4(PositionInput, 1.0));
+
+    NormalVertex = mat3(transpose(inverse(model))) * NormalInput;
+    TextureCoordinatesVertex = TextureCoordinatesInput;
+}
@@ -9,8 +9,6 @@ in GS_OUT
 
 struct Material
 {
-    vec3 color;
-
     sampler2D texture_diffuse1;
     sampler2D texture_diffuse2;
     sampler2D texture_diffuse3;
@@ -21,15 +19,83 @@ struct Material
 
 uniform Material material;
 
+layout(std140, binding = 2) uniform MaterialBlock
+{
+    vec3 materialColor;
+    float materialSpecular;
+    float materialShininess;
+    float radiusMultiplier;
+    int sector_count;
+    int stack_count;
+};
+
 struct PointLight
 {
+    vec3 position;
+
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+
+    float constant;
+    float linear;
+    float quadratic;
+};
+
+struct DirectionalLight
+{
+    vec3 direction;
+
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+};
+
+struct SpotLight
+{
+    vec3 position;
+    vec3 direction;
+
+    vec3 ambient;
     vec3 diffuse;
+    vec3 specular;
+
+    float constant;
+    float linear;
+    float quadratic;
+
+    float cutOff;
+    float outerCutOff;
+};
+
+layout(std140, binding = 1) uniform LightBlock
+{
+    DirectionalLight directionalLight;
+
+    // Light clusters of the main camera, see LightClusters.h
+    mat4 clusterView;
+    mat4 clusterProjection;
+    uvec3 clusterCounts;
+    float clusterDepthScale;
+    float clusterDepthBias;
+
+    int pointLightCount;
+    int spotLightCount;
+    bool directionalLightOn;
 };
 
-const int MAX_POINT_LIGHTS = 1;
-uniform PointLight pointLights[MAX_POINT_LIGHTS];
+layout(std430, binding = 6) readonly buffer PointLights
+{
+    PointLight pointLights[];
+};
+
+layout(std430, binding = 7) readonly buffer SpotLights
+{
+    SpotLight spotLights[];
+};
 
 void main()
 {
-    FragColor = vec4(material.color, 1.0) * vec4(pointLights[0].diffuse, 1.0) * texture(material.texture_diffuse1, fs_in.TextureCoordinatesGeometry);
+    vec3 lightColor = pointLightCount > 0 ? pointLights[0].diffuse : vec3(0.0);
+    FragColor = vec4(materialColor, 1.0) * vec4(lightColor, 1.0) * texture(material.texture_diffuse1, fs_in.TextureCoordinatesGeometry);
 }
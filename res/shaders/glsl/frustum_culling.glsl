@@ -2,27 +2,50 @@
 
 layout(local_size_x = 1024, local_size_y = 1, local_size_z = 1) in;
 
-struct BoundingBox
+struct Instance
 {
     vec3 center;
-    float padding1;
+    uint visibleOffset;
     vec3 extents;
-    float padding2;
+    uint firstCommand;
+    uint commandCount;
+    uint isCullable;
+    vec2 padding;
 };
 
-layout(std430, binding = 1) readonly buffer boundingBoxesBuffer
+struct DrawCommand
 {
-    BoundingBox boundingBoxes[];
+    uint count;
+    uint instanceCount;
+    uint firstIndex;
+    int baseVertex;
+    uint baseInstance;
 };
 
-layout(std430, binding = 2) writeonly buffer visibleInstancesBuffer
+layout(std430, binding = 3) readonly buffer instancesBuffer
+{
+    Instance instances[];
+};
+
+// Indices of visible instances, compacted per batch starting at visibleOffset of the batch
+layout(std430, binding = 1) writeonly buffer visibleInstancesBuffer
 {
     uint visibleInstances[];
 };
 
+// Every mesh of a batch has its own command, all of them are drawn with the same instances
+layout(std430, binding = 2) buffer drawCommandsBuffer
+{
+    DrawCommand drawCommands[];
+};
+
 // First vec3 - normal, last float - offset
 uniform vec4 frustumPlanes[6];
 
+// Instances of the culled material
+uniform int firstInstance;
+uniform int instanceCount;
+
 const vec3 CornerOffsets[8] = vec3[](
     vec3(-1.0, -1.0, -1.0),
     vec3(-1.0, -1.0,  1.0),
@@ -58,21 +81,37 @@ bool HalfPlaneTest(vec3 point, vec3 normal, float offset)
     return distance >= -0.02;
 }
 
-bool IsInOrForwardPlane(vec4 plane)
+bool IsInOrForwardPlane(uint instance, vec4 plane)
 {
     const int index = PlaneNormalToIndex(plane.xyz);
 
     // Test the farthest point of the box from the plane
     // if it's behind the plane, then the entire box will be.
-    return HalfPlaneTest(boundingBoxes[gl_GlobalInvocationID.x].center + boundingBoxes[gl_GlobalInvocationID.x].extents * CornerOffsets[index], plane.xyz, plane.w);
+    return HalfPlaneTest(instances[instance].center + instances[instance].extents * CornerOffsets[index], plane.xyz, plane.w);
 }
 
 void main()
 {
-    uint i = gl_GlobalInvocationID.x;
+    if (gl_GlobalInvocationID.x >= uint(instanceCount))
+        return;
+
+    uint i = uint(firstInstance) + gl_GlobalInvocationID.x;
+
+    bool visible = instances[i].isCullable == 0 ||
+        (IsInOrForwardPlane(i, frustumPlanes[0]) && IsInOrForwardPlane(i, frustumPlanes[1]) &&
+        IsInOrForwardPlane(i, frustumPlanes[2]) && IsInOrForwardPlane(i, frustumPlanes[3]) &&
+        IsInOrForwardPlane(i, frustumPlanes[4]) && IsInOrForwardPlane(i, frustumPlanes[5]));
+
+    if (!visible)
+        return;
+
+    uint firstCommand = instances[i].firstCommand;
+    uint slot = atomicAdd(drawCommands[firstCommand].instanceCount, 1);
+
+    for (uint command = firstCommand + 1; command < firstCommand + instances[i].commandCount; ++command)
+    {
+        atomicAdd(drawCommands[command].instanceCount, 1);
+    }
 
-    bool visible = IsInOrForwardPlane(frustumPlanes[0]) && IsInOrForwardPlane(frustumPlanes[1]) &&
-        IsInOrForwardPlane(frustumPlanes[2]) && IsInOrForwardPlane(frustumPlanes[3]) &&
-        IsInOrForwardPlane(frustumPlanes[4]) && IsInOrForwardPlane(frustumPlanes[5]);
-    visibleInstances[i] = visible ? 1 : 0;
+    visibleInstances[instances[i].visibleOffset + slot] = i;
 }
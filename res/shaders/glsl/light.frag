@@ -1,15 +1,18 @@
 #version 430 core
 
-struct Material
+layout(std140, binding = 2) uniform MaterialBlock
 {
-    vec3 color;
+    vec3 materialColor;
+    float materialSpecular;
+    float materialShininess;
+    float radiusMultiplier;
+    int sector_count;
+    int stack_count;
 };
 
-uniform Material material;
-
 out vec4 FragColor;
 
 void main()
 {
-    FragColor = vec4(material.color, 1.0);
+    FragColor = vec4(materialColor, 1.0);
 }
@@ -2,7 +2,12 @@
 
 layout (location = 0) in vec3 aPos;
 
-uniform mat4 PVM;
+layout(std140, binding = 3) uniform ObjectBlock
+{
+    mat4 PVM;
+    mat4 model;
+    mat4 VM;
+};
 
 void main()
 {
@@ -5,7 +5,13 @@ out vec4 FragColor;
 in vec3 NormalVertex;
 in vec3 FragmentPosition;
 
-uniform vec3 cameraPosition;
+layout(std140, binding = 0) uniform CameraBlock
+{
+    mat4 PV;
+    mat4 PVnoTranslation;
+    vec3 cameraPosition;
+};
+
 uniform samplerCube skybox;
 
 const float ratio = 1.00 / 1.52;
@@ -4,7 +4,12 @@ layout (location = 0) in vec3 PositionInput;
 
 out vec3 TextureCoordinatesVertex;
 
-uniform mat4 PVnoTranslation;
+layout(std140, binding = 0) uniform CameraBlock
+{
+    mat4 PV;
+    mat4 PVnoTranslation;
+    vec3 cameraPosition;
+};
 
 void main()
 {
@@ -8,13 +8,20 @@ struct Material
 {
     sampler2D texture_diffuse1;
     sampler2D texture_specular1;
-    vec3 color;
-    float specular;
-    float shininess;
 };
 
 uniform Material material;
 
+layout(std140, binding = 2) uniform MaterialBlock
+{
+    vec3 materialColor;
+    float materialSpecular;
+    float materialShininess;
+    float radiusMultiplier;
+    int sector_count;
+    int stack_count;
+};
+
 struct PointLight
 {
     vec3 position;
@@ -28,10 +35,6 @@ struct PointLight
     float quadratic;
 };
 
-const int MAX_POINT_LIGHTS = 1;
-uniform int pointLightCount;
-uniform PointLight pointLights[MAX_POINT_LIGHTS];
-
 struct DirectionalLight
 {
     vec3 direction;
@@ -41,9 +44,6 @@ struct DirectionalLight
     vec3 specular;
 };
 
-uniform bool directionalLightOn;
-uniform DirectionalLight directionalLight;
-
 struct SpotLight
 {
     vec3 position;
@@ -61,11 +61,57 @@ struct SpotLight
     float outerCutOff;
 };
 
-const int MAX_SPOT_LIGHTS = 4;
-uniform int spotLightCount;
-uniform SpotLight spotLights[MAX_SPOT_LIGHTS];
+layout(std140, binding = 1) uniform LightBlock
+{
+    DirectionalLight directionalLight;
+
+    // Light clusters of the main camera, see LightClusters.h
+    mat4 clusterView;
+    mat4 clusterProjection;
+    uvec3 clusterCounts;
+    float clusterDepthScale;
+    float clusterDepthBias;
+
+    int pointLightCount;
+    int spotLightCount;
+    bool directionalLightOn;
+};
+
+layout(std430, binding = 6) readonly buffer PointLights
+{
+    PointLight pointLights[];
+};
+
+layout(std430, binding = 7) readonly buffer SpotLights
+{
+    SpotLight spotLights[];
+};
+
+// Each cluster points to a range of lightIndices, with point light indices first and spot light indices after them
+struct LightCluster
+{
+    uint offset;
+    uint pointLightCount;
+    uint spotLightCount;
+    uint padding;
+};
+
+layout(std430, binding = 8) readonly buffer LightClusters
+{
+    LightCluster lightClusters[];
+};
 
-uniform vec3 cameraPosition;
+layout(std430, binding = 9) readonly buffer LightIndices
+{
+    uint lightIndices[];
+};
+
+layout(std140, binding = 0) uniform CameraBlock
+{
+    mat4 PV;
+    mat4 PVnoTranslation;
+    vec3 cameraPosition;
+};
 
 out vec4 FragColor;
 
@@ -75,6 +121,19 @@ vec3 specular_texture = vec3(0.0, 0.0, 0.0);
 vec3 common_diffuse_terms = vec3(0.0, 0.0, 0.0);
 vec3 common_specular_terms = vec3(0.0, 0.0, 0.0);
 
+LightCluster GetLightCluster(vec3 worldPosition)
+{
+    vec4 viewPosition = clusterView * vec4(worldPosition, 1.0);
+    vec4 clipPosition = clusterProjection * viewPosition;
+    vec2 ndc = clipPosition.xy / clipPosition.w;
+
+    uvec2 tile = uvec2(clamp((ndc * 0.5 + 0.5) * vec2(clusterCounts.xy), vec2(0.0), vec2(clusterCounts.xy) - 1.0));
+    float depthSlice = floor(log(max(-viewPosition.z, 0.0001)) * clusterDepthScale + clusterDepthBias);
+    uint slice = uint(clamp(depthSlice, 0.0, float(clusterCounts.z) - 1.0));
+
+    return lightClusters[tile.x + tile.y * clusterCounts.x + slice * clusterCounts.x * clusterCounts.y];
+}
+
 vec3 CalculateDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDirection)
 {
     vec3 lightDirection = -light.direction;
@@ -84,7 +143,7 @@ vec3 CalculateDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir
 
     // Specular
     vec3 halfwayDirection = normalize(lightDirection + viewDirection);
-    float spec = pow(max(dot(viewDirection, halfwayDirection), 0.0), material.shininess);
+    float spec = pow(max(dot(viewDirection, halfwayDirection), 0.0), materialShininess);
 
     // Combine results
     vec3 ambient = light.ambient * diffuse_texture;
@@ -102,7 +161,7 @@ vec3 CalculatePointLight(PointLight light, vec3 normal, vec3 viewDirection)
 
     // Specular
     vec3 halfwayDirection = normalize(lightDirection + viewDirection);
-    float spec = pow(max(dot(viewDirection, halfwayDirection), 0.0), material.shininess);
+    float spec = pow(max(dot(viewDirection, halfwayDirection), 0.0), materialShininess);
 
     // Attenuation
     float distance = length(light.position - FragmentPosition);
@@ -124,7 +183,7 @@ vec3 CalculateSpotLight(SpotLight light, vec3 normal, vec3 viewDirection)
 
     // Specular
     vec3 halfwayDirection = normalize(lightDirection + viewDirection);
-    float spec = pow(max(dot(viewDirection, halfwayDirection), 0.0), material.shininess);
+    float spec = pow(max(dot(viewDirection, halfwayDirection), 0.0), materialShininess);
 
     // Attenuation
     float distance = length(light.position - FragmentPosition);
@@ -158,8 +217,8 @@ void main()
     diffuse_texture = vec3(diffuse_texture_with_alpha);
     specular_texture = vec3(texture(material.texture_specular1, TextureCoordinatesVertex));
 
-    common_diffuse_terms = material.color * diffuse_texture;
-    common_specular_terms = material.specular * specular_texture;
+    common_diffuse_terms = materialColor * diffuse_texture;
+    common_specular_terms = materialSpecular * specular_texture;
 
     vec3 result = vec3(0.0, 0.0, 0.0);
 
@@ -169,16 +228,19 @@ void main()
         result += CalculateDirectionalLight(directionalLight, normal, viewDirection);
     }
 
+    // Only lights of the fragment's cluster can reach it
+    LightCluster cluster = GetLightCluster(FragmentPosition);
+
     // 2. Point lights
-    for (int i = 0; i < pointLightCount; ++i)
+    for (uint i = 0; i < cluster.pointLightCount; ++i)
     {
-        result += CalculatePointLight(pointLights[i], normal, viewDirection);
+        result += CalculatePointLight(pointLights[lightIndices[cluster.offset + i]], normal, viewDirection);
     }
 
     // 3. Spot lights
-    for (int i = 0; i < spotLightCount; ++i)
+    for (uint i = 0; i < cluster.spotLightCount; ++i)
     {
-        result += CalculateSpotLight(spotLights[i], normal, viewDirection);
+        result += CalculateSpotLight(spotLights[lightIndices[cluster.offset + cluster.pointLightCount + i]], normal, viewDirection);
     }
 
     FragColor = vec4(result.xyz, diffuse_texture_with_alpha.w);
@@ -8,8 +8,12 @@ out vec2 TextureCoordinatesVertex;
 out vec3 FragmentPosition;
 out vec3 NormalVertex;
 
-uniform mat4 PVM;
-uniform mat4 model;
+layout(std140, binding = 3) uniform ObjectBlock
+{
+    mat4 PVM;
+    mat4 model;
+    mat4 VM;
+};
 
 void main()
 {
@@ -4,23 +4,39 @@ layout (location = 0) in vec3 PositionInput;
 layout (location = 1) in vec3 NormalInput;
 layout (location = 2) in vec2 TextureCoordinatesInput;
 
-layout(std430, binding = 0) buffer modelMatrices
+layout(std430, binding = 0) readonly buffer modelsBuffer
 {
-    mat4 model[];
+    mat4 models[];
 };
 
+// Indices of instances left visible by frustum culling
+layout(std430, binding = 1) readonly buffer visibleInstancesBuffer
+{
+    uint visibleInstances[];
+};
+
+// Offset of the drawn batch in visibleInstances
+uniform int visibleOffset;
+
 out vec2 TextureCoordinatesVertex;
 out vec3 FragmentPosition;
 out vec3 NormalVertex;
 
-uniform mat4 PV;
+layout(std140, binding = 0) uniform CameraBlock
+{
+    mat4 PV;
+    mat4 PVnoTranslation;
+    vec3 cameraPosition;
+};
 
 void main()
 {
-    gl_Position = PV * model[gl_InstanceID] * vec4(PositionInput, 1.0);
-    FragmentPosition = vec3(model[gl_InstanceID] * vec4(PositionInput, 1.0));
+    mat4 model = models[visibleInstances[visibleOffset + gl_InstanceID]];
+
+    gl_Position = PV * model * vec4(PositionInput, 1.0);
+    FragmentPosition = vec3(model * vec4(PositionInput, 1.0));
 
     // TODO: Do this on the CPU?
-    NormalVertex = mat3(transpose(inverse(model[gl_InstanceID]))) * NormalInput;
+    NormalVertex = mat3(transpose(inverse(model))) * NormalInput;
     TextureCoordinatesVertex = TextureCoordinatesInput;
 }
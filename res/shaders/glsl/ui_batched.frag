@@ -0,0 +1,23 @@
+#version 430 core
+
+in vec2 TexCoords;
+in vec4 ColorVertex;
+flat in uint IsText;
+
+uniform sampler2D uiTexture;
+
+out vec4 FragColor;
+
+void main()
+{
+    vec4 color = texture(uiTexture, TexCoords);
+
+    // Glyph atlases only store coverage, text keeps its exact color
+    if (IsText != 0u)
+    {
+        FragColor = vec4(ColorVertex.rgb, ColorVertex.a * color.a);
+        return;
+    }
+
+    FragColor = color * ColorVertex;
+}
@@ -0,0 +1,31 @@
+#version 430 core
+
+// Position is already in normalized device coordinates, colors are packed as 0xAABBGGRR.
+// Members are scalars, so the layout matches the tightly packed vertices of the CPU.
+struct UIVertex
+{
+    float position[3];
+    float uv[2];
+    uint color;
+    uint isText;
+};
+
+// Every three vertices form a triangle, two triangles form a quad
+layout(std430, binding = 5) readonly buffer uiVerticesBuffer
+{
+    UIVertex uiVertices[];
+};
+
+out vec2 TexCoords;
+out vec4 ColorVertex;
+flat out uint IsText;
+
+void main()
+{
+    UIVertex uiVertex = uiVertices[gl_VertexID];
+
+    gl_Position = vec4(uiVertex.position[0], uiVertex.position[1], uiVertex.position[2], 1.0);
+    TexCoords = vec2(uiVertex.uv[0], uiVertex.uv[1]);
+    ColorVertex = unpackUnorm4x8(uiVertex.color);
+    IsText = uiVertex.isText;
+}
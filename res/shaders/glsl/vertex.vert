@@ -7,7 +7,12 @@ layout (location = 2) in vec2 TextureCoordinatesInput;
 out vec2 TextureCoordinatesVertex;
 out vec3 NormalVertex;
 
-uniform mat4 PVM;
+layout(std140, binding = 3) uniform ObjectBlock
+{
+    mat4 PVM;
+    mat4 model;
+    mat4 VM;
+};
 
 void main()
 {
@@ -10,7 +10,12 @@ out VS_OUT
     vec2 TextureCoordinatesVertex;
 } vs_out;
 
-uniform mat4 PVM;
+layout(std140, binding = 3) uniform ObjectBlock
+{
+    mat4 PVM;
+    mat4 model;
+    mat4 VM;
+};
 
 void main()
 {
@@ -1,4 +1,5 @@
 #include "lighting_calculations.hlsl"
+#include "vertex_decoding.hlsl"
 
 cbuffer object_buffer : register(b0)
 {
@@ -27,6 +28,8 @@ SamplerState default_sampler : register(s0);
 vs_output vs_main(vs_input input)
 {
     vs_output output;
+    input.pos = decode_position(input.pos);
+    input.normal = decode_normal(input.normal);
     output.pos = mul(projection_view_model, float4(input.pos, 1.0f));
     output.uv = input.uv;
     output.world_normal = mul((float3x3) world, input.normal); 
@@ -5,13 +5,12 @@
 cbuffer light_buffer : register(b0)
 {
     DirectionalLight directional_light;
-    PointLight point_lights[20];
-    SpotLight spot_lights[20];
     float3 camera_pos;
-    int number_of_point_lights;
-    int number_of_spot_lights;
     float gamma_strength;
     float exposure_strength;
+    float cluster_depth_scale;
+    float cluster_depth_bias;
+    uint3 cluster_counts;
 };
 
 cbuffer ps_misc_buffer : register(b3)
@@ -24,11 +23,61 @@ cbuffer ps_misc_buffer : register(b3)
     bool is_fog_rendered;
 }
 
+// Clustered lighting, built on the CPU every frame (see LightClusters.h).
+// Each cluster points to a range of light_indices, with point light indices first and spot light indices after them.
+// Clusters are followed by tiles, which have the lights of all depth slices of a tile, used for scattering along the view ray.
+struct LightCluster
+{
+    uint offset;
+    uint point_light_count;
+    uint spot_light_count;
+    uint padding;
+};
+
+StructuredBuffer<LightCluster> light_clusters : register(t60);
+StructuredBuffer<uint> light_indices : register(t61);
+StructuredBuffer<PointLight> point_lights : register(t64);
+StructuredBuffer<SpotLight> spot_lights : register(t65);
+
+uint2 get_light_tile_coordinates(float4 view_pos)
+{
+    float4 clip_pos = mul(projection, view_pos);
+    float2 ndc = clip_pos.xy / clip_pos.w;
+
+    return (uint2)clamp((ndc * 0.5f + 0.5f) * cluster_counts.xy, 0.0f, cluster_counts.xy - 1.0f);
+}
+
+LightCluster get_light_cluster(float3 world_pos)
+{
+    float4 view_pos = mul(view, float4(world_pos, 1.0f));
+    uint2 tile = get_light_tile_coordinates(view_pos);
+    uint slice = (uint)clamp(floor(log(max(-view_pos.z, 0.0001f)) * cluster_depth_scale + cluster_depth_bias), 0.0f, cluster_counts.z - 1.0f);
+
+    return light_clusters[tile.x + tile.y * cluster_counts.x + slice * cluster_counts.x * cluster_counts.y];
+}
+
+LightCluster get_light_tile(float3 world_pos)
+{
+    uint2 tile = get_light_tile_coordinates(mul(view, float4(world_pos, 1.0f)));
+
+    return light_clusters[cluster_counts.x * cluster_counts.y * cluster_counts.z + tile.x + tile.y * cluster_counts.x];
+}
+
+uint get_point_light_index(LightCluster cluster, uint i)
+{
+    return light_indices[cluster.offset + i];
+}
+
+uint get_spot_light_index(LightCluster cluster, uint i)
+{
+    return light_indices[cluster.offset + cluster.point_light_count + i];
+}
+
 SamplerState shadow_map_sampler : register(s1);
 
 Texture2D directional_shadow_map : register(t1);
-Texture2D spot_light_shadow_maps[20] : register(t20);
-TextureCube point_light_shadow_maps[20]: register(t40);
+Texture2D spot_light_shadow_maps[MAX_SHADOWED_LIGHTS] : register(t20);
+TextureCube point_light_shadow_maps[MAX_SHADOWED_LIGHTS]: register(t40);
 
 SamplerState point_sampler
 {
@@ -243,7 +292,7 @@ float3 calculate_directional_light(DirectionalLight light, float3 normal, float3
     return ambient + (1.0f - shadow) * (diffuse + specular);
 }
 
-float3 calculate_point_light(PointLight light, float3 normal, float3 world_pos, float3 view_dir, float3 diffuse_texture, int index, bool calculate_shadows, float ambient_occlusion = 1.0f)
+float3 calculate_point_light(PointLight light, float3 normal, float3 world_pos, float3 view_dir, float3 diffuse_texture, bool calculate_shadows, float ambient_occlusion = 1.0f)
 {
     float3 light_dir = normalize(light.position - world_pos);
 
@@ -264,15 +313,15 @@ float3 calculate_point_light(PointLight light, float3 normal, float3 world_pos,
     float3 specular = light.specular * spec * diffuse_texture;
 
     float shadow = 0.0f;
-    if (calculate_shadows)
+    if (calculate_shadows && light.shadow_map_index >= 0)
     {
-        shadow = point_shadow_calculation(light, world_pos, index);
+        shadow = point_shadow_calculation(light, world_pos, light.shadow_map_index);
     }
 
     return attenuation * (ambient + (1.0f - shadow) * (diffuse + specular));
 }
 
-float3 calculate_spot_light(SpotLight light, float3 normal, float3 world_pos, float3 view_dir, float3 diffuse_texture, int index, bool calculate_shadows, float ambient_occlusion = 1.0f)
+float3 calculate_spot_light(SpotLight light, float3 normal, float3 world_pos, float3 view_dir, float3 diffuse_texture, bool calculate_shadows, float ambient_occlusion = 1.0f)
 {
     float3 light_dir = normalize(light.position - world_pos.xyz);
 
@@ -298,9 +347,9 @@ float3 calculate_spot_light(SpotLight light, float3 normal, float3 world_pos, fl
     float3 specular = light.specular * spec * diffuse_texture;
 
     float shadow = 0.0f;
-    if (calculate_shadows)
+    if (calculate_shadows && light.shadow_map_index >= 0)
     {
-        shadow = spot_shadow_calculation(light, world_pos, index, normal, true);
+        shadow = spot_shadow_calculation(light, world_pos, light.shadow_map_index, normal, true);
     }
 
 #ifdef BELOW_WATER_HACK
@@ -314,7 +363,7 @@ float3 calculate_spot_light(SpotLight light, float3 normal, float3 world_pos, fl
     return attenuation * intensity *  ((1.0f - shadow) * (diffuse + specular + ambient));
 }
 
-float2 intersect_light_cone(SpotLight light, float3 ray_origin, float3 ray_direction, out float shadow, float light_index)
+float2 intersect_light_cone(SpotLight light, float3 ray_origin, float3 ray_direction, out float shadow)
 {
     float4 local_origin = mul(light.inv_model, float4(ray_origin, 1.0f));
     float4 local_direction = mul(light.inv_model, float4(ray_direction, 0.0f));
@@ -343,7 +392,11 @@ float2 intersect_light_cone(SpotLight light, float3 ray_origin, float3 ray_direc
     world_point_max_h.xyz /= world_point_max_h.w;
 
     // Shadow is present, when the closest intersection point is in the shadow
-    shadow = spot_shadow_calculation(light, world_point_min_h.xyz, light_index, float3(1.0f, 1.0f, 1.0f), false);
+    shadow = 0.0f;
+    if (light.shadow_map_index >= 0)
+    {
+        shadow = spot_shadow_calculation(light, world_point_min_h.xyz, light.shadow_map_index, float3(1.0f, 1.0f, 1.0f), false);
+    }
 
     if (y1 > 0.0f && y2 > 0.0f)
     {
@@ -392,7 +445,7 @@ float in_scatter(float3 start, float3 dir, float3 lightPos, float d)
     return l;
 }
 
-float3 calculate_scatter(SpotLight light, float4 world_position, int light_index)
+float3 calculate_scatter(SpotLight light, float4 world_position)
 {
     float3 surface_to_camera_direction = world_position.xyz - camera_pos;
     float ray_length = length(surface_to_camera_direction);
@@ -403,7 +456,7 @@ float3 calculate_scatter(SpotLight light, float4 world_position, int light_index
     float max_t = 0.0f;
 
     float shadow = 0.0f;
-    float2 res = intersect_light_cone(light, camera_pos, surface_to_camera_direction, shadow, light_index);
+    float2 res = intersect_light_cone(light, camera_pos, surface_to_camera_direction, shadow);
 
     if (shadow > 0.0f)
     {
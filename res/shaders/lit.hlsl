@@ -1,4 +1,5 @@
 #include "lighting_calculations.hlsl"
+#include "vertex_decoding.hlsl"
 
 cbuffer object_buffer : register(b0)
 {
@@ -12,6 +13,7 @@ struct VS_Input
     float3 pos: POSITION;
     float3 normal : NORMAL;
     float2 UV : TEXCOORD0;
+    uint instance_id : SV_InstanceID;
 };
 
 struct VS_Output
@@ -28,11 +30,15 @@ SamplerState obj_sampler_state : register(s0);
 VS_Output vs_main(VS_Input input)
 {
     VS_Output output;
+    input.pos = decode_position(input.pos);
+    input.normal = decode_normal(input.normal);
 
-    output.world_pos = mul(model, float4(input.pos, 1.0f)).xyz;
+    float4x4 world = get_model_matrix(model, input.instance_id);
+
+    output.world_pos = mul(world, float4(input.pos, 1.0f)).xyz;
     output.UV = input.UV;
-    output.normal = mul(input.normal, (float3x3)model);
-    output.pixel_pos = mul(projection_view_model, float4(input.pos, 1.0f));
+    output.normal = mul(input.normal, (float3x3)world);
+    output.pixel_pos = mul(get_projection_view_model(projection_view_model, projection_view, world), float4(input.pos, 1.0f));
     return output;
 }
 
@@ -45,14 +51,18 @@ float4 ps_main(VS_Output input) : SV_TARGET
 
     float3 result = calculate_directional_light(directional_light, norm, view_dir, diffuse_texture, input.world_pos, true);
 
-    for (int point_light_index = 0; point_light_index < number_of_point_lights; point_light_index++)
+    LightCluster cluster = get_light_cluster(input.world_pos);
+
+    for (uint i = 0; i < cluster.point_light_count; i++)
     {
-        result += calculate_point_light(point_lights[point_light_index], norm, input.world_pos.rgb, view_dir, diffuse_texture, point_light_index, true);
+        uint point_light_index = get_point_light_index(cluster, i);
+        result += calculate_point_light(point_lights[point_light_index], norm, input.world_pos.rgb, view_dir, diffuse_texture, true);
     }
 
-    for (int spot_light_index = 0; spot_light_index < number_of_spot_lights; spot_light_index++)
+    for (uint j = 0; j < cluster.spot_light_count; j++)
     {
-        result += calculate_spot_light(spot_lights[spot_light_index], norm, input.world_pos, view_dir, diffuse_texture, spot_light_index, true);
+        uint spot_light_index = get_spot_light_index(cluster, j);
+        result += calculate_spot_light(spot_lights[spot_light_index], norm, input.world_pos, view_dir, diffuse_texture, true);
     }
 
     return gamma_correction(result);
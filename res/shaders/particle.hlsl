@@ -1,4 +1,5 @@
 #include "common_functions.hlsl"
+#include "vertex_decoding.hlsl"
 
 cbuffer object_buffer : register(b0)
 {
@@ -31,6 +32,8 @@ SamplerState ObjSamplerState;
 VS_Output vs_main(VS_Input input)
 {
     VS_Output output;
+    input.pos = decode_position(input.pos);
+    input.normal = decode_normal(input.normal);
     output.pos = mul(projection_view_model,float4(input.pos.xyz, 1.0f));
     output.normal = input.normal;
     output.UV = input.UV;
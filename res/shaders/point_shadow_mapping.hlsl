@@ -1,14 +1,18 @@
+#include "vertex_decoding.hlsl"
+
 struct VS_Input
 {
     float3 pos: POSITION;
     float3 normal : NORMAL;
     float2 UV : TEXCOORD0;
+    uint instance_id : SV_InstanceID;
 };
 
 cbuffer object_buffer : register(b0)
 {
     float4x4 projection_view_model;
     float4x4 model;
+    float4x4 projection_view;
 };
 
 cbuffer depth_constants : register(b1)
@@ -26,8 +30,10 @@ struct VS_Output
 VS_Output vs_main(VS_Input input)
 {
     VS_Output output;
-    output.world_pos = mul(model, float4(input.pos, 1.0f));
-    output.pixel_pos = mul(projection_view_model, float4(input.pos, 1.0f));
+    input.pos = decode_position(input.pos);
+    float4x4 world = get_model_matrix(model, input.instance_id);
+    output.world_pos = mul(world, float4(input.pos, 1.0f));
+    output.pixel_pos = mul(get_projection_view_model(projection_view_model, projection_view, world), float4(input.pos, 1.0f));
     return output;
 }
 
@@ -1,3 +1,5 @@
+#include "vertex_decoding.hlsl"
+
 cbuffer object_buffer : register(b0)
 {
     float4x4 projection_view_model;
@@ -24,6 +26,8 @@ SamplerState ObjSamplerState;
 VS_Output vs_main(VS_Input input)
 {
     VS_Output output;
+    input.pos = decode_position(input.pos);
+    input.normal = decode_normal(input.normal);
     output.pos = mul(projection_view_model,float4(input.pos.xyz,1.0f));
     output.normal = input.normal;
     output.UV = input.UV;
@@ -6,11 +6,16 @@ struct PCSSSettingsPerLight
     float light_frustum_width;
 };
 
+// Point and spot lights are read from structured buffers, which aren't padded like constant buffers.
+// Has to match DXPointLight and DXSpotLight in ConstantBufferTypes.h
 struct PointLight
 {
     float3 position;
+    int shadow_map_index; // -1 when the light has no shadow map
     float3 ambient;
+    float padding1;
     float3 diffuse;
+    float padding2;
     float3 specular;
     
     float constant;
@@ -51,6 +56,7 @@ struct SpotLight
     float3 diffuse;
     float near_plane;
     float3 specular;
+    int shadow_map_index; // -1 when the light has no shadow map
 
     float4x4 projection_view;
     float4x4 inv_model;
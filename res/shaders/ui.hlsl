@@ -1,4 +1,5 @@
 #include "common_functions.hlsl"
+#include "vertex_decoding.hlsl"
 
 struct VS_Input
 {
@@ -33,6 +34,7 @@ SamplerState UISampler;
 VS_Output vs_main(VS_Input input)
 {
     VS_Output output;
+    input.pos = decode_position(input.pos);
     output.pos = mul(world, float4(input.pos.xy, 0.0, 1.0));
     output.UV = input.UV;
     return output;
@@ -0,0 +1,49 @@
+#include "common_functions.hlsl"
+
+// Position is already in normalized device coordinates, colors are packed as 0xAABBGGRR
+struct UIVertex
+{
+    float3 position;
+    float2 uv;
+    uint color;
+    uint is_text;
+};
+
+// Every three vertices form a triangle, two triangles form a quad
+StructuredBuffer<UIVertex> ui_vertices : register(t59);
+
+Texture2D UITexture : register(t0);
+SamplerState UISampler : register(s0);
+
+struct VS_Output
+{
+    float4 pos : SV_POSITION;
+    float2 UV : TEXCOORD;
+    float4 color : COLOR;
+    nointerpolation uint is_text : TEXT;
+};
+
+VS_Output vs_main(uint vertex_id : SV_VertexID)
+{
+    UIVertex ui_vertex = ui_vertices[vertex_id];
+
+    VS_Output output;
+    output.pos = float4(ui_vertex.position, 1.0);
+    output.UV = ui_vertex.uv;
+    output.color = float4(ui_vertex.color & 0xff, (ui_vertex.color >> 8) & 0xff, (ui_vertex.color >> 16) & 0xff,
+                          ui_vertex.color >> 24) / 255.0f;
+    output.is_text = ui_vertex.is_text;
+    return output;
+}
+
+float4 ps_main(VS_Output input) : SV_TARGET
+{
+    float4 color = UITexture.Sample(UISampler, input.UV);
+
+    // Glyph atlases only store coverage, text keeps its exact color
+    if (input.is_text != 0)
+        return float4(input.color.rgb, input.color.a * color.a);
+
+    color *= input.color;
+    return float4(exposure_tonemapping(gamma_correction(color.xyz)), color.a);
+}
@@ -0,0 +1,97 @@
+#ifndef VERTEX_DECODING_HLSL
+#define VERTEX_DECODING_HLSL
+
+// Per-mesh parameters, set by every mesh before drawing. Meshes stored in full precision have zero offset and unit scale.
+cbuffer mesh_buffer : register(b5)
+{
+    float3 position_offset;
+    bool is_vertex_packed;
+    float3 position_scale;
+};
+
+// Instanced draws take model matrices from the instance buffer instead of the object buffer, see RendererDX11::update_instances().
+// Billboards replace the rotation of their model matrix with the rotation of the main camera.
+cbuffer draw_flags_buffer : register(b6)
+{
+    bool is_instanced;
+    bool is_billboard;
+};
+
+// Per-frame camera data, see RendererDX11::set_camera_position_buffer()
+cbuffer camera_buffer : register(b2)
+{
+    float3 camera_buffer_position;
+    float camera_buffer_padding0;
+    float3 camera_axis_x;
+    float camera_buffer_padding1;
+    float3 camera_axis_y;
+    float camera_buffer_padding2;
+    float3 camera_axis_z;
+    float camera_buffer_padding3;
+};
+
+StructuredBuffer<float4x4> instance_models : register(t62);
+
+// Keeps the translation and scale of the model matrix, so transforms of billboards never have to be touched on the CPU
+float4x4 orient_billboard(float4x4 model)
+{
+    float3 scale = float3(length(model._m00_m10_m20), length(model._m01_m11_m21), length(model._m02_m12_m22));
+
+    model._m00_m10_m20 = camera_axis_x * scale.x;
+    model._m01_m11_m21 = camera_axis_y * scale.y;
+    model._m02_m12_m22 = camera_axis_z * scale.z;
+
+    return model;
+}
+
+float4x4 get_model_matrix(float4x4 object_model, uint instance_id)
+{
+    float4x4 model = is_instanced ? instance_models[instance_id] : object_model;
+
+    if (is_billboard)
+    {
+        return orient_billboard(model);
+    }
+
+    return model;
+}
+
+float4x4 get_projection_view_model(float4x4 object_projection_view_model, float4x4 projection_view, float4x4 model)
+{
+    if (is_instanced || is_billboard)
+    {
+        return mul(projection_view, model);
+    }
+
+    return object_projection_view_model;
+}
+
+float3 decode_position(float3 position)
+{
+    return position * position_scale + position_offset;
+}
+
+// http://jcgt.org/published/0003/02/01/
+float3 decode_octahedral(float2 encoded)
+{
+    float3 normal = float3(encoded.xy, 1.0f - abs(encoded.x) - abs(encoded.y));
+
+    if (normal.z < 0.0f)
+    {
+        normal.xy = (1.0f - abs(normal.yx)) * (normal.xy >= 0.0f ? 1.0f : -1.0f);
+    }
+
+    return normalize(normal);
+}
+
+float3 decode_normal(float3 normal)
+{
+    if (is_vertex_packed)
+    {
+        return decode_octahedral(normal.xy);
+    }
+
+    return normal;
+}
+
+#endif
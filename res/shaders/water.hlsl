@@ -3,6 +3,7 @@
 
 #include "ssr.hlsl"
 #include "ShadingDefines.h"
+#include "vertex_decoding.hlsl"
 
 cbuffer water_buffer : register(b4)
 {
@@ -121,6 +122,8 @@ float falloff(float3 current_world_position, float3 other_world_position, float
 VS_Output vs_main(VS_Input input)
 {
     VS_Output output;
+    input.pos = decode_position(input.pos);
+    input.normal = decode_normal(input.normal);
     output.world_pos = mul(model, float4(input.pos, 1.0f));
 
     PositionAndNormal pos_and_normal = calc_gerstner_wave_position_and_normal(output.world_pos.x, output.world_pos.z, input.pos);
@@ -238,16 +241,31 @@ float4 ps_main(VS_Output input) : SV_TARGET
     float3 scatter = float3(0.0f.xxx);
     float fog_value = fog_tex.Sample(wrap_sampler, UV + time_ps / 100.0f).r;
 
-    for (int i = 0; i < number_of_point_lights; i++)
+    // Scattering happens along the whole view ray, so it uses the lights of every cluster of the pixel's tile
+    LightCluster tile = get_light_tile(input.world_pos);
+
+    for (uint i = 0; i < tile.point_light_count; i++)
+    {
+        scatter += calculate_scatter(point_lights[get_point_light_index(tile, i)], float4(input.world_pos, 1.0f)) * fog_value;
+    }
+
+    for (uint j = 0; j < tile.spot_light_count; j++)
+    {
+        scatter += calculate_scatter(spot_lights[get_spot_light_index(tile, j)], float4(input.world_pos, 1.0f)) * fog_value;
+    }
+
+    LightCluster cluster = get_light_cluster(input.world_pos);
+
+    for (uint k = 0; k < cluster.point_light_count; k++)
     {
-        scatter += calculate_scatter(point_lights[i], float4(input.world_pos, 1.0f)) * fog_value;
-        result += calculate_point_light(point_lights[i], combined_normal, input.world_pos.rgb, view_dir, pixel_color, i, RENDER_POINT_SHADOW_MAPS);
+        uint point_light_index = get_point_light_index(cluster, k);
+        result += calculate_point_light(point_lights[point_light_index], combined_normal, input.world_pos.rgb, view_dir, pixel_color, RENDER_POINT_SHADOW_MAPS);
     }
 
-    for (int j = 0; j < number_of_spot_lights; j++)
+    for (uint l = 0; l < cluster.spot_light_count; l++)
     {
-        result += calculate_spot_light(spot_lights[j], combined_normal, input.world_pos, view_dir, pixel_color, j, true);
-        scatter += calculate_scatter(spot_lights[j], float4(input.world_pos, 1.0f), j) * fog_value;
+        uint spot_light_index = get_spot_light_index(cluster, l);
+        result += calculate_spot_light(spot_lights[spot_light_index], combined_normal, input.world_pos, view_dir, pixel_color, true);
     }
 
     result = ((ssr_refraction.xyz) * 0.5f + result + ssr_reflection.xyz * 2.0f) / 3.0f;
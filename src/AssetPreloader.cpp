@@ -2,6 +2,7 @@
 
 #include "Debug.h"
 
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 
@@ -45,3 +46,26 @@ void AssetPreloader::preload_text_asset(std::string const& asset_path)
 
     preloaded_text_assets.emplace(asset_path, stream.str());
 }
+
+void AssetPreloader::set_sound_load_policy(std::string const& asset_path, SoundLoadPolicy const policy)
+{
+    sound_load_policies[asset_path] = policy;
+}
+
+SoundLoadPolicy AssetPreloader::get_sound_load_policy(std::string const& asset_path) const
+{
+    if (auto const it = sound_load_policies.find(asset_path); it != sound_load_policies.end() && it->second != SoundLoadPolicy::Default)
+    {
+        return it->second;
+    }
+
+    std::error_code error = {};
+    u64 const size = std::filesystem::file_size(asset_path, error);
+
+    if (!error && size > sound_stream_threshold)
+    {
+        return SoundLoadPolicy::Stream;
+    }
+
+    return SoundLoadPolicy::Preload;
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "AK/Badge.h"
+#include "AK/Types.h"
+#include "Sound.h"
 
 #include <memory>
 #include <optional>
@@ -17,5 +19,13 @@ public:
     std::optional<std::string> get_text_asset(std::string const& asset_path);
     void preload_text_asset(std::string const& asset_path);
 
+    // Whether a sound file is decoded up front or streamed while playing. Files without a policy are streamed
+    // when they are bigger than sound_stream_threshold, so long music and ambience never stay resident in memory.
+    void set_sound_load_policy(std::string const& asset_path, SoundLoadPolicy const policy);
+    SoundLoadPolicy get_sound_load_policy(std::string const& asset_path) const;
+
     std::unordered_map<std::string, std::string> preloaded_text_assets = {};
+    std::unordered_map<std::string, SoundLoadPolicy> sound_load_policies = {};
+
+    inline static u64 constexpr sound_stream_threshold = 1024 * 1024;
 };
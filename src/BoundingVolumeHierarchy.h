@@ -0,0 +1,524 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "AK/Types.h"
+#include "Bounds.h"
+#include "Frustum.h"
+#include "FrustumCuller.h"
+
+// Dynamic bounding volume hierarchy over world space bounding boxes, used for culling and spatial queries.
+// Every object is a leaf with fattened bounds, so objects moving only a little don't change the tree at all. Objects leaving
+// their fattened bounds are reinserted, next to the sibling that increases the surface area of the tree the least, and the tree
+// is kept balanced with rotations on the way up. Nodes live in a single vector and are reused through a free list.
+// Exact bounds are kept in the leaves, so queries never return objects only overlapping the fattened bounds.
+template<typename T>
+class BoundingVolumeHierarchy
+{
+public:
+    inline static i32 constexpr null_node = -1;
+
+    // Returns a proxy identifying the object, valid until it's removed
+    i32 insert(BoundingBox const& bounds, T const& data)
+    {
+        i32 const leaf = allocate_node();
+        Node& node = m_nodes[leaf];
+
+        node.tight_min = bounds.min;
+        node.tight_max = bounds.max;
+        fatten(node);
+        node.data = data;
+        node.height = 0;
+
+        insert_leaf(leaf);
+        m_count += 1;
+
+        return leaf;
+    }
+
+    void remove(i32 const proxy)
+    {
+        assert(is_leaf(proxy));
+
+        remove_leaf(proxy);
+        free_node(proxy);
+        m_count -= 1;
+    }
+
+    // Updates exact bounds of the object. Returns true when the object left its fattened bounds and was reinserted.
+    bool move(i32 const proxy, BoundingBox const& bounds)
+    {
+        assert(is_leaf(proxy));
+
+        Node& node = m_nodes[proxy];
+        node.tight_min = bounds.min;
+        node.tight_max = bounds.max;
+
+        if (glm::all(glm::greaterThanEqual(bounds.min, node.min)) && glm::all(glm::lessThanEqual(bounds.max, node.max)))
+            return false;
+
+        remove_leaf(proxy);
+        fatten(m_nodes[proxy]);
+        insert_leaf(proxy);
+
+        return true;
+    }
+
+    void clear()
+    {
+        m_nodes.clear();
+        m_root = null_node;
+        m_free_list = null_node;
+        m_count = 0;
+    }
+
+    [[nodiscard]] T const& get_data(i32 const proxy) const
+    {
+        return m_nodes[proxy].data;
+    }
+
+    [[nodiscard]] BoundingBox get_bounds(i32 const proxy) const
+    {
+        return {m_nodes[proxy].tight_min, m_nodes[proxy].tight_max};
+    }
+
+    [[nodiscard]] u32 size() const
+    {
+        return m_count;
+    }
+
+    [[nodiscard]] i32 get_height() const
+    {
+        return m_root == null_node ? 0 : m_nodes[m_root].height;
+    }
+
+    // Calls callback(data) for every object with bounds intersecting or inside the frustum. Same test as FrustumCuller, but whole
+    // subtrees are skipped when they are outside of the frustum, or accepted without any tests when they are inside of it.
+    template<typename Callback>
+    void query(Frustum const& frustum, Callback&& callback) const
+    {
+        std::array const planes = {frustum.left_plane, frustum.right_plane,  frustum.top_plane,
+                                   frustum.bottom_plane, frustum.near_plane, frustum.far_plane};
+
+        traverse(
+            [&](Node const& node) {
+                glm::vec3 const center = (node.min + node.max) * 0.5f;
+                glm::vec3 const extents = (node.max - node.min) * 0.5f;
+
+                bool is_inside = true;
+
+                for (auto const& plane : planes)
+                {
+                    float const distance = glm::dot(plane.normal, center) + plane.distance;
+                    float const radius = glm::dot(extents, glm::abs(plane.normal));
+
+                    if (distance + radius < plane_epsilon)
+                        return Overlap::Outside;
+
+                    is_inside = is_inside && distance - radius >= 0.0f;
+                }
+
+                return is_inside ? Overlap::Inside : Overlap::Intersecting;
+            },
+            [&](Node const& node) { return FrustumCuller::is_visible(BoundingBox(node.tight_min, node.tight_max), frustum); },
+            callback);
+    }
+
+    // Calls callback(data) for every object with bounds intersecting the box
+    template<typename Callback>
+    void query(BoundingBox const& bounds, Callback&& callback) const
+    {
+        traverse(
+            [&](Node const& node) {
+                if (!overlaps(node.min, node.max, bounds.min, bounds.max))
+                    return Overlap::Outside;
+
+                bool const is_inside = glm::all(glm::greaterThanEqual(node.min, bounds.min)) && glm::all(glm::lessThanEqual(node.max, bounds.max));
+                return is_inside ? Overlap::Inside : Overlap::Intersecting;
+            },
+            [&](Node const& node) { return overlaps(node.tight_min, node.tight_max, bounds.min, bounds.max); }, callback);
+    }
+
+    // Calls callback(data) for every object with bounds intersecting the sphere
+    template<typename Callback>
+    void query_sphere(glm::vec3 const& center, float const radius, Callback&& callback) const
+    {
+        float const radius_squared = radius * radius;
+
+        auto const distance_squared = [&](glm::vec3 const& min, glm::vec3 const& max) {
+            glm::vec3 const closest = glm::clamp(center, min, max);
+            return glm::dot(closest - center, closest - center);
+        };
+
+        traverse(
+            [&](Node const& node) { return distance_squared(node.min, node.max) <= radius_squared ? Overlap::Intersecting : Overlap::Outside; },
+            [&](Node const& node) { return distance_squared(node.tight_min, node.tight_max) <= radius_squared; }, callback);
+    }
+
+    // Calls callback(data, distance) for every object with bounds hit by the ray within max_distance, in no particular order.
+    // Direction doesn't have to be normalized, distances are then in multiples of its length.
+    template<typename Callback>
+    void query_ray(glm::vec3 const& origin, glm::vec3 const& direction, float const max_distance, Callback&& callback) const
+    {
+        glm::vec3 const inverse_direction = 1.0f / direction;
+        float distance = 0.0f;
+
+        traverse(
+            [&](Node const& node) {
+                return intersects_ray(origin, inverse_direction, max_distance, node.min, node.max, distance) ? Overlap::Intersecting
+                                                                                                           : Overlap::Outside;
+            },
+            [&](Node const& node) { return intersects_ray(origin, inverse_direction, max_distance, node.tight_min, node.tight_max, distance); },
+            [&](T const& data) { callback(data, distance); });
+    }
+
+    // Fattened bounds grow by a fixed margin and by a part of their size, so both small and large objects can move a bit
+    inline static float constexpr fat_margin = 0.1f;
+    inline static float constexpr fat_margin_ratio = 0.1f;
+
+private:
+    struct Node
+    {
+        // Fattened bounds for leaves, bounds of both children otherwise
+        glm::vec3 min = {};
+        glm::vec3 max = {};
+
+        glm::vec3 tight_min = {};
+        glm::vec3 tight_max = {};
+
+        // Next free node for nodes in the free list
+        i32 parent = null_node;
+        i32 left = null_node;
+        i32 right = null_node;
+
+        // Leaves have height 0, free nodes -1
+        i32 height = -1;
+
+        T data = {};
+    };
+
+    enum class Overlap : u8
+    {
+        Outside,
+        Intersecting,
+        Inside,
+    };
+
+    // Same tolerance as BoundingBox::half_plane_test
+    inline static float constexpr plane_epsilon = -0.02f;
+
+    // Enough for any balanced tree that fits in memory
+    inline static u32 constexpr max_stack_size = 256;
+
+    // Visits nodes overlapping the query. Leaves of nodes classified as inside are reported without testing them.
+    template<typename NodeTest, typename LeafTest, typename Callback>
+    void traverse(NodeTest&& node_test, LeafTest&& leaf_test, Callback&& callback) const
+    {
+        if (m_root == null_node)
+            return;
+
+        std::array<std::pair<i32, bool>, max_stack_size> stack = {};
+        u32 stack_size = 0;
+        stack[stack_size++] = {m_root, false};
+
+        while (stack_size > 0)
+        {
+            auto const [index, is_inside] = stack[--stack_size];
+            Node const& node = m_nodes[index];
+
+            Overlap const overlap = is_inside ? Overlap::Inside : node_test(node);
+
+            if (overlap == Overlap::Outside)
+                continue;
+
+            if (node.left == null_node)
+            {
+                if (overlap == Overlap::Inside || leaf_test(node))
+                {
+                    callback(node.data);
+                }
+
+                continue;
+            }
+
+            assert(stack_size + 2 <= max_stack_size);
+            stack[stack_size++] = {node.right, overlap == Overlap::Inside};
+            stack[stack_size++] = {node.left, overlap == Overlap::Inside};
+        }
+    }
+
+    [[nodiscard]] bool is_leaf(i32 const index) const
+    {
+        return index >= 0 && index < static_cast<i32>(m_nodes.size()) && m_nodes[index].height == 0;
+    }
+
+    [[nodiscard]] static bool overlaps(glm::vec3 const& min_a, glm::vec3 const& max_a, glm::vec3 const& min_b, glm::vec3 const& max_b)
+    {
+        return glm::all(glm::lessThanEqual(min_a, max_b)) && glm::all(glm::lessThanEqual(min_b, max_a));
+    }
+
+    [[nodiscard]] static bool intersects_ray(glm::vec3 const& origin, glm::vec3 const& inverse_direction, float const max_distance,
+                                             glm::vec3 const& min, glm::vec3 const& max, float& distance)
+    {
+        glm::vec3 const t0 = (min - origin) * inverse_direction;
+        glm::vec3 const t1 = (max - origin) * inverse_direction;
+
+        glm::vec3 const t_near = glm::min(t0, t1);
+        glm::vec3 const t_far = glm::max(t0, t1);
+
+        float const enter = std::max({t_near.x, t_near.y, t_near.z, 0.0f});
+        float const exit = std::min({t_far.x, t_far.y, t_far.z, max_distance});
+
+        distance = enter;
+        return enter <= exit;
+    }
+
+    [[nodiscard]] static float get_surface_area(glm::vec3 const& min, glm::vec3 const& max)
+    {
+        glm::vec3 const size = max - min;
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    static void fatten(Node& node)
+    {
+        glm::vec3 const margin = glm::vec3(fat_margin) + (node.tight_max - node.tight_min) * fat_margin_ratio;
+        node.min = node.tight_min - margin;
+        node.max = node.tight_max + margin;
+    }
+
+    i32 allocate_node()
+    {
+        if (m_free_list == null_node)
+        {
+            m_nodes.emplace_back();
+            return static_cast<i32>(m_nodes.size() - 1);
+        }
+
+        i32 const index = m_free_list;
+        m_free_list = m_nodes[index].parent;
+        m_nodes[index] = {};
+
+        return index;
+    }
+
+    void free_node(i32 const index)
+    {
+        m_nodes[index] = {};
+        m_nodes[index].parent = m_free_list;
+        m_free_list = index;
+    }
+
+    void insert_leaf(i32 const leaf)
+    {
+        if (m_root == null_node)
+        {
+            m_root = leaf;
+            m_nodes[leaf].parent = null_node;
+            return;
+        }
+
+        glm::vec3 const leaf_min = m_nodes[leaf].min;
+        glm::vec3 const leaf_max = m_nodes[leaf].max;
+
+        // Descend towards the sibling which makes the tree grow the least
+        i32 index = m_root;
+
+        while (m_nodes[index].left != null_node)
+        {
+            Node const& node = m_nodes[index];
+
+            float const area = get_surface_area(node.min, node.max);
+            float const combined_area = get_surface_area(glm::min(node.min, leaf_min), glm::max(node.max, leaf_max));
+
+            // Cost of making a new parent for this node and the leaf
+            float const cost = 2.0f * combined_area;
+
+            // Minimum cost of pushing the leaf further down the tree
+            float const inheritance_cost = 2.0f * (combined_area - area);
+
+            auto const get_child_cost = [&](i32 const child) {
+                Node const& child_node = m_nodes[child];
+                float const child_area = get_surface_area(glm::min(child_node.min, leaf_min), glm::max(child_node.max, leaf_max));
+
+                if (child_node.left == null_node)
+                    return child_area + inheritance_cost;
+
+                return child_area - get_surface_area(child_node.min, child_node.max) + inheritance_cost;
+            };
+
+            float const left_cost = get_child_cost(node.left);
+            float const right_cost = get_child_cost(node.right);
+
+            if (cost < left_cost && cost < right_cost)
+                break;
+
+            index = left_cost < right_cost ? node.left : node.right;
+        }
+
+        i32 const sibling = index;
+        i32 const old_parent = m_nodes[sibling].parent;
+        i32 const new_parent = allocate_node();
+
+        Node& parent = m_nodes[new_parent];
+        parent.parent = old_parent;
+        parent.min = glm::min(leaf_min, m_nodes[sibling].min);
+        parent.max = glm::max(leaf_max, m_nodes[sibling].max);
+        parent.height = m_nodes[sibling].height + 1;
+        parent.left = sibling;
+        parent.right = leaf;
+
+        if (old_parent != null_node)
+        {
+            if (m_nodes[old_parent].left == sibling)
+                m_nodes[old_parent].left = new_parent;
+            else
+                m_nodes[old_parent].right = new_parent;
+        }
+        else
+        {
+            m_root = new_parent;
+        }
+
+        m_nodes[sibling].parent = new_parent;
+        m_nodes[leaf].parent = new_parent;
+
+        refit(new_parent);
+    }
+
+    void remove_leaf(i32 const leaf)
+    {
+        if (leaf == m_root)
+        {
+            m_root = null_node;
+            return;
+        }
+
+        i32 const parent = m_nodes[leaf].parent;
+        i32 const grandparent = m_nodes[parent].parent;
+        i32 const sibling = m_nodes[parent].left == leaf ? m_nodes[parent].right : m_nodes[parent].left;
+
+        free_node(parent);
+
+        if (grandparent == null_node)
+        {
+            m_root = sibling;
+            m_nodes[sibling].parent = null_node;
+            return;
+        }
+
+        if (m_nodes[grandparent].left == parent)
+            m_nodes[grandparent].left = sibling;
+        else
+            m_nodes[grandparent].right = sibling;
+
+        m_nodes[sibling].parent = grandparent;
+
+        refit(grandparent);
+    }
+
+    // Balances and recomputes bounds and heights of the node and all of its ancestors
+    void refit(i32 index)
+    {
+        while (index != null_node)
+        {
+            index = balance(index);
+
+            Node& node = m_nodes[index];
+            Node const& left = m_nodes[node.left];
+            Node const& right = m_nodes[node.right];
+
+            node.height = 1 + std::max(left.height, right.height);
+            node.min = glm::min(left.min, right.min);
+            node.max = glm::max(left.max, right.max);
+
+            index = node.parent;
+        }
+    }
+
+    // Rotates the node's taller child up when the heights of its children differ by more than one. Returns the node now in
+    // the node's place.
+    i32 balance(i32 const a)
+    {
+        Node& node_a = m_nodes[a];
+
+        if (node_a.left == null_node)
+            return a;
+
+        i32 const b = node_a.left;
+        i32 const c = node_a.right;
+        i32 const difference = m_nodes[c].height - m_nodes[b].height;
+
+        if (difference > 1)
+            return rotate(a, c, b);
+
+        if (difference < -1)
+            return rotate(a, b, c);
+
+        return a;
+    }
+
+    // Moves the taller child up into the place of a, a takes the place of its shorter child
+    i32 rotate(i32 const a, i32 const taller, i32 const shorter)
+    {
+        Node& node_a = m_nodes[a];
+        Node& node_taller = m_nodes[taller];
+
+        i32 const f = node_taller.left;
+        i32 const g = node_taller.right;
+
+        node_taller.left = a;
+        node_taller.parent = node_a.parent;
+        node_a.parent = taller;
+
+        if (node_taller.parent != null_node)
+        {
+            if (m_nodes[node_taller.parent].left == a)
+                m_nodes[node_taller.parent].left = taller;
+            else
+                m_nodes[node_taller.parent].right = taller;
+        }
+        else
+        {
+            m_root = taller;
+        }
+
+        // Taller node keeps its taller child, the shorter one goes to a
+        i32 const kept = m_nodes[f].height > m_nodes[g].height ? f : g;
+        i32 const moved = kept == f ? g : f;
+
+        node_taller.right = kept;
+
+        if (node_a.left == taller)
+            node_a.left = moved;
+        else
+            node_a.right = moved;
+
+        m_nodes[moved].parent = a;
+
+        Node const& node_shorter = m_nodes[shorter];
+        Node const& node_moved = m_nodes[moved];
+        Node const& node_kept = m_nodes[kept];
+
+        node_a.min = glm::min(node_shorter.min, node_moved.min);
+        node_a.max = glm::max(node_shorter.max, node_moved.max);
+        node_a.height = 1 + std::max(node_shorter.height, node_moved.height);
+
+        node_taller.min = glm::min(node_a.min, node_kept.min);
+        node_taller.max = glm::max(node_a.max, node_kept.max);
+        node_taller.height = 1 + std::max(node_a.height, node_kept.height);
+
+        return taller;
+    }
+
+    std::vector<Node> m_nodes = {};
+    i32 m_root = null_node;
+    i32 m_free_list = null_node;
+    u32 m_count = 0;
+};
@@ -1,5 +1,12 @@
 #include "Bounds.h"
 
+#include <vector>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtc/epsilon.hpp>
+#include <glm/mat3x3.hpp>
+
 BoundingBox::BoundingBox(glm::vec3 const min, glm::vec3 const max) : min(min), max(max)
 {
     center = (max + min) * 0.5f;
@@ -53,3 +60,86 @@ bool BoundingBox::is_in_frustum(Frustum const& frustum) const
         && is_on_or_forward_plane(frustum.top_plane) && is_on_or_forward_plane(frustum.bottom_plane)
         && is_on_or_forward_plane(frustum.near_plane) && is_on_or_forward_plane(frustum.far_plane);
 }
+
+BoundingBox BoundingBox::merge(BoundingBox const& a, BoundingBox const& b)
+{
+    return {glm::min(a.min, b.min), glm::max(a.max, b.max)};
+}
+
+BoundingBox BoundingBox::transform(glm::mat4 const& model_matrix) const
+{
+    // OPTIMIZATION: For uniformly scaled objects we can perform only 2 multiplications instead of a full matrix one
+    // to determine the new bounding box. This is taken from:
+    // https://stackoverflow.com/questions/6053522/how-to-recalculate-axis-aligned-bounding-box-after-translate-rotate
+    // and:
+    // https://github.com/erich666/GraphicsGems/blob/master/gems/TransBox.c
+    auto const translation = glm::vec3(model_matrix[3]);
+    glm::mat3 const rotation = model_matrix;
+    auto const scale = glm::vec3(glm::length(rotation[0]), glm::length(rotation[1]), glm::length(rotation[2]));
+    if (glm::epsilonEqual(scale.x, scale.y, 0.0001f) && glm::epsilonEqual(scale.x, scale.z, 0.0001f))
+    {
+        float new_min[3];
+        float new_max[3];
+        new_min[0] = new_max[0] = translation.x;
+        new_min[1] = new_max[1] = translation.y;
+        new_min[2] = new_max[2] = translation.z;
+
+        for (u32 i = 0; i < 3; ++i)
+        {
+            for (u32 k = 0; k < 3; ++k)
+            {
+                float a = rotation[i][k] * min[k];
+                float b = rotation[i][k] * max[k];
+                new_min[i] += a < b ? a : b;
+                new_max[i] += a < b ? b : a;
+            }
+        }
+
+        return {glm::vec3(new_min[0], new_min[1], new_min[2]), glm::vec3(new_max[0], new_max[1], new_max[2])};
+    }
+
+    // Create AABB vertices from bounds
+    std::vector<glm::vec3> aabb_vertices = {
+        min,
+        glm::vec3(min.x, min.y, max.z),
+        glm::vec3(min.x, max.y, min.z),
+        glm::vec3(min.x, max.y, max.z),
+        glm::vec3(max.x, min.y, min.z),
+        glm::vec3(max.x, min.y, max.z),
+        glm::vec3(max.x, max.y, min.z),
+        max,
+    };
+
+    // Transform AABB vertices by model matrix
+    for (auto& vertex : aabb_vertices)
+    {
+        vertex = glm::vec3(model_matrix * glm::vec4(vertex, 1.0f));
+    }
+
+    // Find new AABB bounds
+    float lowest_x = aabb_vertices[0].x;
+    float lowest_y = aabb_vertices[0].y;
+    float lowest_z = aabb_vertices[0].z;
+    float highest_x = aabb_vertices[0].x;
+    float highest_y = aabb_vertices[0].y;
+    float highest_z = aabb_vertices[0].z;
+
+    for (auto const& vertex : aabb_vertices)
+    {
+        if (vertex.x < lowest_x)
+            lowest_x = vertex.x;
+        if (vertex.y < lowest_y)
+            lowest_y = vertex.y;
+        if (vertex.z < lowest_z)
+            lowest_z = vertex.z;
+
+        if (vertex.x > highest_x)
+            highest_x = vertex.x;
+        if (vertex.y > highest_y)
+            highest_y = vertex.y;
+        if (vertex.z > highest_z)
+            highest_z = vertex.z;
+    }
+
+    return {glm::vec3(lowest_x, lowest_y, lowest_z), glm::vec3(highest_x, highest_y, highest_z)};
+}
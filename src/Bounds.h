@@ -1,5 +1,6 @@
 #pragma once
 
+#include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
 
 #include "AK/Types.h"
@@ -31,18 +32,10 @@ struct BoundingBox
     [[nodiscard]] bool is_on_or_forward_plane(Plane const& plane) const;
 
     [[nodiscard]] bool is_in_frustum(Frustum const& frustum) const;
-};
-
-struct BoundingBoxShader
-{
-    glm::vec3 center = {};
-    float padding1 = 0.0f;
-    glm::vec3 extents = {};
-    float padding2 = 0.0f;
 
-    BoundingBoxShader() = default;
+    // Smallest box containing both boxes
+    [[nodiscard]] static BoundingBox merge(BoundingBox const& a, BoundingBox const& b);
 
-    explicit BoundingBoxShader(BoundingBox const& bounding_box) : center(bounding_box.center), extents(bounding_box.extents)
-    {
-    }
+    // Smallest box containing the box transformed by the matrix
+    [[nodiscard]] BoundingBox transform(glm::mat4 const& model_matrix) const;
 };
@@ -10,6 +10,8 @@
 #include "ResourceManager.h"
 #include "Sprite.h"
 
+#include <glm/common.hpp>
+
 #if EDITOR
 #include "imgui_stdlib.h"
 #endif
@@ -140,7 +142,13 @@ void Button::reprepare()
 
 void Button::update()
 {
-    calculate_corners_position();
+    update_screen_rectangle();
+
+    // Hover and click are tested once per frame, is_hovered() and is_pressed() only return the results
+    m_this_frame_hovered = is_mouse_inside_screen_rectangle();
+    m_this_frame_clicked =
+        (Input::input->get_key(GLFW_MOUSE_BUTTON_LEFT) || Input::input->get_key(GLFW_MOUSE_BUTTON_RIGHT)) && m_this_frame_hovered;
+
     perform_hover_and_click_checks();
 }
 
@@ -180,84 +188,95 @@ void Button::perform_hover_and_click_checks()
 }
 
 bool Button::is_hovered() const
+{
+    return m_this_frame_hovered;
+}
+
+bool Button::is_pressed() const
+{
+    return m_this_frame_clicked;
+}
+
+bool Button::is_mouse_inside_screen_rectangle() const
 {
     glm::vec2 screen_size = {};
     screen_size.x = RendererDX11::get_instance_dx11()->screen_width;
     screen_size.y = RendererDX11::get_instance_dx11()->screen_height;
 
-#if EDITOR
-    glm::vec2 const game_pos = Editor::Editor::get_instance()->get_game_position();
-    glm::vec2 const game_size = Editor::Editor::get_instance()->get_game_size();
-#endif
-
-    glm::vec2 mouse_pos_screen_space = {};
-    glm::vec2 mouse_pos_pixels = {};
-
-    std::array const corners = {m_top_left_corner, m_top_right_corner, m_bottom_left_corner, m_bottom_right_corner};
-
-    mouse_pos_screen_space = Input::input->get_mouse_position();
-    mouse_pos_pixels = {AK::Math::map_range_clamped(-1.0f, 1.0f, 0.0f, screen_size.x, mouse_pos_screen_space.x),
-                        AK::Math::map_range_clamped(-1.0f, 1.0f, 0.0f, screen_size.y, mouse_pos_screen_space.y)};
+    glm::vec2 const mouse_pos_screen_space = Input::input->get_mouse_position();
+    glm::vec2 mouse_pos_pixels = {AK::Math::map_range_clamped(-1.0f, 1.0f, 0.0f, screen_size.x, mouse_pos_screen_space.x),
+                                  AK::Math::map_range_clamped(-1.0f, 1.0f, 0.0f, screen_size.y, mouse_pos_screen_space.y)};
 
 #if EDITOR
     if (Editor::Editor::get_instance()->is_rendering_to_editor())
     {
-        glm::vec2 const editor_window_corners[4] = {glm::vec2(game_pos.x, game_pos.y), glm::vec2(game_pos.x + game_size.x, game_pos.y),
-                                                    glm::vec2(game_pos.x, game_pos.y + game_size.y),
-                                                    glm::vec2(game_pos.x + game_size.x, game_pos.y + game_size.y)};
+        glm::vec2 const game_pos = Editor::Editor::get_instance()->get_game_position();
+        glm::vec2 const game_size = Editor::Editor::get_instance()->get_game_size();
 
         mouse_pos_pixels = {
-            AK::Math::map_range_clamped(editor_window_corners[0].x, editor_window_corners[1].x, 0.0f, screen_size.x, mouse_pos_pixels.x)
-                - 16.0f,
-            AK::Math::map_range_clamped(editor_window_corners[0].y, editor_window_corners[2].y, 0.0f, screen_size.y, mouse_pos_pixels.y)
-                - 64.0f};
+            AK::Math::map_range_clamped(game_pos.x, game_pos.x + game_size.x, 0.0f, screen_size.x, mouse_pos_pixels.x) - 16.0f,
+            AK::Math::map_range_clamped(game_pos.y, game_pos.y + game_size.y, 0.0f, screen_size.y, mouse_pos_pixels.y) - 64.0f};
     }
 #endif
 
-    return AK::Math::is_point_inside_rectangle(mouse_pos_pixels, corners);
+    return mouse_pos_pixels.x >= m_screen_rectangle_min.x && mouse_pos_pixels.x <= m_screen_rectangle_max.x
+        && mouse_pos_pixels.y >= m_screen_rectangle_min.y && mouse_pos_pixels.y <= m_screen_rectangle_max.y;
 }
 
-bool Button::is_pressed() const
-{
-    return (Input::input->get_key(GLFW_MOUSE_BUTTON_LEFT) || Input::input->get_key(GLFW_MOUSE_BUTTON_RIGHT)) && is_hovered();
-}
-
-void Button::calculate_corners_position()
+void Button::update_screen_rectangle()
 {
     glm::vec2 screen_size = {};
     screen_size.x = RendererDX11::get_instance_dx11()->screen_width;
     screen_size.y = RendererDX11::get_instance_dx11()->screen_height;
 
-    glm::vec2 const world_top_left = {-1.0f * entity->transform->get_scale().x + entity->transform->get_position().x,
-                                      -1.0f * entity->transform->get_scale().y - entity->transform->get_position().y};
-
-    m_top_left_corner = {AK::Math::map_range_clamped(-1.0f, 1.0f, 0.0f, screen_size.x, world_top_left.x),
-                         AK::Math::map_range_clamped(-1.0f, 1.0f, 0.0f, screen_size.y, world_top_left.y)};
+    glm::vec2 const position = glm::vec2(entity->transform->get_position());
+    glm::vec2 const scale = glm::vec2(entity->transform->get_scale());
 
-    glm::vec2 const world_top_right = {1.0f * entity->transform->get_scale().x + entity->transform->get_position().x,
-                                       -1.0f * entity->transform->get_scale().y - entity->transform->get_position().y};
-
-    m_top_right_corner = {AK::Math::map_range_clamped(-1.0f, 1.0f, 0.0f, screen_size.x, world_top_right.x),
-                          AK::Math::map_range_clamped(-1.0f, 1.0f, 0.0f, screen_size.y, world_top_right.y)};
+    // Buttons rarely move, so the rectangle is only mapped to pixels again when the button or the screen changes
+    if (m_is_screen_rectangle_valid && position == m_screen_rectangle_position && scale == m_screen_rectangle_scale
+        && screen_size == m_screen_rectangle_screen_size)
+    {
+        return;
+    }
 
-    glm::vec2 const world_bottom_left = {-1.0f * entity->transform->get_scale().x + entity->transform->get_position().x,
-                                         1.0f * entity->transform->get_scale().y - entity->transform->get_position().y};
+    // Y axis of pixels points down
+    glm::vec2 const world_top_left = {position.x - scale.x, -position.y - scale.y};
+    glm::vec2 const world_bottom_right = {position.x + scale.x, -position.y + scale.y};
 
-    m_bottom_left_corner = {AK::Math::map_range_clamped(-1.0f, 1.0f, 0.0f, screen_size.x, world_bottom_left.x),
-                            AK::Math::map_range_clamped(-1.0f, 1.0f, 0.0f, screen_size.y, world_bottom_left.y)};
+    glm::vec2 const top_left = {AK::Math::map_range_clamped(-1.0f, 1.0f, 0.0f, screen_size.x, world_top_left.x),
+                                AK::Math::map_range_clamped(-1.0f, 1.0f, 0.0f, screen_size.y, world_top_left.y)};
+    glm::vec2 const bottom_right = {AK::Math::map_range_clamped(-1.0f, 1.0f, 0.0f, screen_size.x, world_bottom_right.x),
+                                    AK::Math::map_range_clamped(-1.0f, 1.0f, 0.0f, screen_size.y, world_bottom_right.y)};
 
-    glm::vec2 const world_bottom_right = {1.0f * entity->transform->get_scale().x + entity->transform->get_position().x,
-                                          1.0f * entity->transform->get_scale().y - entity->transform->get_position().y};
+    // Negative scale flips the button
+    m_screen_rectangle_min = glm::min(top_left, bottom_right);
+    m_screen_rectangle_max = glm::max(top_left, bottom_right);
 
-    m_bottom_right_corner = {AK::Math::map_range_clamped(-1.0f, 1.0f, 0.0f, screen_size.x, world_bottom_right.x),
-                             AK::Math::map_range_clamped(-1.0f, 1.0f, 0.0f, screen_size.y, world_bottom_right.y)};
+    m_screen_rectangle_position = position;
+    m_screen_rectangle_scale = scale;
+    m_screen_rectangle_screen_size = screen_size;
+    m_is_screen_rectangle_valid = true;
 }
 
 void Button::prepare()
 {
+    TextureSettings texture_settings = {};
+    texture_settings.wrap_mode_x = TextureWrapMode::ClampToEdge;
+    texture_settings.wrap_mode_y = TextureWrapMode::ClampToEdge;
+
+    m_texture = nullptr;
+
+    if (!m_path.empty())
+        m_texture = ResourceManager::get_instance().load_texture(m_path, TextureType::Diffuse, texture_settings);
+
     m_mesh = create_sprite();
 }
 
+std::shared_ptr<Texture> Button::get_ui_texture() const
+{
+    return m_texture;
+}
+
 std::shared_ptr<Mesh> Button::create_sprite() const
 {
     std::vector<Vertex> const vertices = {
@@ -271,15 +290,8 @@ std::shared_ptr<Mesh> Button::create_sprite() const
 
     std::vector<std::shared_ptr<Texture>> textures;
 
-    std::vector<std::shared_ptr<Texture>> diffuse_maps = {};
-    TextureSettings texture_settings = {};
-    texture_settings.wrap_mode_x = TextureWrapMode::ClampToEdge;
-    texture_settings.wrap_mode_y = TextureWrapMode::ClampToEdge;
-
-    if (!m_path.empty())
-        diffuse_maps.emplace_back(ResourceManager::get_instance().load_texture(m_path, TextureType::Diffuse, texture_settings));
-
-    textures.insert(textures.end(), diffuse_maps.begin(), diffuse_maps.end());
+    if (m_texture != nullptr)
+        textures.emplace_back(m_texture);
 
     return ResourceManager::get_instance().load_mesh(0, m_path, vertices, indices, textures, DrawType::Triangles, material);
 }
@@ -41,26 +41,34 @@ public:
     virtual void update() override;
     void perform_hover_and_click_checks();
 
+    // Results of the hover and click tests of the current frame
     bool is_hovered() const;
     bool is_pressed() const;
 
+    virtual std::shared_ptr<Texture> get_ui_texture() const override;
+
     CUSTOM_EDITOR
     std::string path_default = "./res/textures/white.jpg";
     std::string path_hovered = "./res/textures/light_gray.jpg";
     std::string path_pressed = "./res/textures/dark_gray.jpg";
 
 private:
-    void calculate_corners_position();
+    // Screen rectangle of the button in pixels, cached until the button moves or the screen is resized
+    void update_screen_rectangle();
+    [[nodiscard]] bool is_mouse_inside_screen_rectangle() const;
     [[nodiscard]] std::shared_ptr<Mesh> create_sprite() const;
 
     std::string m_path = path_default;
 
-    glm::vec2 m_top_left_corner = {};
-    glm::vec2 m_top_right_corner = {};
-    glm::vec2 m_bottom_left_corner = {};
-    glm::vec2 m_bottom_right_corner = {};
+    glm::vec2 m_screen_rectangle_min = {};
+    glm::vec2 m_screen_rectangle_max = {};
+    glm::vec2 m_screen_rectangle_position = {};
+    glm::vec2 m_screen_rectangle_scale = {};
+    glm::vec2 m_screen_rectangle_screen_size = {};
+    bool m_is_screen_rectangle_valid = false;
 
     std::shared_ptr<Mesh> m_mesh = {};
+    std::shared_ptr<Texture> m_texture = {};
 
     bool m_previous_frame_hovered = false;
     bool m_this_frame_hovered = false;
@@ -2,7 +2,8 @@
 
 #include "AK/AK.h"
 #include "AK/Math.h"
-#include "DebugDrawing.h"
+#include "Debug.h"
+#include "DebugDraw.h"
 #include "Engine.h"
 #include "Entity.h"
 #include "Globals.h"
@@ -97,12 +98,10 @@ void Collider2D::custom_draw_editor()
     if (collider_type == ColliderType2D::Circle)
     {
         ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "Use RADIUS to control collider size.");
-        m_debug_drawing->set_drawing_type(DrawingType::Sphere);
     }
     else if (collider_type == ColliderType2D::Rectangle)
     {
         ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "Use EXTENTS to control collider size.");
-        m_debug_drawing->set_drawing_type(DrawingType::Box);
     }
 
     ImGui::Spacing();
@@ -127,7 +126,6 @@ void Collider2D::custom_draw_editor()
         {
             is_dirty = true;
             set_radius_2d(radius);
-            m_debug_drawing->set_radius(radius);
         }
     }
     else if (collider_type == ColliderType2D::Rectangle)
@@ -156,15 +154,6 @@ void Collider2D::custom_draw_editor()
     if (is_dirty)
     {
         Debug::log("changed");
-        if (collider_type == ColliderType2D::Circle)
-        {
-            m_debug_drawing->set_drawing_type(DrawingType::Sphere);
-        }
-        else if (collider_type == ColliderType2D::Rectangle)
-        {
-            m_debug_drawing->set_drawing_type(DrawingType::Box);
-        }
-
         update_center_and_corners();
     }
 }
@@ -175,25 +164,6 @@ void Collider2D::initialize()
     Component::initialize();
     PhysicsEngine::get_instance()->emplace_collider(std::static_pointer_cast<Collider2D>(shared_from_this()));
 
-    switch (collider_type)
-    {
-    case ColliderType2D::Circle:
-        m_debug_drawing_entity = Debug::draw_debug_sphere({0.0f, 0.0f, 0.0f}, radius);
-        m_debug_drawing_entity->transform->set_parent(entity->transform);
-        break;
-
-    case ColliderType2D::Rectangle:
-        m_debug_drawing_entity = Debug::draw_debug_box({0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {width * 2.0f, 0.5f, height * 2.0f});
-        m_debug_drawing_entity->transform->set_parent(entity->transform);
-        break;
-
-    default:
-        std::unreachable();
-    }
-
-    m_debug_drawing = m_debug_drawing_entity->get_component<DebugDrawing>();
-    m_debug_drawing->set_radius(radius);
-    m_debug_drawing->set_extents({width * 2.0f, 0.25f, height * 2.0f});
     update_center_and_corners();
 }
 
@@ -229,15 +199,6 @@ void Collider2D::awake()
 void Collider2D::set_collider_type(ColliderType2D new_collider_type)
 {
     collider_type = new_collider_type;
-
-    if (new_collider_type == ColliderType2D::Circle)
-    {
-        m_debug_drawing->set_drawing_type(DrawingType::Sphere);
-    }
-    else if (new_collider_type == ColliderType2D::Rectangle)
-    {
-        m_debug_drawing->set_drawing_type(DrawingType::Box);
-    }
 }
 
 void Collider2D::set_radius_2d(float const new_radius)
@@ -356,7 +317,7 @@ void Collider2D::clear_overlapped_this_frame()
 
 void Collider2D::physics_update()
 {
-    update_center_and_corners();
+    update_center_and_corners_if_needed();
 
     if (glm::epsilonEqual(velocity, {0.0f, 0.0f}, 0.001f) != glm::bvec2(true, true))
     {
@@ -379,10 +340,26 @@ void Collider2D::update_center_and_corners()
     glm::quat const rotation = entity->transform->get_rotation();
 
     compute_axes(position_2d, rotation);
+
+    m_corners_position = entity->transform->get_position();
+    m_corners_rotation = rotation;
+    m_corners_offset = offset;
+    m_corners_extents = {width, height};
+}
+
+void Collider2D::update_center_and_corners_if_needed()
+{
+    // Transform only recomputes its matrix when it's dirty, so reading it back is cheap compared to rotating the corners
+    if (entity->transform->get_position() == m_corners_position && entity->transform->get_rotation() == m_corners_rotation
+        && offset == m_corners_offset && glm::vec2(width, height) == m_corners_extents)
+    {
+        return;
+    }
+
+    update_center_and_corners();
 }
 
 // NOTE: Should be called everytime the position has changed.
-//       Currently we just update it every frame.
 void Collider2D::compute_axes(glm::vec2 const& center, glm::quat const& rotation)
 {
     glm::vec2 const half_extents = {width * 0.5f, height * 0.5f};
@@ -415,8 +392,27 @@ void Collider2D::compute_axes(glm::vec2 const& center, glm::quat const& rotation
 
     // Update the corners in 2D for collision detection purposes
     m_corners = rotated_corners;
+}
+
+void Collider2D::draw_debug()
+{
+    // Entity could have been moved in the editor, when physics doesn't run
+    update_center_and_corners_if_needed();
 
-    // Debug drawing
-    m_debug_drawing_entity->transform->set_position(AK::convert_2d_to_3d(center));
-    m_debug_drawing->set_extents({width, 0.25f, height});
+    switch (collider_type)
+    {
+    case ColliderType2D::Circle:
+        DebugDraw::circle(AK::convert_2d_to_3d(get_center_2d()), radius);
+        break;
+
+    case ColliderType2D::Rectangle:
+        for (u32 i = 0; i < m_corners.size(); ++i)
+        {
+            DebugDraw::line(AK::convert_2d_to_3d(m_corners[i]), AK::convert_2d_to_3d(m_corners[(i + 1) % m_corners.size()]));
+        }
+        break;
+
+    default:
+        std::unreachable();
+    }
 }
@@ -9,8 +9,6 @@
 #include <array>
 #include <unordered_map>
 
-class DebugDrawing;
-
 struct CollisionInfo
 {
     bool is_overlapping = false;
@@ -91,6 +89,12 @@ public:
 
     void update_center_and_corners();
 
+    // Corners only change when the entity moves or the collider is resized, so they are kept until then
+    void update_center_and_corners_if_needed();
+
+    // Queues the outline of the collider on the ground plane with DebugDraw, for this frame only
+    void draw_debug();
+
     CUSTOM_EDITOR
     glm::vec2 offset = {};
 
@@ -119,8 +123,14 @@ public:
 private:
     void compute_axes(glm::vec2 const& center, glm::quat const& rotation);
 
-    std::array<glm::vec2, 4> m_corners = {}; // For rectangle, calculated each frame
-    std::array<glm::vec2, 2> m_axes = {}; // For rectangle, calculated each frame
+    std::array<glm::vec2, 4> m_corners = {}; // For rectangle
+    std::array<glm::vec2, 2> m_axes = {}; // For rectangle
+
+    // State that the corners and axes were calculated for
+    glm::vec3 m_corners_position = glm::vec3(std::nanf("0"));
+    glm::quat m_corners_rotation = {1.0f, 0.0f, 0.0f, 0.0f};
+    glm::vec2 m_corners_offset = {};
+    glm::vec2 m_corners_extents = {};
 
     std::unordered_map<std::string, std::weak_ptr<Collider2D>> m_inside_trigger = {};
     std::vector<std::weak_ptr<Collider2D>> m_inside_trigger_vector = {};
@@ -128,6 +138,9 @@ private:
     std::vector<std::weak_ptr<Collider2D>> m_overlapped_this_frame = {};
     std::unordered_map<std::string, std::weak_ptr<Collider2D>> m_overlapped_this_frame_map = {};
 
-    std::shared_ptr<Entity> m_debug_drawing_entity = nullptr;
-    std::shared_ptr<DebugDrawing> m_debug_drawing = nullptr;
+    // Proxy in the physics engine's collider hierarchy and index in its colliders, assigned every physics step
+    i32 m_hierarchy_proxy = -1;
+    u32 m_physics_index = 0;
+
+    friend class PhysicsEngine;
 };
@@ -0,0 +1,156 @@
+#include "CommandList.h"
+
+#include <format>
+#include <utility>
+
+void CommandList::record(RenderPass const pass, std::span<RenderPacket const> const packets, std::span<glm::mat4 const> const model_matrices,
+                         glm::mat4 const& projection_view)
+{
+    // Local class, so it can access the private members of the list
+    class Recorder final : public RenderQueueBackend
+    {
+    public:
+        Recorder(CommandList& list, std::span<glm::mat4 const> const model_matrices, glm::mat4 const& projection_view)
+            : m_list(list), m_model_matrices(model_matrices), m_projection_view(projection_view)
+        {
+        }
+
+        virtual void bind_shader(std::shared_ptr<Shader> const& shader) override
+        {
+            m_list.m_commands.push_back({.type = DrawCommandType::BindShader, .shader = &shader});
+        }
+
+        virtual void bind_material(std::shared_ptr<Material> const& material) override
+        {
+            m_list.m_commands.push_back({.type = DrawCommandType::BindMaterial, .material = &material});
+        }
+
+        virtual void unbind_material(std::shared_ptr<Material> const& material) override
+        {
+            m_list.m_commands.push_back({.type = DrawCommandType::UnbindMaterial, .material = &material});
+        }
+
+        virtual void draw(RenderPacket const& packet) override
+        {
+            if (packet.drawable == nullptr)
+            {
+                m_list.m_commands.push_back({.type = DrawCommandType::DrawInstanced, .material = packet.material});
+                return;
+            }
+
+            m_list.m_commands.push_back({.type = DrawCommandType::DrawObject,
+                                         .constants_index = static_cast<u32>(m_list.m_constants.size()),
+                                         .material = packet.material,
+                                         .drawable = packet.drawable});
+            m_list.m_constants.emplace_back(make_object_constants(m_model_matrices[packet.push_index], m_projection_view));
+        }
+
+    private:
+        CommandList& m_list;
+        std::span<glm::mat4 const> m_model_matrices;
+        glm::mat4 const& m_projection_view;
+    };
+
+    m_pass = pass;
+    m_commands.clear();
+    m_constants.clear();
+
+    Recorder recorder = {*this, model_matrices, projection_view};
+    m_statistics = RenderQueue::submit(packets, recorder);
+}
+
+void CommandList::replay(CommandListBackend& backend) const
+{
+    for (auto const& command : m_commands)
+    {
+        switch (command.type)
+        {
+        case DrawCommandType::BindShader:
+            backend.bind_shader(*command.shader);
+            break;
+        case DrawCommandType::BindMaterial:
+            backend.bind_material(*command.material);
+            break;
+        case DrawCommandType::UnbindMaterial:
+            backend.unbind_material(*command.material);
+            break;
+        case DrawCommandType::DrawObject:
+            backend.draw(*command.drawable, *command.material, m_constants[command.constants_index]);
+            break;
+        case DrawCommandType::DrawInstanced:
+            backend.draw_instanced(*command.material);
+            break;
+        default:
+            std::unreachable();
+        }
+    }
+}
+
+RenderPass CommandList::get_pass() const
+{
+    return m_pass;
+}
+
+std::span<DrawCommand const> CommandList::get_commands() const
+{
+    return m_commands;
+}
+
+std::span<ObjectConstants const> CommandList::get_constants() const
+{
+    return m_constants;
+}
+
+RenderQueueStatistics const& CommandList::get_statistics() const
+{
+    return m_statistics;
+}
+
+ObjectConstants CommandList::make_object_constants(glm::mat4 const& model, glm::mat4 const& projection_view)
+{
+    return {model, projection_view * model};
+}
+
+void NullCommandListBackend::bind_shader(std::shared_ptr<Shader> const& shader)
+{
+    m_log += std::format("bind_shader {}\n", get_id(shader.get()));
+}
+
+void NullCommandListBackend::bind_material(std::shared_ptr<Material> const& material)
+{
+    m_log += std::format("bind_material {}\n", get_id(material.get()));
+}
+
+void NullCommandListBackend::unbind_material(std::shared_ptr<Material> const& material)
+{
+    m_log += std::format("unbind_material {}\n", get_id(material.get()));
+}
+
+void NullCommandListBackend::draw(std::shared_ptr<Drawable> const& drawable, std::shared_ptr<Material> const& material,
+                                  ObjectConstants const& constants)
+{
+    glm::vec4 const& translation = constants.model[3];
+    m_log += std::format("draw {} {} ({:.3f}, {:.3f}, {:.3f})\n", get_id(drawable.get()), get_id(material.get()), translation.x,
+                         translation.y, translation.z);
+}
+
+void NullCommandListBackend::draw_instanced(std::shared_ptr<Material> const& material)
+{
+    m_log += std::format("draw_instanced {}\n", get_id(material.get()));
+}
+
+std::string const& NullCommandListBackend::get_log() const
+{
+    return m_log;
+}
+
+void NullCommandListBackend::clear()
+{
+    m_ids.clear();
+    m_log.clear();
+}
+
+u32 NullCommandListBackend::get_id(void const* object)
+{
+    return m_ids.try_emplace(object, static_cast<u32>(m_ids.size())).first->second;
+}
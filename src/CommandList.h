@@ -0,0 +1,99 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+
+#include "AK/Types.h"
+#include "RenderQueue.h"
+
+// Per object data computed while recording, uploaded to constant buffers (DX11) or uniforms (OpenGL) when replaying
+struct ObjectConstants
+{
+    glm::mat4 model = {};
+    glm::mat4 projection_view_model = {};
+};
+
+enum class DrawCommandType : u8
+{
+    BindShader,
+    BindMaterial,
+    UnbindMaterial,
+    DrawObject,
+    DrawInstanced,
+};
+
+// Pointers reference shared pointers owned by the renderer, same as in RenderPacket
+struct DrawCommand
+{
+    DrawCommandType type = DrawCommandType::BindShader;
+    u32 constants_index = 0;
+    std::shared_ptr<Shader> const* shader = nullptr;
+    std::shared_ptr<Material> const* material = nullptr;
+    std::shared_ptr<Drawable> const* drawable = nullptr;
+};
+
+// Executes recorded commands on the main thread
+class CommandListBackend
+{
+public:
+    virtual ~CommandListBackend() = default;
+
+    virtual void bind_shader(std::shared_ptr<Shader> const& shader) = 0;
+    virtual void bind_material(std::shared_ptr<Material> const& material) = 0;
+    virtual void unbind_material(std::shared_ptr<Material> const& material) = 0;
+    virtual void draw(std::shared_ptr<Drawable> const& drawable, std::shared_ptr<Material> const& material,
+                      ObjectConstants const& constants) = 0;
+    virtual void draw_instanced(std::shared_ptr<Material> const& material) = 0;
+};
+
+// List of bind and draw commands recorded from a range of sorted render packets. Recording only reads the packets and
+// model matrices computed when they were queued, so lists of different ranges can be recorded on worker threads and replayed
+// in order on the main thread afterwards.
+class CommandList
+{
+public:
+    // Model matrices are indexed by push indices of the packets
+    void record(RenderPass const pass, std::span<RenderPacket const> const packets, std::span<glm::mat4 const> const model_matrices,
+                glm::mat4 const& projection_view);
+    void replay(CommandListBackend& backend) const;
+
+    [[nodiscard]] RenderPass get_pass() const;
+    [[nodiscard]] std::span<DrawCommand const> get_commands() const;
+    [[nodiscard]] std::span<ObjectConstants const> get_constants() const;
+    [[nodiscard]] RenderQueueStatistics const& get_statistics() const;
+
+    [[nodiscard]] static ObjectConstants make_object_constants(glm::mat4 const& model, glm::mat4 const& projection_view);
+
+private:
+    RenderPass m_pass = RenderPass::Geometry;
+    std::vector<DrawCommand> m_commands = {};
+    std::vector<ObjectConstants> m_constants = {};
+    RenderQueueStatistics m_statistics = {};
+};
+
+// Backend that doesn't render anything. Every shader, material and drawable gets an id in the order of its first use
+// and every command is written as a single line, so replayed lists can be compared as text (see tests/CommandListTests.cpp).
+class NullCommandListBackend final : public CommandListBackend
+{
+public:
+    virtual void bind_shader(std::shared_ptr<Shader> const& shader) override;
+    virtual void bind_material(std::shared_ptr<Material> const& material) override;
+    virtual void unbind_material(std::shared_ptr<Material> const& material) override;
+    virtual void draw(std::shared_ptr<Drawable> const& drawable, std::shared_ptr<Material> const& material,
+                      ObjectConstants const& constants) override;
+    virtual void draw_instanced(std::shared_ptr<Material> const& material) override;
+
+    [[nodiscard]] std::string const& get_log() const;
+    void clear();
+
+private:
+    [[nodiscard]] u32 get_id(void const* object);
+
+    std::unordered_map<void const*, u32> m_ids = {};
+    std::string m_log = {};
+};
@@ -58,6 +58,8 @@
     ENUMERATE_COMPONENT(Sphere, "Sphere") \
     ENUMERATE_COMPONENT(Sprite, "Sprite") \
     ENUMERATE_COMPONENT(Water, "Water") \
+    ENUMERATE_COMPONENT(FoliageScatter, "Foliage Scatter") \
+    ENUMERATE_COMPONENT(Grass, "Grass") \
     ENUMERATE_COMPONENT(DirectionalLight, "Directional Light") \
     ENUMERATE_COMPONENT(PointLight, "Point Light") \
     ENUMERATE_COMPONENT(SpotLight, "Spot Light") \
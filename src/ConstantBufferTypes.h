@@ -4,9 +4,6 @@
 
 #include "AK/Types.h"
 
-i32 constexpr MAX_POINT_LIGHTS = 20;
-i32 constexpr MAX_SPOT_LIGHTS = 20;
-
 struct ConstantBuffer
 {
 };
@@ -29,14 +26,15 @@ struct ConstantBufferWave
     int number_of_waves;
 };
 
+// Point and spot lights are stored in structured buffers, has to match PointLight and SpotLight in structs.hlsl
 struct DXPointLight
 {
     glm::vec3 position;
-    float padding1;
+    i32 shadow_map_index;
     glm::vec3 ambient;
-    float padding2;
+    float padding1;
     glm::vec3 diffuse;
-    float padding3;
+    float padding2;
     glm::vec3 specular;
 
     float constant;
@@ -65,7 +63,7 @@ struct DXSpotLight
     glm::vec3 diffuse;
     float near_plane;
     glm::vec3 specular;
-    float padding6;
+    i32 shadow_map_index;
 
     glm::mat4 light_projection_view;
     glm::mat4 inv_light_model;
@@ -106,6 +104,21 @@ struct ConstantBufferPerObject
     i32 is_glowing;
 };
 
+struct ConstantBufferMesh
+{
+    glm::vec3 position_offset;
+    i32 is_vertex_packed;
+    glm::vec3 position_scale;
+    float padding;
+};
+
+struct ConstantBufferDrawFlags
+{
+    i32 is_instanced;
+    i32 is_billboard;
+    glm::vec2 padding;
+};
+
 struct ConstantBufferParticle
 {
     glm::vec4 color;
@@ -115,20 +128,30 @@ struct ConstantBufferCameraPosition
 {
     glm::vec3 camera_pos;
     float padding1;
+
+    // Columns of the camera's rotation, billboards are oriented along them in vertex shaders
+    glm::vec3 camera_axis_x;
+    float padding2;
+    glm::vec3 camera_axis_y;
+    float padding3;
+    glm::vec3 camera_axis_z;
+    float padding4;
 };
 
 struct ConstantBufferLight
 {
     DXDirectionalLight directional_light;
-    DXPointLight point_lights[MAX_POINT_LIGHTS];
-    DXSpotLight spot_lights[MAX_SPOT_LIGHTS];
 
     glm::vec3 camera_pos;
-    i32 number_of_point_lights;
-    i32 number_of_spot_lights;
     float gamma;
     float exposure;
+
+    // Light clusters, see LightClusters
+    float cluster_depth_scale;
+    float cluster_depth_bias;
     float padding;
+    glm::uvec3 cluster_counts;
+    float padding2;
 };
 
 struct ConstantBufferSkybox : public ConstantBuffer
@@ -173,3 +196,140 @@ struct ConstantBufferWater
     float combined_amplitude;
     float phong_contribution;
 };
+
+// Uniform blocks of GLSL shaders, in std140 layout. Their binding points are set in the shaders.
+enum class UniformBlockBinding : u32
+{
+    Camera = 0,
+    Light = 1,
+    Material = 2,
+    Object = 3,
+};
+
+// Point and spot lights are stored in shader storage buffers, in std430 layout
+struct GLPointLight
+{
+    glm::vec3 position;
+    float padding1;
+    glm::vec3 ambient;
+    float padding2;
+    glm::vec3 diffuse;
+    float padding3;
+    glm::vec3 specular;
+
+    float constant;
+    float linear;
+    float quadratic;
+    glm::vec2 padding4;
+};
+
+struct GLSpotLight
+{
+    glm::vec3 position;
+    float padding1;
+    glm::vec3 direction;
+    float padding2;
+    glm::vec3 ambient;
+    float padding3;
+    glm::vec3 diffuse;
+    float padding4;
+    glm::vec3 specular;
+
+    float constant;
+    float linear;
+    float quadratic;
+
+    float cut_off;
+    float outer_cut_off;
+};
+
+struct GLDirectionalLight
+{
+    glm::vec3 direction;
+    float padding1;
+    glm::vec3 ambient;
+    float padding2;
+    glm::vec3 diffuse;
+    float padding3;
+    glm::vec3 specular;
+    float padding4;
+};
+
+struct UniformBufferCamera
+{
+    glm::mat4 projection_view;
+    glm::mat4 projection_view_no_translation;
+    glm::vec3 camera_position;
+    float padding;
+};
+
+struct UniformBufferLight
+{
+    GLDirectionalLight directional_light;
+
+    // Light clusters of the main camera, see LightClusters
+    glm::mat4 cluster_view;
+    glm::mat4 cluster_projection;
+    glm::uvec3 cluster_counts;
+    float cluster_depth_scale;
+    float cluster_depth_bias;
+
+    i32 point_light_count;
+    i32 spot_light_count;
+    i32 directional_light_on;
+};
+
+struct UniformBufferMaterial
+{
+    glm::vec3 color;
+    float specular;
+    float shininess;
+    float radius_multiplier;
+    i32 sector_count;
+    i32 stack_count;
+};
+
+struct UniformBufferObject
+{
+    glm::mat4 projection_view_model;
+    glm::mat4 model;
+    glm::mat4 view_model;
+};
+
+// Shader storage buffers of GPU culled instancing, in std430 layout. Their binding points are set in the shaders.
+enum class StorageBufferBinding : u32
+{
+    Models = 0,
+    VisibleInstances = 1,
+    DrawCommands = 2,
+    Instances = 3,
+    DebugVertices = 4,
+    UIVertices = 5,
+    PointLights = 6,
+    SpotLights = 7,
+    LightClusters = 8,
+    LightIndices = 9,
+};
+
+// Instance of a GPU instanced material, together with the draw commands of its batch. Model matrices of instances
+// are kept in their own array, read by vertex shaders through the visible instances.
+struct GLInstance
+{
+    glm::vec3 center;
+    u32 visible_offset;
+    glm::vec3 extents;
+    u32 first_command;
+    u32 command_count;
+    u32 is_cullable;
+    glm::vec2 padding;
+};
+
+// Same layout as the command read by glDrawElementsIndirect
+struct GLDrawElementsIndirectCommand
+{
+    u32 count;
+    u32 instance_count;
+    u32 first_index;
+    i32 base_vertex;
+    u32 base_instance;
+};
@@ -71,10 +71,8 @@ void Cube::prepare()
 {
     if (material->is_gpu_instanced)
     {
-        if (material->first_drawable != nullptr)
+        if (!material->add_to_instance_batch(std::dynamic_pointer_cast<Drawable>(shared_from_this()), diffuse_texture_path + specular_texture_path))
             return;
-
-        material->first_drawable = std::dynamic_pointer_cast<Drawable>(shared_from_this());
     }
 
     m_meshes.emplace_back(create_cube());
@@ -1,8 +1,8 @@
 #include "Debug.h"
 
-#include "AK/AK.h"
-#include "DebugDrawing.h"
-#include "Entity.h"
+#include <utility>
+
+#include "DebugDraw.h"
 
 void Debug::log(std::string const& message, DebugType type)
 {
@@ -31,19 +31,12 @@ void Debug::clear()
     debug_messages.clear();
 }
 
-std::shared_ptr<Entity> Debug::draw_debug_sphere(glm::vec3 const position, float const radius, float const time)
+void Debug::draw_debug_sphere(glm::vec3 const position, float const radius, float const time)
 {
-    auto debug_entity = Entity::create("DEBUG_" + AK::generate_guid());
-    debug_entity->add_component(DebugDrawing::create(position, radius, time));
-    debug_entity->is_serialized = false;
-    return debug_entity;
+    DebugDraw::sphere(position, radius, DebugDraw::default_color, time);
 }
 
-std::shared_ptr<Entity> Debug::draw_debug_box(glm::vec3 const position, glm::vec3 const euler_angles, glm::vec3 const extents,
-                                              float const time)
+void Debug::draw_debug_box(glm::vec3 const position, glm::vec3 const euler_angles, glm::vec3 const extents, float const time)
 {
-    auto debug_entity = Entity::create("DEBUG_" + AK::generate_guid());
-    debug_entity->add_component(DebugDrawing::create(position, euler_angles, extents, time));
-    debug_entity->is_serialized = false;
-    return debug_entity;
+    DebugDraw::box(position, extents, euler_angles, DebugDraw::default_color, time);
 }
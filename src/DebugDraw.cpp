@@ -0,0 +1,157 @@
+#include "DebugDraw.h"
+
+#include <array>
+#include <utility>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/mat3x3.hpp>
+
+void DebugDraw::line(glm::vec3 const& from, glm::vec3 const& to, glm::vec4 const& color, float const lifetime)
+{
+    if (!enabled)
+        return;
+
+    u32 const packed_color = pack_color(color);
+
+    m_vertices.emplace_back(from, packed_color);
+    m_vertices.emplace_back(to, packed_color);
+    m_line_lifetimes.emplace_back(lifetime);
+}
+
+void DebugDraw::box(glm::vec3 const& center, glm::vec3 const& extents, glm::vec3 const& euler_angles, glm::vec4 const& color,
+                    float const lifetime)
+{
+    if (!enabled)
+        return;
+
+    glm::mat3 const rotation = glm::mat3_cast(glm::quat(glm::radians(euler_angles)));
+
+    std::array<glm::vec3, 8> corners = {};
+    for (u32 i = 0; i < corners.size(); ++i)
+    {
+        corners[i] = center + rotation * (BoundingBox::corner_offsets[i] * extents);
+    }
+
+    // Corners differing in a single axis share an edge. Bits of corner indices are x = 4, y = 2, z = 1.
+    for (u32 i = 0; i < corners.size(); ++i)
+    {
+        for (u32 axis = 1; axis <= 4; axis <<= 1)
+        {
+            if ((i & axis) == 0)
+                line(corners[i], corners[i | axis], color, lifetime);
+        }
+    }
+}
+
+void DebugDraw::box(BoundingBox const& bounds, glm::vec4 const& color, float const lifetime)
+{
+    box(bounds.center, bounds.extents, {0.0f, 0.0f, 0.0f}, color, lifetime);
+}
+
+void DebugDraw::circle(glm::vec3 const& center, float const radius, glm::vec3 const& normal, glm::vec4 const& color,
+                       float const lifetime)
+{
+    if (!enabled)
+        return;
+
+    glm::vec3 const axis = glm::normalize(normal);
+    glm::vec3 const reference = glm::abs(axis.y) < 0.99f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+    glm::vec3 const tangent = glm::normalize(glm::cross(axis, reference)) * radius;
+    glm::vec3 const bitangent = glm::cross(axis, tangent);
+
+    glm::vec3 previous = center + tangent;
+
+    for (u32 i = 1; i <= circle_segments; ++i)
+    {
+        float const angle = glm::two_pi<float>() * static_cast<float>(i) / static_cast<float>(circle_segments);
+        glm::vec3 const current = center + tangent * glm::cos(angle) + bitangent * glm::sin(angle);
+
+        line(previous, current, color, lifetime);
+        previous = current;
+    }
+}
+
+void DebugDraw::sphere(glm::vec3 const& center, float const radius, glm::vec4 const& color, float const lifetime)
+{
+    circle(center, radius, {1.0f, 0.0f, 0.0f}, color, lifetime);
+    circle(center, radius, {0.0f, 1.0f, 0.0f}, color, lifetime);
+    circle(center, radius, {0.0f, 0.0f, 1.0f}, color, lifetime);
+}
+
+void DebugDraw::text(glm::vec3 const& position, std::string const& text, glm::vec4 const& color, float const lifetime)
+{
+    if (!enabled)
+        return;
+
+    m_texts.emplace_back(position, text, pack_color(color));
+    m_text_lifetimes.emplace_back(lifetime);
+}
+
+std::span<DebugVertex const> DebugDraw::get_vertices()
+{
+    return m_vertices;
+}
+
+std::span<DebugText const> DebugDraw::get_texts()
+{
+    return m_texts;
+}
+
+void DebugDraw::advance(double const delta)
+{
+    // Shapes are compacted in place, so the order they were queued in is kept
+    u32 kept_lines = 0;
+    for (u32 i = 0; i < m_line_lifetimes.size(); ++i)
+    {
+        float const lifetime = m_line_lifetimes[i] - static_cast<float>(delta);
+
+        if (lifetime <= 0.0f)
+            continue;
+
+        m_line_lifetimes[kept_lines] = lifetime;
+        m_vertices[kept_lines * 2] = m_vertices[i * 2];
+        m_vertices[kept_lines * 2 + 1] = m_vertices[i * 2 + 1];
+        kept_lines += 1;
+    }
+
+    m_line_lifetimes.resize(kept_lines);
+    m_vertices.resize(kept_lines * 2);
+
+    u32 kept_texts = 0;
+    for (u32 i = 0; i < m_text_lifetimes.size(); ++i)
+    {
+        float const lifetime = m_text_lifetimes[i] - static_cast<float>(delta);
+
+        if (lifetime <= 0.0f)
+            continue;
+
+        m_text_lifetimes[kept_texts] = lifetime;
+
+        if (kept_texts != i)
+            m_texts[kept_texts] = std::move(m_texts[i]);
+
+        kept_texts += 1;
+    }
+
+    m_text_lifetimes.resize(kept_texts);
+    m_texts.resize(kept_texts);
+}
+
+void DebugDraw::clear()
+{
+    m_vertices.clear();
+    m_line_lifetimes.clear();
+    m_texts.clear();
+    m_text_lifetimes.clear();
+}
+
+u32 DebugDraw::pack_color(glm::vec4 const& color)
+{
+    glm::vec4 const scaled = glm::round(glm::clamp(color, 0.0f, 1.0f) * 255.0f);
+
+    return static_cast<u32>(scaled.r) | static_cast<u32>(scaled.g) << 8 | static_cast<u32>(scaled.b) << 16
+         | static_cast<u32>(scaled.a) << 24;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <vector>
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include "AK/Types.h"
+#include "Bounds.h"
+
+// Colors are packed as 0xAABBGGRR, same as screen text colors
+struct DebugVertex
+{
+    glm::vec3 position = {};
+    u32 color = 0;
+};
+
+struct DebugText
+{
+    glm::vec3 position = {};
+    std::string text = {};
+    u32 color = 0;
+};
+
+// Immediate mode debug drawing, without any entities or meshes. Shapes queued on the main thread are turned into lines right away
+// and the renderer draws all lines of the frame from one dynamic buffer with a single draw call, after the forward pass.
+// Shapes are drawn for their lifetime in seconds, shapes without a lifetime only for the frame they were queued in.
+class DebugDraw
+{
+public:
+    static void line(glm::vec3 const& from, glm::vec3 const& to, glm::vec4 const& color = default_color, float const lifetime = 0.0f);
+
+    // Extents are half of the size of the box, rotation is given in degrees
+    static void box(glm::vec3 const& center, glm::vec3 const& extents, glm::vec3 const& euler_angles = {0.0f, 0.0f, 0.0f},
+                    glm::vec4 const& color = default_color, float const lifetime = 0.0f);
+    static void box(BoundingBox const& bounds, glm::vec4 const& color = default_color, float const lifetime = 0.0f);
+
+    static void circle(glm::vec3 const& center, float const radius, glm::vec3 const& normal = {0.0f, 1.0f, 0.0f},
+                       glm::vec4 const& color = default_color, float const lifetime = 0.0f);
+    static void sphere(glm::vec3 const& center, float const radius, glm::vec4 const& color = default_color, float const lifetime = 0.0f);
+
+    // Text markers are drawn on screen at the projected position
+    static void text(glm::vec3 const& position, std::string const& text, glm::vec4 const& color = default_color,
+                     float const lifetime = 0.0f);
+
+    // Every two vertices form a line
+    [[nodiscard]] static std::span<DebugVertex const> get_vertices();
+    [[nodiscard]] static std::span<DebugText const> get_texts();
+
+    // Called by the renderer at the end of every frame, drops shapes that outlived their lifetime
+    static void advance(double const delta);
+    static void clear();
+
+    [[nodiscard]] static u32 pack_color(glm::vec4 const& color);
+
+    inline static bool enabled = true;
+
+    inline static glm::vec4 constexpr default_color = {0.0f, 1.0f, 0.0f, 1.0f};
+    inline static u32 constexpr circle_segments = 32;
+
+private:
+    inline static std::vector<DebugVertex> m_vertices = {};
+    inline static std::vector<float> m_line_lifetimes = {};
+
+    inline static std::vector<DebugText> m_texts = {};
+    inline static std::vector<float> m_text_lifetimes = {};
+};
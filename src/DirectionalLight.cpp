@@ -62,6 +62,8 @@ void DirectionalLight::set_up_shadow_mapping()
     hr = renderer->get_device()->CreateDepthStencilView(m_shadow_texture, &shadow_depth_stencil_view_desc, &m_shadow_depth_stencil_view);
     assert(SUCCEEDED(hr));
 
+    set_up_static_shadow_map(shadow_texture_desc, shadow_depth_stencil_view_desc);
+
     D3D11_SHADER_RESOURCE_VIEW_DESC shadow_shader_resource_view_desc = {};
     shadow_shader_resource_view_desc.Format = DXGI_FORMAT_R32_FLOAT;
     shadow_shader_resource_view_desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
@@ -88,9 +90,13 @@ glm::mat4 DirectionalLight::get_projection_view_matrix()
     return m_projection_view_matrix;
 }
 
-void DirectionalLight::set_render_target_for_shadow_mapping() const
+void DirectionalLight::set_render_target_for_shadow_mapping(bool const clear) const
 {
     auto const renderer = RendererDX11::get_instance_dx11();
     renderer->get_device_context()->OMSetRenderTargets(1, &renderer->g_emptyRenderTargetView, m_shadow_depth_stencil_view);
-    renderer->get_device_context()->ClearDepthStencilView(m_shadow_depth_stencil_view, D3D11_CLEAR_DEPTH, 1.0f, 0);
+
+    if (clear)
+    {
+        renderer->get_device_context()->ClearDepthStencilView(m_shadow_depth_stencil_view, D3D11_CLEAR_DEPTH, 1.0f, 0);
+    }
 }
@@ -22,7 +22,7 @@ public:
 
     glm::mat4 get_projection_view_matrix();
 
-    void set_render_target_for_shadow_mapping() const;
+    void set_render_target_for_shadow_mapping(bool const clear = true) const;
 
 protected:
     virtual void set_up_shadow_mapping() override;
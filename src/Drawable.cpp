@@ -2,6 +2,7 @@
 
 #include "Entity.h"
 #include "Renderer.h"
+#include "UIBatcher.h"
 
 #if EDITOR
 #include "imgui_extensions.h"
@@ -29,6 +30,36 @@ bool Drawable::is_particle() const
     return false;
 }
 
+bool Drawable::is_cullable() const
+{
+    return false;
+}
+
+Mesh const* Drawable::get_sort_mesh() const
+{
+    return nullptr;
+}
+
+std::span<std::shared_ptr<Mesh> const> Drawable::get_meshes() const
+{
+    return {};
+}
+
+std::shared_ptr<Texture> Drawable::get_ui_texture() const
+{
+    return nullptr;
+}
+
+void Drawable::add_ui_quads(UIBatcher& batcher, i32 const render_order) const
+{
+    batcher.add_quad(render_order, get_ui_texture(), entity->transform->get_model_matrix());
+}
+
+u32 Drawable::get_instance_batch() const
+{
+    return m_instance_batch;
+}
+
 void Drawable::set_glowing(bool const is_glowing)
 {
     m_is_glowing = is_glowing ? 1 : 0;
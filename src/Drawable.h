@@ -1,10 +1,16 @@
 #pragma once
 
+#include <span>
+
 #include "Bounds.h"
 #include "Component.h"
 #include "DrawType.h"
 #include "Material.h"
 
+class Mesh;
+class UIBatcher;
+struct Texture;
+
 class Drawable : public Component
 {
 public:
@@ -31,6 +37,25 @@ public:
 
     virtual bool is_particle() const;
 
+    // Whether bounds are valid world space bounds that can be used to skip drawing the drawable outside of the view
+    virtual bool is_cullable() const;
+
+    // Mesh used to group draw calls in the render queue, nullptr if there is no single representative mesh
+    [[nodiscard]] virtual Mesh const* get_sort_mesh() const;
+
+    // Meshes drawn by draw_instanced(), every one of them is drawn with the same instances
+    [[nodiscard]] virtual std::span<std::shared_ptr<Mesh> const> get_meshes() const;
+
+    // Texture of the screen space quads of a UI drawable, nullptr for every other drawable. UI drawables of materials with
+    // a custom render order are drawn by the renderer's UI batcher instead of draw().
+    [[nodiscard]] virtual std::shared_ptr<Texture> get_ui_texture() const;
+
+    // Adds quads of a UI drawable to the batcher, by default a single quad of the UI texture transformed by the model matrix
+    virtual void add_ui_quads(UIBatcher& batcher, i32 const render_order) const;
+
+    // Index of the drawable's batch in material->instance_batches, only valid for GPU instanced materials
+    [[nodiscard]] u32 get_instance_batch() const;
+
     void set_glowing(bool const is_glowing);
     i32 is_glowing() const;
 
@@ -49,5 +74,19 @@ protected:
 
 private:
     i32 m_is_glowing = 0;
+
+    // Index in the renderer's culled drawables, assigned every frame
+    u32 m_culling_index = 0;
+
+    // Proxy in the renderer's drawable hierarchy, -1 when the drawable isn't in it
+    i32 m_hierarchy_proxy = -1;
+
+    // Used by the renderer to tell static shadow casters from dynamic ones
+    u32 m_frames_without_movement = 0;
+
+    u32 m_instance_batch = 0;
+
     friend class SceneSerializer;
+    friend class Renderer;
+    friend class Material;
 };
@@ -8,6 +8,7 @@
 #include <ImGuizmo.h>
 #include <imgui.h>
 #include <imgui_internal.h>
+#include <implot.h>
 #endif
 
 #include <algorithm>
@@ -36,6 +37,7 @@
 #include "Floater.h"
 #include "FloatersManager.h"
 #include "FloeButton.h"
+#include "FoliageScatter.h"
 #include "Game/Clock.h"
 #include "Game/Credits.h"
 #include "Game/Customer.h"
@@ -78,6 +80,7 @@
 #include "Panel.h"
 #include "Particle.h"
 #include "ParticleSystem.h"
+#include "PhysicsEngine.h"
 #include "PointLight.h"
 #include "Quad.h"
 #include "RendererDX11.h"
@@ -210,6 +213,7 @@ void Editor::draw_debug_window(std::shared_ptr<EditorWindow> const& window)
     ImGui::Checkbox("Show newest logs", &m_always_newest_logs);
     ImGui::Text("Application average %.3f ms/frame", m_average_ms_per_frame);
     draw_scene_save();
+    draw_renderer_statistics();
 
     std::string const log_count = "Logs " + std::to_string(Debug::debug_messages.size());
     ImGui::Text(log_count.c_str());
@@ -258,6 +262,66 @@ void Editor::draw_debug_window(std::shared_ptr<EditorWindow> const& window)
     Renderer::get_instance()->wireframe_mode_active = m_polygon_mode_active;
 }
 
+void Editor::draw_renderer_statistics()
+{
+    if (!ImGui::CollapsingHeader("Renderer statistics"))
+        return;
+
+    FrameStatistics const& last_frame = RendererStatistics::get_last_frame();
+
+    ImGui::Text("CPU %.3f ms, GPU %.3f ms", last_frame.cpu_ms, last_frame.gpu_ms);
+    ImGui::Text("Draw calls: %u, triangles: %llu", last_frame.draw_calls, last_frame.triangles);
+    ImGui::Text("Buffer uploads: %u, texture binds: %u, shader switches: %u", last_frame.buffer_uploads, last_frame.texture_binds,
+                last_frame.shader_switches);
+
+    ImGui::Checkbox("Linear culling", &Renderer::linear_culling);
+
+    if (ImGui::Button("Dump statistics to CSV"))
+    {
+        std::string const path = "./renderer_statistics.csv";
+
+        if (RendererStatistics::write_csv(path))
+        {
+            Debug::log("Renderer statistics written to " + path);
+        }
+    }
+
+    auto const& history = RendererStatistics::get_history();
+
+    if (history.empty())
+        return;
+
+    std::vector<double> frames(history.size());
+    std::vector<double> times(history.size());
+
+    for (u32 i = 0; i < history.size(); ++i)
+    {
+        frames[i] = static_cast<double>(history[i].frame);
+    }
+
+    // CPU and GPU times of every pass, as lines over the kept history
+    for (bool const gpu : {false, true})
+    {
+        if (!ImPlot::BeginPlot(gpu ? "GPU time per pass" : "CPU time per pass", ImVec2(-1.0f, 200.0f)))
+            continue;
+
+        ImPlot::SetupAxes("Frame", "ms", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+
+        for (u32 pass = 0; pass < statistics_pass_count; ++pass)
+        {
+            for (u32 i = 0; i < history.size(); ++i)
+            {
+                times[i] = gpu ? history[i].passes[pass].gpu_ms : history[i].passes[pass].cpu_ms;
+            }
+
+            std::string const name = std::string(RendererStatistics::get_pass_name(static_cast<StatisticsPass>(pass)));
+            ImPlot::PlotLine(name.c_str(), frames.data(), times.data(), static_cast<i32>(history.size()));
+        }
+
+        ImPlot::EndPlot();
+    }
+}
+
 void Editor::draw_content_browser(std::shared_ptr<EditorWindow> const& window)
 {
     bool is_still_open = true;
@@ -684,6 +748,15 @@ void Editor::draw_game(std::shared_ptr<EditorWindow> const& window)
     {
         ImGui::SetCursorPos(ImVec2(m_game_position.x, m_game_position.y));
         ImGui::Image(RendererDX11::get_instance_dx11()->get_render_texture_view(), ImVec2(m_game_size.x, m_game_size.y));
+
+        // Gizmo state is from the last frame, but it's drawn on top of the image, so clicking it never selects anything else
+        if (ImGui::IsItemClicked(ImGuiMouseButton_Left) && !ImGuizmo::IsOver())
+        {
+            ImVec2 const mouse_position = ImGui::GetMousePos();
+            ImVec2 const image_position = ImGui::GetItemRectMin();
+
+            select_entity_at({mouse_position.x, mouse_position.y}, {image_position.x, image_position.y}, m_game_size);
+        }
     }
 
     if (m_selected_entity.expired())
@@ -733,6 +806,30 @@ void Editor::draw_game(std::shared_ptr<EditorWindow> const& window)
     ImGui::End();
 }
 
+void Editor::select_entity_at(glm::vec2 const& position, glm::vec2 const& viewport_position, glm::vec2 const& viewport_size)
+{
+    auto const camera = Camera::get_main_camera();
+
+    if (camera == nullptr)
+        return;
+
+    glm::vec2 const relative_position = (position - viewport_position) / viewport_size;
+    glm::vec2 const ndc = {relative_position.x * 2.0f - 1.0f, 1.0f - relative_position.y * 2.0f};
+
+    // Depth of 1 is on the far plane for both OpenGL and DirectX depth ranges
+    glm::vec4 const far_point = glm::inverse(camera->get_projection() * camera->get_view_matrix()) * glm::vec4(ndc, 1.0f, 1.0f);
+
+    glm::vec3 const origin = camera->get_position();
+    glm::vec3 const direction = glm::normalize(glm::vec3(far_point) / far_point.w - origin);
+
+    auto const drawable = Renderer::get_instance()->raycast_drawables(origin, direction);
+
+    if (drawable != nullptr)
+    {
+        m_selected_entity = drawable->entity;
+    }
+}
+
 void Editor::draw_scene_hierarchy(std::shared_ptr<EditorWindow> const& window)
 {
     bool is_still_open = true;
@@ -1998,6 +2095,11 @@ void Editor::run()
     handle_input();
     draw();
 
+    if (m_debug_drawings_enabled)
+    {
+        PhysicsEngine::get_instance()->draw_debug_colliders();
+    }
+
     if (!was_scene_dirty && m_is_scene_dirty)
     {
         update_window_title();
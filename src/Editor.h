@@ -228,6 +228,10 @@ private:
     void draw_inspector(std::shared_ptr<EditorWindow> const& window);
     void draw_scene_hierarchy(std::shared_ptr<EditorWindow> const& window);
     void draw_scene_save();
+    static void draw_renderer_statistics();
+
+    // Selects the entity of the closest drawable under the position in the game viewport
+    void select_entity_at(glm::vec2 const& position, glm::vec2 const& viewport_position, glm::vec2 const& viewport_size);
 
     void draw_entity_recursively(std::shared_ptr<Transform> const& transform);
     static void entity_drag(std::shared_ptr<Entity> const& entity);
@@ -1,5 +1,6 @@
 #include "Engine.h"
 
+#include <filesystem>
 #include <utility>
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -13,11 +14,13 @@
 #include "Globals.h"
 #include "Input.h"
 #include "MainScene.h"
+#include "ModelCooker.h"
 #include "PhysicsEngine.h"
 #include "Renderer.h"
 #include "RendererDX11.h"
 #include "RendererGL.h"
 #include "SceneSerializer.h"
+#include "SoundPool.h"
 #include "Window.h"
 
 #if EDITOR
@@ -101,6 +104,11 @@ void Engine::create_game()
     asset_preloader->preload_text_asset("./res/prefabs/Wheat.txt");
     asset_preloader->preload_text_asset("./res/prefabs/Wheat2.txt");
 
+    // Music and ambience are always streamed
+    asset_preloader->set_sound_load_policy("./res/audio/ost_loop.wav", SoundLoadPolicy::Stream);
+    asset_preloader->set_sound_load_policy("./res/audio/wind.mp3", SoundLoadPolicy::Stream);
+    asset_preloader->set_sound_load_policy("./res/audio/Komiks/foliarzostpropozycja3.mp3", SoundLoadPolicy::Stream);
+
 #if EDITOR
     m_editor->set_scene(main_scene);
 #endif
@@ -146,6 +154,12 @@ void Engine::create_game()
 void Engine::run()
 {
     double last_frame = 0.0; // Time of last frame
+    u32 rendered_frames = 0;
+
+    if (benchmark_frames > 0)
+    {
+        RendererStatistics::set_max_history_frames(benchmark_frames);
+    }
 
     // Main loop
     while (!glfwWindowShouldClose(window->get_glfw_window()) && !should_exit)
@@ -218,6 +232,23 @@ void Engine::run()
         }
 
         Renderer::get_instance()->present();
+
+        rendered_frames += 1;
+
+        if (benchmark_frames > 0 && rendered_frames >= benchmark_frames)
+        {
+            should_exit = true;
+        }
+    }
+
+    if (benchmark_frames > 0)
+    {
+        RendererStatistics::write_csv(benchmark_statistics_path);
+
+        // Mesh optimization statistics are written next to the frame statistics, e.g. "benchmark.csv" -> "benchmark_meshes.csv"
+        std::filesystem::path mesh_statistics_path = benchmark_statistics_path;
+        mesh_statistics_path.replace_filename(mesh_statistics_path.stem().string() + "_meshes.csv");
+        ModelCooker::write_statistics_csv(mesh_statistics_path.string());
     }
 }
 
@@ -412,10 +443,13 @@ i32 Engine::initialize_miniaudio()
 
     ma_device_set_master_volume(audio_engine.pDevice, 0.2f);
 
+    SoundPool::get_instance().initialize(&audio_engine);
+
     return 0;
 }
 
 void Engine::uninitialize_miniaudio()
 {
+    SoundPool::get_instance().uninitialize();
     ma_engine_uninit(&audio_engine);
 }
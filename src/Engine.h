@@ -10,6 +10,7 @@
 #include <miniaudio.h>
 
 #include <memory>
+#include <string>
 
 #include "AK/Types.h"
 #include "EngineDefines.h"
@@ -49,6 +50,11 @@ public:
 
     inline static std::string window_title = "Engine";
 
+    // Benchmark mode, enabled with --benchmark <frames> [csv path]. Renders the given number of frames, then exits
+    // and writes renderer statistics of all of them to a CSV file.
+    inline static u32 benchmark_frames = 0;
+    inline static std::string benchmark_statistics_path = "./benchmark.csv";
+
 private:
     static i32 initialize_thirdparty_before_renderer();
     static i32 initialize_thirdparty_after_renderer();
@@ -1,118 +1,349 @@
 #pragma once
 
-#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <functional>
-#include <iostream>
 #include <memory>
 #include <mutex>
-#include <tuple>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
 #include "AK/Types.h"
 
-// Based on https://codereview.stackexchange.com/questions/188989/a-c-style-event-object-in-c
+// Originally based on https://codereview.stackexchange.com/questions/188989/a-c-style-event-object-in-c
+
+// Identifies a single attached listener. Slots of detached listeners are reused with a new generation,
+// so an old id never detaches a listener attached after it.
+struct EventListenerId
+{
+    u32 index = invalid_index;
+    u32 generation = 0;
+
+    inline static u32 constexpr invalid_index = 0xFFFFFFFF;
+};
 
 template<typename T>
+class Event;
+
+// Listeners are member functions of objects owned by shared pointers, they are detached automatically once the object is destroyed.
+//
+// Event belongs to the thread that created it, usually the main thread. Firing it from that thread doesn't lock any mutex
+// or allocate any memory, listeners are called straight from slots which never move, even when a listener attaches another one.
+// Listeners attached or detached from other threads are queued and published by the owning thread when it fires the event next time.
+// Slots of detached listeners are only reused once no fire is in progress, so a listener detaching itself or another one
+// while the event is firing is safe.
+// Events can also be fired from other threads, which locks the mutex that the owning thread takes when changing listeners.
+template<typename R, typename... Params>
 // TODO: Handle move constructors
-class Event
+class Event<R(Params...)>
 {
 public:
     Event() = default;
     Event(Event const&) = delete;
     Event& operator=(Event const&) = delete;
 
+    // Listeners attached while the event is firing are called starting from the next fire
     template<typename... Args>
     void operator()(Args&&... args)
     {
-        std::lock_guard guard(mutex);
-
-        if (m_listeners.empty())
+        if (!is_owning_thread())
+        {
+            std::lock_guard guard(m_mutex);
+            call_listeners(false, args...);
             return;
+        }
+
+        if (m_has_pending_changes.load(std::memory_order_acquire))
+        {
+            std::lock_guard guard(m_mutex);
+            publish_pending_changes();
+        }
 
-        this->clean();
+        ++m_fire_depth;
+        call_listeners(true, args...);
+        --m_fire_depth;
 
-        for (auto listeners_copy = m_listeners; auto const& listener : listeners_copy)
+        if (m_fire_depth == 0 && !m_detached_slots.empty())
         {
-            if (auto locked = listener.first.lock())
-            {
-                listener.second(std::forward<Args>(args)...);
-            }
+            std::lock_guard guard(m_mutex);
+            reclaim_detached_slots();
         }
     }
 
-    template<typename P, typename Q, typename R, typename... Args>
-    void attach(P (Q::*f)(Args...), std::shared_ptr<R> const& p)
+    // Returns an invalid id when called from another thread than the owning one, such listener can only be detached by its object
+    template<typename P, typename Q, typename S, typename... Args>
+    EventListenerId attach(P (Q::*f)(Args...), std::shared_ptr<S> const& p)
     {
-        std::lock_guard guard(mutex);
+        std::lock_guard guard(m_mutex);
 
-        auto w = std::weak_ptr<Q>(std::static_pointer_cast<Q>(p));
+        auto owner = std::weak_ptr<void>(std::weak_ptr<Q>(std::static_pointer_cast<Q>(p)));
 
-        assert(!attached(w));
-
-        auto l = [w, f](Args... args) {
-            if (auto locked = w.lock())
+        // Object pointer is the one of the owner, so the listener doesn't lock its own weak pointer again
+        Callback callback = [f](void* object, Params... params) -> R {
+            if constexpr (std::is_void_v<R>)
             {
-                return (*locked.get().*f)(args...);
+                (static_cast<Q*>(object)->*f)(params...);
+            }
+            else
+            {
+                return (static_cast<Q*>(object)->*f)(params...);
             }
-
-            return P();
         };
 
-        m_listeners.emplace_back(std::weak_ptr<void>(w), l);
+        if (!is_owning_thread())
+        {
+            m_pending_changes.emplace_back(PendingChange {std::move(owner), std::move(callback), {}, false});
+            m_has_pending_changes.store(true, std::memory_order_release);
+            return {};
+        }
+
+        publish_pending_changes();
+
+        return attach_slot(std::move(owner), std::move(callback));
     }
 
     void detach(std::weak_ptr<void> const& p)
     {
-        std::lock_guard guard(mutex);
+        std::lock_guard guard(m_mutex);
+
+        if (!is_owning_thread())
+        {
+            m_pending_changes.emplace_back(PendingChange {p, {}, {}, true});
+            m_has_pending_changes.store(true, std::memory_order_release);
+            return;
+        }
+
+        publish_pending_changes();
+
+        u32 const index = find(p);
+
+        assert(index != EventListenerId::invalid_index);
+
+        if (index != EventListenerId::invalid_index)
+        {
+            detach_slot(index);
+        }
+    }
+
+    void detach(EventListenerId const id)
+    {
+        std::lock_guard guard(m_mutex);
 
-        auto found = find(p);
+        if (!is_owning_thread())
+        {
+            m_pending_changes.emplace_back(PendingChange {{}, {}, id, true});
+            m_has_pending_changes.store(true, std::memory_order_release);
+            return;
+        }
 
-        assert(found != m_listeners.end());
+        publish_pending_changes();
 
-        if (found != m_listeners.end())
+        if (is_attached(id))
         {
-            m_listeners.erase(found);
+            detach_slot(id.index);
         }
     }
 
+    // Listeners whose objects were destroyed are counted until the next fire. Listeners from other threads count once published.
     [[nodiscard]] i32 count() const
     {
-        std::lock_guard guard(mutex);
+        std::lock_guard guard(m_mutex);
+
+        return static_cast<i32>(m_listener_count);
+    }
+
+private:
+    using Callback = std::function<R(void*, Params...)>;
+
+    struct Slot
+    {
+        std::weak_ptr<void> owner = {};
+        Callback callback = {};
+        u32 generation = 0;
+        bool is_attached = false;
+    };
+
+    struct PendingChange
+    {
+        std::weak_ptr<void> owner = {};
+        Callback callback = {};
+        EventListenerId id = {};
+        bool is_detach = false;
+    };
+
+    // Slots are allocated in blocks, which stay in place when more blocks are added
+    inline static u32 constexpr slots_per_block = 16;
+    using SlotBlock = std::array<Slot, slots_per_block>;
+
+    [[nodiscard]] bool is_owning_thread() const
+    {
+        return std::this_thread::get_id() == m_owning_thread;
+    }
+
+    [[nodiscard]] Slot& get_slot(u32 const index)
+    {
+        return (*m_blocks[index / slots_per_block])[index % slots_per_block];
+    }
+
+    template<typename... Args>
+    void call_listeners(bool const is_owner, Args&... args)
+    {
+        // Slots added by listeners during this fire are past the count taken here
+        u32 const slot_count = m_slot_count;
+
+        for (u32 i = 0; i < slot_count; ++i)
+        {
+            Slot& slot = get_slot(i);
+
+            if (!slot.is_attached)
+                continue;
+
+            // Keeps the object alive while its listener runs
+            auto const owner = slot.owner.lock();
+
+            if (owner == nullptr)
+            {
+                // Only the owning thread changes slots, other threads leave the listener to be detached by the next fire
+                if (is_owner)
+                {
+                    std::lock_guard guard(m_mutex);
+                    detach_slot(i);
+                }
+
+                continue;
+            }
+
+            slot.callback(owner.get(), args...);
+        }
+    }
+
+    EventListenerId attach_slot(std::weak_ptr<void>&& owner, Callback&& callback)
+    {
+        assert(find(owner) == EventListenerId::invalid_index);
+
+        u32 index = 0;
+
+        // Slots freed before the fire are below its slot count, so they are only reused when nothing is firing
+        if (m_fire_depth == 0 && !m_free_slots.empty())
+        {
+            index = m_free_slots.back();
+            m_free_slots.pop_back();
+        }
+        else
+        {
+            index = m_slot_count;
+
+            if (index == m_blocks.size() * slots_per_block)
+                m_blocks.emplace_back(std::make_unique<SlotBlock>());
+
+            ++m_slot_count;
+        }
+
+        Slot& slot = get_slot(index);
+        slot.owner = std::move(owner);
+        slot.callback = std::move(callback);
+        slot.is_attached = true;
+
+        ++m_listener_count;
+
+        return {index, slot.generation};
+    }
+
+    void detach_slot(u32 const index)
+    {
+        Slot& slot = get_slot(index);
+        slot.is_attached = false;
+        ++slot.generation;
+
+        --m_listener_count;
 
-        return m_listeners.size();
+        // Callback of the slot might be running right now, it's only destroyed once nothing is firing
+        m_detached_slots.emplace_back(index);
+
+        if (m_fire_depth == 0)
+            reclaim_detached_slots();
     }
 
-    std::mutex mutex;
+    void reclaim_detached_slots()
+    {
+        for (u32 const index : m_detached_slots)
+        {
+            Slot& slot = get_slot(index);
+            slot.owner.reset();
+            slot.callback = nullptr;
 
-protected:
-    using event_pair = std::pair<std::weak_ptr<void>, std::function<T>>;
+            m_free_slots.emplace_back(index);
+        }
+
+        m_detached_slots.clear();
+    }
 
-    bool attached(std::weak_ptr<void> const& p)
+    void publish_pending_changes()
     {
-        return find(p) != m_listeners.end();
+        if (m_pending_changes.empty())
+            return;
+
+        for (auto& change : m_pending_changes)
+        {
+            if (!change.is_detach)
+            {
+                attach_slot(std::move(change.owner), std::move(change.callback));
+                continue;
+            }
+
+            u32 const index = change.id.index != EventListenerId::invalid_index ? change.id.index : find(change.owner);
+
+            if (index != EventListenerId::invalid_index
+                && (change.id.index == EventListenerId::invalid_index || is_attached(change.id)))
+            {
+                detach_slot(index);
+            }
+        }
+
+        m_pending_changes.clear();
+        m_has_pending_changes.store(false, std::memory_order_relaxed);
     }
 
-    void clean()
+    [[nodiscard]] bool is_attached(EventListenerId const id)
     {
-        m_listeners.erase(
-            std::remove_if(std::begin(m_listeners), std::end(m_listeners), [&](event_pair const& p) -> bool { return p.first.expired(); }),
-            std::end(m_listeners));
+        if (id.index >= m_slot_count)
+            return false;
+
+        Slot const& slot = get_slot(id.index);
+        return slot.is_attached && slot.generation == id.generation;
     }
 
-    typename std::vector<event_pair>::const_iterator find(std::weak_ptr<void> const& p) const
+    // Compares owners rather than pointers, so it doesn't have to lock every listener
+    [[nodiscard]] u32 find(std::weak_ptr<void> const& p)
     {
-        if (auto listener = p.lock())
+        for (u32 i = 0; i < m_slot_count; ++i)
         {
-            return std::find_if(m_listeners.begin(), m_listeners.end(), [&listener](event_pair const& pair) {
-                auto other = pair.first.lock();
+            Slot const& slot = get_slot(i);
 
-                return other && other == listener;
-            });
+            if (slot.is_attached && !slot.owner.owner_before(p) && !p.owner_before(slot.owner))
+                return i;
         }
 
-        return m_listeners.end();
+        return EventListenerId::invalid_index;
     }
 
-    std::vector<event_pair> m_listeners;
+    std::thread::id m_owning_thread = std::this_thread::get_id();
+
+    // Only changed by the owning thread while holding the mutex, so it can read them without locking
+    std::vector<std::unique_ptr<SlotBlock>> m_blocks = {};
+    u32 m_slot_count = 0;
+    u32 m_listener_count = 0;
+    std::vector<u32> m_free_slots = {};
+
+    // Only used by the owning thread
+    std::vector<u32> m_detached_slots = {};
+    u32 m_fire_depth = 0;
+
+    // Changes made by other threads, waiting to be published by the owning thread
+    std::vector<PendingChange> m_pending_changes = {};
+    std::atomic<bool> m_has_pending_changes = false;
+
+    mutable std::recursive_mutex m_mutex = {};
 };
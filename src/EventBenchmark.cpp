@@ -0,0 +1,88 @@
+#include "EventBenchmark.h"
+
+#include <array>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "Event.h"
+
+namespace
+{
+
+struct BenchmarkListener
+{
+    void on_fired(i32 const value)
+    {
+        sum += value;
+    }
+
+    i64 sum = 0;
+};
+
+}
+
+bool EventBenchmark::run(std::string const& path, u32 const fires)
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::ofstream file(path);
+
+    if (!file.is_open())
+    {
+        std::cout << std::format("Could not open {} for writing event benchmark results.\n", path);
+        return false;
+    }
+
+    file << "listeners,fires,total_ms,ns_per_fire,ns_per_listener\n";
+
+    std::array constexpr listener_counts = {1u, 10u, 100u};
+
+    for (u32 const listener_count : listener_counts)
+    {
+        Event<void(i32)> event;
+        std::vector<std::shared_ptr<BenchmarkListener>> listeners = {};
+        listeners.reserve(listener_count);
+
+        for (u32 i = 0; i < listener_count; ++i)
+        {
+            auto const& listener = listeners.emplace_back(std::make_shared<BenchmarkListener>());
+            event.attach(&BenchmarkListener::on_fired, listener);
+        }
+
+        // Warms up caches and branch predictors before timing
+        for (u32 i = 0; i < fires / 10; ++i)
+        {
+            event(1);
+        }
+
+        auto const start = Clock::now();
+
+        for (u32 i = 0; i < fires; ++i)
+        {
+            event(static_cast<i32>(i & 1));
+        }
+
+        double const total_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        double const ns_per_fire = total_ms * 1'000'000.0 / fires;
+
+        // Listener sums are read, so the calls can't be optimized away
+        i64 checksum = 0;
+        for (auto const& listener : listeners)
+        {
+            checksum += listener->sum;
+        }
+
+        std::string const line =
+            std::format("{},{},{:.4f},{:.2f},{:.2f}", listener_count, fires, total_ms, ns_per_fire, ns_per_fire / listener_count);
+        file << line << "\n";
+
+        std::cout << std::format("{} listeners: {:.2f} ns per fire, {:.2f} ns per listener (checksum {})\n", listener_count,
+                                 ns_per_fire, ns_per_fire / listener_count, checksum);
+    }
+
+    return true;
+}
@@ -24,7 +24,7 @@ void ExampleDynamicText::awake()
 
     // This is example usage of ScreenText.
     m_foo = entity->add_component<ScreenText>(
-        ScreenText::create(ui_material, m_example, glm::vec2(0, 0), 128, 0xff0099ff, FW1_RESTORESTATE | FW1_CENTER | FW1_VCENTER));
+        ScreenText::create(ui_material, m_example, glm::vec2(0, 0), 128, 0xff0099ff, TextFlags::Center | TextFlags::VerticalCenter));
 }
 
 void ExampleDynamicText::update()
@@ -32,7 +32,7 @@ void ExampleDynamicText::update()
     // Rewrite the "example" array with different value every frame. ScreenText is referencing "example" so the component sees the change...
     m_example = std::to_string(sin(glfwGetTime()));
 
-    // But you still need to update it in terms of Direct3D state. This call does that.
+    // But you still need to tell it about the change. This call lays the text out again, only if it actually changed.
     m_foo->set_text(m_example);
 }
 
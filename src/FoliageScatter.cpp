@@ -0,0 +1,325 @@
+#include "FoliageScatter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <format>
+#include <random>
+#include <stb_image.h>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Debug.h"
+#include "Entity.h"
+#include "Globals.h"
+#include "Renderer.h"
+
+#if EDITOR
+#include "imgui_extensions.h"
+#endif
+
+std::shared_ptr<FoliageScatter> FoliageScatter::create()
+{
+    return std::make_shared<FoliageScatter>(AK::Badge<FoliageScatter> {}, default_material);
+}
+
+std::shared_ptr<FoliageScatter> FoliageScatter::create(std::shared_ptr<Material> const& material, std::string const& model_path,
+                                                       glm::vec2 const area_size, float const density,
+                                                       std::string const& density_map_path, u32 const seed)
+{
+    auto foliage_scatter = std::make_shared<FoliageScatter>(AK::Badge<FoliageScatter> {}, material, model_path, area_size, density,
+                                                            density_map_path, seed);
+
+    foliage_scatter->prepare();
+
+    return foliage_scatter;
+}
+
+FoliageScatter::FoliageScatter(AK::Badge<FoliageScatter>, std::shared_ptr<Material> const& material) : Model(material)
+{
+}
+
+FoliageScatter::FoliageScatter(AK::Badge<FoliageScatter>, std::shared_ptr<Material> const& material, std::string const& model_path,
+                               glm::vec2 const area_size, float const density, std::string const& density_map_path, u32 const seed)
+    : Model(material), area_size(area_size), density(density), density_map_path(density_map_path), seed(seed)
+{
+    this->model_path = model_path;
+}
+
+FoliageScatter::FoliageScatter(std::shared_ptr<Material> const& material) : Model(material)
+{
+}
+
+void FoliageScatter::draw() const
+{
+    Frustum const frustum = Renderer::get_instance()->get_culling_frustum();
+
+    for (auto const& cell : m_cells)
+    {
+        if (cell.instances == nullptr || !cell.bounds.is_in_frustum(frustum))
+            continue;
+
+        cell.instances->bind();
+
+        for (auto const& mesh : m_meshes)
+        {
+            mesh->draw_instanced(static_cast<i32>(cell.instances->get_instance_count()));
+        }
+    }
+}
+
+void FoliageScatter::prepare()
+{
+    // Instances are drawn by the scatter itself, instance batches of the material would draw a single one
+    if (material->is_gpu_instanced)
+    {
+        Debug::log("Foliage scatter can't use a GPU instanced material.", DebugType::Error);
+        return;
+    }
+
+    // Otherwise every instance would be drawn with the model matrix of the entity, on top of each other
+    if (!material->shader->reads_instance_models())
+    {
+        Debug::log(std::format("Foliage scatter needs a shader reading model matrices of instances, '{}' doesn't.",
+                               material->shader->get_vertex_path()),
+                   DebugType::Error);
+        return;
+    }
+
+    prepare_meshes();
+
+    m_density_map = density_map_path.empty() ? DensityMap {} : load_density_map(density_map_path);
+
+    create_cells();
+
+    m_is_generated = false;
+
+    // Prepared again after the model changed, instances have to be generated for the new cells right away
+    if (entity != nullptr)
+    {
+        calculate_bounding_box();
+        adjust_bounding_box();
+    }
+}
+
+void FoliageScatter::calculate_bounding_box()
+{
+    if (m_cells.empty())
+        return;
+
+    bounds = m_cells[0].local_bounds;
+
+    for (auto const& cell : m_cells)
+        bounds = BoundingBox::merge(bounds, cell.local_bounds);
+}
+
+void FoliageScatter::adjust_bounding_box()
+{
+    if (m_cells.empty())
+        return;
+
+    glm::mat4 const model_matrix = entity->transform->get_model_matrix();
+
+    if (!m_is_generated || model_matrix != m_generated_model_matrix)
+        generate_instances(model_matrix);
+
+    for (auto& cell : m_cells)
+        cell.bounds = cell.local_bounds.transform(model_matrix);
+
+    bounds = m_cells[0].bounds;
+
+    for (auto const& cell : m_cells)
+        bounds = BoundingBox::merge(bounds, cell.bounds);
+}
+
+BoundingBox FoliageScatter::get_adjusted_bounding_box(glm::mat4 const& model_matrix) const
+{
+    if (m_cells.empty())
+        return {};
+
+    BoundingBox local_bounds = m_cells[0].local_bounds;
+
+    for (auto const& cell : m_cells)
+        local_bounds = BoundingBox::merge(local_bounds, cell.local_bounds);
+
+    return local_bounds.transform(model_matrix);
+}
+
+bool FoliageScatter::is_cullable() const
+{
+    return !m_cells.empty();
+}
+
+void FoliageScatter::prepare_meshes()
+{
+    Model::prepare();
+}
+
+u32 FoliageScatter::get_instance_count() const
+{
+    u32 instance_count = 0;
+
+    for (auto const& cell : m_cells)
+    {
+        if (cell.instances != nullptr)
+            instance_count += cell.instances->get_instance_count();
+    }
+
+    return instance_count;
+}
+
+float FoliageScatter::DensityMap::sample(glm::vec2 const& uv) const
+{
+    u32 const x = std::min(static_cast<u32>(glm::max(uv.x, 0.0f) * static_cast<float>(width)), width - 1);
+    u32 const y = std::min(static_cast<u32>(glm::max(uv.y, 0.0f) * static_cast<float>(height)), height - 1);
+
+    return values[x + width * y];
+}
+
+FoliageScatter::DensityMap FoliageScatter::load_density_map(std::string const& path)
+{
+    stbi_set_flip_vertically_on_load(true);
+
+    i32 width, height, number_of_components;
+    unsigned char* data = stbi_load(path.c_str(), &width, &height, &number_of_components, 1);
+
+    if (data == nullptr)
+    {
+        Debug::log("Density map failed to load at path: " + path, DebugType::Error);
+        return {};
+    }
+
+    DensityMap density_map = {};
+    density_map.width = static_cast<u32>(width);
+    density_map.height = static_cast<u32>(height);
+    density_map.values.resize(static_cast<size_t>(width) * height);
+
+    for (size_t i = 0; i < density_map.values.size(); ++i)
+    {
+        density_map.values[i] = static_cast<float>(data[i]) / 255.0f;
+    }
+
+    stbi_image_free(data);
+
+    return density_map;
+}
+
+void FoliageScatter::create_cells()
+{
+    m_cells.clear();
+
+    if (m_meshes.empty() || area_size.x <= 0.0f || area_size.y <= 0.0f)
+        return;
+
+    // Instances are rotated around the up axis, so they can reach as far as the farthest corner of the model in every direction
+    BoundingBox const model_bounds = Model::get_adjusted_bounding_box(glm::mat4(1.0f));
+
+    float const reach = glm::max(glm::max(glm::length(glm::vec2(model_bounds.min.x, model_bounds.min.z)),
+                                          glm::length(glm::vec2(model_bounds.min.x, model_bounds.max.z))),
+                                 glm::max(glm::length(glm::vec2(model_bounds.max.x, model_bounds.min.z)),
+                                          glm::length(glm::vec2(model_bounds.max.x, model_bounds.max.z))))
+                      * max_scale;
+
+    float const min_height = glm::min(model_bounds.min.y * min_scale, model_bounds.min.y * max_scale);
+    float const max_height = glm::max(model_bounds.max.y * min_scale, model_bounds.max.y * max_scale);
+
+    u32 const cells_x = static_cast<u32>(std::ceil(area_size.x / cell_size));
+    u32 const cells_z = static_cast<u32>(std::ceil(area_size.y / cell_size));
+
+    m_cells.reserve(static_cast<size_t>(cells_x) * cells_z);
+
+    for (u32 z = 0; z < cells_z; ++z)
+    {
+        for (u32 x = 0; x < cells_x; ++x)
+        {
+            glm::vec2 const cell_min = -area_size / 2.0f + glm::vec2(x, z) * cell_size;
+            glm::vec2 const cell_max = glm::min(cell_min + cell_size, area_size / 2.0f);
+
+            Cell cell = {};
+            cell.x = x;
+            cell.z = z;
+            cell.local_bounds = {glm::vec3(cell_min.x - reach, min_height, cell_min.y - reach),
+                                 glm::vec3(cell_max.x + reach, max_height, cell_max.y + reach)};
+            cell.bounds = cell.local_bounds;
+
+            m_cells.emplace_back(cell);
+        }
+    }
+}
+
+void FoliageScatter::generate_instances(glm::mat4 const& model_matrix)
+{
+    std::vector<std::vector<glm::mat4>> cell_instances(m_cells.size());
+
+    std::for_each(std::execution::par, m_cells.begin(), m_cells.end(),
+                  [&](Cell const& cell) { cell_instances[&cell - m_cells.data()] = generate_cell(cell, model_matrix); });
+
+    // Buffers are created on the main thread
+    for (u32 i = 0; i < m_cells.size(); ++i)
+    {
+        m_cells[i].instances = cell_instances[i].empty() ? nullptr : InstanceBuffer::create(cell_instances[i]);
+    }
+
+    m_generated_model_matrix = model_matrix;
+    m_is_generated = true;
+}
+
+std::vector<glm::mat4> FoliageScatter::generate_cell(Cell const& cell, glm::mat4 const& model_matrix) const
+{
+    glm::vec2 const cell_min = -area_size / 2.0f + glm::vec2(cell.x, cell.z) * cell_size;
+    glm::vec2 const cell_extent = glm::min(cell_min + cell_size, area_size / 2.0f) - cell_min;
+
+    std::mt19937 generator(seed ^ (cell.x * 73856093u) ^ (cell.z * 19349663u));
+
+    // Raw generator output is the same with every standard library, unlike standard distributions
+    auto const random = [&generator] { return static_cast<float>(generator() >> 8) / 16777216.0f; };
+
+    float const expected_count = density * cell_extent.x * cell_extent.y;
+    u32 candidate_count = static_cast<u32>(expected_count);
+
+    if (random() < expected_count - static_cast<float>(candidate_count))
+        candidate_count += 1;
+
+    std::vector<glm::mat4> instances = {};
+    instances.reserve(candidate_count);
+
+    for (u32 i = 0; i < candidate_count; ++i)
+    {
+        glm::vec2 const position = cell_min + glm::vec2(random(), random()) * cell_extent;
+        float const angle = random() * glm::two_pi<float>();
+        float const scale = glm::mix(min_scale, max_scale, random());
+        float const threshold = random();
+
+        if (!m_density_map.values.empty() && threshold >= m_density_map.sample((position + area_size / 2.0f) / area_size))
+            continue;
+
+        glm::mat4 instance = glm::translate(glm::mat4(1.0f), glm::vec3(position.x, 0.0f, position.y));
+        instance = glm::rotate(instance, angle, glm::vec3(0.0f, 1.0f, 0.0f));
+        instance = glm::scale(instance, glm::vec3(scale));
+
+        instances.emplace_back(model_matrix * instance);
+    }
+
+    return instances;
+}
+
+#if EDITOR
+void FoliageScatter::draw_editor()
+{
+    Model::draw_editor();
+
+    bool is_dirty = false;
+    is_dirty |= vec2_draw_editor("Area Size: ", area_size);
+    is_dirty |= float_draw_editor("Density: ", density);
+    is_dirty |= string_draw_editor("Density Map Path: ", density_map_path);
+    is_dirty |= u32_draw_editor("Seed: ", seed);
+
+    if (is_dirty)
+        reprepare();
+
+    ImGui::Text("Cells: %u, instances: %u", static_cast<u32>(m_cells.size()), get_instance_count());
+}
+#endif
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "AK/Badge.h"
+#include "InstanceBuffer.h"
+#include "Model.h"
+
+// Instances of a model scattered over an area centered on the entity, without an entity per instance. Density of every point
+// is read from a density map, instances are generated deterministically from the seed on worker threads and bucketed
+// into square cells. Every cell is culled on its own and drawn with a single instanced draw per mesh.
+// The material's shader has to read model matrices of instances, like lit.hlsl with DirectX 11 and foliage.vert with OpenGL.
+class FoliageScatter : public Model
+{
+public:
+#if EDITOR
+    virtual void draw_editor() override;
+#endif
+
+    static std::shared_ptr<FoliageScatter> create();
+
+    // Density is the number of instances per square unit where the density map is white, the whole area is used
+    // at full density without a density map
+    static std::shared_ptr<FoliageScatter> create(std::shared_ptr<Material> const& material, std::string const& model_path,
+                                                  glm::vec2 const area_size, float const density,
+                                                  std::string const& density_map_path = "", u32 const seed = 0);
+
+    explicit FoliageScatter(AK::Badge<FoliageScatter>, std::shared_ptr<Material> const& material);
+    explicit FoliageScatter(AK::Badge<FoliageScatter>, std::shared_ptr<Material> const& material, std::string const& model_path,
+                            glm::vec2 const area_size, float const density, std::string const& density_map_path, u32 const seed);
+
+    virtual void draw() const override;
+
+    virtual void prepare() override;
+
+    virtual void calculate_bounding_box() override;
+    virtual void adjust_bounding_box() override;
+    virtual BoundingBox get_adjusted_bounding_box(glm::mat4 const& model_matrix) const override;
+    virtual bool is_cullable() const override;
+
+    [[nodiscard]] u32 get_instance_count() const;
+
+    inline static float constexpr cell_size = 16.0f;
+
+    // Every instance is rotated around the up axis and scaled uniformly by a random amount between these
+    inline static float constexpr min_scale = 0.75f;
+    inline static float constexpr max_scale = 1.25f;
+
+    glm::vec2 area_size = {cell_size, cell_size};
+    float density = 1.0f;
+    std::string density_map_path = "";
+    u32 seed = 0;
+
+protected:
+    explicit FoliageScatter(std::shared_ptr<Material> const& material);
+
+    // Loads meshes of a single instance, the model at model_path by default
+    virtual void prepare_meshes();
+
+private:
+    struct DensityMap
+    {
+        u32 width = 0;
+        u32 height = 0;
+        std::vector<float> values = {};
+
+        [[nodiscard]] float sample(glm::vec2 const& uv) const;
+    };
+
+    struct Cell
+    {
+        u32 x = 0;
+        u32 z = 0;
+
+        BoundingBox local_bounds = {};
+        BoundingBox bounds = {};
+
+        std::shared_ptr<InstanceBuffer> instances = {};
+    };
+
+    [[nodiscard]] static DensityMap load_density_map(std::string const& path);
+
+    void create_cells();
+
+    // Instances are generated again whenever the entity moves, as instance buffers hold world space model matrices
+    void generate_instances(glm::mat4 const& model_matrix);
+
+    // Depends only on the seed and the cell, so cells can be generated in any order on any thread
+    [[nodiscard]] std::vector<glm::mat4> generate_cell(Cell const& cell, glm::mat4 const& model_matrix) const;
+
+    DensityMap m_density_map = {};
+    std::vector<Cell> m_cells = {};
+
+    glm::mat4 m_generated_model_matrix = {};
+    bool m_is_generated = false;
+};
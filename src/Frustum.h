@@ -1,5 +1,7 @@
 #pragma once
 
+#include <glm/mat4x4.hpp>
+
 #include "Plane.h"
 
 struct Frustum
@@ -12,4 +14,8 @@ struct Frustum
 
     Plane far_plane;
     Plane near_plane;
+
+    // Extracts normalized frustum planes from a combined projection and view matrix. Works for both perspective and orthographic
+    // projections, so it can also be used for shadow casting lights.
+    [[nodiscard]] static Frustum from_projection_view(glm::mat4 const& projection_view);
 };
@@ -0,0 +1,192 @@
+#include "FrustumCuller.h"
+
+#include <array>
+#include <bit>
+#include <limits>
+
+#include <emmintrin.h>
+
+#include <glm/glm.hpp>
+
+namespace
+{
+
+// Same tolerance as BoundingBox::half_plane_test
+float constexpr plane_epsilon = -0.02f;
+
+// Large enough to pass every plane test, yet small enough to not overflow when summed up
+float constexpr always_visible_extents = std::numeric_limits<float>::max() / 8.0f;
+
+struct PlaneCoefficients
+{
+    __m128 normal_x;
+    __m128 normal_y;
+    __m128 normal_z;
+    __m128 abs_normal_x;
+    __m128 abs_normal_y;
+    __m128 abs_normal_z;
+    __m128 distance;
+};
+
+}
+
+void FrustumCuller::clear()
+{
+    m_center_x.clear();
+    m_center_y.clear();
+    m_center_z.clear();
+    m_extents_x.clear();
+    m_extents_y.clear();
+    m_extents_z.clear();
+
+    m_count = 0;
+}
+
+void FrustumCuller::reserve(u32 const count)
+{
+    m_center_x.reserve(count);
+    m_center_y.reserve(count);
+    m_center_z.reserve(count);
+    m_extents_x.reserve(count);
+    m_extents_y.reserve(count);
+    m_extents_z.reserve(count);
+}
+
+u32 FrustumCuller::add(BoundingBox const& bounds)
+{
+    m_center_x.emplace_back(bounds.center.x);
+    m_center_y.emplace_back(bounds.center.y);
+    m_center_z.emplace_back(bounds.center.z);
+    m_extents_x.emplace_back(bounds.extents.x);
+    m_extents_y.emplace_back(bounds.extents.y);
+    m_extents_z.emplace_back(bounds.extents.z);
+
+    return m_count++;
+}
+
+u32 FrustumCuller::add_always_visible()
+{
+    m_center_x.emplace_back(0.0f);
+    m_center_y.emplace_back(0.0f);
+    m_center_z.emplace_back(0.0f);
+    m_extents_x.emplace_back(always_visible_extents);
+    m_extents_y.emplace_back(always_visible_extents);
+    m_extents_z.emplace_back(always_visible_extents);
+
+    return m_count++;
+}
+
+void FrustumCuller::cull(Frustum const& frustum, std::vector<u32>& visible_indices) const
+{
+    visible_indices.clear();
+
+    if (m_count == 0)
+        return;
+
+    std::array const planes = {frustum.left_plane, frustum.right_plane, frustum.top_plane,
+                               frustum.bottom_plane, frustum.near_plane, frustum.far_plane};
+
+    // Splat plane coefficients once, absolute values of normals are used to find the box extent along the normal
+    std::array<PlaneCoefficients, planes.size()> plane_coefficients = {};
+    for (u32 i = 0; i < planes.size(); ++i)
+    {
+        plane_coefficients[i] = {
+            _mm_set1_ps(planes[i].normal.x),
+            _mm_set1_ps(planes[i].normal.y),
+            _mm_set1_ps(planes[i].normal.z),
+            _mm_set1_ps(glm::abs(planes[i].normal.x)),
+            _mm_set1_ps(glm::abs(planes[i].normal.y)),
+            _mm_set1_ps(glm::abs(planes[i].normal.z)),
+            _mm_set1_ps(planes[i].distance),
+        };
+    }
+
+    __m128 const epsilon = _mm_set1_ps(plane_epsilon);
+
+    u32 const full_batches_end = m_count / batch_size * batch_size;
+
+    auto const test_batch = [&](float const* center_x, float const* center_y, float const* center_z, float const* extents_x,
+                                float const* extents_y, float const* extents_z) {
+        __m128 const cx = _mm_loadu_ps(center_x);
+        __m128 const cy = _mm_loadu_ps(center_y);
+        __m128 const cz = _mm_loadu_ps(center_z);
+        __m128 const ex = _mm_loadu_ps(extents_x);
+        __m128 const ey = _mm_loadu_ps(extents_y);
+        __m128 const ez = _mm_loadu_ps(extents_z);
+
+        __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        for (auto const& plane : plane_coefficients)
+        {
+            // Signed distance of the box corner farthest along the plane normal
+            __m128 d = _mm_add_ps(_mm_mul_ps(plane.normal_x, cx), _mm_mul_ps(plane.normal_y, cy));
+            d = _mm_add_ps(d, _mm_mul_ps(plane.normal_z, cz));
+            d = _mm_add_ps(d, _mm_mul_ps(plane.abs_normal_x, ex));
+            d = _mm_add_ps(d, _mm_mul_ps(plane.abs_normal_y, ey));
+            d = _mm_add_ps(d, _mm_mul_ps(plane.abs_normal_z, ez));
+            d = _mm_add_ps(d, plane.distance);
+
+            visible = _mm_and_ps(visible, _mm_cmpge_ps(d, epsilon));
+        }
+
+        return static_cast<u32>(_mm_movemask_ps(visible));
+    };
+
+    for (u32 i = 0; i < full_batches_end; i += batch_size)
+    {
+        u32 mask = test_batch(&m_center_x[i], &m_center_y[i], &m_center_z[i], &m_extents_x[i], &m_extents_y[i], &m_extents_z[i]);
+
+        while (mask != 0)
+        {
+            visible_indices.emplace_back(i + std::countr_zero(mask));
+            mask &= mask - 1;
+        }
+    }
+
+    // Copy the remaining boxes to a full batch, padding is masked out afterwards
+    if (full_batches_end < m_count)
+    {
+        u32 const remaining = m_count - full_batches_end;
+
+        std::array<std::array<float, batch_size>, 6> tail = {};
+        for (u32 i = 0; i < remaining; ++i)
+        {
+            tail[0][i] = m_center_x[full_batches_end + i];
+            tail[1][i] = m_center_y[full_batches_end + i];
+            tail[2][i] = m_center_z[full_batches_end + i];
+            tail[3][i] = m_extents_x[full_batches_end + i];
+            tail[4][i] = m_extents_y[full_batches_end + i];
+            tail[5][i] = m_extents_z[full_batches_end + i];
+        }
+
+        u32 mask = test_batch(tail[0].data(), tail[1].data(), tail[2].data(), tail[3].data(), tail[4].data(), tail[5].data());
+        mask &= (1u << remaining) - 1;
+
+        while (mask != 0)
+        {
+            visible_indices.emplace_back(full_batches_end + std::countr_zero(mask));
+            mask &= mask - 1;
+        }
+    }
+}
+
+u32 FrustumCuller::size() const
+{
+    return m_count;
+}
+
+bool FrustumCuller::is_visible(BoundingBox const& bounds, Frustum const& frustum)
+{
+    std::array const planes = {frustum.left_plane, frustum.right_plane, frustum.top_plane,
+                               frustum.bottom_plane, frustum.near_plane, frustum.far_plane};
+
+    for (auto const& plane : planes)
+    {
+        float const distance = glm::dot(plane.normal, bounds.center) + glm::dot(glm::abs(plane.normal), bounds.extents) + plane.distance;
+
+        if (distance < plane_epsilon)
+            return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+
+#include "AK/Types.h"
+#include "Bounds.h"
+#include "Frustum.h"
+
+// Tests world space bounding boxes against view frustums. Boxes are stored as structure of arrays (centers and extents),
+// so four of them can be tested against a plane at once using SSE.
+class FrustumCuller
+{
+public:
+    void clear();
+    void reserve(u32 const count);
+
+    // Returns index of the added box, used to identify it in the visible list
+    u32 add(BoundingBox const& bounds);
+
+    // Adds an entry that passes every frustum test, e.g. for drawables without valid bounds
+    u32 add_always_visible();
+
+    // Fills visible_indices with indices of all boxes intersecting or inside the frustum, in ascending order
+    void cull(Frustum const& frustum, std::vector<u32>& visible_indices) const;
+
+    [[nodiscard]] u32 size() const;
+
+    // Scalar version of the same test, matches BoundingBox::is_in_frustum
+    [[nodiscard]] static bool is_visible(BoundingBox const& bounds, Frustum const& frustum);
+
+    inline static u32 constexpr batch_size = 4;
+
+private:
+    std::vector<float> m_center_x = {};
+    std::vector<float> m_center_y = {};
+    std::vector<float> m_center_z = {};
+    std::vector<float> m_extents_x = {};
+    std::vector<float> m_extents_y = {};
+    std::vector<float> m_extents_z = {};
+
+    u32 m_count = 0;
+};
@@ -43,6 +43,7 @@ void FullscreenQuad::draw() const
     device_context->IASetVertexBuffers(0, 1, m_vertex_buffer->get_address_of(), m_vertex_buffer->stride_ptr(), &offset);
     device_context->IASetIndexBuffer(m_index_buffer->get(), DXGI_FORMAT_R32_UINT, 0);
     device_context->DrawIndexed(6, 0, 0);
+    RendererStatistics::add_draw_call(6);
 }
 
 std::shared_ptr<FullscreenQuad> FullscreenQuad::get_instance()
@@ -34,6 +34,10 @@ void Customer::awake()
 
     m_jump_timer = glm::linearRand(m_jump_timer_min, m_jump_timer_max);
     m_spreading_arms_timer = glm::linearRand(m_spread_arms_min, m_spread_arms_max);
+
+    m_neutral_sounds = SoundPool::get_instance().load_clips("./res/audio/penguin/neutral/pneutral", 7);
+    m_splash_sounds = SoundPool::get_instance().load_clips("./res/audio/penguin/jump/wodnyskok", 4);
+    m_happy_sounds = SoundPool::get_instance().load_clips("./res/audio/penguin/happy/phappy", 6);
 }
 
 void Customer::fixed_update()
@@ -103,9 +107,9 @@ void Customer::fixed_update()
         // 10% chance to squel on jump
         if (std::rand() % 10 == 0)
         {
-            auto squeal =
-                Sound::play_sound_at_location("./res/audio/penguin/neutral/pneutral" + std::to_string(std::rand() % 7 + 1) + ".wav",
-                                              entity->transform->get_position(), Camera::get_main_camera()->get_position());
+            SoundPool::get_instance().play_at_location(m_neutral_sounds[std::rand() % m_neutral_sounds.size()],
+                                                       entity->transform->get_position(), Camera::get_main_camera()->get_position(),
+                                                       1.0f, SoundPriority::Low);
         }
 
         m_is_jumping = true;
@@ -124,10 +128,9 @@ void Customer::fixed_update()
         {
             if (entity->transform->get_position().y < 0.0f && !m_has_splashed)
             {
-                auto splash =
-                    Sound::play_sound_at_location("./res/audio/penguin/jump/wodnyskok" + std::to_string(std::rand() % 4 + 1) + ".wav",
-                                                  entity->transform->get_position(), Camera::get_main_camera()->get_position());
-                splash->set_volume(8.0f);
+                SoundPool::get_instance().play_at_location(m_splash_sounds[std::rand() % m_splash_sounds.size()],
+                                                           entity->transform->get_position(), Camera::get_main_camera()->get_position(),
+                                                           8.0f);
                 m_has_splashed = true;
             }
             if (entity->transform->get_position().y <= desired_height - 5.0f)
@@ -226,8 +229,8 @@ void Customer::draw_editor()
 void Customer::feed(glm::vec3 const& destination)
 {
     set_destination(destination);
-    auto squeal = Sound::play_sound_at_location("./res/audio/penguin/happy/phappy" + std::to_string(std::rand() % 6 + 1) + ".wav",
-                                                entity->transform->get_position(), Camera::get_main_camera()->get_position());
+    SoundPool::get_instance().play_at_location(m_happy_sounds[std::rand() % m_happy_sounds.size()], entity->transform->get_position(),
+                                               Camera::get_main_camera()->get_position());
     m_is_fed = true;
     m_is_waiting_to_jump_to_water = true;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Component.h"
+#include "SoundPool.h"
 
 #include "AK/Badge.h"
 
@@ -62,4 +63,8 @@ private:
     inline static float constexpr m_max_jump_velocity = 3.0f;
 
     inline static float constexpr m_max_left_arm_spread = 50.0f;
+
+    std::vector<std::shared_ptr<AudioClip>> m_neutral_sounds = {};
+    std::vector<std::shared_ptr<AudioClip>> m_splash_sounds = {};
+    std::vector<std::shared_ptr<AudioClip>> m_happy_sounds = {};
 };
@@ -85,7 +85,7 @@ void GameController::awake()
 
     reset_level();
 
-    Sound::play_sound("./res/audio/ost_loop.wav", true);
+    Sound::play_music("./res/audio/ost_loop.wav");
     auto const wind_sound = Sound::play_sound("./res/audio/wind.mp3", true);
     wind_sound->set_volume(0.5f);
 
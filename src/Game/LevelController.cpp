@@ -9,6 +9,7 @@
 #include "Globals.h"
 #include "Input.h"
 #include "Player.h"
+#include "RendererDX11.h"
 #include "SceneSerializer.h"
 #include "ScreenText.h"
 #include "Ship.h"
@@ -31,6 +31,8 @@ Lighthouse::Lighthouse(AK::Badge<Lighthouse>)
 void Lighthouse::awake()
 {
     set_can_tick(true);
+
+    m_enter_sound = SoundPool::get_instance().load_clip("./res/audio/pickup/enter_latarnia.wav");
 }
 
 void Lighthouse::update()
@@ -95,9 +97,8 @@ void Lighthouse::enter()
 
     LevelController::get_instance()->check_tutorial_progress(TutorialProgressAction::KeeperEnteredLighthouse);
 
-    auto const enter_sound = Sound::play_sound_at_location("./res/audio/pickup/enter_latarnia.wav", entity->transform->get_position(),
-                                                           Camera::get_main_camera()->get_position());
-    enter_sound->set_volume(15.0f);
+    SoundPool::get_instance().play_at_location(m_enter_sound, entity->transform->get_position(), Camera::get_main_camera()->get_position(),
+                                               15.0f);
 }
 
 void Lighthouse::exit()
@@ -135,9 +136,8 @@ void Lighthouse::exit()
 
     LevelController::get_instance()->check_tutorial_progress(TutorialProgressAction::KeeperLeftLighthouse);
 
-    auto const exit_sound = Sound::play_sound_at_location("./res/audio/pickup/enter_latarnia.wav", entity->transform->get_position(),
-                                                          Camera::get_main_camera()->get_position());
-    exit_sound->set_volume(15.0f);
+    SoundPool::get_instance().play_at_location(m_enter_sound, entity->transform->get_position(), Camera::get_main_camera()->get_position(),
+                                               15.0f);
 }
 
 void Lighthouse::spawn_hovercraft()
@@ -2,6 +2,7 @@
 
 #include "AK/Badge.h"
 #include "Component.h"
+#include "SoundPool.h"
 #include "Water.h"
 
 class Transform;
@@ -51,4 +52,6 @@ private:
     std::weak_ptr<Entity> m_keeper = {};
     bool m_is_keeeper_inside = true;
     bool m_has_keeper_entered_this_frame = false;
+
+    std::shared_ptr<AudioClip> m_enter_sound = {};
 };
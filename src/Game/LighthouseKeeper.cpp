@@ -45,6 +45,11 @@ void LighthouseKeeper::awake()
         add_package();
     }
     set_can_tick(true);
+
+    m_generator_sound = SoundPool::get_instance().load_clip("./res/audio/generator.wav");
+    m_workshop_sound = SoundPool::get_instance().load_clip("./res/audio/warsztat.wav");
+    m_pickup_sounds = SoundPool::get_instance().load_clips("./res/audio/pickup/paczka", 2);
+
     m_engine_sound = Sound::play_sound_at_location("./res/audio/poduszkowiec.wav", entity->transform->get_position(),
                                                    Camera::get_main_camera()->get_position(), false);
     m_engine_sound->set_volume(2.0f);
@@ -348,17 +353,15 @@ void LighthouseKeeper::handle_input()
                     remove_package();
                     if (closest_factory->type == FactoryType::Generator)
                     {
-                        auto const generator_sound = Sound::play_sound_at_location(
-                            "./res/audio/generator.wav", entity->transform->get_position(), Camera::get_main_camera()->get_position());
-                        generator_sound->set_volume(50.0f);
-                        generator_sound->stop_with_fade(1500);
+                        auto const generator_sound = SoundPool::get_instance().play_at_location(
+                            m_generator_sound, entity->transform->get_position(), Camera::get_main_camera()->get_position(), 50.0f);
+                        generator_sound.stop_with_fade(1500);
                     }
                     else if (closest_factory->type == FactoryType::Workshop)
                     {
-                        auto const workshop_sound = Sound::play_sound_at_location(
-                            "./res/audio/warsztat.wav", entity->transform->get_position(), Camera::get_main_camera()->get_position());
-                        workshop_sound->set_volume(30.0f);
-                        workshop_sound->stop_with_fade(1500);
+                        auto const workshop_sound = SoundPool::get_instance().play_at_location(
+                            m_workshop_sound, entity->transform->get_position(), Camera::get_main_camera()->get_position(), 30.0f);
+                        workshop_sound.stop_with_fade(1500);
                     }
                     return;
                 }
@@ -404,10 +407,9 @@ void LighthouseKeeper::handle_input()
             {
                 hide_interaction_prompt(WorldPromptType::Port);
 
-                auto const pickup_sound =
-                    Sound::play_sound_at_location("./res/audio/pickup/paczka" + std::to_string(std::rand() % 2 + 1) + ".wav",
-                                                  entity->transform->get_position(), Camera::get_main_camera()->get_position());
-                pickup_sound->set_volume(15.0f);
+                SoundPool::get_instance().play_at_location(m_pickup_sounds[std::rand() % m_pickup_sounds.size()],
+                                                           entity->transform->get_position(), Camera::get_main_camera()->get_position(),
+                                                           15.0f);
 
                 if (packages.size() < Player::get_instance()->packages)
                 {
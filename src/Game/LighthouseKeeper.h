@@ -4,6 +4,7 @@
 #include "Input.h"
 #include "ParticleSystem.h"
 #include "Sound.h"
+#include "SoundPool.h"
 
 class Port;
 class Factory;
@@ -71,6 +72,9 @@ private:
     void handle_input();
 
     std::shared_ptr<Sound> m_engine_sound = nullptr;
+    std::shared_ptr<AudioClip> m_generator_sound = {};
+    std::shared_ptr<AudioClip> m_workshop_sound = {};
+    std::vector<std::shared_ptr<AudioClip>> m_pickup_sounds = {};
     bool m_is_inside_port = false;
 
     glm::vec2 m_speed = glm::vec2(0.0f, 0.0f);
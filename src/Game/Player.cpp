@@ -4,6 +4,7 @@
 #include "Globals.h"
 #include "Input.h"
 #include "LevelController.h"
+#include "RendererDX11.h"
 #include "ScreenText.h"
 #include "ShipSpawner.h"
 #include "Sound.h"
@@ -71,6 +72,8 @@ Player::Player(AK::Badge<Player>)
 void Player::awake()
 {
     set_can_tick(true);
+
+    m_flash_sound = SoundPool::get_instance().load_clip("./res/audio/flash.wav");
 }
 
 void Player::update()
@@ -136,8 +139,7 @@ void Player::update()
             }
 
             LevelController::get_instance()->entity->get_component<ShipSpawner>()->burn_out_all_ships(true);
-            auto flash_sound = Sound::play_sound("./res/audio/flash.wav");
-            flash_sound->set_volume(1.0f);
+            SoundPool::get_instance().play(m_flash_sound, 1.0f, SoundPriority::High);
         }
     }
 
@@ -2,6 +2,7 @@
 
 #include "Component.h"
 #include "Engine.h"
+#include "SoundPool.h"
 #include <ScreenText.h>
 
 class Player final : public Component
@@ -60,4 +61,6 @@ private:
     inline static std::shared_ptr<Player> m_instance;
 
     float const m_flash_time = 8.3f;
+
+    std::shared_ptr<AudioClip> m_flash_sound = {};
 };
@@ -53,6 +53,8 @@ void Ship::awake()
     set_start_direction();
     m_range_factor = ship_type_to_range_factor(type);
 
+    m_crash_sound = SoundPool::get_instance().load_clip("./res/audio/crash.wav");
+
     set_can_tick(true);
 }
 
@@ -159,9 +161,8 @@ bool Ship::destroyed_state_change()
     if (is_destroyed)
     {
         behavioral_state = BehavioralState::Destroyed;
-        auto const crash_sound = Sound::play_sound_at_location("./res/audio/crash.wav", entity->transform->get_position(),
-                                                               Camera::get_main_camera()->get_position(), false);
-        crash_sound->set_volume(0.3f);
+        SoundPool::get_instance().play_at_location(m_crash_sound, entity->transform->get_position(),
+                                                   Camera::get_main_camera()->get_position(), 0.3f, SoundPriority::High, 0.0f);
         LevelController::get_instance()->check_tutorial_progress(TutorialProgressAction::ShipDestroyed);
 
         if (type == ShipType::Pirates)
@@ -4,6 +4,7 @@
 #include "LevelController.h"
 #include "LighthouseLight.h"
 #include "ShipEyes.h"
+#include "SoundPool.h"
 
 class Floater;
 
@@ -262,4 +263,6 @@ private:
     glm::quat target_rotation_after_collision = {};
     glm::quat rotation_before_collision = {};
     i32 m_avoid_direction = 0;
+
+    std::shared_ptr<AudioClip> m_crash_sound = {};
 };
@@ -45,6 +45,8 @@ void Truther::awake()
 {
     set_can_tick(true);
 
+    m_grass_sounds = SoundPool::get_instance().load_clips("./res/audio/Komiks/siano", 8);
+
     // This is for generating wheat field
     // i32 wheat_count = 2500;
     // auto const wheat_container = Entity::create("WheatContainer");
@@ -84,7 +86,7 @@ void Truther::update()
                 i32 rand = AK::random_int(1, 8);
                 auto const dir =
                     glm::normalize(Camera::get_main_camera()->entity->transform->get_position() - entity->transform->get_position());
-                Sound::play_sound("./res/audio/Komiks/siano" + std::to_string(rand) + ".wav");
+                SoundPool::get_instance().play(m_grass_sounds[rand - 1], 1.0f, SoundPriority::Low);
                 /*Sound::play_sound_at_location("./res/audio/Komiks/siano" + std::to_string(rand) + ".wav", entity->transform->get_position(),
                                               dir, 0.7f);*/
                 m_grass_sound_timer = 0.0f;
@@ -2,6 +2,7 @@
 
 #include "Component.h"
 #include "Input.h"
+#include "SoundPool.h"
 #include "WheatOverlay.h"
 
 class Truther final : public Component
@@ -65,4 +66,6 @@ private:
     float m_last_jump_timer = 0.0f;
     bool m_do_flip = false;
     float m_grass_sound_timer = 0.0f;
+
+    std::vector<std::shared_ptr<AudioClip>> m_grass_sounds = {};
 };
@@ -0,0 +1,222 @@
+#include "GlyphAtlas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+
+// Both are also compiled by Dear ImGui, with static functions, so they are compiled here the same way
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include <imstb_rectpack.h>
+
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include <imstb_truetype.h>
+
+#include "Debug.h"
+
+std::shared_ptr<GlyphAtlas> GlyphAtlas::create(std::string const& font_path, float const pixel_size)
+{
+    std::ifstream file(font_path, std::ios::binary);
+
+    if (!file.is_open())
+    {
+        Debug::log("Font failed to load at path: " + font_path, DebugType::Error);
+        return nullptr;
+    }
+
+    std::vector<u8> font_data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    auto atlas = create(std::move(font_data), pixel_size, font_path);
+
+    if (atlas == nullptr)
+        Debug::log("Glyphs of font " + font_path + " could not be baked at size " + std::to_string(pixel_size) + ".", DebugType::Error);
+
+    return atlas;
+}
+
+std::shared_ptr<GlyphAtlas> GlyphAtlas::create(std::vector<u8>&& font_data, float const pixel_size, std::string const& font_path)
+{
+    auto atlas = std::make_shared<GlyphAtlas>(AK::Badge<GlyphAtlas> {}, std::move(font_data), pixel_size, font_path);
+
+    if (!atlas->bake())
+        return nullptr;
+
+    return atlas;
+}
+
+GlyphAtlas::GlyphAtlas(AK::Badge<GlyphAtlas>, std::vector<u8>&& font_data, float const pixel_size, std::string const& font_path)
+    : m_font_data(std::move(font_data)), m_font_info(std::make_unique<stbtt_fontinfo>()), m_font_path(font_path),
+      m_pixel_size(pixel_size)
+{
+}
+
+GlyphAtlas::~GlyphAtlas() = default;
+
+Glyph const& GlyphAtlas::get_glyph(u32 const codepoint) const
+{
+    if (auto const it = m_glyphs.find(codepoint); it != m_glyphs.end())
+        return it->second;
+
+    if (auto const it = m_glyphs.find(replacement_codepoint); it != m_glyphs.end())
+        return it->second;
+
+    static Glyph const empty_glyph = {};
+    return empty_glyph;
+}
+
+bool GlyphAtlas::has_glyph(u32 const codepoint) const
+{
+    return m_glyphs.contains(codepoint);
+}
+
+float GlyphAtlas::get_kerning(u32 const first, u32 const second) const
+{
+    return static_cast<float>(stbtt_GetCodepointKernAdvance(m_font_info.get(), static_cast<i32>(first), static_cast<i32>(second)))
+         * m_scale;
+}
+
+std::string const& GlyphAtlas::get_font_path() const
+{
+    return m_font_path;
+}
+
+float GlyphAtlas::get_pixel_size() const
+{
+    return m_pixel_size;
+}
+
+float GlyphAtlas::get_ascent() const
+{
+    return m_ascent;
+}
+
+float GlyphAtlas::get_line_height() const
+{
+    return m_line_height;
+}
+
+u32 GlyphAtlas::get_width() const
+{
+    return m_width;
+}
+
+u32 GlyphAtlas::get_height() const
+{
+    return m_height;
+}
+
+std::span<u8 const> GlyphAtlas::get_pixels() const
+{
+    return m_pixels;
+}
+
+float GlyphAtlas::round_pixel_size(float const font_size)
+{
+    return std::max(std::ceil(font_size / pixel_size_step), 1.0f) * pixel_size_step;
+}
+
+bool GlyphAtlas::bake()
+{
+    if (m_font_data.empty() || m_pixel_size <= 0.0f)
+        return false;
+
+    i32 const font_offset = stbtt_GetFontOffsetForIndex(m_font_data.data(), 0);
+    if (font_offset < 0 || stbtt_InitFont(m_font_info.get(), m_font_data.data(), font_offset) == 0)
+        return false;
+
+    // Font size is the size of the em square, same as font sizes of DirectWrite
+    m_scale = stbtt_ScaleForMappingEmToPixels(m_font_info.get(), m_pixel_size);
+
+    i32 ascent = 0;
+    i32 descent = 0;
+    i32 line_gap = 0;
+    stbtt_GetFontVMetrics(m_font_info.get(), &ascent, &descent, &line_gap);
+
+    m_ascent = static_cast<float>(ascent) * m_scale;
+    m_line_height = static_cast<float>(ascent - descent + line_gap) * m_scale;
+
+    u32 codepoint_count = 0;
+    for (auto const& [first, last] : codepoint_ranges)
+        codepoint_count += last - first;
+
+    std::vector<stbtt_packedchar> packed_chars(codepoint_count);
+    std::vector<stbtt_pack_range> ranges = {};
+    ranges.reserve(codepoint_ranges.size());
+
+    u32 first_packed_char = 0;
+    for (auto const& [first, last] : codepoint_ranges)
+    {
+        stbtt_pack_range range = {};
+        range.font_size = STBTT_POINT_SIZE(m_pixel_size);
+        range.first_unicode_codepoint_in_range = static_cast<i32>(first);
+        range.num_chars = static_cast<i32>(last - first);
+        range.chardata_for_range = packed_chars.data() + first_packed_char;
+
+        ranges.emplace_back(range);
+        first_packed_char += last - first;
+    }
+
+    // Atlas grows until every glyph fits, so small fonts don't waste memory on a big texture
+    std::vector<u8> coverage = {};
+    for (u32 size = min_atlas_size; size <= max_atlas_size && m_width == 0; size *= 2)
+    {
+        coverage.assign(static_cast<size_t>(size) * size, 0);
+
+        stbtt_pack_context context = {};
+        if (stbtt_PackBegin(&context, coverage.data(), static_cast<i32>(size), static_cast<i32>(size), 0, glyph_padding, nullptr) == 0)
+            return false;
+
+        i32 const is_packed = stbtt_PackFontRanges(&context, m_font_data.data(), 0, ranges.data(), static_cast<i32>(ranges.size()));
+        stbtt_PackEnd(&context);
+
+        if (is_packed != 0)
+        {
+            m_width = size;
+            m_height = size;
+        }
+    }
+
+    if (m_width == 0)
+        return false;
+
+    float const inverse_width = 1.0f / static_cast<float>(m_width);
+    float const inverse_height = 1.0f / static_cast<float>(m_height);
+
+    first_packed_char = 0;
+    for (auto const& [first, last] : codepoint_ranges)
+    {
+        for (u32 codepoint = first; codepoint < last; ++codepoint)
+        {
+            stbtt_packedchar const& packed_char = packed_chars[first_packed_char + codepoint - first];
+
+            // Codepoints missing from the font were packed as its "missing glyph", they are drawn as the replacement instead
+            if (stbtt_FindGlyphIndex(m_font_info.get(), static_cast<i32>(codepoint)) == 0)
+                continue;
+
+            Glyph glyph = {};
+            glyph.min = {packed_char.xoff, packed_char.yoff};
+            glyph.max = {packed_char.xoff2, packed_char.yoff2};
+            glyph.uv_min = {static_cast<float>(packed_char.x0) * inverse_width, static_cast<float>(packed_char.y0) * inverse_height};
+            glyph.uv_max = {static_cast<float>(packed_char.x1) * inverse_width, static_cast<float>(packed_char.y1) * inverse_height};
+            glyph.advance = packed_char.xadvance;
+
+            m_glyphs.emplace(codepoint, glyph);
+        }
+
+        first_packed_char += last - first;
+    }
+
+    m_pixels.resize(coverage.size() * 4);
+
+    for (size_t i = 0; i < coverage.size(); ++i)
+    {
+        m_pixels[i * 4] = 255;
+        m_pixels[i * 4 + 1] = 255;
+        m_pixels[i * 4 + 2] = 255;
+        m_pixels[i * 4 + 3] = coverage[i];
+    }
+
+    return true;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "AK/Badge.h"
+#include "AK/Types.h"
+
+struct stbtt_fontinfo;
+
+// Quad of a single glyph in pixels, relative to the pen position on the baseline, with y pointing down
+struct Glyph
+{
+    glm::vec2 min = {};
+    glm::vec2 max = {};
+    glm::vec2 uv_min = {};
+    glm::vec2 uv_max = {};
+    float advance = 0.0f;
+};
+
+// Glyphs of a single font file rasterized once at a single pixel size and packed into one image. Only the font file is read,
+// so glyphs are baked and measured the same way on every platform and with every renderer.
+// Pixels are white with the coverage of glyphs in alpha, so the atlas is sampled the same way as any other UI texture.
+class GlyphAtlas
+{
+public:
+    // Reads the font file, returns nullptr if it can't be read or baked
+    [[nodiscard]] static std::shared_ptr<GlyphAtlas> create(std::string const& font_path, float const pixel_size);
+
+    // Font path is only used to identify the atlas. Doesn't log any errors, so it can be used without the rest of the engine.
+    [[nodiscard]] static std::shared_ptr<GlyphAtlas> create(std::vector<u8>&& font_data, float const pixel_size,
+                                                            std::string const& font_path);
+
+    GlyphAtlas(AK::Badge<GlyphAtlas>, std::vector<u8>&& font_data, float const pixel_size, std::string const& font_path);
+    ~GlyphAtlas();
+
+    // Glyph of the codepoint, or of the replacement character if the atlas doesn't have it
+    [[nodiscard]] Glyph const& get_glyph(u32 const codepoint) const;
+    [[nodiscard]] bool has_glyph(u32 const codepoint) const;
+
+    // Offset added to the pen position between two glyphs
+    [[nodiscard]] float get_kerning(u32 const first, u32 const second) const;
+
+    [[nodiscard]] std::string const& get_font_path() const;
+    [[nodiscard]] float get_pixel_size() const;
+
+    // Distance from the top of a line to its baseline and between baselines of two lines
+    [[nodiscard]] float get_ascent() const;
+    [[nodiscard]] float get_line_height() const;
+
+    [[nodiscard]] u32 get_width() const;
+    [[nodiscard]] u32 get_height() const;
+
+    // RGBA, first row is the top of the atlas
+    [[nodiscard]] std::span<u8 const> get_pixels() const;
+
+    // Atlases are only baked at multiples of pixel_size_step. Texts of other sizes are scaled down from the next baked size,
+    // so texts changing their size every frame don't bake a new atlas every frame.
+    [[nodiscard]] static float round_pixel_size(float const font_size);
+
+    inline static float constexpr pixel_size_step = 8.0f;
+    inline static u32 constexpr min_atlas_size = 256;
+    inline static u32 constexpr max_atlas_size = 4096;
+    inline static u32 constexpr glyph_padding = 1;
+    inline static u32 constexpr replacement_codepoint = '?';
+
+    // Printable ASCII, Latin-1 Supplement and Latin Extended-A, given as first codepoint and one past the last codepoint.
+    // Covers Polish texts of the game.
+    inline static std::array<std::pair<u32, u32>, 2> constexpr codepoint_ranges = {{{0x20, 0x7F}, {0xA0, 0x180}}};
+
+private:
+    bool bake();
+
+    std::vector<u8> m_font_data = {};
+    std::unique_ptr<stbtt_fontinfo> m_font_info;
+    std::string m_font_path = {};
+    float m_pixel_size = 0.0f;
+    float m_scale = 0.0f;
+
+    float m_ascent = 0.0f;
+    float m_line_height = 0.0f;
+
+    std::unordered_map<u32, Glyph> m_glyphs = {};
+
+    u32 m_width = 0;
+    u32 m_height = 0;
+    std::vector<u8> m_pixels = {};
+};
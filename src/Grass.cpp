@@ -11,18 +11,7 @@
 
 std::shared_ptr<Grass> Grass::create()
 {
-    auto grass = std::make_shared<Grass>(AK::Badge<Grass> {}, default_material);
-    grass->prepare();
-
-    return grass;
-}
-
-std::shared_ptr<Grass> Grass::create(std::shared_ptr<Material> const& material)
-{
-    auto grass = std::make_shared<Grass>(AK::Badge<Grass> {}, material);
-    grass->prepare();
-
-    return grass;
+    return std::make_shared<Grass>(AK::Badge<Grass> {}, default_material);
 }
 
 std::shared_ptr<Grass> Grass::create(std::shared_ptr<Material> const& material, std::string const& diffuse_texture_path)
@@ -33,27 +22,19 @@ std::shared_ptr<Grass> Grass::create(std::shared_ptr<Material> const& material,
     return grass;
 }
 
-Grass::Grass(AK::Badge<Grass>, std::shared_ptr<Material> const& material) : Model(material)
+Grass::Grass(AK::Badge<Grass>, std::shared_ptr<Material> const& material) : FoliageScatter(material)
 {
     m_draw_type = DrawType::Triangles;
 }
 
 Grass::Grass(AK::Badge<Grass>, std::shared_ptr<Material> const& material, std::string const& diffuse_texture_path)
-    : Model(material), m_diffuse_texture_path(diffuse_texture_path)
+    : FoliageScatter(material), diffuse_texture_path(diffuse_texture_path)
 {
     m_draw_type = DrawType::Triangles;
 }
 
-void Grass::prepare()
+void Grass::prepare_meshes()
 {
-    if (material->is_gpu_instanced)
-    {
-        if (material->first_drawable != nullptr)
-            return;
-
-        material->first_drawable = std::dynamic_pointer_cast<Drawable>(shared_from_this());
-    }
-
     m_meshes.emplace_back(create_blade());
 }
 
@@ -75,20 +56,22 @@ std::shared_ptr<Mesh> Grass::create_blade() const
     texture_settings.wrap_mode_x = TextureWrapMode::ClampToEdge;
     texture_settings.wrap_mode_y = TextureWrapMode::ClampToEdge;
 
-    if (!m_diffuse_texture_path.empty())
+    if (!diffuse_texture_path.empty())
         diffuse_maps.emplace_back(
-            ResourceManager::get_instance().load_texture(m_diffuse_texture_path, TextureType::Diffuse, texture_settings));
+            ResourceManager::get_instance().load_texture(diffuse_texture_path, TextureType::Diffuse, texture_settings));
 
     textures.insert(textures.end(), diffuse_maps.begin(), diffuse_maps.end());
 
-    return ResourceManager::get_instance().load_mesh(m_meshes.size(), m_diffuse_texture_path, vertices, indices, textures, m_draw_type,
+    return ResourceManager::get_instance().load_mesh(m_meshes.size(), diffuse_texture_path, vertices, indices, textures, m_draw_type,
                                                      material);
 }
 
 #if EDITOR
 void Grass::draw_editor()
 {
-    Model::draw_editor();
+    FoliageScatter::draw_editor();
 
+    if (string_draw_editor("Diffuse Texture Path: ", diffuse_texture_path))
+        reprepare();
 }
 #endif
@@ -1,10 +1,10 @@
 #pragma once
 
 #include "AK/Badge.h"
-#include "Model.h"
+#include "FoliageScatter.h"
 
-NON_SERIALIZED
-class Grass final : public Model
+// Grass blades scattered over an area, every blade is a single textured quad instead of a model
+class Grass final : public FoliageScatter
 {
 public:
 #if EDITOR
@@ -12,16 +12,16 @@ public:
 #endif
 
     static std::shared_ptr<Grass> create();
-    static std::shared_ptr<Grass> create(std::shared_ptr<Material> const& material);
     static std::shared_ptr<Grass> create(std::shared_ptr<Material> const& material, std::string const& diffuse_texture_path = "");
 
     explicit Grass(AK::Badge<Grass>, std::shared_ptr<Material> const& material);
     explicit Grass(AK::Badge<Grass>, std::shared_ptr<Material> const& material, std::string const& diffuse_texture_path);
 
-    virtual void prepare() override;
+    std::string diffuse_texture_path = "";
 
-private:
-    std::string m_diffuse_texture_path;
+protected:
+    virtual void prepare_meshes() override;
 
+private:
     [[nodiscard]] std::shared_ptr<Mesh> create_blade() const;
 };
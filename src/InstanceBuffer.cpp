@@ -0,0 +1,31 @@
+#include "InstanceBuffer.h"
+
+#include <utility>
+
+#include "InstanceBufferDX11.h"
+#include "InstanceBufferGL.h"
+#include "Renderer.h"
+
+std::shared_ptr<InstanceBuffer> InstanceBuffer::create(std::span<glm::mat4 const> const model_matrices)
+{
+    switch (Renderer::renderer_api)
+    {
+    case Renderer::RendererApi::OpenGL:
+        return std::make_shared<InstanceBufferGL>(AK::Badge<InstanceBuffer> {}, model_matrices);
+
+    case Renderer::RendererApi::DirectX11:
+        return std::make_shared<InstanceBufferDX11>(AK::Badge<InstanceBuffer> {}, model_matrices);
+
+    default:
+        std::unreachable();
+    }
+}
+
+InstanceBuffer::InstanceBuffer(u32 const instance_count) : m_instance_count(instance_count)
+{
+}
+
+u32 InstanceBuffer::get_instance_count() const
+{
+    return m_instance_count;
+}
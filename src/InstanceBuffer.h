@@ -0,0 +1,29 @@
+#pragma once
+
+#include <memory>
+#include <span>
+
+#include <glm/mat4x4.hpp>
+
+#include "AK/Badge.h"
+#include "AK/Types.h"
+
+// Model matrices of instances uploaded once, for drawables drawing many instances of their meshes by themselves in draw(),
+// without going through instance batches of their material. Instanced draws issued after bind() read model matrices
+// from this buffer, until the renderer binds instances of the next object.
+class InstanceBuffer
+{
+public:
+    [[nodiscard]] static std::shared_ptr<InstanceBuffer> create(std::span<glm::mat4 const> const model_matrices);
+
+    virtual ~InstanceBuffer() = default;
+
+    virtual void bind() const = 0;
+
+    [[nodiscard]] u32 get_instance_count() const;
+
+protected:
+    explicit InstanceBuffer(u32 const instance_count);
+
+    u32 m_instance_count = 0;
+};
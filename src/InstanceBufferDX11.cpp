@@ -0,0 +1,48 @@
+#include "InstanceBufferDX11.h"
+
+#include <cassert>
+
+#include "RendererDX11.h"
+
+InstanceBufferDX11::InstanceBufferDX11(AK::Badge<InstanceBuffer>, std::span<glm::mat4 const> const model_matrices)
+    : InstanceBuffer(static_cast<u32>(model_matrices.size()))
+{
+    auto const device = RendererDX11::get_instance_dx11()->get_device();
+
+    // Instances never change, unlike the shared instance buffer of the renderer rewritten for every draw
+    D3D11_BUFFER_DESC buffer_desc = {};
+    buffer_desc.Usage = D3D11_USAGE_IMMUTABLE;
+    buffer_desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    buffer_desc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    buffer_desc.ByteWidth = static_cast<u32>(model_matrices.size_bytes());
+    buffer_desc.StructureByteStride = sizeof(glm::mat4);
+
+    D3D11_SUBRESOURCE_DATA buffer_data = {};
+    buffer_data.pSysMem = model_matrices.data();
+
+    HRESULT hr = device->CreateBuffer(&buffer_desc, &buffer_data, &m_buffer);
+    assert(SUCCEEDED(hr));
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srv_desc = {};
+    srv_desc.Format = DXGI_FORMAT_UNKNOWN;
+    srv_desc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+    srv_desc.Buffer.FirstElement = 0;
+    srv_desc.Buffer.NumElements = m_instance_count;
+
+    hr = device->CreateShaderResourceView(m_buffer, &srv_desc, &m_shader_resource_view);
+    assert(SUCCEEDED(hr));
+}
+
+InstanceBufferDX11::~InstanceBufferDX11()
+{
+    if (m_shader_resource_view)
+        m_shader_resource_view->Release();
+
+    if (m_buffer)
+        m_buffer->Release();
+}
+
+void InstanceBufferDX11::bind() const
+{
+    RendererDX11::get_instance_dx11()->bind_instances(m_shader_resource_view);
+}
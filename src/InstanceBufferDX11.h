@@ -0,0 +1,18 @@
+#pragma once
+
+#include <d3d11.h>
+
+#include "InstanceBuffer.h"
+
+class InstanceBufferDX11 final : public InstanceBuffer
+{
+public:
+    InstanceBufferDX11(AK::Badge<InstanceBuffer>, std::span<glm::mat4 const> const model_matrices);
+    ~InstanceBufferDX11() override;
+
+    virtual void bind() const override;
+
+private:
+    ID3D11Buffer* m_buffer = nullptr;
+    ID3D11ShaderResourceView* m_shader_resource_view = nullptr;
+};
@@ -0,0 +1,38 @@
+#include "InstanceBufferGL.h"
+
+#include <numeric>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "ConstantBufferTypes.h"
+
+InstanceBufferGL::InstanceBufferGL(AK::Badge<InstanceBuffer>, std::span<glm::mat4 const> const model_matrices)
+    : InstanceBuffer(static_cast<u32>(model_matrices.size()))
+{
+    std::vector<u32> indices(model_matrices.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    glGenBuffers(1, &m_models_buffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_models_buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(model_matrices.size_bytes()), model_matrices.data(), GL_STATIC_DRAW);
+
+    glGenBuffers(1, &m_indices_buffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_indices_buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(u32)), indices.data(), GL_STATIC_DRAW);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+InstanceBufferGL::~InstanceBufferGL()
+{
+    glDeleteBuffers(1, &m_models_buffer);
+    glDeleteBuffers(1, &m_indices_buffer);
+}
+
+void InstanceBufferGL::bind() const
+{
+    // Renderer rebinds its own buffers before culling instanced materials, so these bindings don't have to be restored
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, static_cast<u32>(StorageBufferBinding::Models), m_models_buffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, static_cast<u32>(StorageBufferBinding::VisibleInstances), m_indices_buffer);
+}
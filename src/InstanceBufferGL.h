@@ -0,0 +1,18 @@
+#pragma once
+
+#include "InstanceBuffer.h"
+
+class InstanceBufferGL final : public InstanceBuffer
+{
+public:
+    InstanceBufferGL(AK::Badge<InstanceBuffer>, std::span<glm::mat4 const> const model_matrices);
+    ~InstanceBufferGL() override;
+
+    virtual void bind() const override;
+
+private:
+    u32 m_models_buffer = 0;
+
+    // Instanced vertex shaders read model matrices through indices of visible instances, which are all of them here
+    u32 m_indices_buffer = 0;
+};
@@ -31,6 +31,8 @@ void Cow::awake()
     set_can_tick(true);
 
     m_collider = entity->get_component<Collider2D>();
+
+    m_moo_sounds = SoundPool::get_instance().load_clips("./res/audio/Komiks/krowa", 8);
 }
 
 void Cow::start()
@@ -231,8 +233,7 @@ void Cow::play_sound_per_chance(float const chance) const
     if (glm::linearRand(0.0f, 1.0f) < chance)
     {
         i32 rand = AK::random_int(1, 8);
-        auto sound = Sound::play_sound("./res/audio/Komiks/krowa" + std::to_string(rand) + ".wav");
-        sound->set_volume(1.6f);
+        SoundPool::get_instance().play(m_moo_sounds[rand - 1], 1.6f, SoundPriority::Low);
     }
 }
 
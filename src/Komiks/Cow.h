@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Component.h"
+#include "SoundPool.h"
 
 #include "AK/Badge.h"
 
@@ -42,4 +43,6 @@ private:
     float m_velocity = 0.0f;
     float m_stopped_timer = 0.0f;
     glm::vec2 m_time_to_stop_range = {5.0f, 15.0f};
+
+    std::vector<std::shared_ptr<AudioClip>> m_moo_sounds = {};
 };
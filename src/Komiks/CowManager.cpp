@@ -77,7 +77,7 @@ void CowManager::awake()
 
 void CowManager::start()
 {
-    auto const sound = Sound::play_sound("./res/audio/Komiks/foliarzostpropozycja3.mp3", true);
+    Sound::play_music("./res/audio/Komiks/foliarzostpropozycja3.mp3");
 
     get_spawn_paths();
 
@@ -1,6 +1,7 @@
 #include "Light.h"
 
 #include "Renderer.h"
+#include "RendererDX11.h"
 
 #if EDITOR
 #include <imgui.h>
@@ -90,6 +91,22 @@ void Light::on_destroyed()
         m_shadow_texture->Release();
         m_shadow_texture = nullptr;
     }
+
+    for (auto const& static_shadow_depth_stencil_view : m_static_shadow_depth_stencil_views)
+    {
+        static_shadow_depth_stencil_view->Release();
+    }
+
+    m_static_shadow_depth_stencil_views.clear();
+
+    if (m_static_shadow_texture != nullptr)
+    {
+        m_static_shadow_texture->Release();
+        m_static_shadow_texture = nullptr;
+    }
+
+    m_is_shadow_map_cached = false;
+    m_is_static_shadow_map_cached = false;
 }
 
 ID3D11ShaderResourceView* const* Light::get_shadow_shader_resource_view_address() const
@@ -101,3 +118,52 @@ ID3D11ShaderResourceView* Light::get_shadow_shader_resource_view() const
 {
     return m_shadow_shader_resource_view;
 }
+
+void Light::set_render_target_for_static_shadow_mapping(u32 const face_index) const
+{
+    auto const renderer = RendererDX11::get_instance_dx11();
+    renderer->get_device_context()->OMSetRenderTargets(1, &renderer->g_emptyRenderTargetView,
+                                                       m_static_shadow_depth_stencil_views[face_index]);
+    renderer->get_device_context()->ClearDepthStencilView(m_static_shadow_depth_stencil_views[face_index], D3D11_CLEAR_DEPTH, 1.0f, 0);
+}
+
+void Light::restore_static_shadow_map() const
+{
+    auto const renderer = RendererDX11::get_instance_dx11();
+
+    // Shadow map can't be bound as a render target while being copied to
+    renderer->get_device_context()->OMSetRenderTargets(0, nullptr, nullptr);
+    renderer->get_device_context()->CopyResource(m_shadow_texture, m_static_shadow_texture);
+}
+
+void Light::set_up_static_shadow_map(D3D11_TEXTURE2D_DESC const& texture_desc, D3D11_DEPTH_STENCIL_VIEW_DESC const& depth_stencil_view_desc)
+{
+    auto const renderer = RendererDX11::get_instance_dx11();
+
+    // CopyResource() requires both textures to have identical descriptions
+    HRESULT hr = renderer->get_device()->CreateTexture2D(&texture_desc, nullptr, &m_static_shadow_texture);
+    assert(SUCCEEDED(hr));
+
+    u32 const view_count = depth_stencil_view_desc.ViewDimension == D3D11_DSV_DIMENSION_TEXTURE2DARRAY ? texture_desc.ArraySize : 1;
+
+    for (u32 i = 0; i < view_count; i++)
+    {
+        D3D11_DEPTH_STENCIL_VIEW_DESC static_depth_stencil_view_desc = depth_stencil_view_desc;
+
+        if (depth_stencil_view_desc.ViewDimension == D3D11_DSV_DIMENSION_TEXTURE2DARRAY)
+        {
+            static_depth_stencil_view_desc.Texture2DArray.FirstArraySlice = i;
+            static_depth_stencil_view_desc.Texture2DArray.ArraySize = 1;
+        }
+
+        ID3D11DepthStencilView* static_shadow_depth_stencil_view = nullptr;
+        hr = renderer->get_device()->CreateDepthStencilView(m_static_shadow_texture, &static_depth_stencil_view_desc,
+                                                            &static_shadow_depth_stencil_view);
+        assert(SUCCEEDED(hr));
+
+        m_static_shadow_depth_stencil_views.emplace_back(static_shadow_depth_stencil_view);
+    }
+
+    m_is_shadow_map_cached = false;
+    m_is_static_shadow_map_cached = false;
+}
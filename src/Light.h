@@ -3,6 +3,9 @@
 #include "AK/Types.h"
 #include "Component.h"
 
+#include <array>
+#include <vector>
+
 #include <d3d11.h>
 
 #include <glm/glm.hpp>
@@ -33,6 +36,11 @@ public:
     ID3D11ShaderResourceView* const* get_shadow_shader_resource_view_address() const;
     ID3D11ShaderResourceView* get_shadow_shader_resource_view() const;
 
+    // Static shadow casters are rendered into a separate cached depth map, which is copied into the shadow map before
+    // the dynamic casters are rendered on top of it.
+    void set_render_target_for_static_shadow_mapping(u32 const face_index = 0) const;
+    void restore_static_shadow_map() const;
+
     CUSTOM_EDITOR
     glm::vec3 ambient = glm::vec3(0.2f, 0.2f, 0.2f);
     CUSTOM_EDITOR
@@ -57,8 +65,22 @@ public:
 protected:
     Light() = default;
 
+    // Has to be called by set_up_shadow_mapping() with descriptions used for the shadow map itself
+    void set_up_static_shadow_map(D3D11_TEXTURE2D_DESC const& texture_desc, D3D11_DEPTH_STENCIL_VIEW_DESC const& depth_stencil_view_desc);
+
     bool m_planes_changed = true;
     glm::mat4 m_last_model_matrix = {};
     ID3D11Texture2D* m_shadow_texture = nullptr;
     ID3D11ShaderResourceView* m_shadow_shader_resource_view = nullptr;
+
+private:
+    ID3D11Texture2D* m_static_shadow_texture = nullptr;
+    std::vector<ID3D11DepthStencilView*> m_static_shadow_depth_stencil_views = {};
+
+    // Shadow map caching state, managed by the renderer
+    std::array<glm::mat4, 6> m_cached_projection_views = {};
+    bool m_is_shadow_map_cached = false;
+    bool m_is_static_shadow_map_cached = false;
+
+    friend class RendererDX11;
 };
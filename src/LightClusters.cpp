@@ -0,0 +1,222 @@
+#include "LightClusters.h"
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cmath>
+#include <limits>
+
+#include <glm/glm.hpp>
+
+void LightClusters::set_projection(glm::mat4 const& projection, float const near_plane, float const far_plane)
+{
+    if (projection == m_projection && near_plane == m_near_plane && far_plane == m_far_plane && !m_clusters.empty())
+        return;
+
+    m_projection = projection;
+    m_near_plane = near_plane;
+    m_far_plane = far_plane;
+
+    float const log_depth_ratio = std::log(far_plane / near_plane);
+    m_depth_scale = static_cast<float>(depth_slices) / log_depth_ratio;
+    m_depth_bias = -static_cast<float>(depth_slices) * std::log(near_plane) / log_depth_ratio;
+
+    m_cluster_min.resize(cluster_count);
+    m_cluster_max.resize(cluster_count);
+    m_clusters.resize(entry_count);
+
+    glm::mat4 const inverse_projection = glm::inverse(projection);
+
+    // Direction from the camera through a point on the screen, scaled so that its view space depth is 1
+    auto const get_ray = [&inverse_projection](float const ndc_x, float const ndc_y) {
+        glm::vec4 const point = inverse_projection * glm::vec4(ndc_x, ndc_y, -1.0f, 1.0f);
+        glm::vec3 const view_point = glm::vec3(point) / point.w;
+        return view_point / -view_point.z;
+    };
+
+    for (u32 y = 0; y < tiles_y; ++y)
+    {
+        for (u32 x = 0; x < tiles_x; ++x)
+        {
+            float const ndc_min_x = -1.0f + 2.0f * static_cast<float>(x) / static_cast<float>(tiles_x);
+            float const ndc_max_x = -1.0f + 2.0f * static_cast<float>(x + 1) / static_cast<float>(tiles_x);
+            float const ndc_min_y = -1.0f + 2.0f * static_cast<float>(y) / static_cast<float>(tiles_y);
+            float const ndc_max_y = -1.0f + 2.0f * static_cast<float>(y + 1) / static_cast<float>(tiles_y);
+
+            std::array const rays = {get_ray(ndc_min_x, ndc_min_y), get_ray(ndc_max_x, ndc_min_y), get_ray(ndc_min_x, ndc_max_y),
+                                     get_ray(ndc_max_x, ndc_max_y)};
+
+            for (u32 slice = 0; slice < depth_slices; ++slice)
+            {
+                float const slice_near = near_plane * std::pow(far_plane / near_plane, static_cast<float>(slice) / depth_slices);
+                float const slice_far = near_plane * std::pow(far_plane / near_plane, static_cast<float>(slice + 1) / depth_slices);
+
+                glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+                glm::vec3 max = glm::vec3(std::numeric_limits<float>::lowest());
+
+                for (auto const& ray : rays)
+                {
+                    min = glm::min(min, glm::min(ray * slice_near, ray * slice_far));
+                    max = glm::max(max, glm::max(ray * slice_near, ray * slice_far));
+                }
+
+                u32 const index = get_cluster_index(x, y, slice);
+                m_cluster_min[index] = min;
+                m_cluster_max[index] = max;
+            }
+        }
+    }
+}
+
+void LightClusters::assign(glm::mat4 const& view, std::span<ClusterLight const> point_lights, std::span<ClusterLight const> spot_lights)
+{
+    m_point_light_counts.assign(entry_count, 0);
+    m_spot_light_counts.assign(entry_count, 0);
+    m_point_light_assignments.clear();
+    m_spot_light_assignments.clear();
+
+    assign_lights(view, point_lights, m_point_light_counts, m_point_light_assignments, m_point_light_visibility);
+    assign_lights(view, spot_lights, m_spot_light_counts, m_spot_light_assignments, m_spot_light_visibility);
+
+    // Prefix sum over the counts gives each cluster and tile a contiguous range of the index list
+    u32 offset = 0;
+    for (u32 i = 0; i < entry_count; ++i)
+    {
+        m_clusters[i] = {offset, m_point_light_counts[i], m_spot_light_counts[i], 0};
+        offset += m_point_light_counts[i] + m_spot_light_counts[i];
+    }
+
+    m_light_indices.resize(offset);
+
+    // Counts are reused as write cursors
+    for (u32 i = 0; i < entry_count; ++i)
+    {
+        m_point_light_counts[i] = m_clusters[i].offset;
+        m_spot_light_counts[i] = m_clusters[i].offset + m_clusters[i].point_light_count;
+    }
+
+    for (auto const& [cluster, light] : m_point_light_assignments)
+    {
+        m_light_indices[m_point_light_counts[cluster]++] = light;
+    }
+
+    for (auto const& [cluster, light] : m_spot_light_assignments)
+    {
+        m_light_indices[m_spot_light_counts[cluster]++] = light;
+    }
+}
+
+std::vector<LightCluster> const& LightClusters::get_clusters() const
+{
+    return m_clusters;
+}
+
+std::vector<u32> const& LightClusters::get_light_indices() const
+{
+    return m_light_indices;
+}
+
+bool LightClusters::is_point_light_visible(u32 const light_index) const
+{
+    return m_point_light_visibility[light_index] != 0;
+}
+
+bool LightClusters::is_spot_light_visible(u32 const light_index) const
+{
+    return m_spot_light_visibility[light_index] != 0;
+}
+
+float LightClusters::get_depth_scale() const
+{
+    return m_depth_scale;
+}
+
+float LightClusters::get_depth_bias() const
+{
+    return m_depth_bias;
+}
+
+u32 LightClusters::get_cluster_index(u32 const x, u32 const y, u32 const slice) const
+{
+    return x + y * tiles_x + slice * tile_count;
+}
+
+u32 LightClusters::get_tile_index(u32 const x, u32 const y) const
+{
+    return cluster_count + x + y * tiles_x;
+}
+
+float LightClusters::calculate_light_range(float const constant, float const linear, float const quadratic, float const intensity,
+                                           float const threshold)
+{
+    // Solves intensity / (constant + linear * d + quadratic * d^2) = threshold for d
+    float const target = intensity / threshold - constant;
+
+    if (target <= 0.0f)
+        return 0.0f;
+
+    if (quadratic <= 0.0f)
+        return linear > 0.0f ? target / linear : std::numeric_limits<float>::max();
+
+    return (-linear + std::sqrt(linear * linear + 4.0f * quadratic * target)) / (2.0f * quadratic);
+}
+
+void LightClusters::assign_lights(glm::mat4 const& view, std::span<ClusterLight const> lights, std::vector<u32>& counts,
+                                  std::vector<glm::uvec2>& assignments, std::vector<u8>& visibility) const
+{
+    visibility.assign(lights.size(), 0);
+
+    for (u32 light_index = 0; light_index < lights.size(); ++light_index)
+    {
+        auto const& light = lights[light_index];
+        glm::vec3 const center = view * glm::vec4(light.position, 1.0f);
+        float const depth = -center.z;
+
+        // Lights without any range don't light anything
+        if (light.range <= 0.0f || depth + light.range < m_near_plane || depth - light.range > m_far_plane)
+            continue;
+
+        u32 const first_slice = get_depth_slice(std::max(depth - light.range, m_near_plane));
+        u32 const last_slice = get_depth_slice(std::min(depth + light.range, m_far_plane));
+        float const range_squared = light.range * light.range;
+
+        std::bitset<tile_count> lit_tiles = {};
+
+        for (u32 slice = first_slice; slice <= last_slice; ++slice)
+        {
+            for (u32 tile = 0; tile < tile_count; ++tile)
+            {
+                u32 const cluster = tile + slice * tile_count;
+
+                // Sphere-box test against the closest point of the cluster bounds
+                glm::vec3 const closest_point = glm::clamp(center, m_cluster_min[cluster], m_cluster_max[cluster]);
+                glm::vec3 const offset = closest_point - center;
+
+                if (glm::dot(offset, offset) > range_squared)
+                    continue;
+
+                assignments.emplace_back(cluster, light_index);
+                counts[cluster]++;
+                lit_tiles.set(tile);
+            }
+        }
+
+        // Every tile gets the light once, no matter in how many of its slices it is
+        for (u32 tile = 0; tile < tile_count; ++tile)
+        {
+            if (!lit_tiles.test(tile))
+                continue;
+
+            assignments.emplace_back(cluster_count + tile, light_index);
+            counts[cluster_count + tile]++;
+        }
+
+        visibility[light_index] = lit_tiles.any();
+    }
+}
+
+u32 LightClusters::get_depth_slice(float const depth) const
+{
+    float const slice = std::floor(std::log(depth) * m_depth_scale + m_depth_bias);
+    return static_cast<u32>(std::clamp(slice, 0.0f, static_cast<float>(depth_slices - 1)));
+}
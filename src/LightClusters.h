@@ -0,0 +1,91 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include "AK/Types.h"
+
+// Has to match LightCluster in lighting_calculations.hlsl
+struct LightCluster
+{
+    u32 offset = 0;
+    u32 point_light_count = 0;
+    u32 spot_light_count = 0;
+    u32 padding = 0;
+};
+
+// World space bounding sphere of the area lit by a light
+struct ClusterLight
+{
+    glm::vec3 position = {};
+    float range = 0.0f;
+};
+
+// Clustered light assignment. View frustum is divided into tiles in screen space and exponentially distributed depth slices,
+// every light is assigned to the clusters its bounding sphere intersects. Shaders find the cluster of a pixel and only iterate over
+// the lights in its range of the index list (point lights first, spot lights after them).
+// Clusters are followed by one entry per tile with the lights of all of its depth slices, for volumetric scattering which
+// integrates along the whole view ray instead of at a single point.
+class LightClusters
+{
+public:
+    // Recomputes view space bounds of the clusters if the projection has changed
+    void set_projection(glm::mat4 const& projection, float const near_plane, float const far_plane);
+
+    // Light indices stored in the index list are indices in the given spans
+    void assign(glm::mat4 const& view, std::span<ClusterLight const> point_lights, std::span<ClusterLight const> spot_lights);
+
+    // Clusters first, tiles after them
+    [[nodiscard]] std::vector<LightCluster> const& get_clusters() const;
+    [[nodiscard]] std::vector<u32> const& get_light_indices() const;
+
+    // Whether the light was assigned to any cluster, lights outside of the view frustum don't affect anything seen by the camera
+    [[nodiscard]] bool is_point_light_visible(u32 const light_index) const;
+    [[nodiscard]] bool is_spot_light_visible(u32 const light_index) const;
+
+    // Depth slice of a view space depth is floor(log(depth) * depth_scale + depth_bias)
+    [[nodiscard]] float get_depth_scale() const;
+    [[nodiscard]] float get_depth_bias() const;
+
+    [[nodiscard]] u32 get_cluster_index(u32 const x, u32 const y, u32 const slice) const;
+    [[nodiscard]] u32 get_tile_index(u32 const x, u32 const y) const;
+
+    // Distance at which attenuation makes the light contribute less than the given fraction of its intensity
+    [[nodiscard]] static float calculate_light_range(float const constant, float const linear, float const quadratic,
+                                                     float const intensity, float const threshold = 1.0f / 256.0f);
+
+    inline static u32 constexpr tiles_x = 16;
+    inline static u32 constexpr tiles_y = 9;
+    inline static u32 constexpr depth_slices = 24;
+    inline static u32 constexpr tile_count = tiles_x * tiles_y;
+    inline static u32 constexpr cluster_count = tile_count * depth_slices;
+    inline static u32 constexpr entry_count = cluster_count + tile_count;
+
+private:
+    void assign_lights(glm::mat4 const& view, std::span<ClusterLight const> lights, std::vector<u32>& counts,
+                       std::vector<glm::uvec2>& assignments, std::vector<u8>& visibility) const;
+    [[nodiscard]] u32 get_depth_slice(float const depth) const;
+
+    glm::mat4 m_projection = {};
+    float m_near_plane = 0.0f;
+    float m_far_plane = 0.0f;
+    float m_depth_scale = 0.0f;
+    float m_depth_bias = 0.0f;
+
+    std::vector<glm::vec3> m_cluster_min = {};
+    std::vector<glm::vec3> m_cluster_max = {};
+
+    std::vector<LightCluster> m_clusters = {};
+    std::vector<u32> m_light_indices = {};
+
+    std::vector<u32> m_point_light_counts = {};
+    std::vector<u32> m_spot_light_counts = {};
+    std::vector<glm::uvec2> m_point_light_assignments = {};
+    std::vector<glm::uvec2> m_spot_light_assignments = {};
+    std::vector<u8> m_point_light_visibility = {};
+    std::vector<u8> m_spot_light_visibility = {};
+};
@@ -1,5 +1,6 @@
 #include "Material.h"
 
+#include "Drawable.h"
 #include "Renderer.h"
 
 std::shared_ptr<Material> Material::create(std::shared_ptr<Shader> const& shader, i32 const render_order, bool const is_gpu_instanced,
@@ -32,3 +33,19 @@ i32 Material::get_render_order() const
 {
     return m_render_order;
 }
+
+bool Material::add_to_instance_batch(std::shared_ptr<Drawable> const& drawable, std::string const& key)
+{
+    for (u32 i = 0; i < instance_batches.size(); ++i)
+    {
+        if (instance_batches[i].key == key)
+        {
+            drawable->m_instance_batch = i;
+            return instance_batches[i].first_drawable == drawable;
+        }
+    }
+
+    drawable->m_instance_batch = static_cast<u32>(instance_batches.size());
+    instance_batches.push_back({key, drawable});
+    return true;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <glm/mat4x4.hpp>
@@ -13,6 +14,17 @@
 
 class Drawable;
 
+// Drawables of a GPU instanced material that share the same meshes. Every batch is drawn with a single instanced draw call
+// using the meshes of its first drawable, the other drawables don't load any meshes at all.
+struct InstanceBatch
+{
+    std::string key = {};
+    std::shared_ptr<Drawable> first_drawable = {};
+
+    // Model matrices of the instances visible in the currently rendered view
+    std::vector<glm::mat4> model_matrices = {};
+};
+
 class Material
 {
 public:
@@ -30,6 +42,10 @@ public:
 
     [[nodiscard]] i32 get_render_order() const;
 
+    // Assigns the drawable to the batch of drawables with the same meshes, identified by the key (e.g. a model path).
+    // Returns true if the drawable is the first one in its batch and has to load the meshes.
+    bool add_to_instance_batch(std::shared_ptr<Drawable> const& drawable, std::string const& key);
+
     std::shared_ptr<Shader> shader;
 
     // TODO: Expose properties directly from the shader, somehow.
@@ -54,13 +70,11 @@ public:
 
     bool is_transparent = false;
 
-    // TODO: GPU instancing on one material currently supports only the first mesh that was bound to the material.
     bool is_gpu_instanced = false;
 
     // NOTE: Only valid if is_gpu_instanced is true
-    std::vector<glm::mat4> model_matrices = {};
-    std::vector<BoundingBoxShader> bounding_boxes = {};
-    std::shared_ptr<Drawable> first_drawable = {};
+    std::vector<InstanceBatch> instance_batches = {};
+
     std::vector<std::shared_ptr<Drawable>> drawables = {};
 
 private:
@@ -1,6 +1,5 @@
 #include "Mesh.h"
 
-#include <glm/gtc/epsilon.hpp>
 #include <iostream>
 
 #include "Globals.h"
@@ -9,13 +8,11 @@
 #include "Vertex.h"
 
 Mesh::Mesh(std::vector<Vertex> const& vertices, std::vector<u32> const& indices, std::vector<std::shared_ptr<Texture>> const& textures,
-           DrawType const draw_type, std::shared_ptr<Material> const& material, DrawFunctionType const draw_function)
-    : material(material), m_vertices(vertices), m_indices(indices), m_textures(textures), m_draw_type(draw_type),
-      m_draw_function(draw_function)
-{
-}
-
-void Mesh::calculate_bounding_box()
+           DrawType const draw_type, std::shared_ptr<Material> const& material, DrawFunctionType const draw_function,
+           VertexFormat const vertex_format)
+    : material(material), m_vertices(vertices), m_indices(indices), m_textures(textures),
+      m_vertex_count(static_cast<u32>(vertices.size())), m_index_count(static_cast<u32>(indices.size())), m_draw_type(draw_type),
+      m_draw_function(draw_function), m_vertex_format(vertex_format)
 {
     if (m_vertices.empty())
         return;
@@ -44,7 +41,14 @@ void Mesh::calculate_bounding_box()
             highest_z = vertex.position.z;
     }
 
-    this->bounds = {glm::vec3(lowest_x, lowest_y, lowest_z), glm::vec3(highest_x, highest_y, highest_z)};
+    m_local_bounds = {glm::vec3(lowest_x, lowest_y, lowest_z), glm::vec3(highest_x, highest_y, highest_z)};
+    bounds = m_local_bounds;
+}
+
+void Mesh::calculate_bounding_box()
+{
+    // Vertices might have already been discarded, so we use the bounds calculated on creation
+    this->bounds = m_local_bounds;
 }
 
 void Mesh::adjust_bounding_box(glm::mat4 const& model_matrix)
@@ -57,80 +61,28 @@ BoundingBox Mesh::get_adjusted_bounding_box(glm::mat4 const& model_matrix) const
     return calculate_adjusted_bounding_box(model_matrix);
 }
 
-BoundingBox Mesh::calculate_adjusted_bounding_box(glm::mat4 const& model_matrix) const
+void Mesh::discard_cpu_data()
 {
-    // OPTIMIZATION: For uniformly scaled objects we can perform only 2 multiplications instead of a full matrix one
-    // to determine the new bounding box. This is taken from:
-    // https://stackoverflow.com/questions/6053522/how-to-recalculate-axis-aligned-bounding-box-after-translate-rotate
-    // and:
-    // https://github.com/erich666/GraphicsGems/blob/master/gems/TransBox.c
-    auto const translation = glm::vec3(model_matrix[3]);
-    glm::mat3 const rotation = model_matrix;
-    auto const scale = glm::vec3(glm::length(rotation[0]), glm::length(rotation[1]), glm::length(rotation[2]));
-    if (glm::epsilonEqual(scale.x, scale.y, 0.0001f) && glm::epsilonEqual(scale.x, scale.z, 0.0001f))
-    {
-        float min[3];
-        float max[3];
-        min[0] = max[0] = translation.x;
-        min[1] = max[1] = translation.y;
-        min[2] = max[2] = translation.z;
-
-        for (u32 i = 0; i < 3; ++i)
-        {
-            for (u32 k = 0; k < 3; ++k)
-            {
-                float a = rotation[i][k] * bounds.min[k];
-                float b = rotation[i][k] * bounds.max[k];
-                min[i] += a < b ? a : b;
-                max[i] += a < b ? b : a;
-            }
-        }
-
-        return {glm::vec3(min[0], min[1], min[2]), glm::vec3(max[0], max[1], max[2])};
-    }
-
-    // Create AABB vertices from bounds
-    std::vector<glm::vec3> aabb_vertices = {
-        bounds.min,
-        glm::vec3(bounds.min.x, bounds.min.y, bounds.max.z),
-        glm::vec3(bounds.min.x, bounds.max.y, bounds.min.z),
-        glm::vec3(bounds.min.x, bounds.max.y, bounds.max.z),
-        glm::vec3(bounds.max.x, bounds.min.y, bounds.min.z),
-        glm::vec3(bounds.max.x, bounds.min.y, bounds.max.z),
-        glm::vec3(bounds.max.x, bounds.max.y, bounds.min.z),
-        bounds.max,
-    };
-
-    // Transform AABB vertices by model matrix
-    for (auto& vertex : aabb_vertices)
-    {
-        vertex = glm::vec3(model_matrix * glm::vec4(vertex, 1.0f));
-    }
+    std::vector<Vertex>().swap(m_vertices);
+    std::vector<u32>().swap(m_indices);
+}
 
-    // Find new AABB bounds
-    float lowest_x = aabb_vertices[0].x;
-    float lowest_y = aabb_vertices[0].y;
-    float lowest_z = aabb_vertices[0].z;
-    float highest_x = aabb_vertices[0].x;
-    float highest_y = aabb_vertices[0].y;
-    float highest_z = aabb_vertices[0].z;
+bool Mesh::has_cpu_data() const
+{
+    return !m_vertices.empty() || !m_indices.empty();
+}
 
-    for (auto const& vertex : aabb_vertices)
-    {
-        if (vertex.x < lowest_x)
-            lowest_x = vertex.x;
-        if (vertex.y < lowest_y)
-            lowest_y = vertex.y;
-        if (vertex.z < lowest_z)
-            lowest_z = vertex.z;
+VertexFormat Mesh::get_vertex_format() const
+{
+    return m_vertex_format;
+}
 
-        if (vertex.x > highest_x)
-            highest_x = vertex.x;
-        if (vertex.y > highest_y)
-            highest_y = vertex.y;
-        if (vertex.z > highest_z)
-            highest_z = vertex.z;
-    }
+u32 Mesh::get_index_count() const
+{
+    return m_index_count;
+}
 
-    return {glm::vec3(lowest_x, lowest_y, lowest_z), glm::vec3(highest_x, highest_y, highest_z)};
+BoundingBox Mesh::calculate_adjusted_bounding_box(glm::mat4 const& model_matrix) const
+{
+    return m_local_bounds.transform(model_matrix);
 }
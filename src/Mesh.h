@@ -18,6 +18,9 @@ public:
     void virtual draw(u32 const size, void const* offset) const = 0;
     void virtual draw_instanced(i32 const size) const = 0;
 
+    // Draws instances with the command at the given byte offset of the bound draw indirect buffer, used by GPU culled instancing
+    void virtual draw_indirect(u64 const command_offset) const = 0;
+
     void virtual bind_textures() const = 0;
     void virtual unbind_textures() const = 0;
 
@@ -25,13 +28,21 @@ public:
     void adjust_bounding_box(glm::mat4 const& model_matrix);
     [[nodiscard]] BoundingBox get_adjusted_bounding_box(glm::mat4 const& model_matrix) const;
 
+    // Frees CPU side copies of vertices and indices. Only data already uploaded to the GPU is kept.
+    void discard_cpu_data();
+    [[nodiscard]] bool has_cpu_data() const;
+
+    [[nodiscard]] VertexFormat get_vertex_format() const;
+    [[nodiscard]] u32 get_index_count() const;
+
     BoundingBox bounds = {};
 
     std::shared_ptr<Material> material;
 
 protected:
     Mesh(std::vector<Vertex> const& vertices, std::vector<u32> const& indices, std::vector<std::shared_ptr<Texture>> const& textures,
-         DrawType const draw_type, std::shared_ptr<Material> const& material, DrawFunctionType const draw_function);
+         DrawType const draw_type, std::shared_ptr<Material> const& material, DrawFunctionType const draw_function,
+         VertexFormat const vertex_format = VertexFormat::Full);
 
     [[nodiscard]] BoundingBox calculate_adjusted_bounding_box(glm::mat4 const& model_matrix) const;
 
@@ -39,6 +50,14 @@ protected:
     std::vector<u32> m_indices;
     std::vector<std::shared_ptr<Texture>> m_textures;
 
+    // Counts are stored separately, so meshes can still be drawn after discarding their CPU data
+    u32 m_vertex_count = 0;
+    u32 m_index_count = 0;
+
+    // Bounds in mesh space, calculated once on creation
+    BoundingBox m_local_bounds = {};
+
     DrawType m_draw_type;
     DrawFunctionType m_draw_function;
+    VertexFormat m_vertex_format = VertexFormat::Full;
 };
@@ -2,15 +2,20 @@
 
 #include <array>
 #include <iostream>
+#include <utility>
 
+#include <glm/gtc/packing.hpp>
+
+#include "ConstantBufferTypes.h"
 #include "RendererDX11.h"
+#include "ShaderDX11.h"
 #include <TextureLoader.h>
 #include <TextureLoaderDX11.h>
 
 MeshDX11::MeshDX11(AK::Badge<MeshFactory>, std::vector<Vertex> const& vertices, std::vector<u32> const& indices,
                    std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type,
-                   std::shared_ptr<Material> const& material, DrawFunctionType const draw_function)
-    : Mesh(vertices, indices, textures, draw_type, material, draw_function)
+                   std::shared_ptr<Material> const& material, DrawFunctionType const draw_function, VertexFormat const vertex_format)
+    : Mesh(vertices, indices, textures, draw_type, material, draw_function, vertex_format)
 {
     switch (draw_type)
     {
@@ -45,16 +50,25 @@ MeshDX11::MeshDX11(AK::Badge<MeshFactory>, std::vector<Vertex> const& vertices,
 
     ID3D11Device* device = RendererDX11::get_instance_dx11()->get_device();
 
-    m_vertex_buffer = std::make_shared<VertexBufferDX11>(device, vertices.data(), vertices.size());
+    create_vertex_buffer(device, vertices);
+    create_mesh_constant_buffer(device);
     m_index_buffer = std::make_shared<IndexBufferDX11>(device, indices.data(), indices.size());
 }
 
 MeshDX11::MeshDX11(MeshDX11&& mesh) noexcept
-    : Mesh(mesh.m_vertices, mesh.m_indices, mesh.m_textures, mesh.m_draw_type, mesh.material, mesh.m_draw_function)
+    : Mesh(mesh.m_vertices, mesh.m_indices, mesh.m_textures, mesh.m_draw_type, mesh.material, mesh.m_draw_function, mesh.m_vertex_format)
 {
+    m_vertex_count = mesh.m_vertex_count;
+    m_index_count = mesh.m_index_count;
+    m_local_bounds = mesh.m_local_bounds;
+    bounds = mesh.bounds;
+
     m_vertex_buffer = mesh.m_vertex_buffer;
     mesh.m_vertex_buffer = nullptr;
 
+    m_constant_buffer_mesh = mesh.m_constant_buffer_mesh;
+    mesh.m_constant_buffer_mesh = nullptr;
+
     m_index_buffer = mesh.m_index_buffer;
     mesh.m_index_buffer = nullptr;
 
@@ -68,6 +82,11 @@ MeshDX11::~MeshDX11()
     m_vertices.clear();
     m_indices.clear();
 
+    if (m_constant_buffer_mesh)
+    {
+        m_constant_buffer_mesh->Release();
+    }
+
     // FIXME: Managing lifetime of models and textures should be handled in ResourceManager
     for (auto const& texture : m_textures)
     {
@@ -93,16 +112,102 @@ MeshDX11::~MeshDX11()
 void MeshDX11::draw() const
 {
     bind_textures();
+    bind_buffers();
 
+    RendererDX11::get_instance_dx11()->get_device_context()->DrawIndexed(m_index_buffer->buffer_size(), 0, 0);
+    RendererStatistics::add_draw_call(m_index_buffer->buffer_size());
+
+    unbind_textures();
+}
+
+void MeshDX11::bind_buffers() const
+{
     auto const device_context = RendererDX11::get_instance_dx11()->get_device_context();
 
+    ShaderDX11::set_vertex_format(m_vertex_format);
+    device_context->VSSetConstantBuffers(5, 1, &m_constant_buffer_mesh);
+
     u32 constexpr offset = 0;
     device_context->IASetPrimitiveTopology(m_primitive_topology);
     device_context->IASetVertexBuffers(0, 1, m_vertex_buffer->get_address_of(), m_vertex_buffer->stride_ptr(), &offset);
     device_context->IASetIndexBuffer(m_index_buffer->get(), DXGI_FORMAT_R32_UINT, 0);
-    device_context->DrawIndexed(m_index_buffer->buffer_size(), 0, 0);
+}
 
-    unbind_textures();
+void MeshDX11::create_vertex_buffer(ID3D11Device* device, std::vector<Vertex> const& vertices)
+{
+    if (m_vertex_format == VertexFormat::Packed)
+    {
+        std::vector<PackedVertex> const packed_vertices = pack_vertices(vertices, m_local_bounds);
+        m_vertex_buffer = std::make_shared<VertexBufferDX11>(device, packed_vertices.data(), packed_vertices.size(), sizeof(PackedVertex));
+        return;
+    }
+
+    m_vertex_buffer = std::make_shared<VertexBufferDX11>(device, vertices.data(), vertices.size());
+}
+
+void MeshDX11::create_mesh_constant_buffer(ID3D11Device* device)
+{
+    ConstantBufferMesh data = {};
+    data.position_offset = glm::vec3(0.0f);
+    data.position_scale = glm::vec3(1.0f);
+    data.is_vertex_packed = 0;
+
+    if (m_vertex_format == VertexFormat::Packed)
+    {
+        data.position_offset = m_local_bounds.min;
+        data.position_scale = m_local_bounds.max - m_local_bounds.min;
+        data.is_vertex_packed = 1;
+    }
+
+    D3D11_BUFFER_DESC desc = {};
+    desc.Usage = D3D11_USAGE_IMMUTABLE;
+    desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    desc.ByteWidth = static_cast<UINT>(sizeof(ConstantBufferMesh));
+
+    D3D11_SUBRESOURCE_DATA initial_data = {};
+    initial_data.pSysMem = &data;
+
+    HRESULT const hr = device->CreateBuffer(&desc, &initial_data, &m_constant_buffer_mesh);
+    assert(SUCCEEDED(hr));
+}
+
+std::vector<PackedVertex> MeshDX11::pack_vertices(std::vector<Vertex> const& vertices, BoundingBox const& bounds)
+{
+    glm::vec3 const extent = bounds.max - bounds.min;
+
+    // Flat meshes have zero extent on one of the axes, every position along that axis is then just the offset
+    glm::vec3 const inverse_extent = {extent.x > 0.0f ? 1.0f / extent.x : 0.0f, extent.y > 0.0f ? 1.0f / extent.y : 0.0f,
+                                      extent.z > 0.0f ? 1.0f / extent.z : 0.0f};
+
+    std::vector<PackedVertex> packed_vertices(vertices.size());
+
+    for (u32 i = 0; i < vertices.size(); ++i)
+    {
+        glm::vec3 const normalized_position = (vertices[i].position - bounds.min) * inverse_extent;
+
+        packed_vertices[i].position = glm::packUnorm4x16(glm::vec4(normalized_position, 0.0f));
+        packed_vertices[i].normal = glm::packSnorm2x16(encode_octahedral(vertices[i].normal));
+        packed_vertices[i].texture_coordinates = glm::packHalf2x16(vertices[i].texture_coordinates);
+    }
+
+    return packed_vertices;
+}
+
+glm::vec2 MeshDX11::encode_octahedral(glm::vec3 const& normal)
+{
+    // http://jcgt.org/published/0003/02/01/
+    float const l1_norm = glm::abs(normal.x) + glm::abs(normal.y) + glm::abs(normal.z);
+
+    if (l1_norm == 0.0f)
+        return glm::vec2(0.0f);
+
+    glm::vec3 const projected = normal / l1_norm;
+
+    if (projected.z >= 0.0f)
+        return glm::vec2(projected.x, projected.y);
+
+    glm::vec2 const sign_not_zero = {projected.x >= 0.0f ? 1.0f : -1.0f, projected.y >= 0.0f ? 1.0f : -1.0f};
+    return (1.0f - glm::abs(glm::vec2(projected.y, projected.x))) * sign_not_zero;
 }
 
 void MeshDX11::draw(u32 const size, void const* offset) const
@@ -111,6 +216,19 @@ void MeshDX11::draw(u32 const size, void const* offset) const
 
 void MeshDX11::draw_instanced(i32 const size) const
 {
+    bind_textures();
+    bind_buffers();
+
+    RendererDX11::get_instance_dx11()->get_device_context()->DrawIndexedInstanced(m_index_buffer->buffer_size(), size, 0, 0, 0);
+    RendererStatistics::add_draw_call(m_index_buffer->buffer_size(), size);
+
+    unbind_textures();
+}
+
+void MeshDX11::draw_indirect(u64 const command_offset) const
+{
+    // Instances are culled on the CPU with DirectX 11
+    std::unreachable();
 }
 
 void MeshDX11::bind_textures() const
@@ -122,6 +240,8 @@ void MeshDX11::bind_textures() const
         device_context->PSSetShaderResources(i, 1, &m_textures[i]->shader_resource_view);
         device_context->PSSetSamplers(i, 1, &m_textures[i]->image_sampler_state);
     }
+
+    RendererStatistics::add_texture_binds(static_cast<u32>(m_textures.size()));
 }
 
 void MeshDX11::unbind_textures() const
@@ -12,7 +12,7 @@ class MeshDX11 final : public Mesh
 public:
     MeshDX11(AK::Badge<MeshFactory>, std::vector<Vertex> const& vertices, std::vector<u32> const& indices,
              std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type, std::shared_ptr<Material> const& material,
-             DrawFunctionType const draw_function);
+             DrawFunctionType const draw_function, VertexFormat const vertex_format = VertexFormat::Full);
 
     MeshDX11(MeshDX11&& mesh) noexcept;
     ~MeshDX11() override;
@@ -20,13 +20,24 @@ public:
     void virtual draw() const override;
     void virtual draw(u32 const size, void const* offset) const override;
     void virtual draw_instanced(i32 const size) const override;
+    void virtual draw_indirect(u64 const command_offset) const override;
 
     void virtual bind_textures() const override;
     void virtual unbind_textures() const override;
 
 private:
+    void bind_buffers() const;
+    void create_vertex_buffer(ID3D11Device* device, std::vector<Vertex> const& vertices);
+    void create_mesh_constant_buffer(ID3D11Device* device);
+
+    [[nodiscard]] static std::vector<PackedVertex> pack_vertices(std::vector<Vertex> const& vertices, BoundingBox const& bounds);
+    [[nodiscard]] static glm::vec2 encode_octahedral(glm::vec3 const& normal);
+
     std::shared_ptr<VertexBufferDX11> m_vertex_buffer;
     std::shared_ptr<IndexBufferDX11> m_index_buffer;
 
+    // Holds the dequantization parameters for packed vertices, bound to b5 (VS)
+    ID3D11Buffer* m_constant_buffer_mesh = nullptr;
+
     D3D_PRIMITIVE_TOPOLOGY m_primitive_topology = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
 };
@@ -1,28 +1,62 @@
 #include "MeshFactory.h"
 
+#include <algorithm>
+
+#include <glm/glm.hpp>
+
 #include "MeshDX11.h"
 #include "MeshGL.h"
 #include "Renderer.h"
 
 std::shared_ptr<Mesh> MeshFactory::create(std::vector<Vertex> const& vertices, std::vector<u32> const& indices,
                                           std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type,
-                                          std::shared_ptr<Material> const& material, DrawFunctionType const draw_function)
+                                          std::shared_ptr<Material> const& material, DrawFunctionType const draw_function,
+                                          bool const cpu_access)
 {
+    std::shared_ptr<Mesh> mesh = nullptr;
+
     switch (Renderer::renderer_api)
     {
     case Renderer::RendererApi::OpenGL:
     {
-        auto mesh = std::make_shared<MeshGL>(AK::Badge<MeshFactory> {}, vertices, indices, textures, draw_type, material, draw_function);
-        return mesh;
+        mesh = std::make_shared<MeshGL>(AK::Badge<MeshFactory> {}, vertices, indices, textures, draw_type, material, draw_function);
+        break;
     }
 
     case Renderer::RendererApi::DirectX11:
     {
-        auto mesh = std::make_shared<MeshDX11>(AK::Badge<MeshFactory> {}, vertices, indices, textures, draw_type, material, draw_function);
-        return mesh;
+        VertexFormat const vertex_format = select_vertex_format(vertices, draw_type, draw_function);
+        mesh = std::make_shared<MeshDX11>(AK::Badge<MeshFactory> {}, vertices, indices, textures, draw_type, material, draw_function,
+                                          vertex_format);
+        break;
     }
 
     default:
         std::unreachable();
     }
+
+    if (discard_cpu_data && !cpu_access)
+    {
+        mesh->discard_cpu_data();
+    }
+
+    return mesh;
+}
+
+VertexFormat MeshFactory::select_vertex_format(std::vector<Vertex> const& vertices, DrawType const draw_type,
+                                               DrawFunctionType const draw_function)
+{
+    // Only regular meshes are packed. Other draw types are mostly used by procedural meshes that might rely on exact positions.
+    if (!allow_packed_vertices || vertices.empty() || draw_type != DrawType::Triangles || draw_function != DrawFunctionType::Indexed)
+        return VertexFormat::Full;
+
+    bool const texture_coordinates_fit = std::ranges::all_of(vertices, [](Vertex const& vertex) {
+        return glm::abs(vertex.texture_coordinates.x) <= max_packed_texture_coordinate
+            && glm::abs(vertex.texture_coordinates.y) <= max_packed_texture_coordinate;
+    });
+
+    if (!texture_coordinates_fit)
+        return VertexFormat::Full;
+
+    return VertexFormat::Packed;
 }
@@ -16,9 +16,21 @@ class MeshFactory
 public:
     friend class ResourceManager;
 
+    // Meshes drop their CPU side vertex and index copies after uploading them to the GPU, unless they are created with CPU access
+    inline static bool discard_cpu_data = true;
+
+    // Meshes are stored in PackedVertex format whenever it's supported and precise enough
+    inline static bool allow_packed_vertices = true;
+
 private:
     static std::shared_ptr<Mesh> create(std::vector<Vertex> const& vertices, std::vector<u32> const& indices,
                                         std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type,
                                         std::shared_ptr<Material> const& material,
-                                        DrawFunctionType const draw_function = DrawFunctionType::Indexed);
+                                        DrawFunctionType const draw_function = DrawFunctionType::Indexed, bool const cpu_access = false);
+
+    [[nodiscard]] static VertexFormat select_vertex_format(std::vector<Vertex> const& vertices, DrawType const draw_type,
+                                                          DrawFunctionType const draw_function);
+
+    // Half floats have 11 bits of precision, so texture coordinates in [-2, 2] range keep at least 1/2048 precision
+    inline static float constexpr max_packed_texture_coordinate = 2.0f;
 };
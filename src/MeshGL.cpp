@@ -4,6 +4,7 @@
 #include <iostream>
 
 #include "Globals.h"
+#include "RendererStatistics.h"
 #include "Texture.h"
 
 MeshGL::MeshGL(AK::Badge<MeshFactory>, std::vector<Vertex> const& vertices, std::vector<u32> const& indices,
@@ -80,6 +81,11 @@ MeshGL::MeshGL(AK::Badge<MeshFactory>, std::vector<Vertex> const& vertices, std:
 MeshGL::MeshGL(MeshGL&& mesh) noexcept
     : Mesh(mesh.m_vertices, mesh.m_indices, mesh.m_textures, mesh.m_draw_type, mesh.material, mesh.m_draw_function)
 {
+    m_vertex_count = mesh.m_vertex_count;
+    m_index_count = mesh.m_index_count;
+    m_local_bounds = mesh.m_local_bounds;
+    bounds = mesh.bounds;
+
     m_VAO = mesh.m_VAO;
     m_VBO = mesh.m_VBO;
     m_EBO = mesh.m_EBO;
@@ -117,9 +123,15 @@ void MeshGL::draw() const
     glBindVertexArray(m_VAO);
 
     if (m_draw_function == DrawFunctionType::NotIndexed)
-        glDrawArrays(m_draw_typeGL, 0, static_cast<i32>(m_vertices.size()));
+    {
+        glDrawArrays(m_draw_typeGL, 0, static_cast<i32>(m_vertex_count));
+        RendererStatistics::add_draw_call(static_cast<u32>(m_vertex_count));
+    }
     else
-        glDrawElements(m_draw_typeGL, static_cast<i32>(m_indices.size()), GL_UNSIGNED_INT, 0);
+    {
+        glDrawElements(m_draw_typeGL, static_cast<i32>(m_index_count), GL_UNSIGNED_INT, 0);
+        RendererStatistics::add_draw_call(static_cast<u32>(m_index_count));
+    }
 
     glBindVertexArray(0);
 
@@ -135,6 +147,7 @@ void MeshGL::draw(u32 const size, void const* offset) const
     if (m_draw_function == DrawFunctionType::Indexed)
     {
         glDrawElements(m_draw_typeGL, size, GL_UNSIGNED_INT, offset);
+        RendererStatistics::add_draw_call(size);
     }
     else
     {
@@ -152,7 +165,21 @@ void MeshGL::draw_instanced(i32 const size) const
     bind_textures();
 
     glBindVertexArray(m_VAO);
-    glDrawElementsInstanced(GL_TRIANGLES, m_indices.size(), GL_UNSIGNED_INT, (void*)0, size);
+    glDrawElementsInstanced(GL_TRIANGLES, m_index_count, GL_UNSIGNED_INT, (void*)0, size);
+    RendererStatistics::add_draw_call(static_cast<u32>(m_index_count), size);
+
+    unbind_textures();
+}
+
+void MeshGL::draw_indirect(u64 const command_offset) const
+{
+    bind_textures();
+
+    glBindVertexArray(m_VAO);
+    glDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, reinterpret_cast<void const*>(command_offset));
+
+    // Instance count is only known on the GPU, so triangles of indirect draws aren't counted
+    RendererStatistics::add_draw_call(static_cast<u32>(m_index_count), 0);
 
     unbind_textures();
 }
@@ -198,6 +225,8 @@ void MeshGL::bind_textures() const
 
         glBindTexture(GL_TEXTURE_2D, InternalMeshData::white_texture->id);
     }
+
+    RendererStatistics::add_texture_binds(m_textures.empty() ? 1 : static_cast<u32>(m_textures.size()));
 }
 
 void MeshGL::unbind_textures() const
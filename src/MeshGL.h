@@ -17,6 +17,7 @@ public:
     virtual void draw() const override;
     virtual void draw(u32 const size, void const* offset) const override;
     virtual void draw_instanced(i32 const size) const override;
+    virtual void draw_indirect(u64 const command_offset) const override;
 
     virtual void bind_textures() const override;
     virtual void unbind_textures() const override;
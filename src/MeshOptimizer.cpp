@@ -0,0 +1,463 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+
+#include "AK/AK.h"
+
+namespace
+{
+
+struct VertexHash
+{
+    size_t operator()(Vertex const& vertex) const
+    {
+        return AK::murmur_hash(reinterpret_cast<u8 const*>(&vertex), sizeof(Vertex), 0);
+    }
+};
+
+struct VertexEqual
+{
+    bool operator()(Vertex const& a, Vertex const& b) const
+    {
+        return std::memcmp(&a, &b, sizeof(Vertex)) == 0;
+    }
+};
+
+struct TriangleAdjacency
+{
+    std::vector<u32> offsets = {};
+    std::vector<u32> triangles = {};
+};
+
+TriangleAdjacency build_triangle_adjacency(std::vector<u32> const& indices, u32 const vertex_count)
+{
+    TriangleAdjacency adjacency = {};
+    adjacency.offsets.resize(vertex_count + 1, 0);
+    adjacency.triangles.resize(indices.size());
+
+    for (u32 const index : indices)
+    {
+        adjacency.offsets[index + 1]++;
+    }
+
+    std::partial_sum(adjacency.offsets.begin(), adjacency.offsets.end(), adjacency.offsets.begin());
+
+    std::vector<u32> fill = adjacency.offsets;
+    for (u32 i = 0; i < indices.size(); ++i)
+    {
+        adjacency.triangles[fill[indices[i]]++] = i / 3;
+    }
+
+    return adjacency;
+}
+
+}
+
+MeshOptimizationStatistics MeshOptimizer::optimize(std::vector<Vertex>& vertices, std::vector<u32>& indices)
+{
+    MeshOptimizationStatistics statistics = {};
+    statistics.vertex_count_before = static_cast<u32>(vertices.size());
+    statistics.triangle_count = static_cast<u32>(indices.size() / 3);
+    statistics.acmr_before = calculate_acmr(indices, static_cast<u32>(vertices.size()));
+    statistics.atvr_before = calculate_atvr(indices, static_cast<u32>(vertices.size()));
+    statistics.overfetch_before = calculate_overfetch(indices, static_cast<u32>(vertices.size()));
+
+    if (!indices.empty() && indices.size() % 3 == 0)
+    {
+        deduplicate_vertices(vertices, indices);
+        optimize_vertex_cache(indices, static_cast<u32>(vertices.size()));
+        optimize_overdraw(vertices, indices);
+        optimize_vertex_fetch(vertices, indices);
+    }
+
+    statistics.vertex_count_after = static_cast<u32>(vertices.size());
+    statistics.acmr_after = calculate_acmr(indices, static_cast<u32>(vertices.size()));
+    statistics.atvr_after = calculate_atvr(indices, static_cast<u32>(vertices.size()));
+    statistics.overfetch_after = calculate_overfetch(indices, static_cast<u32>(vertices.size()));
+
+    return statistics;
+}
+
+void MeshOptimizer::deduplicate_vertices(std::vector<Vertex>& vertices, std::vector<u32>& indices)
+{
+    std::unordered_map<Vertex, u32, VertexHash, VertexEqual> unique_vertices;
+    unique_vertices.reserve(vertices.size());
+
+    std::vector<u32> remap(vertices.size());
+    std::vector<Vertex> welded_vertices;
+    welded_vertices.reserve(vertices.size());
+
+    for (u32 i = 0; i < vertices.size(); ++i)
+    {
+        auto const [it, inserted] = unique_vertices.try_emplace(vertices[i], static_cast<u32>(welded_vertices.size()));
+
+        if (inserted)
+        {
+            welded_vertices.emplace_back(vertices[i]);
+        }
+
+        remap[i] = it->second;
+    }
+
+    for (auto& index : indices)
+    {
+        index = remap[index];
+    }
+
+    vertices = std::move(welded_vertices);
+}
+
+void MeshOptimizer::optimize_vertex_cache(std::vector<u32>& indices, u32 const vertex_count)
+{
+    u32 const triangle_count = static_cast<u32>(indices.size() / 3);
+
+    if (triangle_count == 0 || vertex_count == 0)
+        return;
+
+    TriangleAdjacency const adjacency = build_triangle_adjacency(indices, vertex_count);
+
+    // Number of not yet emitted triangles using each vertex
+    std::vector<u32> live_triangles(vertex_count);
+    for (u32 i = 0; i < vertex_count; ++i)
+    {
+        live_triangles[i] = adjacency.offsets[i + 1] - adjacency.offsets[i];
+    }
+
+    std::vector<u32> cache_timestamps(vertex_count, 0);
+    std::vector<bool> emitted_triangles(triangle_count, false);
+    std::vector<u32> dead_end_stack;
+    std::vector<u32> candidates;
+
+    std::vector<u32> result;
+    result.reserve(indices.size());
+
+    u32 timestamp = vertex_cache_size + 1;
+    u32 input_cursor = 1;
+    i64 fanning_vertex = 0;
+
+    while (fanning_vertex >= 0)
+    {
+        candidates.clear();
+
+        for (u32 i = adjacency.offsets[fanning_vertex]; i < adjacency.offsets[fanning_vertex + 1]; ++i)
+        {
+            u32 const triangle = adjacency.triangles[i];
+
+            if (emitted_triangles[triangle])
+                continue;
+
+            for (u32 k = 0; k < 3; ++k)
+            {
+                u32 const vertex = indices[triangle * 3 + k];
+
+                result.emplace_back(vertex);
+                dead_end_stack.emplace_back(vertex);
+                candidates.emplace_back(vertex);
+
+                live_triangles[vertex]--;
+
+                if (timestamp - cache_timestamps[vertex] > vertex_cache_size)
+                {
+                    cache_timestamps[vertex] = timestamp;
+                    timestamp++;
+                }
+            }
+
+            emitted_triangles[triangle] = true;
+        }
+
+        // Choose the next fanning vertex - the one which will still be in the cache after emitting all of its triangles
+        i64 best_vertex = -1;
+        i64 best_priority = -1;
+
+        for (u32 const vertex : candidates)
+        {
+            if (live_triangles[vertex] == 0)
+                continue;
+
+            i64 priority = 0;
+            if (timestamp - cache_timestamps[vertex] + 2 * live_triangles[vertex] <= vertex_cache_size)
+            {
+                priority = timestamp - cache_timestamps[vertex];
+            }
+
+            if (priority > best_priority)
+            {
+                best_priority = priority;
+                best_vertex = vertex;
+            }
+        }
+
+        // Dead end, pick any vertex that still has live triangles
+        if (best_vertex == -1)
+        {
+            while (!dead_end_stack.empty())
+            {
+                u32 const vertex = dead_end_stack.back();
+                dead_end_stack.pop_back();
+
+                if (live_triangles[vertex] > 0)
+                {
+                    best_vertex = vertex;
+                    break;
+                }
+            }
+        }
+
+        if (best_vertex == -1)
+        {
+            while (input_cursor < vertex_count)
+            {
+                if (live_triangles[input_cursor] > 0)
+                {
+                    best_vertex = input_cursor;
+                    break;
+                }
+
+                input_cursor++;
+            }
+        }
+
+        fanning_vertex = best_vertex;
+    }
+
+    indices = std::move(result);
+}
+
+void MeshOptimizer::optimize_overdraw(std::vector<Vertex> const& vertices, std::vector<u32>& indices, float const threshold)
+{
+    u32 const triangle_count = static_cast<u32>(indices.size() / 3);
+
+    if (triangle_count == 0)
+        return;
+
+    // Split the cache optimized triangle list into clusters. A new cluster starts where the cache has to be rebuilt anyway (hard
+    // boundary) or where the cluster, rendered from a cold cache, is already about as cache efficient as the whole mesh (soft
+    // boundary), so reordering the clusters costs only a little bit of vertex cache efficiency.
+    std::vector<u32> cluster_starts = {0};
+    {
+        u32 const vertex_count = static_cast<u32>(vertices.size());
+        float const mesh_acmr = calculate_acmr(indices, vertex_count);
+
+        std::vector<u32> stream_timestamps(vertex_count, 0);
+        std::vector<u32> cluster_timestamps(vertex_count, 0);
+        u32 stream_timestamp = vertex_cache_size + 1;
+        u32 cluster_timestamp = vertex_cache_size + 1;
+
+        u32 cluster_start = 0;
+        u32 cluster_misses = 0;
+
+        for (u32 triangle = 0; triangle < triangle_count; ++triangle)
+        {
+            u32 stream_misses = 0;
+            for (u32 k = 0; k < 3; ++k)
+            {
+                u32 const vertex = indices[triangle * 3 + k];
+
+                if (stream_timestamp - stream_timestamps[vertex] > vertex_cache_size)
+                {
+                    stream_timestamps[vertex] = stream_timestamp;
+                    stream_timestamp++;
+                    stream_misses++;
+                }
+            }
+
+            if (triangle != cluster_start)
+            {
+                float const cluster_acmr = static_cast<float>(cluster_misses) / static_cast<float>(triangle - cluster_start);
+                bool const hard_boundary = stream_misses == 3;
+                bool const soft_boundary = stream_misses > 0 && cluster_acmr <= mesh_acmr * threshold;
+
+                if (hard_boundary || soft_boundary)
+                {
+                    cluster_starts.emplace_back(triangle);
+                    cluster_start = triangle;
+                    cluster_misses = 0;
+
+                    // Invalidate the whole cluster cache
+                    cluster_timestamp += vertex_cache_size + 1;
+                }
+            }
+
+            for (u32 k = 0; k < 3; ++k)
+            {
+                u32 const vertex = indices[triangle * 3 + k];
+
+                if (cluster_timestamp - cluster_timestamps[vertex] > vertex_cache_size)
+                {
+                    cluster_timestamps[vertex] = cluster_timestamp;
+                    cluster_timestamp++;
+                    cluster_misses++;
+                }
+            }
+        }
+    }
+
+    u32 const cluster_count = static_cast<u32>(cluster_starts.size());
+    cluster_starts.emplace_back(triangle_count);
+
+    // Sort clusters by how much they face away from the mesh center, outward facing ones are the most likely to occlude others
+    glm::vec3 mesh_centroid = {};
+    float mesh_area = 0.0f;
+
+    std::vector<glm::vec3> cluster_centroids(cluster_count);
+    std::vector<glm::vec3> cluster_normals(cluster_count);
+
+    for (u32 cluster = 0; cluster < cluster_count; ++cluster)
+    {
+        glm::vec3 centroid = {};
+        glm::vec3 normal = {};
+        float area = 0.0f;
+
+        for (u32 triangle = cluster_starts[cluster]; triangle < cluster_starts[cluster + 1]; ++triangle)
+        {
+            glm::vec3 const a = vertices[indices[triangle * 3 + 0]].position;
+            glm::vec3 const b = vertices[indices[triangle * 3 + 1]].position;
+            glm::vec3 const c = vertices[indices[triangle * 3 + 2]].position;
+
+            glm::vec3 const cross = glm::cross(b - a, c - a);
+            float const triangle_area = glm::length(cross);
+
+            centroid += (a + b + c) * (triangle_area / 3.0f);
+            normal += cross;
+            area += triangle_area;
+        }
+
+        mesh_centroid += centroid;
+        mesh_area += area;
+
+        cluster_centroids[cluster] = area > 0.0f ? centroid / area : centroid;
+        cluster_normals[cluster] = glm::length(normal) > 0.0f ? glm::normalize(normal) : normal;
+    }
+
+    if (mesh_area > 0.0f)
+    {
+        mesh_centroid /= mesh_area;
+    }
+
+    std::vector<float> cluster_sort_keys(cluster_count);
+    for (u32 cluster = 0; cluster < cluster_count; ++cluster)
+    {
+        cluster_sort_keys[cluster] = glm::dot(cluster_centroids[cluster] - mesh_centroid, cluster_normals[cluster]);
+    }
+
+    std::vector<u32> cluster_order(cluster_count);
+    std::iota(cluster_order.begin(), cluster_order.end(), 0);
+    std::ranges::stable_sort(cluster_order, [&cluster_sort_keys](u32 const a, u32 const b) {
+        return cluster_sort_keys[a] > cluster_sort_keys[b];
+    });
+
+    std::vector<u32> result;
+    result.reserve(indices.size());
+
+    for (u32 const cluster : cluster_order)
+    {
+        result.insert(result.end(), indices.begin() + cluster_starts[cluster] * 3, indices.begin() + cluster_starts[cluster + 1] * 3);
+    }
+
+    indices = std::move(result);
+}
+
+void MeshOptimizer::optimize_vertex_fetch(std::vector<Vertex>& vertices, std::vector<u32>& indices)
+{
+    u32 constexpr unused = std::numeric_limits<u32>::max();
+
+    std::vector<u32> remap(vertices.size(), unused);
+    std::vector<Vertex> ordered_vertices;
+    ordered_vertices.reserve(vertices.size());
+
+    // Vertices not referenced by any triangle are dropped
+    for (auto& index : indices)
+    {
+        if (remap[index] == unused)
+        {
+            remap[index] = static_cast<u32>(ordered_vertices.size());
+            ordered_vertices.emplace_back(vertices[index]);
+        }
+
+        index = remap[index];
+    }
+
+    vertices = std::move(ordered_vertices);
+}
+
+u32 MeshOptimizer::simulate_vertex_cache(std::vector<u32> const& indices, u32 const vertex_count, u32 const cache_size)
+{
+    std::vector<u32> cache_timestamps(vertex_count, 0);
+    u32 timestamp = cache_size + 1;
+    u32 misses = 0;
+
+    for (u32 const index : indices)
+    {
+        if (timestamp - cache_timestamps[index] > cache_size)
+        {
+            cache_timestamps[index] = timestamp;
+            timestamp++;
+            misses++;
+        }
+    }
+
+    return misses;
+}
+
+float MeshOptimizer::calculate_acmr(std::vector<u32> const& indices, u32 const vertex_count)
+{
+    if (indices.size() < 3)
+        return 0.0f;
+
+    return static_cast<float>(simulate_vertex_cache(indices, vertex_count)) / static_cast<float>(indices.size() / 3);
+}
+
+float MeshOptimizer::calculate_atvr(std::vector<u32> const& indices, u32 const vertex_count)
+{
+    if (vertex_count == 0)
+        return 0.0f;
+
+    return static_cast<float>(simulate_vertex_cache(indices, vertex_count)) / static_cast<float>(vertex_count);
+}
+
+float MeshOptimizer::calculate_overfetch(std::vector<u32> const& indices, u32 const vertex_count)
+{
+    if (vertex_count == 0)
+        return 0.0f;
+
+    u32 constexpr vertex_size = sizeof(Vertex);
+    u32 const line_count = (vertex_count * vertex_size + fetch_cache_line_size - 1) / fetch_cache_line_size;
+
+    std::vector<u32> vertex_timestamps(vertex_count, 0);
+    std::vector<u32> line_timestamps(line_count, 0);
+    u32 vertex_timestamp = vertex_cache_size + 1;
+    u32 line_timestamp = fetch_cache_line_count + 1;
+    u32 fetched_lines = 0;
+
+    for (u32 const index : indices)
+    {
+        // Vertices still in the post-transform cache aren't fetched again
+        if (vertex_timestamp - vertex_timestamps[index] <= vertex_cache_size)
+            continue;
+
+        vertex_timestamps[index] = vertex_timestamp;
+        vertex_timestamp++;
+
+        u32 const first_line = index * vertex_size / fetch_cache_line_size;
+        u32 const last_line = ((index + 1) * vertex_size - 1) / fetch_cache_line_size;
+
+        for (u32 line = first_line; line <= last_line; ++line)
+        {
+            if (line_timestamp - line_timestamps[line] > fetch_cache_line_count)
+            {
+                line_timestamps[line] = line_timestamp;
+                line_timestamp++;
+                fetched_lines++;
+            }
+        }
+    }
+
+    return static_cast<float>(fetched_lines * fetch_cache_line_size) / static_cast<float>(vertex_count * vertex_size);
+}
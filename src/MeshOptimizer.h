@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+
+#include "AK/Types.h"
+#include "Vertex.h"
+
+struct MeshOptimizationStatistics
+{
+    u32 vertex_count_before = 0;
+    u32 vertex_count_after = 0;
+    u32 triangle_count = 0;
+
+    // Average cache miss ratio - post-transform cache misses per triangle. 0.5 is the theoretical optimum, 3.0 is the worst case.
+    float acmr_before = 0.0f;
+    float acmr_after = 0.0f;
+
+    // Average transform to vertex ratio - post-transform cache misses per vertex. 1.0 is the optimum.
+    float atvr_before = 0.0f;
+    float atvr_after = 0.0f;
+
+    // Bytes read from the vertex buffer divided by its size, with vertices fetched in whole cache lines. 1.0 is the optimum.
+    float overfetch_before = 0.0f;
+    float overfetch_after = 0.0f;
+};
+
+// Import-time optimizations for indexed triangle lists. The whole pipeline runs on the CPU, so all of it (including statistics)
+// can be verified offline without a GPU.
+//
+// Stages, in the order they are applied:
+// 1. Vertex deduplication - welds binary identical vertices.
+// 2. Vertex cache optimization - "Tipsify" index reordering.
+//    https://gfx.cs.princeton.edu/pubs/Sander_2007_%3ETR/tipsy.pdf
+// 3. Overdraw optimization - splits the cache optimized triangles into clusters and sorts them so outward facing clusters come first.
+//    Same paper as above, section 4.
+// 4. Vertex fetch optimization - reorders vertices in the order of their first use.
+class MeshOptimizer
+{
+public:
+    MeshOptimizer() = delete;
+
+    static MeshOptimizationStatistics optimize(std::vector<Vertex>& vertices, std::vector<u32>& indices);
+
+    static void deduplicate_vertices(std::vector<Vertex>& vertices, std::vector<u32>& indices);
+    static void optimize_vertex_cache(std::vector<u32>& indices, u32 const vertex_count);
+    static void optimize_overdraw(std::vector<Vertex> const& vertices, std::vector<u32>& indices, float const threshold = 1.05f);
+    static void optimize_vertex_fetch(std::vector<Vertex>& vertices, std::vector<u32>& indices);
+
+    // Simulates a FIFO post-transform cache and returns the number of cache misses
+    [[nodiscard]] static u32 simulate_vertex_cache(std::vector<u32> const& indices, u32 const vertex_count,
+                                                   u32 const cache_size = vertex_cache_size);
+    [[nodiscard]] static float calculate_acmr(std::vector<u32> const& indices, u32 const vertex_count);
+    [[nodiscard]] static float calculate_atvr(std::vector<u32> const& indices, u32 const vertex_count);
+    [[nodiscard]] static float calculate_overfetch(std::vector<u32> const& indices, u32 const vertex_count);
+
+    // Post-transform cache size used both for the optimization and the statistics.
+    inline static u32 constexpr vertex_cache_size = 16;
+
+    // Memory cache used for the overfetch statistic, vertices missing the post-transform cache are read through it.
+    inline static u32 constexpr fetch_cache_line_size = 64;
+    inline static u32 constexpr fetch_cache_line_count = 64;
+};
@@ -5,6 +5,7 @@
 #include "Globals.h"
 #include "Mesh.h"
 #include "MeshFactory.h"
+#include "ModelCooker.h"
 #include "Renderer.h"
 #include "ResourceManager.h"
 #include "Texture.h"
@@ -13,10 +14,6 @@
 #include <filesystem>
 #include <iostream>
 
-#include <assimp/Importer.hpp>
-#include <assimp/postprocess.h>
-#include <assimp/scene.h>
-
 #if EDITOR
 #include <imgui.h>
 #include <imgui_stdlib.h>
@@ -101,27 +98,57 @@ void Model::calculate_bounding_box()
     for (auto const& mesh : m_meshes)
         mesh->calculate_bounding_box();
 
-    // TODO: Merge bounding boxes together
-    if (!m_meshes.empty())
-        bounds = m_meshes[0]->bounds;
+    merge_mesh_bounds();
 }
 
 void Model::adjust_bounding_box()
 {
-    // TODO: If we merge bounding boxes together, I think we can just adjust the whole model bounding box
     for (auto const& mesh : m_meshes)
         mesh->adjust_bounding_box(entity->transform->get_model_matrix());
 
-    if (!m_meshes.empty())
-        bounds = m_meshes[0]->bounds;
+    merge_mesh_bounds();
 }
 
 BoundingBox Model::get_adjusted_bounding_box(glm::mat4 const& model_matrix) const
 {
-    if (!m_meshes.empty())
-        return m_meshes[0]->get_adjusted_bounding_box(model_matrix);
+    if (m_meshes.empty())
+        return {};
+
+    BoundingBox adjusted_bounds = m_meshes[0]->get_adjusted_bounding_box(model_matrix);
 
-    return {};
+    for (u32 i = 1; i < m_meshes.size(); ++i)
+        adjusted_bounds = BoundingBox::merge(adjusted_bounds, m_meshes[i]->get_adjusted_bounding_box(model_matrix));
+
+    return adjusted_bounds;
+}
+
+bool Model::is_cullable() const
+{
+    return !m_meshes.empty();
+}
+
+void Model::merge_mesh_bounds()
+{
+    if (m_meshes.empty())
+        return;
+
+    bounds = m_meshes[0]->bounds;
+
+    for (u32 i = 1; i < m_meshes.size(); ++i)
+        bounds = BoundingBox::merge(bounds, m_meshes[i]->bounds);
+}
+
+Mesh const* Model::get_sort_mesh() const
+{
+    if (m_meshes.empty())
+        return nullptr;
+
+    return m_meshes[0].get();
+}
+
+std::span<std::shared_ptr<Mesh> const> Model::get_meshes() const
+{
+    return m_meshes;
 }
 
 Model::Model(std::shared_ptr<Material> const& material) : Drawable(material)
@@ -154,10 +181,8 @@ void Model::prepare()
 {
     if (material->is_gpu_instanced)
     {
-        if (material->first_drawable != nullptr)
+        if (!material->add_to_instance_batch(std::dynamic_pointer_cast<Drawable>(shared_from_this()), model_path))
             return;
-
-        material->first_drawable = std::dynamic_pointer_cast<Drawable>(shared_from_this());
     }
 
     load_model(model_path);
@@ -177,101 +202,43 @@ void Model::reprepare()
 
 void Model::load_model(std::string const& path)
 {
-    Assimp::Importer importer;
-    aiScene const* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_FlipUVs);
+    CookedModel cooked_model = {};
 
-    if (scene == nullptr || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || scene->mRootNode == nullptr)
-    {
-        std::cout << "Error. Failed loading a model: " << importer.GetErrorString() << "\n";
+    if (!ModelCooker::load_or_cook(path, cooked_model))
         return;
-    }
 
     std::filesystem::path const filesystem_path = path;
     m_directory = filesystem_path.parent_path().string();
 
-    proccess_node(scene->mRootNode, scene);
-}
-
-void Model::proccess_node(aiNode const* node, aiScene const* scene)
-{
-    for (u32 i = 0; i < node->mNumMeshes; ++i)
-    {
-        aiMesh const* mesh = scene->mMeshes[node->mMeshes[i]];
-        m_meshes.emplace_back(proccess_mesh(mesh, scene));
-    }
+    m_meshes.reserve(m_meshes.size() + cooked_model.meshes.size());
 
-    for (u32 i = 0; i < node->mNumChildren; ++i)
+    for (auto const& cooked_mesh : cooked_model.meshes)
     {
-        proccess_node(node->mChildren[i], scene);
+        m_meshes.emplace_back(proccess_mesh(cooked_mesh));
     }
 }
 
-std::shared_ptr<Mesh> Model::proccess_mesh(aiMesh const* mesh, aiScene const* scene)
+std::shared_ptr<Mesh> Model::proccess_mesh(CookedMesh const& cooked_mesh)
 {
-    std::vector<Vertex> vertices;
-    std::vector<u32> indices;
-    std::vector<std::shared_ptr<Texture>> textures;
+    std::vector<std::shared_ptr<Texture>> const textures = load_material_textures(cooked_mesh.textures);
 
-    for (u32 i = 0; i < mesh->mNumVertices; ++i)
-    {
-        Vertex vertex = {};
-
-        vertex.position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
-
-        if (mesh->HasNormals())
-        {
-            vertex.normal = glm::vec3(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z);
-        }
-
-        if (mesh->mTextureCoords[0] != nullptr)
-        {
-            vertex.texture_coordinates = glm::vec2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y);
-        }
-        else
-        {
-            vertex.texture_coordinates = glm::vec2(0.0f, 0.0f);
-        }
-
-        vertices.push_back(vertex);
-    }
-
-    for (u32 i = 0; i < mesh->mNumFaces; ++i)
-    {
-        aiFace const face = mesh->mFaces[i];
-        for (u32 k = 0; k < face.mNumIndices; k++)
-        {
-            indices.push_back(face.mIndices[k]);
-        }
-    }
-
-    aiMaterial const* assimp_material = scene->mMaterials[mesh->mMaterialIndex];
-
-    std::vector<std::shared_ptr<Texture>> diffuse_maps =
-        load_material_textures(assimp_material, aiTextureType_DIFFUSE, TextureType::Diffuse);
-    textures.insert(textures.end(), diffuse_maps.begin(), diffuse_maps.end());
-
-    std::vector<std::shared_ptr<Texture>> specular_maps =
-        load_material_textures(assimp_material, aiTextureType_SPECULAR, TextureType::Specular);
-    textures.insert(textures.end(), specular_maps.begin(), specular_maps.end());
-
-    return ResourceManager::get_instance().load_mesh(m_meshes.size(), model_path, vertices, indices, textures, m_draw_type, material);
+    return ResourceManager::get_instance().load_mesh(m_meshes.size(), model_path, cooked_mesh.vertices, cooked_mesh.indices, textures,
+                                                     m_draw_type, material);
 }
 
-std::vector<std::shared_ptr<Texture>> Model::load_material_textures(aiMaterial const* material, aiTextureType const type,
-                                                                    TextureType const type_name)
+std::vector<std::shared_ptr<Texture>> Model::load_material_textures(std::vector<CookedTextureReference> const& texture_references)
 {
     std::vector<std::shared_ptr<Texture>> textures;
+    textures.reserve(texture_references.size());
 
-    u32 const material_count = material->GetTextureCount(type);
-    for (u32 i = 0; i < material_count; ++i)
+    for (auto const& texture_reference : texture_references)
     {
-        aiString str;
-        material->GetTexture(type, i, &str);
+        std::string const file_path = m_directory + '/' + texture_reference.path;
 
         bool is_already_loaded = false;
         for (auto const& loaded_texture : m_loaded_textures)
         {
-            if (std::strcmp(loaded_texture->path.data(), str.C_Str()) == 0)
+            if (loaded_texture->path == file_path)
             {
                 textures.push_back(loaded_texture);
                 is_already_loaded = true;
@@ -282,16 +249,13 @@ std::vector<std::shared_ptr<Texture>> Model::load_material_textures(aiMaterial c
         if (is_already_loaded)
             continue;
 
-        auto file_path = std::string(str.C_Str());
-        file_path = m_directory + '/' + file_path;
-
         TextureSettings settings = {};
         settings.flip_vertically = false;
         settings.filtering_min = TextureFiltering::Nearest;
         settings.filtering_max = TextureFiltering::Nearest;
         settings.filtering_mipmap = TextureFiltering::Nearest;
 
-        std::shared_ptr<Texture> texture = ResourceManager::get_instance().load_texture(file_path, type_name, settings);
+        std::shared_ptr<Texture> texture = ResourceManager::get_instance().load_texture(file_path, texture_reference.type, settings);
         textures.push_back(texture);
         m_loaded_textures.push_back(texture);
     }
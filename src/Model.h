@@ -2,16 +2,12 @@
 #include <string>
 #include <vector>
 
-#include <assimp/material.h>
-
 #include "AK/Badge.h"
 #include "Mesh.h"
 #include "Texture.h"
 
-struct aiMaterial;
-struct aiMesh;
-struct aiScene;
-struct aiNode;
+struct CookedMesh;
+struct CookedTextureReference;
 
 class Model : public Drawable
 {
@@ -43,6 +39,9 @@ public:
     virtual void calculate_bounding_box() override;
     virtual void adjust_bounding_box() override;
     virtual BoundingBox get_adjusted_bounding_box(glm::mat4 const& model_matrix) const override;
+    virtual bool is_cullable() const override;
+    [[nodiscard]] virtual Mesh const* get_sort_mesh() const override;
+    [[nodiscard]] virtual std::span<std::shared_ptr<Mesh> const> get_meshes() const override;
 
     CUSTOM_EDITOR
     std::string model_path = "";
@@ -55,10 +54,9 @@ protected:
 
 private:
     void load_model(std::string const& path);
-    void proccess_node(aiNode const* node, aiScene const* scene);
-    std::shared_ptr<Mesh> proccess_mesh(aiMesh const* mesh, aiScene const* scene);
-    std::vector<std::shared_ptr<Texture>> load_material_textures(aiMaterial const* material, aiTextureType type,
-                                                                 TextureType const type_name);
+    void merge_mesh_bounds();
+    std::shared_ptr<Mesh> proccess_mesh(CookedMesh const& cooked_mesh);
+    std::vector<std::shared_ptr<Texture>> load_material_textures(std::vector<CookedTextureReference> const& texture_references);
 
     std::string m_directory;
     std::vector<std::shared_ptr<Texture>> m_loaded_textures;
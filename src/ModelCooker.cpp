@@ -0,0 +1,461 @@
+#include "ModelCooker.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <regex>
+
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include "AK/AK.h"
+#include "Debug.h"
+
+namespace
+{
+
+struct CookedModelHeader
+{
+    u32 magic = 0;
+    u32 version = 0;
+    u32 source_hash = 0;
+    u32 mesh_count = 0;
+    u64 source_size = 0;
+};
+
+struct CookedMeshHeader
+{
+    u32 vertex_count = 0;
+    u32 index_count = 0;
+    u32 texture_count = 0;
+    u32 padding = 0;
+    glm::vec3 bounds_min = {};
+    glm::vec3 bounds_max = {};
+    MeshOptimizationStatistics statistics = {};
+};
+
+// Cooked files store vertices as a raw blob, so any change to the Vertex layout has to bump the cooked format version.
+static_assert(sizeof(Vertex) == 32);
+
+class CookedReader
+{
+public:
+    explicit CookedReader(std::vector<u8> const& data) : m_data(data)
+    {
+    }
+
+    bool read(void* destination, size_t const size)
+    {
+        if (m_offset + size > m_data.size())
+            return false;
+
+        std::memcpy(destination, m_data.data() + m_offset, size);
+        m_offset += size;
+        return true;
+    }
+
+    template<typename T>
+    bool read(T& value)
+    {
+        return read(&value, sizeof(T));
+    }
+
+    [[nodiscard]] bool is_at_end() const
+    {
+        return m_offset == m_data.size();
+    }
+
+private:
+    std::vector<u8> const& m_data;
+    size_t m_offset = 0;
+};
+
+template<typename T>
+void write(std::ofstream& file, T const& value)
+{
+    file.write(reinterpret_cast<char const*>(&value), sizeof(T));
+}
+
+}
+
+bool ModelCooker::load_or_cook(std::string const& source_path, CookedModel& cooked_model)
+{
+    SourceHash source_hash = {};
+    if (!hash_source(source_path, source_hash))
+    {
+        std::cout << "Error. Failed reading a model: " << source_path << "\n";
+        return false;
+    }
+
+    std::string const cooked_path = get_cooked_path(source_path, source_hash.hash);
+
+    if (read_cooked_model(cooked_path, source_hash.hash, source_hash.size, cooked_model))
+    {
+        record_statistics(source_path, cooked_model);
+        return true;
+    }
+
+    cooked_model = {};
+    cooked_model.source_hash = source_hash.hash;
+    cooked_model.source_size = source_hash.size;
+
+    if (!cook(source_path, cooked_model))
+        return false;
+
+    // Failing to save the cooked model is not fatal, we will just cook it again next time.
+    write_cooked_model(cooked_path, cooked_model);
+
+    record_statistics(source_path, cooked_model);
+
+    return true;
+}
+
+std::vector<CookedMeshStatistics> const& ModelCooker::get_mesh_statistics()
+{
+    return m_mesh_statistics;
+}
+
+bool ModelCooker::write_statistics_csv(std::string const& path)
+{
+    std::ofstream file(path);
+
+    if (!file.is_open())
+    {
+        Debug::log(std::format("Could not open {} for writing mesh optimization statistics.", path), DebugType::Error);
+        return false;
+    }
+
+    file << "model,mesh,triangles,vertices_before,vertices_after,acmr_before,acmr_after,atvr_before,atvr_after,overfetch_before,"
+            "overfetch_after\n";
+
+    for (auto const& [source_path, mesh_index, statistics] : m_mesh_statistics)
+    {
+        file << std::format("{},{},{},{},{},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f}\n", source_path, mesh_index,
+                            statistics.triangle_count, statistics.vertex_count_before, statistics.vertex_count_after,
+                            statistics.acmr_before, statistics.acmr_after, statistics.atvr_before, statistics.atvr_after,
+                            statistics.overfetch_before, statistics.overfetch_after);
+    }
+
+    return true;
+}
+
+void ModelCooker::record_statistics(std::string const& source_path, CookedModel const& cooked_model)
+{
+    // Models loaded by many entities are reported once
+    if (std::ranges::find(m_mesh_statistics, source_path, &CookedMeshStatistics::source_path) != m_mesh_statistics.end())
+        return;
+
+    for (u32 i = 0; i < cooked_model.meshes.size(); ++i)
+    {
+        m_mesh_statistics.emplace_back(source_path, i, cooked_model.meshes[i].statistics);
+    }
+}
+
+bool ModelCooker::hash_source(std::string const& source_path, SourceHash& source_hash)
+{
+    std::error_code error_code;
+    auto const write_time = std::filesystem::last_write_time(source_path, error_code);
+
+    if (error_code)
+        return false;
+
+    // The same model is usually loaded by many entities, so we only hash it again if it changed on disk
+    if (auto const it = m_source_hashes.find(source_path); it != m_source_hashes.end() && it->second.write_time == write_time)
+    {
+        source_hash = it->second;
+        return true;
+    }
+
+    std::vector<u8> source_data;
+    if (!read_file(source_path, source_data))
+        return false;
+
+    source_hash.write_time = write_time;
+    source_hash.hash = AK::murmur_hash(source_data.data(), source_data.size(), 0);
+    source_hash.size = source_data.size();
+
+    // glTF keeps vertex data in separate binary buffers, so they have to be a part of the hash as well
+    for (auto const& dependency_path : get_source_dependencies(source_path, source_data))
+    {
+        std::vector<u8> dependency_data;
+        if (!read_file(dependency_path, dependency_data))
+            continue;
+
+        source_hash.hash = AK::murmur_hash(dependency_data.data(), dependency_data.size(), source_hash.hash);
+        source_hash.size += dependency_data.size();
+    }
+
+    m_source_hashes.insert_or_assign(source_path, source_hash);
+
+    return true;
+}
+
+bool ModelCooker::cook(std::string const& source_path, CookedModel& cooked_model)
+{
+    Assimp::Importer importer;
+    aiScene const* scene = importer.ReadFile(source_path, aiProcess_Triangulate | aiProcess_FlipUVs);
+
+    if (scene == nullptr || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || scene->mRootNode == nullptr)
+    {
+        std::cout << "Error. Failed loading a model: " << importer.GetErrorString() << "\n";
+        return false;
+    }
+
+    cooked_model.meshes.reserve(scene->mNumMeshes);
+    cook_node(scene->mRootNode, scene, cooked_model);
+
+    return true;
+}
+
+void ModelCooker::cook_node(aiNode const* node, aiScene const* scene, CookedModel& cooked_model)
+{
+    for (u32 i = 0; i < node->mNumMeshes; ++i)
+    {
+        aiMesh const* mesh = scene->mMeshes[node->mMeshes[i]];
+        cooked_model.meshes.emplace_back(cook_mesh(mesh, scene));
+    }
+
+    for (u32 i = 0; i < node->mNumChildren; ++i)
+    {
+        cook_node(node->mChildren[i], scene, cooked_model);
+    }
+}
+
+CookedMesh ModelCooker::cook_mesh(aiMesh const* mesh, aiScene const* scene)
+{
+    CookedMesh cooked_mesh = {};
+    cooked_mesh.vertices.resize(mesh->mNumVertices);
+
+    bool const has_normals = mesh->HasNormals();
+    bool const has_texture_coordinates = mesh->mTextureCoords[0] != nullptr;
+
+    glm::vec3 bounds_min = glm::vec3(std::numeric_limits<float>::max());
+    glm::vec3 bounds_max = glm::vec3(std::numeric_limits<float>::lowest());
+
+    for (u32 i = 0; i < mesh->mNumVertices; ++i)
+    {
+        Vertex& vertex = cooked_mesh.vertices[i];
+
+        vertex.position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+        vertex.normal = has_normals ? glm::vec3(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z) : glm::vec3(0.0f);
+        vertex.texture_coordinates =
+            has_texture_coordinates ? glm::vec2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y) : glm::vec2(0.0f);
+
+        bounds_min = glm::min(bounds_min, vertex.position);
+        bounds_max = glm::max(bounds_max, vertex.position);
+    }
+
+    if (mesh->mNumVertices > 0)
+    {
+        cooked_mesh.bounds = {bounds_min, bounds_max};
+    }
+
+    // Faces are triangulated on import, but points and lines can still have less indices
+    u32 index_count = 0;
+    for (u32 i = 0; i < mesh->mNumFaces; ++i)
+    {
+        index_count += mesh->mFaces[i].mNumIndices;
+    }
+
+    cooked_mesh.indices.reserve(index_count);
+
+    for (u32 i = 0; i < mesh->mNumFaces; ++i)
+    {
+        aiFace const& face = mesh->mFaces[i];
+        cooked_mesh.indices.insert(cooked_mesh.indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
+    }
+
+    // Only pure triangle lists can be reordered, meshes containing points or lines are left untouched
+    if (mesh->mPrimitiveTypes == aiPrimitiveType_TRIANGLE && cooked_mesh.indices.size() % 3 == 0)
+    {
+        cooked_mesh.statistics = MeshOptimizer::optimize(cooked_mesh.vertices, cooked_mesh.indices);
+
+        Debug::log(std::format("Optimized mesh '{}': vertices {} -> {}, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}, "
+                               "overfetch {:.3f} -> {:.3f}",
+                               mesh->mName.C_Str(), cooked_mesh.statistics.vertex_count_before,
+                               cooked_mesh.statistics.vertex_count_after, cooked_mesh.statistics.acmr_before,
+                               cooked_mesh.statistics.acmr_after, cooked_mesh.statistics.atvr_before, cooked_mesh.statistics.atvr_after,
+                               cooked_mesh.statistics.overfetch_before, cooked_mesh.statistics.overfetch_after));
+    }
+
+    aiMaterial const* assimp_material = scene->mMaterials[mesh->mMaterialIndex];
+    cook_material_textures(assimp_material, aiTextureType_DIFFUSE, TextureType::Diffuse, cooked_mesh.textures);
+    cook_material_textures(assimp_material, aiTextureType_SPECULAR, TextureType::Specular, cooked_mesh.textures);
+
+    return cooked_mesh;
+}
+
+void ModelCooker::cook_material_textures(aiMaterial const* material, aiTextureType const type, TextureType const type_name,
+                                         std::vector<CookedTextureReference>& textures)
+{
+    u32 const texture_count = material->GetTextureCount(type);
+    for (u32 i = 0; i < texture_count; ++i)
+    {
+        aiString str;
+        material->GetTexture(type, i, &str);
+
+        textures.emplace_back(type_name, std::string(str.C_Str()));
+    }
+}
+
+bool ModelCooker::read_cooked_model(std::string const& cooked_path, u32 const source_hash, u64 const source_size,
+                                    CookedModel& cooked_model)
+{
+    std::vector<u8> data;
+    if (!read_file(cooked_path, data))
+        return false;
+
+    CookedReader reader(data);
+
+    CookedModelHeader header = {};
+    if (!reader.read(header))
+        return false;
+
+    if (header.magic != m_magic || header.version != m_version || header.source_hash != source_hash || header.source_size != source_size)
+        return false;
+
+    cooked_model.source_hash = header.source_hash;
+    cooked_model.source_size = header.source_size;
+    cooked_model.meshes.resize(header.mesh_count);
+
+    for (auto& cooked_mesh : cooked_model.meshes)
+    {
+        CookedMeshHeader mesh_header = {};
+        if (!reader.read(mesh_header))
+            return false;
+
+        cooked_mesh.bounds = {mesh_header.bounds_min, mesh_header.bounds_max};
+        cooked_mesh.statistics = mesh_header.statistics;
+        cooked_mesh.textures.resize(mesh_header.texture_count);
+
+        for (auto& texture : cooked_mesh.textures)
+        {
+            u32 path_length = 0;
+            if (!reader.read(texture.type) || !reader.read(path_length))
+                return false;
+
+            texture.path.resize(path_length);
+            if (!reader.read(texture.path.data(), path_length))
+                return false;
+        }
+
+        cooked_mesh.vertices.resize(mesh_header.vertex_count);
+        cooked_mesh.indices.resize(mesh_header.index_count);
+
+        if (!reader.read(cooked_mesh.vertices.data(), cooked_mesh.vertices.size() * sizeof(Vertex)))
+            return false;
+
+        if (!reader.read(cooked_mesh.indices.data(), cooked_mesh.indices.size() * sizeof(u32)))
+            return false;
+    }
+
+    return reader.is_at_end();
+}
+
+bool ModelCooker::write_cooked_model(std::string const& cooked_path, CookedModel const& cooked_model)
+{
+    // Model imported this call is still used when the cache can't be written, it's just not cooked for the next run
+    std::error_code error = {};
+    std::filesystem::create_directories(m_cooked_path, error);
+
+    if (error)
+    {
+        Debug::log(std::format("Failed to create cooked model directory '{}': {}. Using the uncooked import.", m_cooked_path,
+                               error.message()),
+                   DebugType::Error);
+        return false;
+    }
+
+    std::ofstream file(cooked_path, std::ios::binary);
+
+    if (!file.is_open())
+    {
+        std::cerr << "Failed to open file: " << cooked_path << std::endl;
+        return false;
+    }
+
+    CookedModelHeader header = {};
+    header.magic = m_magic;
+    header.version = m_version;
+    header.source_hash = cooked_model.source_hash;
+    header.source_size = cooked_model.source_size;
+    header.mesh_count = static_cast<u32>(cooked_model.meshes.size());
+    write(file, header);
+
+    for (auto const& cooked_mesh : cooked_model.meshes)
+    {
+        CookedMeshHeader mesh_header = {};
+        mesh_header.vertex_count = static_cast<u32>(cooked_mesh.vertices.size());
+        mesh_header.index_count = static_cast<u32>(cooked_mesh.indices.size());
+        mesh_header.texture_count = static_cast<u32>(cooked_mesh.textures.size());
+        mesh_header.bounds_min = cooked_mesh.bounds.min;
+        mesh_header.bounds_max = cooked_mesh.bounds.max;
+        mesh_header.statistics = cooked_mesh.statistics;
+        write(file, mesh_header);
+
+        for (auto const& texture : cooked_mesh.textures)
+        {
+            write(file, texture.type);
+            write(file, static_cast<u32>(texture.path.size()));
+            file.write(texture.path.data(), static_cast<std::streamsize>(texture.path.size()));
+        }
+
+        file.write(reinterpret_cast<char const*>(cooked_mesh.vertices.data()),
+                   static_cast<std::streamsize>(cooked_mesh.vertices.size() * sizeof(Vertex)));
+        file.write(reinterpret_cast<char const*>(cooked_mesh.indices.data()),
+                   static_cast<std::streamsize>(cooked_mesh.indices.size() * sizeof(u32)));
+    }
+
+    if (!file)
+    {
+        std::cerr << "Failed to write to file: " << cooked_path << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool ModelCooker::read_file(std::string const& path, std::vector<u8>& data)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+    if (!file.is_open())
+        return false;
+
+    std::streamsize const file_size = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    data.resize(static_cast<size_t>(file_size));
+
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(data.data()), file_size));
+}
+
+std::vector<std::string> ModelCooker::get_source_dependencies(std::string const& source_path, std::vector<u8> const& source_data)
+{
+    std::vector<std::string> dependencies;
+
+    std::filesystem::path const filesystem_path = source_path;
+    if (filesystem_path.extension() != ".gltf")
+        return dependencies;
+
+    std::string const source_text(source_data.begin(), source_data.end());
+    std::regex const uri_pattern(R"("uri"\s*:\s*"([^"]+\.bin)")");
+
+    for (auto it = std::sregex_iterator(source_text.begin(), source_text.end(), uri_pattern); it != std::sregex_iterator(); ++it)
+    {
+        dependencies.emplace_back((filesystem_path.parent_path() / (*it)[1].str()).string());
+    }
+
+    return dependencies;
+}
+
+std::string ModelCooker::get_cooked_path(std::string const& source_path, u32 const source_hash)
+{
+    std::filesystem::path const filesystem_path = source_path;
+    return m_cooked_path + filesystem_path.stem().string() + "_" + std::to_string(source_hash) + ".cmesh";
+}
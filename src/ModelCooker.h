@@ -0,0 +1,104 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <assimp/material.h>
+
+#include "AK/Types.h"
+#include "Bounds.h"
+#include "MeshOptimizer.h"
+#include "Texture.h"
+#include "Vertex.h"
+
+struct aiMaterial;
+struct aiMesh;
+struct aiNode;
+struct aiScene;
+
+struct CookedTextureReference
+{
+    TextureType type = TextureType::None;
+
+    // Path relative to the directory of the source model, exactly as stored by the source file
+    std::string path = {};
+};
+
+struct CookedMesh
+{
+    std::vector<Vertex> vertices = {};
+    std::vector<u32> indices = {};
+    std::vector<CookedTextureReference> textures = {};
+    BoundingBox bounds = {};
+    MeshOptimizationStatistics statistics = {};
+};
+
+struct CookedMeshStatistics
+{
+    std::string source_path = {};
+    u32 mesh_index = 0;
+    MeshOptimizationStatistics statistics = {};
+};
+
+struct CookedModel
+{
+    u32 source_hash = 0;
+    u64 source_size = 0;
+    std::vector<CookedMesh> meshes = {};
+};
+
+// Converts models imported through Assimp to a binary format that can be loaded with a single file read.
+// Cooked files are stored on disk and keyed by the hash of the source file, so changing the source model
+// automatically invalidates the cached one.
+class ModelCooker
+{
+public:
+    ModelCooker() = delete;
+
+    // Loads the cooked model for a given source path, cooking and caching it first if it's missing or outdated.
+    static bool load_or_cook(std::string const& source_path, CookedModel& cooked_model);
+
+    // Optimization statistics of every mesh loaded so far, stored in the cooked files so cached models report them as well
+    [[nodiscard]] static std::vector<CookedMeshStatistics> const& get_mesh_statistics();
+
+    // Writes one line per loaded mesh with its statistics before and after the optimization
+    static bool write_statistics_csv(std::string const& path);
+
+private:
+    struct SourceHash
+    {
+        std::filesystem::file_time_type write_time = {};
+        u32 hash = 0;
+        u64 size = 0;
+    };
+
+    static void record_statistics(std::string const& source_path, CookedModel const& cooked_model);
+
+    static bool hash_source(std::string const& source_path, SourceHash& source_hash);
+
+    static bool cook(std::string const& source_path, CookedModel& cooked_model);
+    static void cook_node(aiNode const* node, aiScene const* scene, CookedModel& cooked_model);
+    static CookedMesh cook_mesh(aiMesh const* mesh, aiScene const* scene);
+    static void cook_material_textures(aiMaterial const* material, aiTextureType const type, TextureType const type_name,
+                                       std::vector<CookedTextureReference>& textures);
+
+    static bool read_cooked_model(std::string const& cooked_path, u32 const source_hash, u64 const source_size, CookedModel& cooked_model);
+    static bool write_cooked_model(std::string const& cooked_path, CookedModel const& cooked_model);
+
+    static bool read_file(std::string const& path, std::vector<u8>& data);
+    [[nodiscard]] static std::vector<std::string> get_source_dependencies(std::string const& source_path,
+                                                                          std::vector<u8> const& source_data);
+    [[nodiscard]] static std::string get_cooked_path(std::string const& source_path, u32 const source_hash);
+
+    inline static u32 constexpr m_magic = 0x48534D43; // "CMSH"
+    inline static u32 constexpr m_version = 3;
+
+    // NOTE: Do not use constexpr here! The string will not live until runtime because of that.
+    //       https://developercommunity.visualstudio.com/t/c20-constexpr-stdstring-with-static-is-not-working/1441363
+    inline static std::string m_cooked_path = "./res/models/cooked/";
+
+    inline static std::unordered_map<std::string, SourceHash> m_source_hashes = {};
+    inline static std::vector<CookedMeshStatistics> m_mesh_statistics = {};
+};
@@ -80,9 +80,23 @@ void Panel::reprepare()
 
 void Panel::prepare()
 {
+    TextureSettings texture_settings = {};
+    texture_settings.wrap_mode_x = TextureWrapMode::ClampToEdge;
+    texture_settings.wrap_mode_y = TextureWrapMode::ClampToEdge;
+
+    m_texture = nullptr;
+
+    if (!background_path.empty())
+        m_texture = ResourceManager::get_instance().load_texture(background_path, TextureType::Diffuse, texture_settings);
+
     m_mesh = create_sprite();
 }
 
+std::shared_ptr<Texture> Panel::get_ui_texture() const
+{
+    return m_texture;
+}
+
 std::shared_ptr<Mesh> Panel::create_sprite() const
 {
     std::vector<Vertex> const vertices = {
@@ -96,15 +110,8 @@ std::shared_ptr<Mesh> Panel::create_sprite() const
 
     std::vector<std::shared_ptr<Texture>> textures;
 
-    std::vector<std::shared_ptr<Texture>> diffuse_maps = {};
-    TextureSettings texture_settings = {};
-    texture_settings.wrap_mode_x = TextureWrapMode::ClampToEdge;
-    texture_settings.wrap_mode_y = TextureWrapMode::ClampToEdge;
-
-    if (!background_path.empty())
-        diffuse_maps.emplace_back(ResourceManager::get_instance().load_texture(background_path, TextureType::Diffuse, texture_settings));
-
-    textures.insert(textures.end(), diffuse_maps.begin(), diffuse_maps.end());
+    if (m_texture != nullptr)
+        textures.emplace_back(m_texture);
 
     return ResourceManager::get_instance().load_mesh(0, background_path, vertices, indices, textures, DrawType::Triangles, material);
 }
@@ -24,6 +24,8 @@ public:
     void prepare();
     virtual void reprepare() override;
 
+    virtual std::shared_ptr<Texture> get_ui_texture() const override;
+
     CUSTOM_EDITOR
     std::string background_path = "./res/textures/white.jpg";
 
@@ -31,4 +33,5 @@ private:
     [[nodiscard]] std::shared_ptr<Mesh> create_sprite() const;
 
     std::shared_ptr<Mesh> m_mesh = {};
+    std::shared_ptr<Texture> m_texture = {};
 };
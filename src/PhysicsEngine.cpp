@@ -1,5 +1,7 @@
 #include "PhysicsEngine.h"
 
+#include <algorithm>
+
 #include "AK/AK.h"
 #include "AK/Math.h"
 #include "Debug.h"
@@ -97,6 +99,107 @@ void PhysicsEngine::emplace_collider(std::shared_ptr<Collider2D> const& collider
 void PhysicsEngine::remove_collider(std::shared_ptr<Collider2D> const& collider)
 {
     AK::swap_and_erase(colliders, collider);
+
+    // Candidates of the collision being solved might point to it
+    m_removed_colliders.emplace_back(collider.get());
+
+    if (collider->m_hierarchy_proxy != BoundingVolumeHierarchy<Collider2D*>::null_node)
+    {
+        m_collider_hierarchy.remove(collider->m_hierarchy_proxy);
+        collider->m_hierarchy_proxy = BoundingVolumeHierarchy<Collider2D*>::null_node;
+    }
+}
+
+std::vector<std::shared_ptr<Collider2D>> PhysicsEngine::get_colliders_in_radius(glm::vec2 const& center, float const radius) const
+{
+    std::vector<std::shared_ptr<Collider2D>> result = {};
+
+    m_collider_hierarchy.query_sphere(AK::convert_2d_to_3d(center), radius, [&result](Collider2D* const collider) {
+        result.emplace_back(std::static_pointer_cast<Collider2D>(collider->shared_from_this()));
+    });
+
+    return result;
+}
+
+void PhysicsEngine::draw_debug_colliders() const
+{
+    for (auto const& collider : colliders)
+    {
+        collider->draw_debug();
+    }
+}
+
+void PhysicsEngine::update_collider_hierarchy() const
+{
+    for (u32 i = 0; i < colliders.size(); ++i)
+    {
+        auto const& collider = colliders[i];
+        collider->m_physics_index = i;
+
+        BoundingBox const bounds = get_collider_bounds(*collider);
+
+        if (collider->m_hierarchy_proxy == BoundingVolumeHierarchy<Collider2D*>::null_node)
+        {
+            collider->m_hierarchy_proxy = m_collider_hierarchy.insert(bounds, collider.get());
+        }
+        else
+        {
+            m_collider_hierarchy.move(collider->m_hierarchy_proxy, bounds);
+        }
+    }
+}
+
+BoundingBox PhysicsEngine::get_collider_bounds(Collider2D const& collider)
+{
+    glm::vec2 min = {};
+    glm::vec2 max = {};
+
+    if (collider.collider_type == ColliderType2D::Circle)
+    {
+        glm::vec2 const center = collider.get_center_2d();
+        glm::vec2 const radius = glm::vec2(collider.get_radius_2d());
+
+        min = center - radius;
+        max = center + radius;
+    }
+    else
+    {
+        std::array const corners = collider.get_corners();
+
+        min = corners[0];
+        max = corners[0];
+
+        for (auto const& corner : corners)
+        {
+            min = glm::min(min, corner);
+            max = glm::max(max, corner);
+        }
+    }
+
+    return {AK::convert_2d_to_3d(min), AK::convert_2d_to_3d(max)};
+}
+
+void PhysicsEngine::refit_collider(Collider2D const& collider) const
+{
+    if (collider.m_hierarchy_proxy != BoundingVolumeHierarchy<Collider2D*>::null_node)
+        m_collider_hierarchy.move(collider.m_hierarchy_proxy, get_collider_bounds(collider));
+}
+
+void PhysicsEngine::find_collision_candidates(Collider2D const& collider, u32 const first_index) const
+{
+    m_collision_candidates.clear();
+    m_collider_hierarchy.query(get_collider_bounds(collider), [this, first_index](Collider2D* const other) {
+        if (other->m_physics_index >= first_index)
+            m_collision_candidates.emplace_back(other);
+    });
+
+    // Candidates are tested in the same order as when testing every pair, so collisions are resolved the same way
+    std::ranges::sort(m_collision_candidates, {}, &Collider2D::m_physics_index);
+}
+
+bool PhysicsEngine::was_removed(Collider2D const* collider) const
+{
+    return !m_removed_colliders.empty() && std::ranges::find(m_removed_colliders, collider) != m_removed_colliders.end();
 }
 
 bool PhysicsEngine::compute_penetration(std::shared_ptr<Collider2D> const& collider, std::shared_ptr<Collider2D> const& other,
@@ -132,16 +235,33 @@ bool PhysicsEngine::compute_penetration(std::shared_ptr<Collider2D> const& colli
 
 void PhysicsEngine::solve_collisions() const
 {
+    update_collider_hierarchy();
+
+    m_removed_colliders.clear();
+
     // Collision detection
     for (u32 i = 0; i < colliders.size(); i++)
     {
-        for (u32 j = 0; j < colliders.size(); j++)
+        std::shared_ptr<Collider2D> const collider1 = colliders[i];
+
+        find_collision_candidates(*collider1, 0);
+
+        u32 candidate = 0;
+        while (candidate < m_collision_candidates.size())
         {
-            if (i == j || (colliders[i]->is_static && colliders[j]->is_static))
+            Collider2D* const other = m_collision_candidates[candidate++];
+
+            // Colliders might have been removed by collision callbacks
+            if (was_removed(collider1.get()))
+                break;
+
+            if (was_removed(other))
+                continue;
+
+            if (other == collider1.get() || (collider1->is_static && other->is_static))
                 continue;
 
-            std::shared_ptr<Collider2D> collider1 = colliders[i];
-            std::shared_ptr<Collider2D> collider2 = colliders[j];
+            std::shared_ptr<Collider2D> const collider2 = std::static_pointer_cast<Collider2D>(other->shared_from_this());
 
             bool const should_overlap_as_trigger = collider1->is_trigger || collider2->is_trigger;
 
@@ -192,6 +312,17 @@ void PhysicsEngine::solve_collisions() const
                     collider1->apply_mtv(mtv);
                 }
 
+                if (!collider2->is_static)
+                    refit_collider(*collider2);
+
+                // Moved collider can now overlap colliders it didn't overlap when its candidates were found
+                if (!collider1->is_static)
+                {
+                    refit_collider(*collider1);
+                    find_collision_candidates(*collider1, other->m_physics_index + 1);
+                    candidate = 0;
+                }
+
                 on_collision_exit(collider1, collider2);
                 on_collision_exit(collider2, collider1);
             }
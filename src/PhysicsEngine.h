@@ -2,6 +2,7 @@
 
 #include <vector>
 
+#include "BoundingVolumeHierarchy.h"
 #include "Collider2D.h"
 
 enum class CollisionType
@@ -45,10 +46,25 @@ public:
 
     static bool compute_penetration(std::shared_ptr<Collider2D> const& collider, std::shared_ptr<Collider2D> const& other, glm::vec2& mtv);
 
+    // Colliders with bounds within the radius around the point. Bounds are updated once per physics step.
+    [[nodiscard]] std::vector<std::shared_ptr<Collider2D>> get_colliders_in_radius(glm::vec2 const& center, float const radius) const;
+
+    void draw_debug_colliders() const;
+
 private:
     void update_physics() const;
     void solve_collisions() const;
 
+    // Broad phase. Bounds of all colliders are kept in a bounding volume hierarchy on the ground plane, so only colliders
+    // with overlapping bounds are tested for collisions.
+    void update_collider_hierarchy() const;
+    [[nodiscard]] static BoundingBox get_collider_bounds(Collider2D const& collider);
+    void refit_collider(Collider2D const& collider) const;
+
+    // Colliders overlapping the bounds of the collider, starting from the given index, in the order of the colliders vector
+    void find_collision_candidates(Collider2D const& collider, u32 const first_index) const;
+    [[nodiscard]] bool was_removed(Collider2D const* collider) const;
+
     static bool test_collision_rectangle_rectangle(Collider2D const& obb1, Collider2D const& obb2, glm::vec2& mtv);
     static bool test_collision_circle_circle(Collider2D const& obb1, Collider2D const& obb2, glm::vec2& mtv);
     static bool test_collision_circle_rectangle(Collider2D const& circle_collider, Collider2D const& rect_collider, glm::vec2& mtv);
@@ -60,6 +76,12 @@ private:
 
     std::vector<std::shared_ptr<Collider2D>> colliders = {};
 
+    mutable BoundingVolumeHierarchy<Collider2D*> m_collider_hierarchy = {};
+    mutable std::vector<Collider2D*> m_collision_candidates = {};
+
+    // Colliders removed since collisions started being solved, their candidates are skipped
+    mutable std::vector<Collider2D const*> m_removed_colliders = {};
+
     double m_accumulated_delta = 0.0;
 
     inline static std::shared_ptr<PhysicsEngine> m_instance;
@@ -110,30 +110,36 @@ void PointLight::set_up_shadow_mapping()
                                                           &m_shadow_shader_resource_view);
     assert(SUCCEEDED(hr));
 
+    D3D11_DEPTH_STENCIL_VIEW_DESC shadow_depth_stencil_view_desc = {};
+    shadow_depth_stencil_view_desc.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
+    shadow_depth_stencil_view_desc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2DARRAY;
+    shadow_depth_stencil_view_desc.Texture2DArray.MipSlice = 0;
+    shadow_depth_stencil_view_desc.Texture2DArray.ArraySize = 1;
+    shadow_depth_stencil_view_desc.Flags = 0;
+
     for (u32 i = 0; i < 6; i++)
     {
         ID3D11DepthStencilView* shadow_depth_stencil_view = nullptr;
-        D3D11_DEPTH_STENCIL_VIEW_DESC shadow_depth_stencil_view_desc = {};
-        shadow_depth_stencil_view_desc.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
-        shadow_depth_stencil_view_desc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2DARRAY;
-        shadow_depth_stencil_view_desc.Texture2DArray.MipSlice = 0;
-        shadow_depth_stencil_view_desc.Texture2DArray.ArraySize = 1;
-        shadow_depth_stencil_view_desc.Texture2DArray.MipSlice = 0;
         shadow_depth_stencil_view_desc.Texture2DArray.FirstArraySlice = i;
-        shadow_depth_stencil_view_desc.Flags = 0;
 
         hr = renderer->get_device()->CreateDepthStencilView(m_shadow_texture, &shadow_depth_stencil_view_desc, &shadow_depth_stencil_view);
         assert(SUCCEEDED(hr));
 
         m_shadow_depth_stencil_views.emplace_back(shadow_depth_stencil_view);
     }
+
+    set_up_static_shadow_map(shadow_texture_desc, shadow_depth_stencil_view_desc);
 }
 
-void PointLight::set_render_target_for_shadow_mapping(u32 const face_index) const
+void PointLight::set_render_target_for_shadow_mapping(u32 const face_index, bool const clear) const
 {
     auto const renderer = RendererDX11::get_instance_dx11();
     renderer->get_device_context()->OMSetRenderTargets(1, &renderer->g_emptyRenderTargetView, m_shadow_depth_stencil_views[face_index]);
-    renderer->get_device_context()->ClearDepthStencilView(m_shadow_depth_stencil_views[face_index], D3D11_CLEAR_DEPTH, 1.0f, 0);
+
+    if (clear)
+    {
+        renderer->get_device_context()->ClearDepthStencilView(m_shadow_depth_stencil_views[face_index], D3D11_CLEAR_DEPTH, 1.0f, 0);
+    }
 }
 
 glm::mat4 PointLight::get_projection_view_matrix(u32 const face_index)
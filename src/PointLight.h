@@ -29,7 +29,7 @@ public:
     virtual void custom_draw_editor() override;
 #endif
 
-    void set_render_target_for_shadow_mapping(u32 const face_index) const;
+    void set_render_target_for_shadow_mapping(u32 const face_index, bool const clear = true) const;
     glm::mat4 get_projection_view_matrix(u32 const face_index);
 
     void set_pulsate(bool const value);
@@ -0,0 +1,295 @@
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+namespace
+{
+
+u32 constexpr pass_bits = 3;
+u32 constexpr render_order_bits = 13;
+u32 constexpr shader_bits = 12;
+u32 constexpr material_bits = 12;
+u32 constexpr mesh_bits = 12;
+u32 constexpr opaque_depth_bits = 11;
+u32 constexpr transparent_depth_bits = 23;
+
+u32 constexpr pass_shift = 64 - pass_bits;
+u32 constexpr render_order_shift = pass_shift - render_order_bits;
+u32 constexpr opaque_shift = render_order_shift - 1;
+
+static_assert(static_cast<u32>(RenderPass::Count) <= (1u << pass_bits));
+static_assert(opaque_shift == shader_bits + material_bits + mesh_bits + opaque_depth_bits);
+static_assert(opaque_shift == transparent_depth_bits + shader_bits + material_bits);
+
+u64 constexpr mask(u32 const bits)
+{
+    return (1ull << bits) - 1;
+}
+
+// Ties are ordered by the push order, same as after the stable radix sort of packets in their push order
+bool is_sorted_before(RenderPacket const& a, RenderPacket const& b)
+{
+    return a.sort_key < b.sort_key || (a.sort_key == b.sort_key && a.push_index < b.push_index);
+}
+
+}
+
+void RenderQueue::clear()
+{
+    m_packets.clear();
+}
+
+void RenderQueue::reserve(u32 const count)
+{
+    m_packets.reserve(count);
+}
+
+void RenderQueue::push(RenderPacket const& packet)
+{
+    u32 const push_index = static_cast<u32>(m_packets.size());
+    m_packets.emplace_back(packet).push_index = push_index;
+}
+
+void RenderQueue::sort()
+{
+    m_was_sorted_incrementally = try_sort_incrementally();
+
+    if (!m_was_sorted_incrementally)
+    {
+        radix_sort(m_packets, m_scratch);
+    }
+
+    m_previous_identities.resize(m_packets.size());
+    m_previous_order.resize(m_packets.size());
+
+    for (u32 i = 0; i < m_packets.size(); ++i)
+    {
+        m_previous_identities[m_packets[i].push_index] = get_identity(m_packets[i]);
+        m_previous_order[i] = m_packets[i].push_index;
+    }
+}
+
+bool RenderQueue::try_sort_incrementally()
+{
+    if (m_packets.size() != m_previous_identities.size())
+        return false;
+
+    for (u32 i = 0; i < m_packets.size(); ++i)
+    {
+        if (get_identity(m_packets[i]) != m_previous_identities[i])
+            return false;
+    }
+
+    m_scratch.resize(m_packets.size());
+
+    for (u32 i = 0; i < m_packets.size(); ++i)
+    {
+        m_scratch[i] = m_packets[m_previous_order[i]];
+    }
+
+    // Past this point a radix sort is cheaper than fixing the order packet by packet
+    u64 const max_moves = static_cast<u64>(m_packets.size()) * 8;
+
+    if (!insertion_sort(m_scratch, max_moves))
+        return false;
+
+    m_packets.swap(m_scratch);
+    return true;
+}
+
+bool RenderQueue::was_sorted_incrementally() const
+{
+    return m_was_sorted_incrementally;
+}
+
+RenderQueueStatistics RenderQueue::submit(RenderPass const pass, RenderQueueBackend& backend) const
+{
+    return submit(get_packets(pass), backend);
+}
+
+RenderQueueStatistics RenderQueue::submit(std::span<RenderPacket const> const packets, RenderQueueBackend& backend)
+{
+    RenderQueueStatistics statistics = {};
+
+    Shader const* bound_shader = nullptr;
+    std::shared_ptr<Material> const* bound_material = nullptr;
+
+    for (auto const& packet : packets)
+    {
+        if (packet.shader->get() != bound_shader)
+        {
+            bound_shader = packet.shader->get();
+            backend.bind_shader(*packet.shader);
+            statistics.shader_binds++;
+        }
+
+        if (bound_material == nullptr || packet.material->get() != bound_material->get())
+        {
+            if (bound_material != nullptr)
+            {
+                backend.unbind_material(*bound_material);
+            }
+
+            bound_material = packet.material;
+            backend.bind_material(*packet.material);
+            statistics.material_binds++;
+        }
+
+        backend.draw(packet);
+        statistics.packets++;
+    }
+
+    if (bound_material != nullptr)
+    {
+        backend.unbind_material(*bound_material);
+    }
+
+    return statistics;
+}
+
+std::span<RenderPacket const> RenderQueue::get_packets(RenderPass const pass) const
+{
+    // Pass occupies the most significant bits, so packets of each pass form one contiguous range after sorting
+    auto const is_before = [pass](RenderPacket const& packet) { return get_pass(packet.sort_key) < pass; };
+    auto const is_not_after = [pass](RenderPacket const& packet) { return get_pass(packet.sort_key) <= pass; };
+
+    auto const first = std::ranges::partition_point(m_packets, is_before);
+    auto const last = std::ranges::partition_point(first, m_packets.end(), is_not_after);
+
+    return {first, last};
+}
+
+u32 RenderQueue::size() const
+{
+    return static_cast<u32>(m_packets.size());
+}
+
+u64 RenderQueue::make_opaque_key(RenderPass const pass, i32 const render_order, u32 const shader_id, u32 const material_id,
+                                 u32 const mesh_id, float const depth)
+{
+    u64 key = make_key_prefix(pass, render_order, true);
+    key |= (shader_id & mask(shader_bits)) << (material_bits + mesh_bits + opaque_depth_bits);
+    key |= (material_id & mask(material_bits)) << (mesh_bits + opaque_depth_bits);
+    key |= (mesh_id & mask(mesh_bits)) << opaque_depth_bits;
+    key |= quantize_depth(depth, opaque_depth_bits);
+    return key;
+}
+
+u64 RenderQueue::make_transparent_key(RenderPass const pass, i32 const render_order, u32 const shader_id, u32 const material_id,
+                                      float const depth)
+{
+    u64 key = make_key_prefix(pass, render_order, false);
+    key |= (mask(transparent_depth_bits) - quantize_depth(depth, transparent_depth_bits)) << (shader_bits + material_bits);
+    key |= (shader_id & mask(shader_bits)) << material_bits;
+    key |= material_id & mask(material_bits);
+    return key;
+}
+
+RenderPass RenderQueue::get_pass(u64 const sort_key)
+{
+    return static_cast<RenderPass>(sort_key >> pass_shift);
+}
+
+void RenderQueue::radix_sort(std::vector<RenderPacket>& packets, std::vector<RenderPacket>& scratch)
+{
+    u32 constexpr digit_bits = 8;
+    u32 constexpr digit_count = 64 / digit_bits;
+    u32 constexpr bucket_count = 1 << digit_bits;
+
+    if (packets.size() < 2)
+        return;
+
+    // Histograms for all digits are gathered in a single pass over the keys
+    std::array<std::array<u32, bucket_count>, digit_count> histograms = {};
+
+    for (auto const& packet : packets)
+    {
+        for (u32 digit = 0; digit < digit_count; ++digit)
+        {
+            histograms[digit][(packet.sort_key >> (digit * digit_bits)) & (bucket_count - 1)]++;
+        }
+    }
+
+    scratch.resize(packets.size());
+
+    u32 const packet_count = static_cast<u32>(packets.size());
+
+    for (u32 digit = 0; digit < digit_count; ++digit)
+    {
+        auto& histogram = histograms[digit];
+
+        // All keys share this digit, so this pass wouldn't change the order. Happens a lot for the upper bits.
+        if (std::ranges::find(histogram, packet_count) != histogram.end())
+            continue;
+
+        u32 offset = 0;
+        for (u32& count : histogram)
+        {
+            u32 const bucket_size = count;
+            count = offset;
+            offset += bucket_size;
+        }
+
+        for (auto const& packet : packets)
+        {
+            scratch[histogram[(packet.sort_key >> (digit * digit_bits)) & (bucket_count - 1)]++] = packet;
+        }
+
+        packets.swap(scratch);
+    }
+
+    assert(std::ranges::is_sorted(packets, {}, &RenderPacket::sort_key));
+}
+
+bool RenderQueue::insertion_sort(std::vector<RenderPacket>& packets, u64 const max_moves)
+{
+    u64 moves = 0;
+
+    for (u32 i = 1; i < packets.size(); ++i)
+    {
+        if (!is_sorted_before(packets[i], packets[i - 1]))
+            continue;
+
+        RenderPacket const packet = packets[i];
+        u32 j = i;
+
+        while (j > 0 && is_sorted_before(packet, packets[j - 1]))
+        {
+            packets[j] = packets[j - 1];
+            j--;
+        }
+
+        packets[j] = packet;
+        moves += i - j;
+
+        if (moves > max_moves)
+            return false;
+    }
+
+    return true;
+}
+
+u64 RenderQueue::make_key_prefix(RenderPass const pass, i32 const render_order, bool const is_opaque)
+{
+    u64 const clamped_render_order = static_cast<u64>(std::clamp(render_order, 0, static_cast<i32>(mask(render_order_bits))));
+
+    return (static_cast<u64>(pass) << pass_shift) | (clamped_render_order << render_order_shift)
+         | (static_cast<u64>(is_opaque) << opaque_shift);
+}
+
+u64 RenderQueue::quantize_depth(float const depth, u32 const bits)
+{
+    float const clamped_depth = std::clamp(depth, 0.0f, 1.0f);
+    return static_cast<u64>(clamped_depth * static_cast<float>(mask(bits)));
+}
+
+void const* RenderQueue::get_identity(RenderPacket const& packet)
+{
+    // Instanced packets don't have a drawable, but there is only one of them for every material
+    if (packet.drawable != nullptr)
+        return packet.drawable->get();
+
+    return packet.material->get();
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "AK/Types.h"
+
+class Drawable;
+class Material;
+class Shader;
+
+enum class RenderPass : u8
+{
+    Geometry,
+    Forward,
+    CustomBeforeAA,
+    CustomAfterAA,
+    Count,
+};
+
+// A single draw call. Pointers reference shared pointers owned by the renderer (shaders, materials and their drawables),
+// so building the queue doesn't touch any reference counts. They have to stay valid until the queue is submitted.
+// Packets without a drawable draw the whole material at once using GPU instancing.
+struct RenderPacket
+{
+    u64 sort_key = 0;
+    std::shared_ptr<Shader> const* shader = nullptr;
+    std::shared_ptr<Material> const* material = nullptr;
+    std::shared_ptr<Drawable> const* drawable = nullptr;
+
+    // Position in the push order, assigned by RenderQueue::push()
+    u32 push_index = 0;
+};
+
+struct RenderQueueStatistics
+{
+    u32 packets = 0;
+    u32 shader_binds = 0;
+    u32 material_binds = 0;
+};
+
+// Receives packets from RenderQueue::submit() in the sorted order. Bind calls are only issued when the state actually changes.
+class RenderQueueBackend
+{
+public:
+    virtual ~RenderQueueBackend() = default;
+
+    virtual void bind_shader(std::shared_ptr<Shader> const& shader) = 0;
+    virtual void bind_material(std::shared_ptr<Material> const& material) = 0;
+    virtual void unbind_material(std::shared_ptr<Material> const& material) = 0;
+    virtual void draw(RenderPacket const& packet) = 0;
+};
+
+// Every visible draw of a frame becomes a packet with a 64-bit sort key. Packets are radix sorted once per frame, then each pass
+// is submitted as a contiguous range of the queue.
+//
+// Sort key layout, from the most significant bit:
+// | pass (3) | render order (13) | opaque (1) | shader (12) | material (12) | mesh (12) | depth (11) |  - opaque draws
+// | pass (3) | render order (13) | opaque (1) | inverted depth (23) | shader (12) | material (12) |   - transparent draws
+// Opaque draws are grouped by state and then drawn front-to-back, transparent draws are drawn back-to-front.
+// Transparent draws come before opaque ones sharing the same render order.
+class RenderQueue
+{
+public:
+    void clear();
+    void reserve(u32 const count);
+    void push(RenderPacket const& packet);
+
+    // Sorts all packets by their keys. Sorting is stable, so packets with equal keys keep their push order.
+    // When the same packets are pushed in the same order as in the previous frame, they are first arranged in the previous
+    // sorted order and only the packets whose keys changed (e.g. moving transparent objects) are moved by an insertion sort.
+    void sort();
+
+    // Submits all packets of a given pass. Has to be called after sort().
+    RenderQueueStatistics submit(RenderPass const pass, RenderQueueBackend& backend) const;
+
+    // Submits a range of sorted packets, e.g. a part of a pass
+    static RenderQueueStatistics submit(std::span<RenderPacket const> const packets, RenderQueueBackend& backend);
+
+    [[nodiscard]] std::span<RenderPacket const> get_packets(RenderPass const pass) const;
+    [[nodiscard]] u32 size() const;
+
+    // Depth is normalized distance from the camera, clamped to [0, 1]. Ids wider than their fields are wrapped, which only
+    // affects grouping, not correctness.
+    [[nodiscard]] static u64 make_opaque_key(RenderPass const pass, i32 const render_order, u32 const shader_id, u32 const material_id,
+                                             u32 const mesh_id, float const depth);
+    [[nodiscard]] static u64 make_transparent_key(RenderPass const pass, i32 const render_order, u32 const shader_id,
+                                                  u32 const material_id, float const depth);
+    [[nodiscard]] static RenderPass get_pass(u64 const sort_key);
+
+    // Whether the last sort() reused the order of the previous frame
+    [[nodiscard]] bool was_sorted_incrementally() const;
+
+    // Exposed for testing
+    static void radix_sort(std::vector<RenderPacket>& packets, std::vector<RenderPacket>& scratch);
+
+    // Insertion sort that gives up after moving packets by more than max_moves positions in total, leaving them partially sorted.
+    // Packets with equal keys are ordered by their push indices, so the result matches the radix sort.
+    // Returns whether the packets are sorted.
+    static bool insertion_sort(std::vector<RenderPacket>& packets, u64 const max_moves);
+
+private:
+    [[nodiscard]] static u64 make_key_prefix(RenderPass const pass, i32 const render_order, bool const is_opaque);
+    [[nodiscard]] static u64 quantize_depth(float const depth, u32 const bits);
+    [[nodiscard]] static void const* get_identity(RenderPacket const& packet);
+
+    [[nodiscard]] bool try_sort_incrementally();
+
+    std::vector<RenderPacket> m_packets = {};
+    std::vector<RenderPacket> m_scratch = {};
+
+    // Identities of packets of the previous frame in the push order and push indices of the previous frame's sorted packets
+    std::vector<void const*> m_previous_identities = {};
+    std::vector<u32> m_previous_order = {};
+    bool m_was_sorted_incrementally = false;
+};
@@ -1,34 +1,35 @@
 #include "Renderer.h"
 
+#include <algorithm>
 #include <array>
+#include <execution>
 #include <format>
 #include <glad/glad.h>
 #include <glm/gtx/rotate_vector.hpp>
 #include <glm/gtx/string_cast.hpp>
 #include <iostream>
+#include <limits>
 
 #include "AK/AK.h"
 #include "Camera.h"
 #include "Debug.h"
 #include "Engine.h"
 #include "Entity.h"
+#include "Globals.h"
+#include "ResourceManager.h"
 #include "ShaderFactory.h"
 #include "Skybox.h"
 
 #include <filesystem>
-#include <glm/gtx/norm.hpp>
 
 void Renderer::initialize()
 {
     initialize_global_renderer_settings();
 
-    // TODO: GPU instancing on one material currently supports only the first mesh that was bound to the material.
+    // Initial size of instancing buffers, they grow when more drawables are registered later
     size_t max_size = 0;
     for (auto const& material : m_instanced_materials)
     {
-        material->model_matrices.reserve(material->drawables.size());
-        material->bounding_boxes = std::vector<BoundingBoxShader>(material->drawables.size());
-
         if (max_size < material->drawables.size())
             max_size = material->drawables.size();
     }
@@ -40,7 +41,6 @@ void Renderer::initialize()
 
 void Renderer::uninitialize()
 {
-    unload_fonts();
 }
 
 void Renderer::register_shader(std::shared_ptr<Shader> const& shader)
@@ -63,6 +63,9 @@ void Renderer::register_drawable(std::shared_ptr<Drawable> const& drawable)
 {
     bool const should_register_material = drawable->material->drawables.size() == 0;
 
+    // Newly registered shadow casters are dynamic until they stay in place for a while
+    drawable->m_frames_without_movement = 0;
+
     drawable->material->drawables.emplace_back(drawable);
 
     if (should_register_material)
@@ -73,8 +76,20 @@ void Renderer::register_drawable(std::shared_ptr<Drawable> const& drawable)
 
 void Renderer::unregister_drawable(std::shared_ptr<Drawable> const& drawable)
 {
+    // Shadow of the removed drawable might still be in the cached shadow maps
+    if (m_shadow_map_caching && drawable->material->casts_shadows)
+    {
+        update_shadow_caster(drawable, true, drawable->bounds);
+    }
+
     AK::swap_and_erase(drawable->material->drawables, drawable);
 
+    if (drawable->m_hierarchy_proxy != BoundingVolumeHierarchy<Drawable*>::null_node)
+    {
+        m_drawable_hierarchy.remove(drawable->m_hierarchy_proxy);
+        drawable->m_hierarchy_proxy = BoundingVolumeHierarchy<Drawable*>::null_node;
+    }
+
     if (drawable->material->drawables.size() == 0)
     {
         unregister_material(drawable->material);
@@ -88,23 +103,6 @@ void Renderer::register_material(std::shared_ptr<Material> const& material)
         m_instanced_materials.emplace_back(material);
     }
 
-    if (material->has_custom_render_order())
-    {
-        if (material->get_render_order() <= aa_render_order)
-        {
-            m_custom_render_order_materials_before_aa.insert({material->get_render_order(), material});
-        }
-        else
-        {
-            m_custom_render_order_materials_after_aa.insert({material->get_render_order(), material});
-        }
-    }
-
-    if (material->is_transparent)
-    {
-        m_transparent_materials.emplace_back(material);
-    }
-
     material->shader->materials.emplace_back(material);
 }
 
@@ -115,42 +113,6 @@ void Renderer::unregister_material(std::shared_ptr<Material> const& material)
         AK::swap_and_erase(m_instanced_materials, material);
     }
 
-    // FIXME: Not sure if find works
-    if (material->has_custom_render_order())
-    {
-        if (material->get_render_order() <= aa_render_order)
-        {
-            auto const [first, second] = m_custom_render_order_materials_before_aa.equal_range({material->get_render_order(), material});
-
-            for (auto i = first; i != second; ++i)
-            {
-                if (i->material->drawables.size() == 0)
-                {
-                    m_custom_render_order_materials_before_aa.erase(i);
-                    break;
-                }
-            }
-        }
-        else
-        {
-            auto const [first, second] = m_custom_render_order_materials_after_aa.equal_range({material->get_render_order(), material});
-
-            for (auto i = first; i != second; ++i)
-            {
-                if (i->material->drawables.size() == 0)
-                {
-                    m_custom_render_order_materials_after_aa.erase(i);
-                    break;
-                }
-            }
-        }
-    }
-
-    if (material->is_transparent)
-    {
-        AK::swap_and_erase(m_transparent_materials, material);
-    }
-
     AK::swap_and_erase(material->shader->materials, material);
 }
 
@@ -178,25 +140,11 @@ void Renderer::register_light(std::shared_ptr<Light> const& light)
 {
     if (auto const potential_point_light = std::dynamic_pointer_cast<PointLight>(light))
     {
-        if (m_point_lights.size() >= MAX_POINT_LIGHTS)
-        {
-            Debug::log("You've reached the limit of point lights!", DebugType::Error);
-        }
-        else
-        {
-            m_point_lights.emplace_back(potential_point_light);
-        }
+        m_point_lights.emplace_back(potential_point_light);
     }
     else if (auto const potential_spot_light = std::dynamic_pointer_cast<SpotLight>(light))
     {
-        if (m_spot_lights.size() >= MAX_SPOT_LIGHTS)
-        {
-            Debug::log("You've reached the limit of spot lights!", DebugType::Error);
-        }
-        else
-        {
-            m_spot_lights.emplace_back(potential_spot_light);
-        }
+        m_spot_lights.emplace_back(potential_spot_light);
     }
     else if (auto const potential_directional_light = std::dynamic_pointer_cast<DirectionalLight>(light))
     {
@@ -255,6 +203,10 @@ void Renderer::begin_frame() const
 {
     glfwGetFramebufferSize(Engine::window->get_glfw_window(), &screen_width, &screen_height);
 
+#if EDITOR
+    m_shader_hot_reload.update(m_shaders);
+#endif
+
     // Update camera
     if (Camera::get_main_camera() != nullptr)
     {
@@ -268,34 +220,101 @@ void Renderer::render() const
     if (Camera::get_main_camera() == nullptr)
         return;
 
+    RendererStatistics::begin_frame();
+    begin_gpu_frame();
+
+    begin_pass(StatisticsPass::Culling);
+    prepare_frustum_culling();
+    assign_light_clusters();
+    end_pass(StatisticsPass::Culling);
+
+    begin_pass(StatisticsPass::Shadows);
     render_shadow_maps();
+    end_pass(StatisticsPass::Shadows);
+
+    m_moved_caster_bounds.clear();
+    m_static_caster_changes.clear();
 
     // Premultiply projection and view matrices
     glm::mat4 const projection_view = Camera::get_main_camera()->get_projection() * Camera::get_main_camera()->get_view_matrix();
     glm::mat4 const projection_view_no_translation =
         Camera::get_main_camera()->get_projection() * glm::mat4(glm::mat3(Camera::get_main_camera()->get_view_matrix()));
 
+    begin_pass(StatisticsPass::RenderQueue);
+    cull_view(Camera::get_main_camera()->get_frustum());
+
+    build_render_queue();
+    record_command_lists(projection_view);
+    end_pass(StatisticsPass::RenderQueue);
+
     // Renders to G-Buffer
+    begin_pass(StatisticsPass::Geometry);
     render_geometry_pass(projection_view);
+    end_pass(StatisticsPass::Geometry);
 
+    begin_pass(StatisticsPass::SSAO);
     render_ssao();
+    end_pass(StatisticsPass::SSAO);
+
+    begin_pass(StatisticsPass::Lighting);
 
     // We bind resources that are used in both deferred and forward rendering
     bind_universal_resources();
 
     // Renders opaque objects
     render_lighting_pass();
+    end_pass(StatisticsPass::Lighting);
 
     // Renders transparent objects
+    begin_pass(StatisticsPass::Forward);
     render_forward_pass(projection_view, projection_view_no_translation);
+    end_pass(StatisticsPass::Forward);
 
+    begin_pass(StatisticsPass::CustomBeforeAA);
     render_custom_render_order_before_aa(projection_view, projection_view_no_translation);
+    render_debug_drawings(projection_view);
+    end_pass(StatisticsPass::CustomBeforeAA);
 
     // Render AA (FXAA)
+    begin_pass(StatisticsPass::AA);
     render_aa();
+    end_pass(StatisticsPass::AA);
 
     // Render custom render order materials, so in our case UI, as it should not be affected by AA
+    begin_pass(StatisticsPass::CustomAfterAA);
     render_custom_render_order_after_aa(projection_view, projection_view_no_translation);
+    end_pass(StatisticsPass::CustomAfterAA);
+
+    end_gpu_frame();
+    RendererStatistics::end_frame();
+}
+
+void Renderer::begin_pass(StatisticsPass const pass) const
+{
+    RendererStatistics::begin_pass(pass);
+    begin_gpu_pass(pass);
+}
+
+void Renderer::end_pass(StatisticsPass const pass) const
+{
+    end_gpu_pass(pass);
+    RendererStatistics::end_pass(pass);
+}
+
+void Renderer::begin_gpu_frame() const
+{
+}
+
+void Renderer::end_gpu_frame() const
+{
+}
+
+void Renderer::begin_gpu_pass(StatisticsPass const pass) const
+{
+}
+
+void Renderer::end_gpu_pass(StatisticsPass const pass) const
+{
 }
 
 void Renderer::render_geometry_pass(glm::mat4 const& projection_view) const
@@ -312,86 +331,91 @@ void Renderer::render_aa() const
 
 void Renderer::render_custom_render_order_before_aa(glm::mat4 const& projection_view, glm::mat4 const& projection_view_no_translation) const
 {
-    bool drawn_transparent = false;
-
-    for (auto const& [render_order, material] : m_custom_render_order_materials_before_aa)
-    {
-        if (render_order == transparent_render_order)
-        {
-            if (!drawn_transparent)
-            {
-                draw_transparent(projection_view, projection_view_no_translation);
-                drawn_transparent = true;
-            }
+    submit_command_lists(RenderPass::CustomBeforeAA, projection_view, projection_view_no_translation);
+}
 
-            if (material->is_transparent)
-            {
-                continue;
-            }
-        }
+void Renderer::render_custom_render_order_after_aa(glm::mat4 const& projection_view, glm::mat4 const& projection_view_no_translation) const
+{
+    submit_command_lists(RenderPass::CustomAfterAA, projection_view, projection_view_no_translation);
+}
 
-        material->shader->use();
+void Renderer::bind_universal_resources() const
+{
+}
 
-        update_shader(material->shader, projection_view, projection_view_no_translation);
+void Renderer::render_debug_drawings(glm::mat4 const& projection_view) const
+{
+    if (!DebugDraw::get_vertices().empty())
+        draw_debug_lines(DebugDraw::get_vertices(), projection_view);
 
-        if (material->is_gpu_instanced)
-            draw_instanced(material, projection_view, projection_view_no_translation);
-        else
-            draw(material, projection_view);
-    }
+    if (!DebugDraw::get_texts().empty())
+        draw_debug_texts(DebugDraw::get_texts(), projection_view);
 }
 
-void Renderer::render_custom_render_order_after_aa(glm::mat4 const& projection_view, glm::mat4 const& projection_view_no_translation) const
+void Renderer::draw_debug_texts(std::span<DebugText const> const texts, glm::mat4 const& projection_view) const
 {
-    for (auto const& [render_order, material] : m_custom_render_order_materials_after_aa)
+    if (m_ui_batch_shader == nullptr || loaded_fonts.empty())
+        return;
+
+    if (m_debug_font_atlas == nullptr)
     {
-        material->shader->use();
+        m_debug_font_atlas = ResourceManager::get_instance().load_glyph_atlas(loaded_fonts.front().paths.front(), debug_text_size);
 
-        update_shader(material->shader, projection_view, projection_view_no_translation);
+        if (m_debug_font_atlas == nullptr)
+            return;
 
-        if (material->is_gpu_instanced)
-            draw_instanced(material, projection_view, projection_view_no_translation);
-        else
-            draw(material, projection_view);
+        m_debug_font_texture = ResourceManager::get_instance().load_glyph_atlas_texture(*m_debug_font_atlas);
     }
-}
 
-void Renderer::bind_universal_resources() const
-{
-}
+    glm::vec2 const screen_size = {static_cast<float>(screen_width), static_cast<float>(screen_height)};
 
-void Renderer::render_forward_pass(glm::mat4 const& projection_view, glm::mat4 const& projection_view_no_translation) const
-{
-    bind_for_render_frame();
+    m_debug_text_batcher.clear();
 
-    for (auto const& shader : m_shaders)
+    for (auto const& text : texts)
     {
-        shader->use();
+        glm::vec4 const clip_position = projection_view * glm::vec4(text.position, 1.0f);
 
-        update_shader(shader, projection_view, projection_view_no_translation);
+        // Behind the camera
+        if (clip_position.w <= 0.0f)
+            continue;
 
-        for (auto const& material : shader->materials)
-        {
-            if (!material->needs_forward_rendering)
-                continue;
+        glm::vec2 const ndc_position = glm::vec2(clip_position) / clip_position.w;
+        glm::vec2 const anchor = glm::vec2(ndc_position.x * 0.5f + 0.5f, 0.5f - ndc_position.y * 0.5f) * screen_size;
 
-            if (material->has_custom_render_order())
-                continue;
+        auto const layout = m_debug_text_layouts.get(m_debug_font_atlas, text.text, TextFlags::Center | TextFlags::VerticalCenter);
+        m_debug_text_batcher.add_text(0, m_debug_font_texture, *layout, anchor, 1.0f, text.color, screen_size);
+    }
 
-            if (material->is_gpu_instanced)
-                draw_instanced(material, projection_view, projection_view_no_translation);
-            else
-                draw(material, projection_view);
-        }
+    m_debug_text_batcher.build(m_ui_batch_shader);
+
+    for (auto const& group : m_debug_text_batcher.get_groups())
+    {
+        m_ui_batch_shader->use();
+        draw_ui_batches(m_debug_text_batcher.get_vertices(group), m_debug_text_batcher.get_batches(group));
     }
 }
 
+void Renderer::draw_ui_batches(std::span<UIVertex const> const vertices, std::span<UIBatch const> const batches) const
+{
+}
+
+void Renderer::render_forward_pass(glm::mat4 const& projection_view, glm::mat4 const& projection_view_no_translation) const
+{
+    bind_for_render_frame();
+
+    submit_command_lists(RenderPass::Forward, projection_view, projection_view_no_translation);
+}
+
 void Renderer::render_lighting_pass() const
 {
 }
 
-void Renderer::render_single_shadow_map(glm::mat4 const& projection_view) const
+void Renderer::render_single_shadow_map(glm::mat4 const& projection_view, ShadowCasterFilter const filter) const
 {
+    cull_view(Frustum::from_projection_view(projection_view));
+
+    m_shadow_caster_filter = filter;
+
     for (auto const& shader : m_shaders)
     {
         for (auto const& material : shader->materials)
@@ -401,8 +425,11 @@ void Renderer::render_single_shadow_map(glm::mat4 const& projection_view) const
 
             if (material->is_gpu_instanced)
             {
-                // GPU instancing is not implemented in DX11
-                std::unreachable();
+                // Instanced drawables are not tracked as static shadow casters, so they are always rendered with the dynamic ones
+                if (filter != ShadowCasterFilter::Static)
+                {
+                    draw_instanced(material, projection_view, projection_view);
+                }
             }
             else
             {
@@ -410,10 +437,13 @@ void Renderer::render_single_shadow_map(glm::mat4 const& projection_view) const
             }
         }
     }
+
+    m_shadow_caster_filter = ShadowCasterFilter::All;
 }
 
 void Renderer::end_frame() const
 {
+    DebugDraw::advance(delta_time);
 }
 
 void Renderer::present() const
@@ -434,6 +464,13 @@ void Renderer::reload_shaders() const
 {
     float const time = glfwGetTime();
 
+    // Only changed shaders are compiled, all of them in parallel. Loading afterwards just reads them from the shader cache.
+    // Errors are reported by load_shader(), which compiles failed shaders again.
+    std::for_each(std::execution::par, m_shaders.begin(), m_shaders.end(), [](auto const& shader) {
+        std::string errors = {};
+        shader->compile(errors);
+    });
+
     for (u32 i = 0; i < m_shaders.size(); i++)
     {
         m_shaders[i]->load_shader();
@@ -451,121 +488,616 @@ void Renderer::bind_for_render_frame() const
 {
 }
 
-void Renderer::draw(std::shared_ptr<Material> const& material, glm::mat4 const& projection_view) const
+void Renderer::prepare_frustum_culling() const
 {
-    update_material(material);
+    if (!m_cpu_frustum_culling)
+        return;
 
-    for (auto const& drawable : material->drawables)
-    {
-        update_object(drawable, material, projection_view);
+    m_frustum_culler.clear();
+    m_culled_drawables.clear();
+    m_always_visible_indices.clear();
+    m_static_casters.clear();
 
-        if (material->is_billboard)
+    for (auto const& shader : m_shaders)
+    {
+        for (auto const& material : shader->materials)
         {
-            drawable->entity->transform->set_euler_angles(Camera::get_main_camera()->entity->transform->get_euler_angles());
-        }
+            // Instanced materials are culled separately in perform_frustum_culling()
+            if (material->is_gpu_instanced)
+            {
+                update_instance_bounds(material);
+                continue;
+            }
 
-        drawable->draw();
+            for (auto const& drawable : material->drawables)
+            {
+                bool const moved = drawable->entity->transform->needs_bounding_box_adjusting;
+                BoundingBox const previous_bounds = drawable->bounds;
+
+                drawable->m_culling_index = static_cast<u32>(m_culled_drawables.size());
+
+                if (drawable->is_cullable())
+                {
+                    if (moved)
+                    {
+                        drawable->adjust_bounding_box();
+
+                        if (material->is_billboard && m_shader_billboarding)
+                        {
+                            drawable->bounds = get_billboard_bounds(drawable->bounds, drawable->entity->transform->get_position());
+                        }
+                    }
+
+                    // Bounds can also change without moving, e.g. when a model is reloaded, so every drawable is refitted.
+                    // Drawables that stay within their fattened bounds don't change the hierarchy.
+                    if (drawable->m_hierarchy_proxy == BoundingVolumeHierarchy<Drawable*>::null_node)
+                    {
+                        drawable->m_hierarchy_proxy = m_drawable_hierarchy.insert(drawable->bounds, drawable.get());
+                    }
+                    else
+                    {
+                        m_drawable_hierarchy.move(drawable->m_hierarchy_proxy, drawable->bounds);
+                    }
+
+                    if (linear_culling)
+                    {
+                        m_frustum_culler.add(drawable->bounds);
+                    }
+                }
+                else
+                {
+                    if (drawable->m_hierarchy_proxy != BoundingVolumeHierarchy<Drawable*>::null_node)
+                    {
+                        m_drawable_hierarchy.remove(drawable->m_hierarchy_proxy);
+                        drawable->m_hierarchy_proxy = BoundingVolumeHierarchy<Drawable*>::null_node;
+                    }
+
+                    m_always_visible_indices.emplace_back(drawable->m_culling_index);
+
+                    if (linear_culling)
+                    {
+                        m_frustum_culler.add_always_visible();
+                    }
+                }
+
+                drawable->entity->transform->needs_bounding_box_adjusting = false;
+
+                if (m_shadow_map_caching && material->casts_shadows)
+                {
+                    update_shadow_caster(drawable, moved, previous_bounds);
+                }
+
+                m_culled_drawables.emplace_back(drawable.get());
+                m_static_casters.emplace_back(drawable->m_frames_without_movement >= static_shadow_caster_frames);
+            }
+        }
     }
 
-    unbind_material(material);
+    m_visibility.resize(m_culled_drawables.size());
 }
 
-void Renderer::draw_instanced(std::shared_ptr<Material> const& material, glm::mat4 const& projection_view,
-                              glm::mat4 const& projection_view_no_translation) const
+Frustum Renderer::get_culling_frustum() const
 {
-    if (material->drawables.empty())
+    if (!m_cpu_frustum_culling)
+        return Camera::get_main_camera()->get_frustum();
+
+    return m_culling_frustum;
+}
+
+void Renderer::cull_view(Frustum const& frustum) const
+{
+    if (!m_cpu_frustum_culling)
         return;
 
-    auto const first_drawable = material->first_drawable;
-    auto const shader = material->shader;
+    m_culling_frustum = frustum;
 
-    material->model_matrices.clear();
-    material->model_matrices.reserve(material->drawables.size());
+    std::ranges::fill(m_visibility, 0);
 
-    if (material->is_billboard)
+    if (linear_culling)
     {
-        for (auto const& drawable : material->drawables)
+        m_frustum_culler.cull(frustum, m_visible_indices);
+
+        for (u32 const index : m_visible_indices)
         {
-            drawable->entity->transform->set_euler_angles(Camera::get_main_camera()->entity->transform->get_euler_angles());
+            m_visibility[index] = 1;
         }
+
+        return;
     }
 
-    // TODO: Adjust bounding boxes on GPU?
-    for (u32 i = 0; i < material->drawables.size(); ++i)
+    for (u32 const index : m_always_visible_indices)
     {
-        if (material->drawables[i]->entity->transform->needs_bounding_box_adjusting)
+        m_visibility[index] = 1;
+    }
+
+    m_drawable_hierarchy.query(frustum, [this](Drawable* const drawable) {
+        // Drawables of shaders that were unregistered aren't gathered anymore, so their culling index is stale
+        if (drawable->m_culling_index < m_culled_drawables.size() && m_culled_drawables[drawable->m_culling_index] == drawable)
         {
-            material->drawables[i]->bounds =
-                material->first_drawable->get_adjusted_bounding_box(material->drawables[i]->entity->transform->get_model_matrix());
-            material->bounding_boxes[i] = BoundingBoxShader(material->drawables[i]->bounds);
-            material->drawables[i]->entity->transform->needs_bounding_box_adjusting = false;
+            m_visibility[drawable->m_culling_index] = 1;
         }
+    });
+}
+
+void Renderer::assign_light_clusters() const
+{
+    auto const get_range = [](std::shared_ptr<Light> const& light, float const constant, float const linear, float const quadratic) {
+        // Disabled lights get no range, so they aren't assigned to any cluster
+        if (!light->enabled())
+            return 0.0f;
+
+        glm::vec3 const color = glm::max(light->ambient, glm::max(light->diffuse, light->specular));
+        return LightClusters::calculate_light_range(constant, linear, quadratic, glm::max(color.r, glm::max(color.g, color.b)));
+    };
+
+    m_cluster_point_lights.clear();
+    for (auto const& point_light : m_point_lights)
+    {
+        float const range = get_range(point_light, point_light->constant, point_light->linear, point_light->quadratic);
+        m_cluster_point_lights.emplace_back(point_light->entity->transform->get_position(), range);
     }
 
-    perform_frustum_culling(material);
+    // Bounding sphere of the whole light, the cone would be a tighter fit but spot lights are few and rarely cover many clusters
+    m_cluster_spot_lights.clear();
+    for (auto const& spot_light : m_spot_lights)
+    {
+        float const range = get_range(spot_light, spot_light->constant, spot_light->linear, spot_light->quadratic);
+        m_cluster_spot_lights.emplace_back(spot_light->entity->transform->get_position(), range);
+    }
 
-    shader->use();
+    auto const camera = Camera::get_main_camera();
+    m_light_clusters.set_projection(camera->get_projection(), camera->get_near_plane(), camera->get_far_plane());
+    m_light_clusters.assign(camera->get_view_matrix(), m_cluster_point_lights, m_cluster_spot_lights);
+}
 
-    //set_shader_uniforms(shader, projection_view, projection_view_no_translation);
+std::vector<std::shared_ptr<Drawable>> Renderer::get_drawables_in_box(BoundingBox const& bounds) const
+{
+    std::vector<std::shared_ptr<Drawable>> drawables = {};
 
-    shader->set_vec3("material.color",
-                     glm::vec3(first_drawable->material->color.x, first_drawable->material->color.y, first_drawable->material->color.z));
-    shader->set_float("material.specular", first_drawable->material->specular);
-    shader->set_float("material.shininess", first_drawable->material->shininess);
+    m_drawable_hierarchy.query(bounds, [&drawables](Drawable* const drawable) {
+        drawables.emplace_back(std::static_pointer_cast<Drawable>(drawable->shared_from_this()));
+    });
 
-    first_drawable->draw_instanced(material->model_matrices.size());
+    return drawables;
 }
 
-void Renderer::draw_transparent(glm::mat4 const& projection_view, glm::mat4 const& projection_view_no_translation) const
+std::vector<std::shared_ptr<Drawable>> Renderer::get_drawables_in_radius(glm::vec3 const& center, float const radius) const
 {
-    std::vector<std::shared_ptr<Drawable>> transparent_drawables = {};
+    std::vector<std::shared_ptr<Drawable>> drawables = {};
+
+    m_drawable_hierarchy.query_sphere(center, radius, [&drawables](Drawable* const drawable) {
+        drawables.emplace_back(std::static_pointer_cast<Drawable>(drawable->shared_from_this()));
+    });
+
+    return drawables;
+}
+
+std::shared_ptr<Drawable> Renderer::raycast_drawables(glm::vec3 const& origin, glm::vec3 const& direction, float const max_distance) const
+{
+    Drawable* closest = nullptr;
+    float closest_distance = max_distance;
+
+    m_drawable_hierarchy.query_ray(origin, direction, max_distance, [&](Drawable* const drawable, float const distance) {
+        if (distance <= closest_distance)
+        {
+            closest = drawable;
+            closest_distance = distance;
+        }
+    });
+
+    if (closest == nullptr)
+        return nullptr;
+
+    return std::static_pointer_cast<Drawable>(closest->shared_from_this());
+}
+
+bool Renderer::is_visible(std::shared_ptr<Drawable> const& drawable) const
+{
+    if (!m_cpu_frustum_culling)
+        return true;
+
+    u32 const index = drawable->m_culling_index;
 
-    for (auto const& material : m_transparent_materials)
+    // Drawables registered after culling was prepared are always visible for the rest of the frame.
+    // They are dynamic shadow casters, so they can't end up in cached shadow maps.
+    if (index >= m_culled_drawables.size() || m_culled_drawables[index] != drawable.get())
+        return m_shadow_caster_filter != ShadowCasterFilter::Static;
+
+    if (m_shadow_caster_filter != ShadowCasterFilter::All
+        && (m_static_casters[index] != 0) != (m_shadow_caster_filter == ShadowCasterFilter::Static))
+        return false;
+
+    return m_visibility[index] != 0;
+}
+
+void Renderer::update_shadow_caster(std::shared_ptr<Drawable> const& drawable, bool const moved, BoundingBox const& previous_bounds) const
+{
+    bool const was_static = drawable->m_frames_without_movement >= static_shadow_caster_frames;
+
+    if (moved)
+    {
+        drawable->m_frames_without_movement = 0;
+    }
+    else if (!was_static)
+    {
+        drawable->m_frames_without_movement++;
+    }
+
+    bool const is_static = drawable->m_frames_without_movement >= static_shadow_caster_frames;
+
+    // Bounds of drawables that can't be culled are not reliable, so they affect every shadow map
+    BoundingBox const unbounded = get_unbounded_box();
+    BoundingBox const& bounds = drawable->is_cullable() ? drawable->bounds : unbounded;
+    BoundingBox const& old_bounds = drawable->is_cullable() ? previous_bounds : unbounded;
+
+    if (moved)
     {
-        transparent_drawables.insert(transparent_drawables.end(), material->drawables.begin(), material->drawables.end());
+        m_moved_caster_bounds.emplace_back(old_bounds);
+        m_moved_caster_bounds.emplace_back(bounds);
     }
 
+    if (was_static != is_static)
+    {
+        m_static_caster_changes.emplace_back(was_static ? old_bounds : bounds);
+    }
+}
+
+bool Renderer::are_shadow_casters_affected(std::vector<BoundingBox> const& bounds, std::span<Frustum const> frustums)
+{
+    for (auto const& frustum : frustums)
+    {
+        for (auto const& caster_bounds : bounds)
+        {
+            if (FrustumCuller::is_visible(caster_bounds, frustum))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+void Renderer::build_render_queue() const
+{
+    m_render_queue.clear();
+    m_model_matrices.clear();
+    m_mesh_sort_ids.clear();
+    m_ui_batcher.clear();
+
     std::shared_ptr<Camera> const camera = Camera::get_main_camera();
-    glm::vec3 camera_position = camera->entity->transform->get_position();
+    glm::vec3 const camera_position = camera->entity->transform->get_position();
+    float const inverse_far_plane = 1.0f / camera->get_far_plane();
 
-    std::ranges::sort(transparent_drawables, [&camera_position](std::shared_ptr<Drawable> const& a, std::shared_ptr<Drawable> const& b) {
-        float const distance_a = glm::distance2(camera_position, a->entity->transform->get_position());
-        float const distance_b = glm::distance2(camera_position, b->entity->transform->get_position());
-        return distance_a >= distance_b; // For back-to-front rendering
-    });
+    u32 material_id = 0;
 
-    for (auto const& drawable : transparent_drawables)
+    for (u32 shader_id = 0; shader_id < m_shaders.size(); ++shader_id)
     {
-        drawable->material->shader->use();
+        auto const& shader = m_shaders[shader_id];
 
-        update_shader(drawable->material->shader, projection_view, projection_view_no_translation);
+        for (auto const& material : shader->materials)
+        {
+            material_id++;
 
+            i32 const render_order = material->get_render_order();
+
+            RenderPass custom_pass = RenderPass::Count;
+            if (material->has_custom_render_order())
+            {
+                custom_pass = render_order <= aa_render_order ? RenderPass::CustomBeforeAA : RenderPass::CustomAfterAA;
+            }
+
+            if (material->is_gpu_instanced)
+            {
+                // Instanced materials are drawn all at once, so they get a single packet without a drawable
+                if (material->is_transparent)
+                {
 #if _DEBUG
-        if (drawable->material->is_gpu_instanced)
+                    Debug::log("GPU instanced transparent materials are not supported.", DebugType::Error);
+#endif
+                    continue;
+                }
+
+                RenderPass pass = material->needs_forward_rendering ? RenderPass::Forward : RenderPass::Geometry;
+                if (custom_pass != RenderPass::Count)
+                {
+                    pass = custom_pass;
+                }
+
+                u64 const key = RenderQueue::make_opaque_key(pass, render_order, shader_id, material_id, 0, 0.0f);
+
+                m_render_queue.push({key, &shader, &material});
+                continue;
+            }
+
+            for (auto const& drawable : material->drawables)
+            {
+                // UI is in screen space, so it's never tested against the frustum of the camera
+                if (m_ui_batch_shader != nullptr && custom_pass != RenderPass::Count && drawable->get_ui_texture() != nullptr)
+                {
+                    if (drawable->get_rasterizer_draw_type() != RasterizerDrawType::None)
+                        drawable->add_ui_quads(m_ui_batcher, render_order);
+
+                    continue;
+                }
+
+                if (!is_visible(drawable))
+                    continue;
+
+                float const depth = glm::distance(camera_position, drawable->entity->transform->get_position()) * inverse_far_plane;
+
+                // Computed here, so command lists recorded on worker threads only read plain matrices and never update transforms
+                glm::mat4 const& model = drawable->entity->transform->get_model_matrix();
+
+                u32 mesh_id = 0;
+                if (Mesh const* mesh = drawable->get_sort_mesh())
+                {
+                    mesh_id = m_mesh_sort_ids.try_emplace(mesh, static_cast<u32>(m_mesh_sort_ids.size() + 1)).first->second;
+                }
+
+                // Drawables can be a part of two passes, e.g. deferred materials with a custom render order
+                if (!material->needs_forward_rendering || custom_pass == RenderPass::Count)
+                {
+                    RenderPass const pass = material->needs_forward_rendering ? RenderPass::Forward : RenderPass::Geometry;
+                    u64 const key = RenderQueue::make_opaque_key(pass, 0, shader_id, material_id, mesh_id, depth);
+
+                    push_drawable_packet({key, &shader, &material, &drawable}, model);
+                }
+
+                if (custom_pass == RenderPass::Count)
+                    continue;
+
+                u64 const key = material->is_transparent
+                                  ? RenderQueue::make_transparent_key(custom_pass, render_order, shader_id, material_id, depth)
+                                  : RenderQueue::make_opaque_key(custom_pass, render_order, shader_id, material_id, mesh_id, depth);
+
+                push_drawable_packet({key, &shader, &material, &drawable}, model);
+            }
+        }
+    }
+
+    // Groups are drawn like instanced materials, with a single packet without a drawable
+    m_ui_batcher.build(m_ui_batch_shader);
+
+    u32 const ui_shader_id = static_cast<u32>(m_shaders.size());
+
+    for (auto const& group : m_ui_batcher.get_groups())
+    {
+        material_id++;
+
+        i32 const render_order = group.material->get_render_order();
+        RenderPass const pass = render_order <= aa_render_order ? RenderPass::CustomBeforeAA : RenderPass::CustomAfterAA;
+        u64 const key = RenderQueue::make_opaque_key(pass, render_order, ui_shader_id, material_id, 0, 0.0f);
+
+        m_render_queue.push({key, &group.material->shader, &group.material});
+    }
+
+    m_render_queue.sort();
+}
+
+void Renderer::push_drawable_packet(RenderPacket const& packet, glm::mat4 const& model) const
+{
+    // Matrices are indexed by the push index of the packet, packets without a drawable leave a gap
+    m_model_matrices.resize(m_render_queue.size());
+    m_model_matrices.emplace_back(model);
+
+    m_render_queue.push(packet);
+}
+
+void Renderer::record_command_lists(glm::mat4 const& projection_view) const
+{
+    struct Chunk
+    {
+        RenderPass pass = RenderPass::Geometry;
+        std::span<RenderPacket const> packets = {};
+    };
+
+    std::vector<Chunk> chunks = {};
+
+    for (u32 pass = 0; pass < static_cast<u32>(RenderPass::Count); ++pass)
+    {
+        auto const packets = m_render_queue.get_packets(static_cast<RenderPass>(pass));
+
+        for (size_t offset = 0; offset < packets.size(); offset += command_list_size)
         {
-            Debug::log("GPU instanced transparent materials are not supported.", DebugType::Error);
-            return;
+            size_t const count = std::min<size_t>(command_list_size, packets.size() - offset);
+            chunks.push_back({static_cast<RenderPass>(pass), packets.subspan(offset, count)});
         }
-#endif
+    }
+
+    m_command_lists.resize(chunks.size());
+
+    // Model matrices of all queued drawables were computed by build_render_queue(), so recording doesn't touch any transforms
+    std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](Chunk const& chunk) {
+        m_command_lists[&chunk - chunks.data()].record(chunk.pass, chunk.packets, m_model_matrices, projection_view);
+    });
+}
+
+void Renderer::submit_command_lists(RenderPass const pass, glm::mat4 const& projection_view,
+                                    glm::mat4 const& projection_view_no_translation) const
+{
+    // Local class, so it can access the protected update functions of the renderer
+    class Backend final : public CommandListBackend
+    {
+    public:
+        Backend(Renderer const& renderer, RenderPass const pass, glm::mat4 const& projection_view,
+                glm::mat4 const& projection_view_no_translation)
+            : m_renderer(renderer), m_pass(pass), m_projection_view(projection_view),
+              m_projection_view_no_translation(projection_view_no_translation)
+        {
+        }
+
+        virtual void bind_shader(std::shared_ptr<Shader> const& shader) override
+        {
+            // Geometry pass renders everything with the G-Buffer shader, which is bound beforehand
+            if (m_pass == RenderPass::Geometry)
+                return;
+
+            shader->use();
 
-        update_material(drawable->material);
+            m_renderer.update_shader(shader, m_projection_view, m_projection_view_no_translation);
+        }
+
+        virtual void bind_material(std::shared_ptr<Material> const& material) override
+        {
+            // draw_instanced() sets up the material by itself
+            if (material->is_gpu_instanced)
+                return;
+
+            m_renderer.update_material(material);
+        }
+
+        virtual void unbind_material(std::shared_ptr<Material> const& material) override
+        {
+            if (material->is_gpu_instanced)
+                return;
+
+            m_renderer.unbind_material(material);
+        }
+
+        virtual void draw(std::shared_ptr<Drawable> const& drawable, std::shared_ptr<Material> const& material,
+                          ObjectConstants const& constants) override
+        {
+            m_renderer.update_object(drawable, material, m_projection_view, constants);
+
+            if (material->is_billboard)
+            {
+                m_renderer.orient_billboard(drawable);
+            }
+
+            drawable->draw();
+        }
+
+        virtual void draw_instanced(std::shared_ptr<Material> const& material) override
+        {
+            m_renderer.draw_instanced(material, m_projection_view, m_projection_view_no_translation);
+        }
+
+    private:
+        Renderer const& m_renderer;
+        RenderPass m_pass;
+        glm::mat4 const& m_projection_view;
+        glm::mat4 const& m_projection_view_no_translation;
+    };
+
+    Backend backend = {*this, pass, projection_view, projection_view_no_translation};
+
+    for (auto const& command_list : m_command_lists)
+    {
+        if (command_list.get_pass() == pass)
+        {
+            command_list.replay(backend);
+        }
+    }
+}
 
-        update_object(drawable, drawable->material, projection_view);
+void Renderer::draw(std::shared_ptr<Material> const& material, glm::mat4 const& projection_view) const
+{
+    update_material(material);
 
-        if (drawable->material->is_billboard)
+    for (auto const& drawable : material->drawables)
+    {
+        if (!is_visible(drawable))
+            continue;
+
+        update_object(drawable, material, projection_view,
+                      CommandList::make_object_constants(drawable->entity->transform->get_model_matrix(), projection_view));
+
+        if (material->is_billboard)
         {
-            drawable->entity->transform->set_euler_angles(Camera::get_main_camera()->entity->transform->get_euler_angles());
+            orient_billboard(drawable);
         }
 
         drawable->draw();
+    }
 
-        unbind_material(drawable->material);
+    unbind_material(material);
+}
+
+void Renderer::draw_instanced(std::shared_ptr<Material> const& material, glm::mat4 const& projection_view,
+                              glm::mat4 const& projection_view_no_translation) const
+{
+    if (UIGroup const* group = m_ui_batcher.find_group(material))
+    {
+        draw_ui_batches(m_ui_batcher.get_vertices(*group), m_ui_batcher.get_batches(*group));
+        return;
     }
+
+    if (material->drawables.empty())
+        return;
+
+    if (material->is_billboard)
+    {
+        for (auto const& drawable : material->drawables)
+        {
+            orient_billboard(drawable);
+        }
+    }
+
+    update_instance_bounds(material);
+
+    for (auto& batch : material->instance_batches)
+    {
+        batch.model_matrices.clear();
+    }
+
+    perform_frustum_culling(material);
+    draw_instance_batches(material, projection_view);
+}
+
+void Renderer::update_instance_bounds(std::shared_ptr<Material> const& material) const
+{
+    // TODO: Adjust bounding boxes on GPU?
+    for (u32 i = 0; i < material->drawables.size(); ++i)
+    {
+        auto const& drawable = material->drawables[i];
+
+        if (drawable->entity->transform->needs_bounding_box_adjusting)
+        {
+            BoundingBox const previous_bounds = drawable->bounds;
+            auto const& first_drawable = material->instance_batches[drawable->m_instance_batch].first_drawable;
+
+            drawable->bounds = first_drawable->get_adjusted_bounding_box(drawable->entity->transform->get_model_matrix());
+
+            if (material->is_billboard && m_shader_billboarding)
+            {
+                drawable->bounds = get_billboard_bounds(drawable->bounds, drawable->entity->transform->get_position());
+            }
+            drawable->entity->transform->needs_bounding_box_adjusting = false;
+
+            // Instanced drawables are always dynamic shadow casters, so they only invalidate cached shadow maps when they move
+            if (m_shadow_map_caching && material->casts_shadows)
+            {
+                m_moved_caster_bounds.emplace_back(first_drawable->is_cullable() ? previous_bounds : get_unbounded_box());
+                m_moved_caster_bounds.emplace_back(first_drawable->is_cullable() ? drawable->bounds : get_unbounded_box());
+            }
+        }
+    }
+}
+
+void Renderer::orient_billboard(std::shared_ptr<Drawable> const& drawable) const
+{
+    // Vertex shaders orient billboards by themselves, so transforms (and cached bounds) of static billboards stay untouched
+    if (m_shader_billboarding)
+        return;
+
+    drawable->entity->transform->set_euler_angles(Camera::get_main_camera()->entity->transform->get_euler_angles());
+}
+
+BoundingBox Renderer::get_billboard_bounds(BoundingBox const& bounds, glm::vec3 const& pivot)
+{
+    // Billboard rotates around its pivot, so the bounds have to contain every rotation of the unrotated bounds
+    float const radius = glm::distance(pivot, bounds.center) + glm::length(bounds.extents);
+    return {pivot - glm::vec3(radius), pivot + glm::vec3(radius)};
+}
+
+BoundingBox Renderer::get_unbounded_box()
+{
+    float constexpr unbounded_extents = std::numeric_limits<float>::max() / 8.0f;
+    return {glm::vec3(0.0f), unbounded_extents, unbounded_extents, unbounded_extents};
 }
 
 void Renderer::load_fonts()
 {
-    bool changed = false;
+    loaded_fonts.clear();
 
     for (auto const& path : std::filesystem::recursive_directory_iterator(m_font_path))
     {
@@ -573,8 +1105,6 @@ void Renderer::load_fonts()
             continue;
 
         std::string const path_str = path.path().string();
-        LPCSTR const wide_path = path_str.c_str();
-        i32 const loaded_fonts_count = AddFontResource(wide_path);
 
         std::string family_name = path.path().stem().string();
 
@@ -614,40 +1144,27 @@ void Renderer::load_fonts()
             loaded_fonts.emplace_back(new_font);
         }
 
-        // This might not return more than 0 if the font was already loaded or if it was loaded unsuccessfully, we can't tell for sure.
-        if (loaded_fonts_count > 0)
-        {
-            changed = true;
-
 #if _DEBUG
-            Debug::log("Loaded font: " + path.path().string());
+        Debug::log("Found font: " + path_str);
 #endif
-        }
-    }
-
-    if (changed)
-    {
-        PostMessage(HWND_BROADCAST, WM_FONTCHANGE, 0, 0);
     }
 }
 
-void Renderer::unload_fonts()
+std::string Renderer::find_font_path(std::string const& family_name, bool const bold)
 {
-    for (auto const& font : loaded_fonts)
+    auto const font = std::ranges::find(loaded_fonts, family_name, &Font::family_name);
+
+    if (font == loaded_fonts.end())
+        return {};
+
+    // Fonts without a file of the requested weight use their first file
+    for (auto const& path : font->paths)
     {
-        for (auto const& path : font.paths)
-        {
-            std::string const path_str = path;
-            LPCSTR const wide_path = path_str.c_str();
-            i32 const return_value = RemoveFontResource(wide_path);
+        bool const is_bold = std::filesystem::path(path).stem().string().find(" Bold") != std::string::npos;
 
-            if (return_value == 0)
-            {
-                // Failed to unload a font
-                std::cout << "Failed to unload font: " << path_str;
-            }
-        }
+        if (is_bold == bold)
+            return path;
     }
 
-    PostMessage(HWND_BROADCAST, WM_FONTCHANGE, 0, 0);
+    return font->paths.front();
 }
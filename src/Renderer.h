@@ -1,18 +1,31 @@
 #pragma once
 
+#include "BoundingVolumeHierarchy.h"
+#include "CommandList.h"
 #include "ConstantBufferTypes.h"
+#include "DebugDraw.h"
 #include "DirectionalLight.h"
 #include "Drawable.h"
 #include "EngineDefines.h"
 #include "Font.h"
+#include "FrustumCuller.h"
+#include "GlyphAtlas.h"
 #include "Light.h"
+#include "LightClusters.h"
 #include "Mesh.h"
 #include "PointLight.h"
+#include "RenderQueue.h"
+#include "RendererStatistics.h"
+#include "ShaderHotReload.h"
 #include "SpotLight.h"
+#include "TextLayout.h"
 #include "Texture.h"
+#include "UIBatcher.h"
 #include "Vertex.h"
 
-#include <set>
+#include <limits>
+#include <span>
+#include <unordered_map>
 
 #include <glm/mat4x4.hpp>
 
@@ -61,6 +74,19 @@ public:
 
     void set_vsync(bool const enabled);
 
+    // Spatial queries over world space bounds of all drawables except GPU instanced ones. Bounds are gathered together with
+    // frustum culling at the start of every frame, so queries only work with CPU frustum culling.
+    [[nodiscard]] std::vector<std::shared_ptr<Drawable>> get_drawables_in_box(BoundingBox const& bounds) const;
+    [[nodiscard]] std::vector<std::shared_ptr<Drawable>> get_drawables_in_radius(glm::vec3 const& center, float const radius) const;
+
+    // Closest drawable with bounds hit by the ray, nullptr if there is none
+    [[nodiscard]] std::shared_ptr<Drawable> raycast_drawables(glm::vec3 const& origin, glm::vec3 const& direction,
+                                                              float const max_distance = std::numeric_limits<float>::max()) const;
+
+    // Frustum of the view being rendered, so drawables can cull their own parts in draw(). Without CPU frustum culling
+    // views aren't culled one by one and the main camera's frustum is returned instead.
+    [[nodiscard]] Frustum get_culling_frustum() const;
+
     virtual void set_rasterizer_draw_type(RasterizerDrawType const rasterizer_draw_type) = 0;
     virtual void restore_default_rasterizer_draw_type() = 0;
 
@@ -79,6 +105,10 @@ public:
 
     bool wireframe_mode_active = false;
 
+    // Culls views by testing bounds of every drawable instead of querying the drawable hierarchy, enabled with --linear-culling
+    // so both can be compared in benchmarks
+    inline static bool linear_culling = false;
+
 #if EDITOR
     inline static ImVec4 clear_color = ImVec4(0.2f, 0.2f, 0.2f, 1.00f);
 #endif
@@ -92,8 +122,12 @@ public:
     inline static constexpr i32 aa_render_order = 2000;
     inline static constexpr i32 ui_render_order = 3000;
 
+    // Font files found in res/fonts, their glyphs are baked into atlases by the resource manager when texts use them
     inline static std::vector<Font> loaded_fonts = {};
 
+    // Path of the bold or regular file of a loaded font family, empty if the family isn't loaded
+    [[nodiscard]] static std::string find_font_path(std::string const& family_name, bool const bold);
+
 protected:
     Renderer() = default;
     virtual ~Renderer() = default;
@@ -107,15 +141,33 @@ protected:
                                glm::mat4 const& projection_view_no_translation) const = 0;
     void virtual update_material(std::shared_ptr<Material> const& material) const = 0;
     void virtual update_object(std::shared_ptr<Drawable> const& drawable, std::shared_ptr<Material> const& material,
-                               glm::mat4 const& projection_view) const = 0;
+                               glm::mat4 const& projection_view, ObjectConstants const& constants) const = 0;
 
     void virtual unbind_material(std::shared_ptr<Material> const& material) const = 0;
 
+    // Draws every instance batch of the material with the instances left visible by perform_frustum_culling()
+    void virtual draw_instance_batches(std::shared_ptr<Material> const& material, glm::mat4 const& projection_view) const = 0;
+
     void virtual initialize_global_renderer_settings() = 0;
     void virtual initialize_buffers(size_t const max_size) = 0;
+
+    // Fills model matrices of instance batches with the instances visible in the currently rendered view
     void virtual perform_frustum_culling(std::shared_ptr<Material> const& material) const = 0;
     virtual void render_shadow_maps() const = 0;
-    void render_single_shadow_map(glm::mat4 const& projection_view) const;
+
+    // Shadow map caching. Shadow casters that haven't moved for static_shadow_caster_frames frames are static, so they can be
+    // rendered once into a cached shadow map. Dynamic casters are rendered on top of a copy of it.
+    enum class ShadowCasterFilter : u8
+    {
+        All,
+        Static,
+        Dynamic,
+    };
+
+    void render_single_shadow_map(glm::mat4 const& projection_view, ShadowCasterFilter const filter = ShadowCasterFilter::All) const;
+
+    // Whether any of the bounds intersects any of the frustums
+    [[nodiscard]] static bool are_shadow_casters_affected(std::vector<BoundingBox> const& bounds, std::span<Frustum const> frustums);
 
     virtual void render_lighting_pass() const;
     virtual void render_geometry_pass(glm::mat4 const& projection_view) const;
@@ -130,6 +182,28 @@ protected:
     virtual void bind_universal_resources() const;
     virtual void bind_for_render_frame() const;
 
+    // Lines and text markers queued with DebugDraw, drawn on top of the forward pass. Lines of the whole frame are uploaded
+    // into one buffer and drawn with a single draw call.
+    void render_debug_drawings(glm::mat4 const& projection_view) const;
+    void virtual draw_debug_lines(std::span<DebugVertex const> const vertices, glm::mat4 const& projection_view) const = 0;
+    void draw_debug_texts(std::span<DebugText const> const texts, glm::mat4 const& projection_view) const;
+
+    // Draws batches of a single UI group from the group's vertices. Only called when the backend loaded m_ui_batch_shader,
+    // otherwise UI drawables are drawn one by one.
+    virtual void draw_ui_batches(std::span<UIVertex const> const vertices, std::span<UIBatch const> const batches) const;
+
+    // Renderer statistics. Sections of render() are timed on the CPU and, through timestamp queries issued by the backends,
+    // on the GPU. Backends read the queries back a few frames later and report the times with RendererStatistics::set_gpu_time().
+    void begin_pass(StatisticsPass const pass) const;
+    void end_pass(StatisticsPass const pass) const;
+
+    virtual void begin_gpu_frame() const;
+    virtual void end_gpu_frame() const;
+    virtual void begin_gpu_pass(StatisticsPass const pass) const;
+    virtual void end_gpu_pass(StatisticsPass const pass) const;
+
+    inline static u32 constexpr gpu_timer_frames = 4;
+
     inline static std::shared_ptr<Renderer> m_instance;
 
     bool vsync_enabled = false;
@@ -139,10 +213,27 @@ protected:
     inline static std::vector<std::shared_ptr<SpotLight>> m_spot_lights = {};
     inline static std::shared_ptr<DirectionalLight> m_directional_light = {};
 
-    // TODO: Retrieve this information from the shader
-    // NOTE: This has to be the same value as the variable in a shader to work in all cases.
-    i32 m_max_point_lights = 4;
-    i32 m_max_spot_lights = 4;
+    // Clustered lighting. Point and spot lights are assigned to clusters of the main camera's frustum once per frame, during culling.
+    // Backends upload all lights together with the clusters, shaders only iterate over the lights of a pixel's cluster.
+    // Lights that aren't assigned to any cluster can't be seen, so backends also skip rendering their shadow maps.
+    void assign_light_clusters() const;
+
+    // CPU frustum culling. All registered drawables are gathered once per frame, then every view (camera, shadow casting lights)
+    // is culled right before being rendered and draw() skips drawables outside of the currently culled view.
+    // Bounds of cullable drawables are kept in a bounding volume hierarchy, which is refitted with the bounds of moved drawables
+    // when they are gathered and queried for every view.
+    void prepare_frustum_culling() const;
+    void cull_view(Frustum const& frustum) const;
+    [[nodiscard]] bool is_visible(std::shared_ptr<Drawable> const& drawable) const;
+
+    // All passes rendered from the main camera are drawn from a single render queue, built once per frame after culling.
+    // Every pass is split into chunks of command_list_size packets, which are recorded into command lists on worker threads
+    // and replayed on the main thread when the pass is rendered.
+    void build_render_queue() const;
+    void push_drawable_packet(RenderPacket const& packet, glm::mat4 const& model) const;
+    void record_command_lists(glm::mat4 const& projection_view) const;
+    void submit_command_lists(RenderPass const pass, glm::mat4 const& projection_view,
+                              glm::mat4 const& projection_view_no_translation) const;
 
     void draw(std::shared_ptr<Material> const& material, glm::mat4 const& projection_view) const;
     void draw_instanced(std::shared_ptr<Material> const& material, glm::mat4 const& projection_view,
@@ -156,26 +247,70 @@ protected:
     std::shared_ptr<Shader> m_blur_shader = nullptr;
     std::shared_ptr<Shader> m_lighting_pass_shader = nullptr;
     std::shared_ptr<Shader> m_fxaa_shader = nullptr;
+    std::shared_ptr<Shader> m_debug_line_shader = nullptr;
+    std::shared_ptr<Shader> m_ui_batch_shader = nullptr;
 
-private:
-    void draw_transparent(glm::mat4 const& projection_view, glm::mat4 const& projection_view_no_translation) const;
-    static void load_fonts();
-    static void unload_fonts();
+    bool m_cpu_frustum_culling = false;
 
-    struct MaterialWithOrder
-    {
-        i32 render_order;
-        std::shared_ptr<Material> material;
+    mutable FrustumCuller m_frustum_culler = {};
+    mutable BoundingVolumeHierarchy<Drawable*> m_drawable_hierarchy = {};
+    mutable std::vector<u32> m_always_visible_indices = {};
+    mutable Frustum m_culling_frustum = {};
+    mutable std::vector<Drawable const*> m_culled_drawables = {};
+    mutable std::vector<u32> m_visible_indices = {};
+    mutable std::vector<u8> m_visibility = {};
 
-        bool operator<(MaterialWithOrder const& b) const
-        {
-            return render_order < b.render_order;
-        }
-    };
+    mutable LightClusters m_light_clusters = {};
+    mutable std::vector<ClusterLight> m_cluster_point_lights = {};
+    mutable std::vector<ClusterLight> m_cluster_spot_lights = {};
+
+    bool m_shadow_map_caching = false;
+
+    // Shader billboarding. Vertex shaders replace the rotation of billboards with the rotation of the main camera,
+    // otherwise transforms of billboards are rotated towards the camera every time they are drawn.
+    bool m_shader_billboarding = false;
+
+    // Old and new bounds of all shadow casters that moved since shadow maps were last rendered
+    mutable std::vector<BoundingBox> m_moved_caster_bounds = {};
+
+    // Bounds of shadow casters that became static or stopped being static since shadow maps were last rendered
+    mutable std::vector<BoundingBox> m_static_caster_changes = {};
+
+    mutable std::vector<u8> m_static_casters = {};
+    mutable ShadowCasterFilter m_shadow_caster_filter = ShadowCasterFilter::All;
+
+    inline static u32 constexpr static_shadow_caster_frames = 60;
+
+    mutable RenderQueue m_render_queue = {};
 
-    std::multiset<MaterialWithOrder> m_custom_render_order_materials_before_aa = {};
-    std::multiset<MaterialWithOrder> m_custom_render_order_materials_after_aa = {};
-    std::vector<std::shared_ptr<Material>> m_transparent_materials = {};
+    // Model matrices of queued drawables, by push index of their packets
+    mutable std::vector<glm::mat4> m_model_matrices = {};
+    mutable std::unordered_map<Mesh const*, u32> m_mesh_sort_ids = {};
+
+    // Quads of UI drawables are gathered while building the render queue, every group gets a single packet in it
+    mutable UIBatcher m_ui_batcher = {};
+
+    // Debug texts are drawn with the UI batch shader too, in a single group of their own
+    mutable UIBatcher m_debug_text_batcher = {};
+    mutable TextLayoutCache m_debug_text_layouts = {};
+    mutable std::shared_ptr<GlyphAtlas> m_debug_font_atlas = {};
+    mutable std::shared_ptr<Texture> m_debug_font_texture = {};
+    inline static float constexpr debug_text_size = 16.0f;
+
+    mutable std::vector<CommandList> m_command_lists = {};
+    inline static u32 constexpr command_list_size = 256;
+
+#if EDITOR
+    mutable ShaderHotReload m_shader_hot_reload = {};
+#endif
+
+private:
+    void update_shadow_caster(std::shared_ptr<Drawable> const& drawable, bool const moved, BoundingBox const& previous_bounds) const;
+    void update_instance_bounds(std::shared_ptr<Material> const& material) const;
+    void orient_billboard(std::shared_ptr<Drawable> const& drawable) const;
+    [[nodiscard]] static BoundingBox get_billboard_bounds(BoundingBox const& bounds, glm::vec3 const& pivot);
+    [[nodiscard]] static BoundingBox get_unbounded_box();
+    static void load_fonts();
 
     std::vector<std::shared_ptr<Camera>> m_cameras = {};
 
@@ -3,6 +3,7 @@
 #include <array>
 #include <iostream>
 
+#include "AK/AK.h"
 #include "Camera.h"
 #include "DebugInputController.h"
 #include "Drawable.h"
@@ -14,6 +15,7 @@
 #include "Input.h"
 #include "Model.h"
 #include "ResourceManager.h"
+#include "ShaderDX11.h"
 #include "ShaderFactory.h"
 #include "ShadingDefines.h"
 #include "Skybox.h"
@@ -38,6 +40,9 @@ std::shared_ptr<RendererDX11> RendererDX11::create()
 
     TextureLoaderDX11::create();
 
+    // Compiles all changed shaders in parallel before they are created one by one while loading the scene
+    ShaderDX11::precompile("./res/shaders/");
+
     D3D11_BUFFER_DESC desc;
     desc.Usage = D3D11_USAGE_DYNAMIC;
     desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
@@ -113,6 +118,25 @@ std::shared_ptr<RendererDX11> RendererDX11::create()
     hr = renderer->get_device()->CreateBuffer(&time_buffer_desc, nullptr, &renderer->m_constant_buffer_psmisc);
     assert(SUCCEEDED(hr));
 
+    D3D11_BUFFER_DESC draw_flags_buffer_desc = {};
+    draw_flags_buffer_desc.Usage = D3D11_USAGE_IMMUTABLE;
+    draw_flags_buffer_desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    draw_flags_buffer_desc.ByteWidth = sizeof(ConstantBufferDrawFlags);
+
+    for (u32 i = 0; i < renderer->m_constant_buffers_draw_flags.size(); ++i)
+    {
+        ConstantBufferDrawFlags draw_flags_data = {};
+        draw_flags_data.is_instanced = (i & 1) != 0;
+        draw_flags_data.is_billboard = (i & 2) != 0;
+
+        D3D11_SUBRESOURCE_DATA draw_flags_initial_data = {};
+        draw_flags_initial_data.pSysMem = &draw_flags_data;
+
+        hr = renderer->get_device()->CreateBuffer(&draw_flags_buffer_desc, &draw_flags_initial_data,
+                                                  &renderer->m_constant_buffers_draw_flags[i]);
+        assert(SUCCEEDED(hr));
+    }
+
     renderer->create_depth_stencil();
     renderer->create_rasterizer_state();
 
@@ -134,6 +158,10 @@ std::shared_ptr<RendererDX11> RendererDX11::create()
     renderer->m_lighting_pass_shader =
         ResourceManager::get_instance().load_shader("./res/shaders/deferred_lighting.hlsl", "./res/shaders/deferred_lighting.hlsl");
     renderer->m_fxaa_shader = ResourceManager::get_instance().load_shader("./res/shaders/fxaa.hlsl", "./res/shaders/fxaa.hlsl");
+    renderer->m_debug_line_shader =
+        ResourceManager::get_instance().load_shader("./res/shaders/debug_lines.hlsl", "./res/shaders/debug_lines.hlsl");
+    renderer->m_ui_batch_shader =
+        ResourceManager::get_instance().load_shader("./res/shaders/ui_batched.hlsl", "./res/shaders/ui_batched.hlsl");
 
     // FIXME: Maybe move this somewhere else
     D3D11_SAMPLER_DESC repeat_sampler_desc = {};
@@ -182,6 +210,9 @@ std::shared_ptr<RendererDX11> RendererDX11::create()
 
 RendererDX11::RendererDX11(AK::Badge<RendererDX11>)
 {
+    m_cpu_frustum_culling = true;
+    m_shadow_map_caching = true;
+    m_shader_billboarding = true;
 }
 
 void RendererDX11::on_window_resize(GLFWwindow* window, i32 const width, i32 const height)
@@ -265,24 +296,8 @@ void RendererDX11::render_geometry_pass(glm::mat4 const& projection_view) const
     g_pd3dDeviceContext->RSSetViewports(1, &m_viewport);
     m_gbuffer->use_shader();
 
-    for (auto const& shader : m_shaders)
-    {
-        for (auto const& material : shader->materials)
-        {
-            if (material->needs_forward_rendering)
-                continue;
-
-            if (material->is_gpu_instanced)
-            {
-                // GPU instancing is not implemented in DX11
-                std::unreachable();
-            }
-            else
-            {
-                draw(material, projection_view);
-            }
-        }
-    }
+    // G-Buffer shader is used for every packet, so projection view without translation is never needed here
+    submit_command_lists(RenderPass::Geometry, projection_view, projection_view);
 }
 
 void RendererDX11::render_ssao() const
@@ -302,6 +317,7 @@ void RendererDX11::render_ssao() const
     D3D11_MAPPED_SUBRESOURCE mapped_resource = {};
     HRESULT const hr = get_device_context()->Map(m_constant_buffer_ssao, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped_resource);
     assert(SUCCEEDED(hr));
+    RendererStatistics::add_buffer_upload();
 
     CopyMemory(mapped_resource.pData, &ssao_data, sizeof(ConstantBufferSSAO));
     get_device_context()->Unmap(m_constant_buffer_ssao, 0);
@@ -399,49 +415,141 @@ void RendererDX11::inject_light_range(float const range)
 
 void RendererDX11::render_shadow_maps() const
 {
+    // Billboards face the main camera in shadow maps as well, so the camera buffer is uploaded once for the whole frame here
+    set_camera_position_buffer();
+
     set_RS_for_shadow_mapping();
 
     get_device_context()->OMSetDepthStencilState(m_depth_stencil_state, 0);
 
+    // Lights outside of the view don't need shadow maps, the remaining ones get shadow map registers in order until they run out.
+    // Shadow maps of skipped lights weren't kept up to date with moving casters, so they have to be rendered again.
+    auto const select_shadowed_lights = [](auto const& lights, auto const& is_visible, std::vector<u32>& shadowed_lights) {
+        shadowed_lights.clear();
+
+        for (u32 i = 0; i < lights.size(); ++i)
+        {
+            if (shadowed_lights.size() < MAX_SHADOWED_LIGHTS && is_visible(i))
+            {
+                shadowed_lights.emplace_back(i);
+                continue;
+            }
+
+            lights[i]->m_is_shadow_map_cached = false;
+            lights[i]->m_is_static_shadow_map_cached = false;
+        }
+    };
+
+    select_shadowed_lights(m_point_lights, [this](u32 const i) { return m_light_clusters.is_point_light_visible(i); },
+                           m_shadowed_point_lights);
+    select_shadowed_lights(m_spot_lights, [this](u32 const i) { return m_light_clusters.is_spot_light_visible(i); },
+                           m_shadowed_spot_lights);
+
     // Directional light
     if (m_directional_light != nullptr)
     {
-        m_directional_light->set_render_target_for_shadow_mapping();
         m_shadow_shader->use();
-        render_single_shadow_map(m_directional_light->get_projection_view_matrix());
+
+        std::array const projection_views = {m_directional_light->get_projection_view_matrix()};
+        render_cached_shadow_map(m_directional_light, projection_views, [](u32 const, bool const clear) {
+            m_directional_light->set_render_target_for_shadow_mapping(clear);
+        });
     }
 
 #if RENDER_POINT_SHADOW_MAPS == true
     // Point lights
-    if (m_point_lights.size() > 0)
+    if (!m_shadowed_point_lights.empty())
     {
         m_point_shadow_shader->use();
     }
 
-    for (u32 i = 0; i < m_point_lights.size(); ++i)
+    for (u32 const i : m_shadowed_point_lights)
     {
         update_depth_shader(m_point_lights[i]);
+
+        std::array<glm::mat4, 6> projection_views = {};
         for (u32 face = 0; face < 6; ++face)
         {
-            m_point_lights[i]->set_render_target_for_shadow_mapping(face);
-            render_single_shadow_map(m_point_lights[i]->get_projection_view_matrix(face));
+            projection_views[face] = m_point_lights[i]->get_projection_view_matrix(face);
         }
+
+        render_cached_shadow_map(m_point_lights[i], projection_views, [i](u32 const face, bool const clear) {
+            m_point_lights[i]->set_render_target_for_shadow_mapping(face, clear);
+        });
     }
 #endif // RENDER_POINT_SHADOW_MAPS == true
 
     // Spot lights
 
-    if (m_spot_lights.size() > 0)
+    if (!m_shadowed_spot_lights.empty())
     {
         m_shadow_shader->use();
     }
 
-    for (u32 i = 0; i < m_spot_lights.size(); ++i)
+    for (u32 const i : m_shadowed_spot_lights)
     {
         update_depth_shader(m_spot_lights[i]);
-        m_spot_lights[i]->set_render_target_for_shadow_mapping();
-        render_single_shadow_map(m_spot_lights[i]->get_projection_view_matrix());
+
+        std::array const projection_views = {m_spot_lights[i]->get_projection_view_matrix()};
+        render_cached_shadow_map(m_spot_lights[i], projection_views, [i](u32 const, bool const clear) {
+            m_spot_lights[i]->set_render_target_for_shadow_mapping(clear);
+        });
+    }
+}
+
+void RendererDX11::render_cached_shadow_map(std::shared_ptr<Light> const& light, std::span<glm::mat4 const> const projection_views,
+                                            std::function<void(u32, bool)> const& set_render_target) const
+{
+    if (!m_shadow_map_caching)
+    {
+        for (u32 face = 0; face < projection_views.size(); ++face)
+        {
+            set_render_target(face, true);
+            render_single_shadow_map(projection_views[face]);
+        }
+
+        return;
+    }
+
+    bool light_moved = !light->m_is_shadow_map_cached;
+
+    std::array<Frustum, 6> frustums = {};
+    for (u32 face = 0; face < projection_views.size(); ++face)
+    {
+        light_moved |= projection_views[face] != light->m_cached_projection_views[face];
+        frustums[face] = Frustum::from_projection_view(projection_views[face]);
+    }
+
+    std::span<Frustum const> const light_frustums = {frustums.data(), projection_views.size()};
+
+    bool const static_casters_changed = light_moved || !light->m_is_static_shadow_map_cached
+                                     || are_shadow_casters_affected(m_static_caster_changes, light_frustums);
+
+    // Neither the light nor anything inside of its frustum has moved, so the shadow map is still valid
+    if (!static_casters_changed && !are_shadow_casters_affected(m_moved_caster_bounds, light_frustums))
+        return;
+
+    if (static_casters_changed)
+    {
+        for (u32 face = 0; face < projection_views.size(); ++face)
+        {
+            light->set_render_target_for_static_shadow_mapping(face);
+            render_single_shadow_map(projection_views[face], ShadowCasterFilter::Static);
+        }
+
+        light->m_is_static_shadow_map_cached = true;
     }
+
+    light->restore_static_shadow_map();
+
+    for (u32 face = 0; face < projection_views.size(); ++face)
+    {
+        set_render_target(face, false);
+        render_single_shadow_map(projection_views[face], ShadowCasterFilter::Dynamic);
+        light->m_cached_projection_views[face] = projection_views[face];
+    }
+
+    light->m_is_shadow_map_cached = true;
 }
 
 // This is technically a rendering pass but I didn't make a RenderPassResourceContainer for it
@@ -468,8 +576,6 @@ void RendererDX11::render_aa() const
 
 void RendererDX11::render_lighting_pass() const
 {
-    set_light_buffer();
-
     update_shader(nullptr, glm::mat4(1.0f), glm::mat4(1.0f));
 
     g_pd3dDeviceContext->PSSetSamplers(0, 1, &m_clamp_border_sampler_state);
@@ -550,6 +656,7 @@ void RendererDX11::update_depth_shader(std::shared_ptr<Light> const& light) cons
     D3D11_MAPPED_SUBRESOURCE mapped_resource = {};
     HRESULT const hr = get_device_context()->Map(m_constant_buffer_point_shadows, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped_resource);
     assert(SUCCEEDED(hr));
+    RendererStatistics::add_buffer_upload();
 
     CopyMemory(mapped_resource.pData, &data, sizeof(ConstantBufferDepth));
 
@@ -564,15 +671,17 @@ void RendererDX11::update_shader(std::shared_ptr<Shader> const& shader, glm::mat
     {
         g_pd3dDeviceContext->PSSetShaderResources(1, 1, m_directional_light->get_shadow_shader_resource_view_address());
     }
-    for (u32 i = 0; i < m_spot_lights.size(); ++i)
+    for (u32 i = 0; i < m_shadowed_spot_lights.size(); ++i)
     {
         u32 const register_slot = i + spot_light_shadow_register_offset;
-        g_pd3dDeviceContext->PSSetShaderResources(register_slot, 1, m_spot_lights[i]->get_shadow_shader_resource_view_address());
+        auto const& spot_light = m_spot_lights[m_shadowed_spot_lights[i]];
+        g_pd3dDeviceContext->PSSetShaderResources(register_slot, 1, spot_light->get_shadow_shader_resource_view_address());
     }
-    for (u32 i = 0; i < m_point_lights.size(); ++i)
+    for (u32 i = 0; i < m_shadowed_point_lights.size(); ++i)
     {
         u32 const register_slot = i + point_light_shadow_register_offset;
-        g_pd3dDeviceContext->PSSetShaderResources(register_slot, 1, m_point_lights[i]->get_shadow_shader_resource_view_address());
+        auto const& point_light = m_point_lights[m_shadowed_point_lights[i]];
+        g_pd3dDeviceContext->PSSetShaderResources(register_slot, 1, point_light->get_shadow_shader_resource_view_address());
     }
 
     g_pd3dDeviceContext->PSSetSamplers(1, 1, &m_shadow_sampler_state);
@@ -585,32 +694,30 @@ void RendererDX11::update_material(std::shared_ptr<Material> const& material) co
 }
 
 void RendererDX11::update_object(std::shared_ptr<Drawable> const& drawable, std::shared_ptr<Material> const& material,
-                                 glm::mat4 const& projection_view) const
+                                 glm::mat4 const& projection_view, ObjectConstants const& constants) const
 {
     ConstantBufferPerObject data = {};
-    glm::mat4 const model = drawable->entity->transform->get_model_matrix();
-    data.projection_view_model = projection_view * model;
-    data.model = drawable->entity->transform->get_model_matrix();
+    data.projection_view_model = constants.projection_view_model;
+    data.model = constants.model;
     data.projection_view = projection_view;
     data.is_glowing = drawable->is_glowing();
 
     D3D11_MAPPED_SUBRESOURCE mapped_resource;
     HRESULT hr = get_device_context()->Map(m_constant_buffer_per_object, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped_resource);
     assert(SUCCEEDED(hr));
+    RendererStatistics::add_buffer_upload();
 
     CopyMemory(mapped_resource.pData, &data, sizeof(ConstantBufferPerObject));
 
     get_device_context()->Unmap(m_constant_buffer_per_object, 0);
     get_device_context()->VSSetConstantBuffers(0, 1, &m_constant_buffer_per_object);
     get_device_context()->PSSetConstantBuffers(10, 1, &m_constant_buffer_per_object);
+    bind_draw_flags(false, material->is_billboard);
 
     if (drawable->is_particle())
     {
         set_particle_buffer(drawable, material);
     }
-
-    set_light_buffer();
-    set_camera_position_buffer(drawable);
 }
 
 void RendererDX11::unbind_material(std::shared_ptr<Material> const& material) const
@@ -619,10 +726,164 @@ void RendererDX11::unbind_material(std::shared_ptr<Material> const& material) co
         Skybox::get_instance()->unbind();
 }
 
+void RendererDX11::draw_instance_batches(std::shared_ptr<Material> const& material, glm::mat4 const& projection_view) const
+{
+    for (auto const& batch : material->instance_batches)
+    {
+        if (batch.model_matrices.empty())
+            continue;
+
+        update_instances(material, batch, projection_view);
+
+        batch.first_drawable->draw_instanced(static_cast<i32>(batch.model_matrices.size()));
+    }
+}
+
+void RendererDX11::update_instances(std::shared_ptr<Material> const& material, InstanceBatch const& batch,
+                                    glm::mat4 const& projection_view) const
+{
+    u32 const instance_count = static_cast<u32>(batch.model_matrices.size());
+
+    // All instanced draws share one buffer, which is rewritten for every draw and only recreated when it doesn't fit anymore
+    if (m_instance_buffer == nullptr || instance_count > m_instance_buffer_capacity)
+    {
+        if (m_instance_buffer != nullptr)
+        {
+            m_instance_srv->Release();
+            m_instance_buffer->Release();
+        }
+
+        m_instance_buffer_capacity = glm::max(instance_count, glm::max(m_instance_buffer_capacity * 2, 256u));
+        create_structured_buffer(sizeof(glm::mat4), m_instance_buffer_capacity, &m_instance_buffer, &m_instance_srv);
+    }
+
+    D3D11_MAPPED_SUBRESOURCE mapped_resource = {};
+    HRESULT hr = get_device_context()->Map(m_instance_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped_resource);
+    assert(SUCCEEDED(hr));
+    RendererStatistics::add_buffer_upload();
+
+    CopyMemory(mapped_resource.pData, batch.model_matrices.data(), instance_count * sizeof(glm::mat4));
+    get_device_context()->Unmap(m_instance_buffer, 0);
+
+    // Model matrix comes from the instance buffer, object buffer only provides the projection view matrix
+    ConstantBufferPerObject data = {};
+    data.projection_view_model = projection_view;
+    data.model = glm::mat4(1.0f);
+    data.projection_view = projection_view;
+    data.is_glowing = 0;
+
+    hr = get_device_context()->Map(m_constant_buffer_per_object, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped_resource);
+    assert(SUCCEEDED(hr));
+    RendererStatistics::add_buffer_upload();
+
+    CopyMemory(mapped_resource.pData, &data, sizeof(ConstantBufferPerObject));
+    get_device_context()->Unmap(m_constant_buffer_per_object, 0);
+
+    get_device_context()->VSSetConstantBuffers(0, 1, &m_constant_buffer_per_object);
+    get_device_context()->PSSetConstantBuffers(10, 1, &m_constant_buffer_per_object);
+    bind_draw_flags(true, material->is_billboard);
+    get_device_context()->VSSetShaderResources(instance_register, 1, &m_instance_srv);
+}
+
+void RendererDX11::draw_debug_lines(std::span<DebugVertex const> const vertices, glm::mat4 const& projection_view) const
+{
+    u32 const vertex_count = static_cast<u32>(vertices.size());
+
+    // Lines of the whole frame share one buffer
+    upload_dynamic_structured_buffer(vertices.data(), sizeof(DebugVertex), vertex_count, m_debug_vertex_buffer, m_debug_vertex_srv,
+                                     m_debug_vertex_capacity);
+
+    ConstantBufferPerObject data = {};
+    data.projection_view_model = projection_view;
+    data.model = glm::mat4(1.0f);
+    data.projection_view = projection_view;
+    data.is_glowing = 0;
+
+    D3D11_MAPPED_SUBRESOURCE mapped_resource = {};
+    HRESULT const hr = get_device_context()->Map(m_constant_buffer_per_object, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped_resource);
+    assert(SUCCEEDED(hr));
+    RendererStatistics::add_buffer_upload();
+
+    CopyMemory(mapped_resource.pData, &data, sizeof(ConstantBufferPerObject));
+    get_device_context()->Unmap(m_constant_buffer_per_object, 0);
+
+    m_debug_line_shader->use();
+
+    get_device_context()->VSSetConstantBuffers(0, 1, &m_constant_buffer_per_object);
+    get_device_context()->VSSetShaderResources(debug_vertex_register, 1, &m_debug_vertex_srv);
+    get_device_context()->IASetInputLayout(nullptr);
+    get_device_context()->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
+
+    get_device_context()->Draw(vertex_count, 0);
+    RendererStatistics::add_draw_call(0);
+}
+
+void RendererDX11::draw_ui_batches(std::span<UIVertex const> const vertices, std::span<UIBatch const> const batches) const
+{
+    upload_dynamic_structured_buffer(vertices.data(), sizeof(UIVertex), static_cast<u32>(vertices.size()), m_ui_vertex_buffer,
+                                     m_ui_vertex_srv, m_ui_vertex_capacity);
+
+    // UI batch shader is already bound by the render queue, vertices are read by their index
+    get_device_context()->VSSetShaderResources(ui_vertex_register, 1, &m_ui_vertex_srv);
+    get_device_context()->IASetInputLayout(nullptr);
+    get_device_context()->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+    for (auto const& batch : batches)
+    {
+        get_device_context()->PSSetShaderResources(0, 1, &batch.texture->shader_resource_view);
+        get_device_context()->PSSetSamplers(0, 1, &batch.texture->image_sampler_state);
+        RendererStatistics::add_texture_binds(1);
+
+        get_device_context()->Draw(batch.vertex_count, batch.first_vertex);
+        RendererStatistics::add_draw_call(batch.vertex_count);
+    }
+
+    ID3D11ShaderResourceView* null_shader_resource_view = nullptr;
+    get_device_context()->PSSetShaderResources(0, 1, &null_shader_resource_view);
+    get_device_context()->VSSetShaderResources(ui_vertex_register, 1, &null_shader_resource_view);
+}
+
+void RendererDX11::upload_dynamic_structured_buffer(void const* data, u32 const stride, u32 const count, ID3D11Buffer*& buffer,
+                                                    ID3D11ShaderResourceView*& srv, u32& capacity) const
+{
+    // Buffer is only recreated when the data doesn't fit anymore
+    if (buffer == nullptr || count > capacity)
+    {
+        if (buffer != nullptr)
+        {
+            srv->Release();
+            buffer->Release();
+        }
+
+        capacity = glm::max(count, glm::max(capacity * 2, 1024u));
+        create_structured_buffer(stride, capacity, &buffer, &srv);
+    }
+
+    D3D11_MAPPED_SUBRESOURCE mapped_resource = {};
+    HRESULT const hr = get_device_context()->Map(buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped_resource);
+    assert(SUCCEEDED(hr));
+    RendererStatistics::add_buffer_upload();
+
+    CopyMemory(mapped_resource.pData, data, static_cast<size_t>(stride) * count);
+    get_device_context()->Unmap(buffer, 0);
+}
+
+void RendererDX11::bind_instances(ID3D11ShaderResourceView* instances) const
+{
+    // Object buffer already provides the projection view matrix of the current view
+    bind_draw_flags(true, false);
+    get_device_context()->VSSetShaderResources(instance_register, 1, &instances);
+}
+
 void RendererDX11::bind_universal_resources() const
 {
     g_pd3dDeviceContext->PSSetShaderResources(16, 1, &m_shadow_texture->shader_resource_view);
 
+    // Lights don't change during the frame, so they are only uploaded once instead of for every drawn object.
+    // Camera buffer is uploaded before rendering shadow maps, see render_shadow_maps().
+    set_light_buffer();
+    update_light_clusters();
+
     ConstantBufferPSMisc misc_data = {};
     misc_data.time = static_cast<float>(glfwGetTime());
     misc_data.is_fog_rendered = Engine::is_game_running();
@@ -634,6 +895,7 @@ void RendererDX11::bind_universal_resources() const
     D3D11_MAPPED_SUBRESOURCE time_resource = {};
     HRESULT const hr = get_device_context()->Map(m_constant_buffer_psmisc, 0, D3D11_MAP_WRITE_DISCARD, 0, &time_resource);
     assert(SUCCEEDED(hr));
+    RendererStatistics::add_buffer_upload();
 
     g_pd3dDeviceContext->PSSetSamplers(2, 1, &m_repeat_sampler_state);
 
@@ -643,6 +905,62 @@ void RendererDX11::bind_universal_resources() const
     get_device_context()->PSSetConstantBuffers(3, 1, &m_constant_buffer_psmisc);
 }
 
+void RendererDX11::update_light_clusters() const
+{
+    auto const& clusters = m_light_clusters.get_clusters();
+    auto const& light_indices = m_light_clusters.get_light_indices();
+
+    if (m_light_cluster_buffer == nullptr)
+    {
+        create_structured_buffer(sizeof(LightCluster), LightClusters::entry_count, &m_light_cluster_buffer, &m_light_cluster_srv);
+    }
+
+    D3D11_MAPPED_SUBRESOURCE mapped_resource = {};
+    HRESULT const hr = get_device_context()->Map(m_light_cluster_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped_resource);
+    assert(SUCCEEDED(hr));
+    RendererStatistics::add_buffer_upload();
+
+    CopyMemory(mapped_resource.pData, clusters.data(), clusters.size() * sizeof(LightCluster));
+    get_device_context()->Unmap(m_light_cluster_buffer, 0);
+
+    // Index list and lights grow with the number of lights in the scene
+    upload_dynamic_structured_buffer(light_indices.data(), sizeof(u32), static_cast<u32>(light_indices.size()), m_light_index_buffer,
+                                     m_light_index_srv, m_light_index_capacity);
+    upload_dynamic_structured_buffer(m_point_light_data.data(), sizeof(DXPointLight), static_cast<u32>(m_point_light_data.size()),
+                                     m_point_light_buffer, m_point_light_srv, m_point_light_capacity);
+    upload_dynamic_structured_buffer(m_spot_light_data.data(), sizeof(DXSpotLight), static_cast<u32>(m_spot_light_data.size()),
+                                     m_spot_light_buffer, m_spot_light_srv, m_spot_light_capacity);
+
+    get_device_context()->PSSetShaderResources(light_cluster_register, 1, &m_light_cluster_srv);
+    get_device_context()->PSSetShaderResources(light_index_register, 1, &m_light_index_srv);
+    get_device_context()->PSSetShaderResources(point_light_register, 1, &m_point_light_srv);
+    get_device_context()->PSSetShaderResources(spot_light_register, 1, &m_spot_light_srv);
+}
+
+void RendererDX11::create_structured_buffer(u32 const stride, u32 const count, ID3D11Buffer** buffer,
+                                           ID3D11ShaderResourceView** srv) const
+{
+    D3D11_BUFFER_DESC buffer_desc = {};
+    buffer_desc.Usage = D3D11_USAGE_DYNAMIC;
+    buffer_desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    buffer_desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    buffer_desc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    buffer_desc.ByteWidth = stride * count;
+    buffer_desc.StructureByteStride = stride;
+
+    HRESULT hr = get_device()->CreateBuffer(&buffer_desc, nullptr, buffer);
+    assert(SUCCEEDED(hr));
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srv_desc = {};
+    srv_desc.Format = DXGI_FORMAT_UNKNOWN;
+    srv_desc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+    srv_desc.Buffer.FirstElement = 0;
+    srv_desc.Buffer.NumElements = count;
+
+    hr = get_device()->CreateShaderResourceView(*buffer, &srv_desc, srv);
+    assert(SUCCEEDED(hr));
+}
+
 void RendererDX11::initialize_global_renderer_settings()
 {
     D3D11_BLEND_DESC blend_desc = {};
@@ -679,6 +997,16 @@ void RendererDX11::initialize_buffers(size_t const max_size)
 
 void RendererDX11::perform_frustum_culling(std::shared_ptr<Material> const& material) const
 {
+    for (auto const& drawable : material->drawables)
+    {
+        auto& batch = material->instance_batches[drawable->get_instance_batch()];
+
+        // Bounds are taken from the first drawable's meshes, they can't be trusted if they don't cover the whole drawable
+        if (batch.first_drawable->is_cullable() && !FrustumCuller::is_visible(drawable->bounds, m_culling_frustum))
+            continue;
+
+        batch.model_matrices.emplace_back(drawable->entity->transform->get_model_matrix());
+    }
 }
 
 D3D11_VIEWPORT RendererDX11::create_viewport(i32 const width, i32 const height)
@@ -717,56 +1045,75 @@ void RendererDX11::set_light_buffer() const
         light_data.directional_light.near_plane = m_directional_light->m_near_plane;
     }
 
-    for (i32 i = 0; i < m_point_lights.size(); i++)
+    m_point_light_data.resize(m_point_lights.size());
+    for (u32 i = 0; i < m_point_lights.size(); i++)
+    {
+        DXPointLight& point_light = m_point_light_data[i];
+        point_light.position = m_point_lights[i]->entity->transform->get_position();
+        point_light.shadow_map_index = -1;
+        point_light.ambient = m_point_lights[i]->ambient;
+        point_light.diffuse = m_point_lights[i]->diffuse;
+        point_light.specular = m_point_lights[i]->specular;
+        point_light.constant = m_point_lights[i]->constant;
+        point_light.linear = m_point_lights[i]->linear;
+        point_light.quadratic = m_point_lights[i]->quadratic;
+        point_light.far_plane = m_point_lights[i]->m_far_plane;
+        point_light.near_plane = m_point_lights[i]->m_near_plane;
+    }
+
+    m_spot_light_data.resize(m_spot_lights.size());
+    for (u32 i = 0; i < m_spot_lights.size(); i++)
     {
-        light_data.point_lights[i].position = m_point_lights[i]->entity->transform->get_position();
-        light_data.point_lights[i].ambient = m_point_lights[i]->ambient;
-        light_data.point_lights[i].diffuse = m_point_lights[i]->diffuse;
-        light_data.point_lights[i].specular = m_point_lights[i]->specular;
-        light_data.point_lights[i].constant = m_point_lights[i]->constant;
-        light_data.point_lights[i].linear = m_point_lights[i]->linear;
-        light_data.point_lights[i].quadratic = m_point_lights[i]->quadratic;
-        light_data.point_lights[i].far_plane = m_point_lights[i]->m_far_plane;
-        light_data.point_lights[i].near_plane = m_point_lights[i]->m_near_plane;
+        DXSpotLight& spot_light = m_spot_light_data[i];
+        spot_light.position = m_spot_lights[i]->entity->transform->get_position();
+        spot_light.scattering_factor = m_spot_lights[i]->scattering_factor;
+        spot_light.direction = m_spot_lights[i]->entity->transform->get_forward();
+        spot_light.cut_off = m_spot_lights[i]->cut_off;
+        spot_light.outer_cut_off = m_spot_lights[i]->outer_cut_off;
+
+        spot_light.constant = m_spot_lights[i]->constant;
+        spot_light.linear = m_spot_lights[i]->linear;
+        spot_light.quadratic = m_spot_lights[i]->quadratic;
+
+        spot_light.ambient = m_spot_lights[i]->ambient;
+        spot_light.diffuse = m_spot_lights[i]->diffuse;
+        spot_light.specular = m_spot_lights[i]->specular;
+        spot_light.shadow_map_index = -1;
+
+        spot_light.near_plane = m_spot_lights[i]->m_near_plane;
+        spot_light.far_plane = m_spot_lights[i]->m_far_plane;
+
+        spot_light.light_projection_view = m_spot_lights[i]->get_projection_view_matrix();
+        spot_light.inv_light_model = m_spot_lights[i]->get_rotated_inverse_model_matrix();
+        spot_light.light_model = m_spot_lights[i]->get_rotated_model_matrix();
+
+        spot_light.light_frustum_width = m_spot_lights[i]->m_light_frustum_width;
+        spot_light.light_world_size = m_spot_lights[i]->m_light_world_size;
+        spot_light.pcf_num_samples = m_spot_lights[i]->m_pcf_num_samples;
+        spot_light.blocker_search_num_samples = m_spot_lights[i]->m_blocker_search_num_samples;
     }
 
-    for (i32 i = 0; i < m_spot_lights.size(); i++)
+    for (u32 i = 0; i < m_shadowed_point_lights.size(); ++i)
     {
-        light_data.spot_lights[i].position = m_spot_lights[i]->entity->transform->get_position();
-        light_data.spot_lights[i].scattering_factor = m_spot_lights[i]->scattering_factor;
-        light_data.spot_lights[i].direction = m_spot_lights[i]->entity->transform->get_forward();
-        light_data.spot_lights[i].cut_off = m_spot_lights[i]->cut_off;
-        light_data.spot_lights[i].outer_cut_off = m_spot_lights[i]->outer_cut_off;
-
-        light_data.spot_lights[i].constant = m_spot_lights[i]->constant;
-        light_data.spot_lights[i].linear = m_spot_lights[i]->linear;
-        light_data.spot_lights[i].quadratic = m_spot_lights[i]->quadratic;
-
-        light_data.spot_lights[i].ambient = m_spot_lights[i]->ambient;
-        light_data.spot_lights[i].diffuse = m_spot_lights[i]->diffuse;
-        light_data.spot_lights[i].specular = m_spot_lights[i]->specular;
-
-        light_data.spot_lights[i].near_plane = m_spot_lights[i]->m_near_plane;
-        light_data.spot_lights[i].far_plane = m_spot_lights[i]->m_far_plane;
-
-        light_data.spot_lights[i].light_projection_view = m_spot_lights[i]->get_projection_view_matrix();
-        light_data.spot_lights[i].inv_light_model = m_spot_lights[i]->get_rotated_inverse_model_matrix();
-        light_data.spot_lights[i].light_model = m_spot_lights[i]->get_rotated_model_matrix();
-
-        light_data.spot_lights[i].light_frustum_width = m_spot_lights[i]->m_light_frustum_width;
-        light_data.spot_lights[i].light_world_size = m_spot_lights[i]->m_light_world_size;
-        light_data.spot_lights[i].pcf_num_samples = m_spot_lights[i]->m_pcf_num_samples;
-        light_data.spot_lights[i].blocker_search_num_samples = m_spot_lights[i]->m_blocker_search_num_samples;
+        m_point_light_data[m_shadowed_point_lights[i]].shadow_map_index = static_cast<i32>(i);
+    }
+
+    for (u32 i = 0; i < m_shadowed_spot_lights.size(); ++i)
+    {
+        m_spot_light_data[m_shadowed_spot_lights[i]].shadow_map_index = static_cast<i32>(i);
     }
 
     light_data.camera_pos = Camera::get_main_camera()->entity->transform->get_position();
-    light_data.number_of_point_lights = m_point_lights.size();
-    light_data.number_of_spot_lights = m_spot_lights.size();
+
+    light_data.cluster_counts = {LightClusters::tiles_x, LightClusters::tiles_y, LightClusters::depth_slices};
+    light_data.cluster_depth_scale = m_light_clusters.get_depth_scale();
+    light_data.cluster_depth_bias = m_light_clusters.get_depth_bias();
 
     D3D11_MAPPED_SUBRESOURCE mapped_light_buffer_resource = {};
     HRESULT const hr = get_device_context()->Map(m_constant_buffer_light, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped_light_buffer_resource);
 
     assert(SUCCEEDED(hr));
+    RendererStatistics::add_buffer_upload();
 
     CopyMemory(mapped_light_buffer_resource.pData, &light_data, sizeof(ConstantBufferLight));
     get_device_context()->Unmap(m_constant_buffer_light, 0);
@@ -784,6 +1131,7 @@ void RendererDX11::set_particle_buffer(std::shared_ptr<Drawable> const& drawable
     HRESULT const hr = get_instance_dx11()->get_device_context()->Map(m_constant_buffer_particle, 0, D3D11_MAP_WRITE_DISCARD, 0,
                                                                       &particle_mapped_resource);
     assert(SUCCEEDED(hr));
+    RendererStatistics::add_buffer_upload();
 
     CopyMemory(particle_mapped_resource.pData, &particle_data, sizeof(ConstantBufferParticle));
 
@@ -791,21 +1139,130 @@ void RendererDX11::set_particle_buffer(std::shared_ptr<Drawable> const& drawable
     get_instance_dx11()->get_device_context()->PSSetConstantBuffers(4, 1, &m_constant_buffer_particle);
 }
 
-void RendererDX11::set_camera_position_buffer(std::shared_ptr<Drawable> const& drawable) const
+void RendererDX11::set_camera_position_buffer() const
 {
+    auto const& camera_transform = Camera::get_main_camera()->entity->transform;
+    glm::mat4 const& camera_model = camera_transform->get_model_matrix();
+
     ConstantBufferCameraPosition camera_pos_data = {};
-    camera_pos_data.camera_pos = Camera::get_main_camera()->entity->transform->get_position();
+    camera_pos_data.camera_pos = camera_transform->get_position();
+    camera_pos_data.camera_axis_x = glm::normalize(glm::vec3(camera_model[0]));
+    camera_pos_data.camera_axis_y = glm::normalize(glm::vec3(camera_model[1]));
+    camera_pos_data.camera_axis_z = glm::normalize(glm::vec3(camera_model[2]));
 
     D3D11_MAPPED_SUBRESOURCE camera_pos_buffer_resource = {};
     HRESULT const hr =
         get_device_context()->Map(m_constant_buffer_camera_position, 0, D3D11_MAP_WRITE_DISCARD, 0, &camera_pos_buffer_resource);
     assert(SUCCEEDED(hr));
+    RendererStatistics::add_buffer_upload();
 
     CopyMemory(camera_pos_buffer_resource.pData, &camera_pos_data, sizeof(ConstantBufferCameraPosition));
     get_device_context()->Unmap(m_constant_buffer_camera_position, 0);
+    get_device_context()->VSSetConstantBuffers(2, 1, &m_constant_buffer_camera_position);
     get_device_context()->PSSetConstantBuffers(2, 1, &m_constant_buffer_camera_position);
 }
 
+void RendererDX11::begin_gpu_frame() const
+{
+    auto& queries = get_current_gpu_timer_queries();
+
+    if (queries.disjoint == nullptr)
+    {
+        create_gpu_timer_queries(queries);
+    }
+    else if (queries.is_pending)
+    {
+        resolve_gpu_timer_queries(queries);
+    }
+
+    queries.frame = RendererStatistics::get_frame();
+    queries.is_pass_issued.fill(false);
+    queries.is_pending = true;
+
+    get_device_context()->Begin(queries.disjoint);
+}
+
+void RendererDX11::end_gpu_frame() const
+{
+    get_device_context()->End(get_current_gpu_timer_queries().disjoint);
+}
+
+void RendererDX11::begin_gpu_pass(StatisticsPass const pass) const
+{
+    auto& queries = get_current_gpu_timer_queries();
+    get_device_context()->End(queries.pass_begin[static_cast<u32>(pass)]);
+}
+
+void RendererDX11::end_gpu_pass(StatisticsPass const pass) const
+{
+    auto& queries = get_current_gpu_timer_queries();
+    get_device_context()->End(queries.pass_end[static_cast<u32>(pass)]);
+    queries.is_pass_issued[static_cast<u32>(pass)] = true;
+}
+
+void RendererDX11::create_gpu_timer_queries(GpuTimerQueries& queries) const
+{
+    D3D11_QUERY_DESC disjoint_desc = {};
+    disjoint_desc.Query = D3D11_QUERY_TIMESTAMP_DISJOINT;
+
+    HRESULT hr = get_device()->CreateQuery(&disjoint_desc, &queries.disjoint);
+    assert(SUCCEEDED(hr));
+
+    D3D11_QUERY_DESC timestamp_desc = {};
+    timestamp_desc.Query = D3D11_QUERY_TIMESTAMP;
+
+    for (u32 i = 0; i < statistics_pass_count; ++i)
+    {
+        hr = get_device()->CreateQuery(&timestamp_desc, &queries.pass_begin[i]);
+        assert(SUCCEEDED(hr));
+
+        hr = get_device()->CreateQuery(&timestamp_desc, &queries.pass_end[i]);
+        assert(SUCCEEDED(hr));
+    }
+}
+
+void RendererDX11::resolve_gpu_timer_queries(GpuTimerQueries& queries) const
+{
+    queries.is_pending = false;
+
+    D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint = {};
+    if (get_device_context()->GetData(queries.disjoint, &disjoint, sizeof(disjoint), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+        return;
+
+    // Timestamps are unreliable when the GPU clock changed during the frame
+    if (disjoint.Disjoint)
+        return;
+
+    for (u32 i = 0; i < statistics_pass_count; ++i)
+    {
+        if (!queries.is_pass_issued[i])
+            continue;
+
+        u64 begin = 0;
+        u64 end = 0;
+
+        if (get_device_context()->GetData(queries.pass_begin[i], &begin, sizeof(begin), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK
+            || get_device_context()->GetData(queries.pass_end[i], &end, sizeof(end), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+        {
+            continue;
+        }
+
+        double const milliseconds = static_cast<double>(end - begin) * 1000.0 / static_cast<double>(disjoint.Frequency);
+        RendererStatistics::set_gpu_time(queries.frame, static_cast<StatisticsPass>(i), milliseconds);
+    }
+}
+
+RendererDX11::GpuTimerQueries& RendererDX11::get_current_gpu_timer_queries() const
+{
+    return m_gpu_timer_queries[RendererStatistics::get_frame() % gpu_timer_frames];
+}
+
+void RendererDX11::bind_draw_flags(bool const is_instanced, bool const is_billboard) const
+{
+    u32 const index = static_cast<u32>(is_instanced) | static_cast<u32>(is_billboard) << 1;
+    get_device_context()->VSSetConstantBuffers(6, 1, &m_constant_buffers_draw_flags[index]);
+}
+
 bool RendererDX11::create_device_d3d(HWND const hwnd)
 {
     DXGI_SWAP_CHAIN_DESC sd = {};
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <array>
+#include <functional>
+#include <span>
+
 #include "BlurPassContainer.h"
 #include "Engine.h"
 #include "GBuffer.h"
@@ -33,6 +37,9 @@ public:
     [[nodiscard]] ID3D11DepthStencilView* get_depth_stencil_view() const;
     [[nodiscard]] D3D11_VIEWPORT get_main_view_port() const;
 
+    // Makes the following instanced draws of the current object read model matrices from the instances
+    void bind_instances(ID3D11ShaderResourceView* instances) const;
+
     void inject_mouse_position(glm::vec2 const mouse_position);
     void inject_light_range(float const range);
 
@@ -47,20 +54,33 @@ protected:
                                glm::mat4 const& projection_view_no_translation) const override;
     virtual void update_material(std::shared_ptr<Material> const& material) const override;
     virtual void update_object(std::shared_ptr<Drawable> const& drawable, std::shared_ptr<Material> const& material,
-                               glm::mat4 const& projection_view) const override;
+                               glm::mat4 const& projection_view, ObjectConstants const& constants) const override;
 
     virtual void unbind_material(std::shared_ptr<Material> const& material) const override;
+    virtual void draw_instance_batches(std::shared_ptr<Material> const& material, glm::mat4 const& projection_view) const override;
     virtual void bind_universal_resources() const override;
 
+    virtual void draw_debug_lines(std::span<DebugVertex const> const vertices, glm::mat4 const& projection_view) const override;
+    virtual void draw_ui_batches(std::span<UIVertex const> const vertices, std::span<UIBatch const> const batches) const override;
+
+    virtual void begin_gpu_frame() const override;
+    virtual void end_gpu_frame() const override;
+    virtual void begin_gpu_pass(StatisticsPass const pass) const override;
+    virtual void end_gpu_pass(StatisticsPass const pass) const override;
+
 private:
     virtual void initialize_global_renderer_settings() override;
     virtual void initialize_buffers(size_t const max_size) override;
     virtual void perform_frustum_culling(std::shared_ptr<Material> const& material) const override;
 
+    // Uploads model matrices of the visible instances of a batch and prepares the pipeline for an instanced draw call
+    void update_instances(std::shared_ptr<Material> const& material, InstanceBatch const& batch, glm::mat4 const& projection_view) const;
+
     [[nodiscard]] static D3D11_VIEWPORT create_viewport(i32 const width, i32 const height);
     void set_light_buffer() const;
     void set_particle_buffer(std::shared_ptr<Drawable> const& drawable, std::shared_ptr<Material> const& material) const;
-    void set_camera_position_buffer(std::shared_ptr<Drawable> const& drawable) const;
+    void set_camera_position_buffer() const;
+    void bind_draw_flags(bool const is_instanced, bool const is_billboard) const;
 
     [[nodiscard]] bool create_device_d3d(HWND const hwnd);
     void cleanup_device_d3d();
@@ -83,6 +103,36 @@ private:
     void update_depth_shader(std::shared_ptr<Light> const& light) const;
     virtual void render_shadow_maps() const override;
 
+    // Skips the light when its shadow map is still valid and only re-renders static casters when they have changed.
+    // set_render_target binds the shadow map face for rendering and optionally clears it.
+    void render_cached_shadow_map(std::shared_ptr<Light> const& light, std::span<glm::mat4 const> const projection_views,
+                                  std::function<void(u32, bool)> const& set_render_target) const;
+
+    // Uploads point and spot lights written by set_light_buffer() together with their clusters, see Renderer::assign_light_clusters().
+    // Has to be called once per frame, before any lit geometry is drawn.
+    void update_light_clusters() const;
+    void create_structured_buffer(u32 const stride, u32 const count, ID3D11Buffer** buffer, ID3D11ShaderResourceView** srv) const;
+
+    // Copies data into a dynamic structured buffer, which is recreated with a larger capacity when the data doesn't fit
+    void upload_dynamic_structured_buffer(void const* data, u32 const stride, u32 const count, ID3D11Buffer*& buffer,
+                                          ID3D11ShaderResourceView*& srv, u32& capacity) const;
+
+    // Timestamp queries of a single frame, reused gpu_timer_frames frames later. Results that aren't available by then are dropped,
+    // so reading them back never stalls the CPU.
+    struct GpuTimerQueries
+    {
+        ID3D11Query* disjoint = nullptr;
+        std::array<ID3D11Query*, statistics_pass_count> pass_begin = {};
+        std::array<ID3D11Query*, statistics_pass_count> pass_end = {};
+        std::array<bool, statistics_pass_count> is_pass_issued = {};
+        u64 frame = 0;
+        bool is_pending = false;
+    };
+
+    void create_gpu_timer_queries(GpuTimerQueries& queries) const;
+    void resolve_gpu_timer_queries(GpuTimerQueries& queries) const;
+    [[nodiscard]] GpuTimerQueries& get_current_gpu_timer_queries() const;
+
     virtual void render_lighting_pass() const override;
     virtual void render_geometry_pass(glm::mat4 const& projection_view) const override;
     virtual void render_ssao() const override;
@@ -116,6 +166,9 @@ private:
     ID3D11Buffer* m_constant_buffer_ssao = nullptr;
     ID3D11Buffer* m_constant_buffer_psmisc = nullptr;
     ID3D11Buffer* m_constant_buffer_particle = nullptr;
+
+    // Immutable buffers for every combination of draw flags, indexed by is_instanced | is_billboard << 1
+    std::array<ID3D11Buffer*, 4> m_constant_buffers_draw_flags = {};
     ID3D11DepthStencilView* m_depth_stencil_view = nullptr;
     ID3D11Texture2D* m_depth_stencil_buffer = nullptr;
     ID3D11DepthStencilState* m_depth_stencil_state = nullptr;
@@ -144,6 +197,50 @@ private:
     inline static u32 constexpr spot_light_shadow_register_offset = 20;
     inline static u32 constexpr point_light_shadow_register_offset = 40;
 
+    // Indices of lights that got one of the MAX_SHADOWED_LIGHTS shadow map registers this frame
+    mutable std::vector<u32> m_shadowed_point_lights = {};
+    mutable std::vector<u32> m_shadowed_spot_lights = {};
+
+    // Clustered lighting, lights are bound to t64 and t65
+    mutable std::vector<DXPointLight> m_point_light_data = {};
+    mutable std::vector<DXSpotLight> m_spot_light_data = {};
+    mutable ID3D11Buffer* m_point_light_buffer = nullptr;
+    mutable ID3D11ShaderResourceView* m_point_light_srv = nullptr;
+    mutable u32 m_point_light_capacity = 0;
+    mutable ID3D11Buffer* m_spot_light_buffer = nullptr;
+    mutable ID3D11ShaderResourceView* m_spot_light_srv = nullptr;
+    mutable u32 m_spot_light_capacity = 0;
+    inline static u32 constexpr point_light_register = 64;
+    inline static u32 constexpr spot_light_register = 65;
+
+    mutable ID3D11Buffer* m_light_cluster_buffer = nullptr;
+    mutable ID3D11ShaderResourceView* m_light_cluster_srv = nullptr;
+    mutable ID3D11Buffer* m_light_index_buffer = nullptr;
+    mutable ID3D11ShaderResourceView* m_light_index_srv = nullptr;
+    mutable u32 m_light_index_capacity = 0;
+    inline static u32 constexpr light_cluster_register = 60;
+    inline static u32 constexpr light_index_register = 61;
+
+    // GPU instancing, model matrices of instances are bound to t62 (VS)
+    mutable ID3D11Buffer* m_instance_buffer = nullptr;
+    mutable ID3D11ShaderResourceView* m_instance_srv = nullptr;
+    mutable u32 m_instance_buffer_capacity = 0;
+    inline static u32 constexpr instance_register = 62;
+
+    // Debug drawing, vertices of debug lines are bound to t63 (VS) and read by their index without any input layout
+    mutable ID3D11Buffer* m_debug_vertex_buffer = nullptr;
+    mutable ID3D11ShaderResourceView* m_debug_vertex_srv = nullptr;
+    mutable u32 m_debug_vertex_capacity = 0;
+    inline static u32 constexpr debug_vertex_register = 63;
+
+    // UI batches, vertices of a UI group are bound to t59 (VS) the same way as vertices of debug lines
+    mutable ID3D11Buffer* m_ui_vertex_buffer = nullptr;
+    mutable ID3D11ShaderResourceView* m_ui_vertex_srv = nullptr;
+    mutable u32 m_ui_vertex_capacity = 0;
+    inline static u32 constexpr ui_vertex_register = 59;
+
+    mutable std::array<GpuTimerQueries, gpu_timer_frames> m_gpu_timer_queries = {};
+
     inline static DXGI_FORMAT m_render_target_format = DXGI_FORMAT_R32G32B32A32_FLOAT;
 
     glm::vec2 m_mouse_position = {};
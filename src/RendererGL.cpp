@@ -1,16 +1,29 @@
 #include "RendererGL.h"
 
+#include <algorithm>
 #include <array>
-#include <format>
+#include <cstring>
+#include <vector>
 
 #include "Camera.h"
 #include "Entity.h"
 #include "MeshGL.h"
 #include "ResourceManager.h"
 #include "ShaderFactory.h"
+#include "ShaderGL.h"
 #include "Skybox.h"
 #include "TextureLoaderGL.h"
 
+namespace
+{
+
+size_t align_up(size_t const size, size_t const alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+}
+
 std::shared_ptr<RendererGL> RendererGL::create()
 {
     auto renderer = std::make_shared<RendererGL>(AK::Badge<RendererGL> {});
@@ -21,7 +34,15 @@ std::shared_ptr<RendererGL> RendererGL::create()
 
     TextureLoaderGL::create();
 
-    renderer->m_frustum_culling_shader = ResourceManager::get_instance().load_shader("./res/shaders/glsl/frustum_culling.glsl");
+    renderer->m_frustum_culling_shader = std::static_pointer_cast<ShaderGL>(
+        ResourceManager::get_instance().load_shader("./res/shaders/glsl/frustum_culling.glsl"));
+
+    renderer->m_debug_line_shader =
+        ResourceManager::get_instance().load_shader("./res/shaders/glsl/debug_lines.vert", "./res/shaders/glsl/debug_lines.frag");
+    renderer->m_ui_batch_shader =
+        ResourceManager::get_instance().load_shader("./res/shaders/glsl/ui_batched.vert", "./res/shaders/glsl/ui_batched.frag");
+
+    renderer->resolve_uniform_handles();
 
     return renderer;
 }
@@ -34,6 +55,13 @@ void RendererGL::begin_frame() const
 {
     Renderer::begin_frame();
 
+    // Reloaded shaders get new programs, so uniforms have to be looked up again
+    if (m_frustum_culling_shader->program_id != m_resolved_frustum_culling_program
+        || m_debug_line_shader->program_id != m_resolved_debug_line_program)
+    {
+        resolve_uniform_handles();
+    }
+
     glViewport(0, 0, screen_width, screen_height);
 
     if (wireframe_mode_active)
@@ -47,6 +75,35 @@ void RendererGL::begin_frame() const
 
     glClearColor(clear_color_glm.g, clear_color_glm.g, clear_color_glm.b, clear_color_glm.w);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    m_instance_region = (m_instance_region + 1) % instance_buffer_regions;
+    m_written_instances = 0;
+    m_written_commands = 0;
+
+    wait_for_instance_region();
+}
+
+void RendererGL::resolve_uniform_handles() const
+{
+    m_frustum_planes_uniform = m_frustum_culling_shader->get_uniform<glm::vec4>("frustumPlanes");
+    m_first_instance_uniform = m_frustum_culling_shader->get_uniform<i32>("firstInstance");
+    m_instance_count_uniform = m_frustum_culling_shader->get_uniform<i32>("instanceCount");
+    m_resolved_frustum_culling_program = m_frustum_culling_shader->program_id;
+
+    m_debug_projection_view_uniform = std::static_pointer_cast<ShaderGL>(m_debug_line_shader)->get_uniform<glm::mat4>("projectionView");
+    m_resolved_debug_line_program = m_debug_line_shader->program_id;
+}
+
+void RendererGL::end_frame() const
+{
+    Renderer::end_frame();
+
+    auto& fence = m_instance_region_fences[m_instance_region];
+
+    if (fence != nullptr)
+        glDeleteSync(fence);
+
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
 }
 
 void RendererGL::render_shadow_maps() const
@@ -66,97 +123,127 @@ void RendererGL::restore_default_rasterizer_draw_type()
 void RendererGL::update_shader(std::shared_ptr<Shader> const& shader, glm::mat4 const& projection_view,
                                glm::mat4 const& projection_view_no_translation) const
 {
-    // TODO: Ultimately we would probably want to cache the uniform location instead of retrieving them by name
-
-    shader->set_vec3("cameraPosition", Camera::get_main_camera()->get_position());
-    shader->set_mat4("PV", projection_view);
-    shader->set_mat4("PVnoTranslation", projection_view_no_translation);
-
-    // TODO: Choose only the closest lights
+    UniformBufferCamera camera = {};
+    camera.projection_view = projection_view;
+    camera.projection_view_no_translation = projection_view_no_translation;
+    camera.camera_position = Camera::get_main_camera()->get_position();
 
-    i32 enabled_light_count = 0;
-    for (u32 i = 0; i < m_point_lights.size(); ++i)
+    // Camera and light blocks are shared by all shaders, so they are only uploaded when they change between shaders
+    if (std::memcmp(&camera, &m_camera_uniforms, sizeof(UniformBufferCamera)) != 0)
     {
-        if (!m_point_lights[i]->enabled())
-            continue;
+        m_camera_uniforms = camera;
+        update_uniform_buffer(UniformBlockBinding::Camera, m_camera_uniforms);
+    }
+
+    UniformBufferLight light = {};
 
-        std::string light_element = std::format("pointLights[{}].", enabled_light_count);
-        shader->set_vec3(light_element + "position", m_point_lights[i]->entity->transform->get_local_position());
+    auto const main_camera = Camera::get_main_camera();
+    light.cluster_view = main_camera->get_view_matrix();
+    light.cluster_projection = main_camera->get_projection();
+    light.cluster_counts = {LightClusters::tiles_x, LightClusters::tiles_y, LightClusters::depth_slices};
+    light.cluster_depth_scale = m_light_clusters.get_depth_scale();
+    light.cluster_depth_bias = m_light_clusters.get_depth_bias();
 
-        shader->set_vec3(light_element + "ambient", m_point_lights[i]->ambient);
-        shader->set_vec3(light_element + "diffuse", m_point_lights[i]->diffuse);
-        shader->set_vec3(light_element + "specular", m_point_lights[i]->specular);
+    light.point_light_count = static_cast<i32>(m_point_lights.size());
+    light.spot_light_count = static_cast<i32>(m_spot_lights.size());
 
-        shader->set_float(light_element + "constant", m_point_lights[i]->constant);
-        shader->set_float(light_element + "linear", m_point_lights[i]->linear);
-        shader->set_float(light_element + "quadratic", m_point_lights[i]->quadratic);
+    bool const directional_light_on = m_directional_light != nullptr && m_directional_light->enabled();
+    if (directional_light_on)
+    {
+        light.directional_light.direction = m_directional_light->entity->transform->get_forward();
 
-        enabled_light_count++;
+        light.directional_light.ambient = m_directional_light->ambient;
+        light.directional_light.diffuse = m_directional_light->diffuse;
+        light.directional_light.specular = m_directional_light->specular;
     }
 
-    shader->set_int("pointLightCount", enabled_light_count > m_max_point_lights ? m_max_point_lights : enabled_light_count);
+    light.directional_light_on = directional_light_on;
 
-    enabled_light_count = 0;
-    for (u32 i = 0; i < m_spot_lights.size(); ++i)
+    if (std::memcmp(&light, &m_light_uniforms, sizeof(UniformBufferLight)) != 0)
     {
-        if (!m_spot_lights[i]->enabled())
-            continue;
-
-        std::string light_element = std::format("spotLights[{}].", enabled_light_count);
-        shader->set_vec3(light_element + "position", m_spot_lights[i]->entity->transform->get_local_position());
-        shader->set_vec3(light_element + "direction", m_spot_lights[i]->entity->transform->get_forward());
-
-        shader->set_vec3(light_element + "ambient", m_spot_lights[i]->ambient);
-        shader->set_vec3(light_element + "diffuse", m_spot_lights[i]->diffuse);
-        shader->set_vec3(light_element + "specular", m_spot_lights[i]->specular);
+        m_light_uniforms = light;
+        update_uniform_buffer(UniformBlockBinding::Light, m_light_uniforms);
+    }
+}
 
-        shader->set_float(light_element + "cutOff", m_spot_lights[i]->cut_off);
-        shader->set_float(light_element + "outerCutOff", m_spot_lights[i]->outer_cut_off);
+void RendererGL::bind_universal_resources() const
+{
+    // Disabled lights are kept, so indices in the clusters stay the same, but they aren't assigned to any cluster
+    m_point_light_data.resize(m_point_lights.size());
+    for (u32 i = 0; i < m_point_lights.size(); ++i)
+    {
+        GLPointLight& point_light = m_point_light_data[i];
+        point_light.position = m_point_lights[i]->entity->transform->get_position();
 
-        shader->set_float(light_element + "constant", m_spot_lights[i]->constant);
-        shader->set_float(light_element + "linear", m_spot_lights[i]->linear);
-        shader->set_float(light_element + "quadratic", m_spot_lights[i]->quadratic);
+        point_light.ambient = m_point_lights[i]->ambient;
+        point_light.diffuse = m_point_lights[i]->diffuse;
+        point_light.specular = m_point_lights[i]->specular;
 
-        enabled_light_count++;
+        point_light.constant = m_point_lights[i]->constant;
+        point_light.linear = m_point_lights[i]->linear;
+        point_light.quadratic = m_point_lights[i]->quadratic;
     }
 
-    shader->set_int("spotLightCount", enabled_light_count > m_max_spot_lights ? m_max_spot_lights : enabled_light_count);
-
-    bool const directional_light_on = m_directional_light != nullptr && m_directional_light->enabled();
-    if (directional_light_on)
+    m_spot_light_data.resize(m_spot_lights.size());
+    for (u32 i = 0; i < m_spot_lights.size(); ++i)
     {
-        shader->set_vec3("directionalLight.direction", m_directional_light->entity->transform->get_forward());
+        GLSpotLight& spot_light = m_spot_light_data[i];
+        spot_light.position = m_spot_lights[i]->entity->transform->get_position();
+        spot_light.direction = m_spot_lights[i]->entity->transform->get_forward();
 
-        shader->set_vec3("directionalLight.ambient", m_directional_light->ambient);
-        shader->set_vec3("directionalLight.diffuse", m_directional_light->diffuse);
-        shader->set_vec3("directionalLight.specular", m_directional_light->specular);
+        spot_light.ambient = m_spot_lights[i]->ambient;
+        spot_light.diffuse = m_spot_lights[i]->diffuse;
+        spot_light.specular = m_spot_lights[i]->specular;
+
+        spot_light.cut_off = m_spot_lights[i]->cut_off;
+        spot_light.outer_cut_off = m_spot_lights[i]->outer_cut_off;
+
+        spot_light.constant = m_spot_lights[i]->constant;
+        spot_light.linear = m_spot_lights[i]->linear;
+        spot_light.quadratic = m_spot_lights[i]->quadratic;
     }
 
-    shader->set_bool("directionalLightOn", directional_light_on);
+    auto const& clusters = m_light_clusters.get_clusters();
+    auto const& light_indices = m_light_clusters.get_light_indices();
+
+    update_storage_buffer(StorageBufferBinding::PointLights, m_point_light_buffer, m_point_light_data.data(),
+                          m_point_light_data.size() * sizeof(GLPointLight));
+    update_storage_buffer(StorageBufferBinding::SpotLights, m_spot_light_buffer, m_spot_light_data.data(),
+                          m_spot_light_data.size() * sizeof(GLSpotLight));
+    update_storage_buffer(StorageBufferBinding::LightClusters, m_light_cluster_buffer, clusters.data(),
+                          clusters.size() * sizeof(LightCluster));
+    update_storage_buffer(StorageBufferBinding::LightIndices, m_light_index_buffer, light_indices.data(),
+                          light_indices.size() * sizeof(u32));
 }
 
 void RendererGL::update_material(std::shared_ptr<Material> const& material) const
 {
-    material->shader->set_vec3("material.color", glm::vec3(material->color.x, material->color.y, material->color.z));
-    material->shader->set_float("material.specular", material->specular);
-    material->shader->set_float("material.shininess", material->shininess);
+    UniformBufferMaterial material_uniforms = {};
+    material_uniforms.color = glm::vec3(material->color.x, material->color.y, material->color.z);
+    material_uniforms.specular = material->specular;
+    material_uniforms.shininess = material->shininess;
+
+    material_uniforms.radius_multiplier = material->radius_multiplier;
+    material_uniforms.sector_count = static_cast<i32>(material->sector_count);
+    material_uniforms.stack_count = static_cast<i32>(material->stack_count);
 
-    material->shader->set_float("radiusMultiplier", material->radius_multiplier);
-    material->shader->set_int("sector_count", material->sector_count);
-    material->shader->set_int("stack_count", material->stack_count);
+    update_uniform_buffer(UniformBlockBinding::Material, material_uniforms);
 }
 
 void RendererGL::update_object(std::shared_ptr<Drawable> const& drawable, std::shared_ptr<Material> const& material,
-                               glm::mat4 const& projection_view) const
+                               glm::mat4 const& projection_view, ObjectConstants const& constants) const
 {
+    UniformBufferObject object = {};
+    object.projection_view_model = constants.projection_view_model;
+    object.model = constants.model;
+
     if (material->needs_view_model)
-        material->shader->set_mat4("VM", Camera::get_main_camera()->get_view_matrix() * drawable->entity->transform->get_model_matrix());
+        object.view_model = Camera::get_main_camera()->get_view_matrix() * constants.model;
 
     if (Skybox::get_instance() != nullptr && material->needs_skybox)
         Skybox::get_instance()->bind();
 
-    material->shader->set_mat4("PVM", projection_view * drawable->entity->transform->get_model_matrix());
-    material->shader->set_mat4("model", drawable->entity->transform->get_model_matrix());
+    update_uniform_buffer(UniformBlockBinding::Object, object);
 }
 
 void RendererGL::unbind_material(std::shared_ptr<Material> const& material) const
@@ -177,71 +264,414 @@ void RendererGL::initialize_global_renderer_settings()
 
 void RendererGL::initialize_buffers(size_t const max_size)
 {
-    glGenBuffers(1, &m_gpu_instancing_ssbo);
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_gpu_instancing_ssbo);
-    glBufferData(GL_SHADER_STORAGE_BUFFER, max_size * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_gpu_instancing_ssbo);
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    m_is_persistently_mapped = GLAD_GL_VERSION_4_4 != 0;
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &m_storage_buffer_offset_alignment);
+
+    reserve_instancing_buffers(max_size, max_size);
 
-    glGenBuffers(1, &m_bounding_boxes_ssbo);
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_bounding_boxes_ssbo);
-    glBufferData(GL_SHADER_STORAGE_BUFFER, max_size * sizeof(BoundingBoxShader), nullptr, GL_DYNAMIC_READ);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_bounding_boxes_ssbo);
+    std::array<size_t, uniform_block_count> constexpr uniform_block_sizes = {sizeof(UniformBufferCamera), sizeof(UniformBufferLight),
+                                                                             sizeof(UniformBufferMaterial), sizeof(UniformBufferObject)};
+
+    glGenBuffers(uniform_block_count, m_uniform_buffers.data());
+
+    // Buffers start zeroed, same as the last uploaded contents of the shared blocks
+    for (u32 i = 0; i < uniform_block_count; ++i)
+    {
+        std::vector<u8> const zeroed(uniform_block_sizes[i]);
+
+        glBindBuffer(GL_UNIFORM_BUFFER, m_uniform_buffers[i]);
+        glBufferData(GL_UNIFORM_BUFFER, uniform_block_sizes[i], zeroed.data(), GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, i, m_uniform_buffers[i]);
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void RendererGL::update_uniform_buffer(UniformBlockBinding const binding, void const* data, size_t const size) const
+{
+    glBindBuffer(GL_UNIFORM_BUFFER, m_uniform_buffers[static_cast<u32>(binding)]);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, static_cast<GLsizeiptr>(size), data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    RendererStatistics::add_buffer_upload();
+}
+
+void RendererGL::update_storage_buffer(StorageBufferBinding const binding, GLuint& buffer, void const* data, size_t const size) const
+{
+    if (buffer == 0)
+        glGenBuffers(1, &buffer);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(size), data, GL_STREAM_DRAW);
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    RendererStatistics::add_buffer_upload();
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, static_cast<u32>(binding), buffer);
+}
+
+void RendererGL::reserve_instancing_buffers(size_t const instance_count, size_t const command_count) const
+{
+    if (m_instance_buffer != 0 && instance_count <= m_instance_capacity && command_count <= m_command_capacity)
+        return;
+
+    // Grow geometrically, so registering drawables one by one doesn't reallocate the buffers every frame
+    m_instance_capacity = std::max({instance_count, m_instance_capacity * 2, static_cast<size_t>(1)});
+    m_command_capacity = std::max({command_count, m_command_capacity * 2, static_cast<size_t>(1)});
+
+    // Instances written so far have already been culled and drawn. Deleted buffers are kept alive until the GPU is done with them.
+    if (m_instance_buffer != 0)
+    {
+        glDeleteBuffers(1, &m_instance_buffer);
+        glDeleteBuffers(1, &m_visible_instances_buffer);
+    }
+
+    for (auto& fence : m_instance_region_fences)
+    {
+        if (fence != nullptr)
+            glDeleteSync(fence);
+
+        fence = nullptr;
+    }
+
+    size_t const buffer_size = get_instance_region_size() * instance_buffer_regions;
 
-    glGenBuffers(1, &m_visible_instances_ssbo);
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_visible_instances_ssbo);
-    glBufferData(GL_SHADER_STORAGE_BUFFER, max_size * sizeof(GLuint), nullptr, GL_DYNAMIC_READ);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, m_visible_instances_ssbo);
+    glGenBuffers(1, &m_instance_buffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_instance_buffer);
+
+    if (m_is_persistently_mapped)
+    {
+        GLbitfield constexpr flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(buffer_size), nullptr, flags);
+        m_instance_data = static_cast<u8*>(glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, static_cast<GLsizeiptr>(buffer_size), flags));
+    }
+    else
+    {
+        glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(buffer_size), nullptr, GL_DYNAMIC_DRAW);
+        m_instance_staging.resize(buffer_size);
+        m_instance_data = m_instance_staging.data();
+    }
+
+    // Visible instances are only ever written and read by the GPU
+    glGenBuffers(1, &m_visible_instances_buffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_visible_instances_buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(m_instance_capacity * sizeof(GLuint)), nullptr, GL_DYNAMIC_COPY);
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    m_instance_region = 0;
+    m_written_instances = 0;
+    m_written_commands = 0;
+}
+
+void RendererGL::wait_for_instance_region() const
+{
+    auto& fence = m_instance_region_fences[m_instance_region];
+
+    if (fence == nullptr)
+        return;
+
+    // Region was last written instance_buffer_regions frames ago, so the GPU is almost always done with it
+    GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    while (result == GL_TIMEOUT_EXPIRED)
+    {
+        result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+    }
+
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+size_t RendererGL::get_models_size() const
+{
+    return align_up(m_instance_capacity * sizeof(glm::mat4), m_storage_buffer_offset_alignment);
+}
+
+size_t RendererGL::get_instances_size() const
+{
+    return align_up(m_instance_capacity * sizeof(GLInstance), m_storage_buffer_offset_alignment);
+}
+
+size_t RendererGL::get_instance_region_size() const
+{
+    return get_models_size() + get_instances_size()
+         + align_up(m_command_capacity * sizeof(GLDrawElementsIndirectCommand), m_storage_buffer_offset_alignment);
+}
+
+size_t RendererGL::get_models_offset() const
+{
+    return m_instance_region * get_instance_region_size();
+}
+
+size_t RendererGL::get_instances_offset() const
+{
+    return get_models_offset() + get_models_size();
+}
+
+size_t RendererGL::get_commands_offset() const
+{
+    return get_instances_offset() + get_instances_size();
 }
 
 void RendererGL::perform_frustum_culling(std::shared_ptr<Material> const& material) const
 {
-    m_frustum_culling_shader->use();
+    size_t command_count = 0;
+    for (auto const& batch : material->instance_batches)
+    {
+        command_count += batch.first_drawable->get_meshes().size();
+    }
 
-    // Set frustum planes
-    auto const frustum_planes = Camera::get_main_camera()->get_frustum_planes();
+    reserve_instancing_buffers(m_written_instances + material->drawables.size(), m_written_commands + command_count);
+
+    size_t const first_instance = m_written_instances;
+    size_t const first_command = m_written_commands;
 
-    for (u32 i = 0; i < 6; ++i)
+    auto* models = reinterpret_cast<glm::mat4*>(m_instance_data + get_models_offset());
+    auto* instances = reinterpret_cast<GLInstance*>(m_instance_data + get_instances_offset());
+    auto* commands = reinterpret_cast<GLDrawElementsIndirectCommand*>(m_instance_data + get_commands_offset());
+
+    // Visible instances of every batch are compacted into their own range, which can fit all instances of the batch
+    m_indirect_batches.assign(material->instance_batches.size(), {});
+
+    for (auto const& drawable : material->drawables)
     {
-        m_frustum_culling_shader->set_vec4(std::format("frustumPlanes[{}]", i), frustum_planes[i]);
+        m_indirect_batches[drawable->get_instance_batch()].instance_count += 1;
     }
 
-    // Send bounding boxes
-    // TODO: Batch them with all other existing objects and send only once
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_bounding_boxes_ssbo);
-    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, material->bounding_boxes.size() * sizeof(BoundingBoxShader),
-                    material->bounding_boxes.data());
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    u32 visible_offset = static_cast<u32>(first_instance);
+    u32 command = static_cast<u32>(first_command);
 
-    // Run frustum culling
-    glDispatchCompute((material->drawables.size() / 1024) + 1, 1, 1);
+    for (u32 i = 0; i < material->instance_batches.size(); ++i)
+    {
+        auto& indirect_batch = m_indirect_batches[i];
+        indirect_batch.visible_offset = visible_offset;
+        indirect_batch.first_command = command;
 
-    // Wait for SSBO write to complete
-    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+        // Instance counts are accumulated by the culling shader
+        for (auto const& mesh : material->instance_batches[i].first_drawable->get_meshes())
+        {
+            commands[command] = {mesh->get_index_count(), 0, 0, 0, 0};
+            command += 1;
+        }
 
-    // Read visible_instances SSBO which has value of 1 when a corresponding object is visible and 0 if it is not visible
-    auto* visible_instances = new GLuint[material->drawables.size()];
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_visible_instances_ssbo);
-    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, material->drawables.size() * sizeof(GLuint), visible_instances);
+        indirect_batch.command_count = command - indirect_batch.first_command;
+        visible_offset += indirect_batch.instance_count;
+    }
 
-    // TODO: Pass visible instances directly to the shader by a shared SSBO. Might not actually be beneficial?
     for (u32 i = 0; i < material->drawables.size(); ++i)
     {
-        if (visible_instances[i] == 1)
+        auto const& drawable = material->drawables[i];
+        auto const& indirect_batch = m_indirect_batches[drawable->get_instance_batch()];
+
+        // Bounds are taken from the first drawable's meshes, they can't be trusted if they don't cover the whole drawable
+        bool const is_cullable = material->instance_batches[drawable->get_instance_batch()].first_drawable->is_cullable();
+
+        models[first_instance + i] = drawable->entity->transform->get_model_matrix();
+
+        auto& instance = instances[first_instance + i];
+        instance.center = drawable->bounds.center;
+        instance.visible_offset = indirect_batch.visible_offset;
+        instance.extents = drawable->bounds.extents;
+        instance.first_command = indirect_batch.first_command;
+        instance.command_count = indirect_batch.command_count;
+        instance.is_cullable = is_cullable ? 1 : 0;
+    }
+
+    m_written_instances += material->drawables.size();
+    m_written_commands += command_count;
+
+    if (!m_is_persistently_mapped)
+    {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_instance_buffer);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, static_cast<GLintptr>(get_models_offset() + first_instance * sizeof(glm::mat4)),
+                        static_cast<GLsizeiptr>(material->drawables.size() * sizeof(glm::mat4)), &models[first_instance]);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, static_cast<GLintptr>(get_instances_offset() + first_instance * sizeof(GLInstance)),
+                        static_cast<GLsizeiptr>(material->drawables.size() * sizeof(GLInstance)), &instances[first_instance]);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER,
+                        static_cast<GLintptr>(get_commands_offset() + first_command * sizeof(GLDrawElementsIndirectCommand)),
+                        static_cast<GLsizeiptr>(command_count * sizeof(GLDrawElementsIndirectCommand)), &commands[first_command]);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        RendererStatistics::add_buffer_upload();
+    }
+
+    // Drawables binding their own instance buffers replace the models and visible instances, so all of them are bound again
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, static_cast<u32>(StorageBufferBinding::Models), m_instance_buffer,
+                      static_cast<GLintptr>(get_models_offset()), static_cast<GLsizeiptr>(get_models_size()));
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, static_cast<u32>(StorageBufferBinding::Instances), m_instance_buffer,
+                      static_cast<GLintptr>(get_instances_offset()), static_cast<GLsizeiptr>(get_instances_size()));
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, static_cast<u32>(StorageBufferBinding::VisibleInstances), m_visible_instances_buffer);
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, static_cast<u32>(StorageBufferBinding::DrawCommands), m_instance_buffer,
+                      static_cast<GLintptr>(get_commands_offset()),
+                      static_cast<GLsizeiptr>(m_command_capacity * sizeof(GLDrawElementsIndirectCommand)));
+
+    m_frustum_culling_shader->use();
+
+    auto const frustum_planes = Camera::get_main_camera()->get_frustum_planes();
+    m_frustum_culling_shader->set(m_frustum_planes_uniform, std::span<glm::vec4 const>(frustum_planes));
+    m_frustum_culling_shader->set(m_first_instance_uniform, static_cast<i32>(first_instance));
+    m_frustum_culling_shader->set(m_instance_count_uniform, static_cast<i32>(material->drawables.size()));
+
+    glDispatchCompute(static_cast<GLuint>((material->drawables.size() + culling_group_size - 1) / culling_group_size), 1, 1);
+
+    // Draws read visible instances in vertex shaders and instance counts from the commands. The barrier only orders GPU work,
+    // the CPU doesn't wait for the culling to finish.
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+}
+
+void RendererGL::draw_instance_batches(std::shared_ptr<Material> const& material, glm::mat4 const& projection_view) const
+{
+    auto const shader = std::static_pointer_cast<ShaderGL>(material->shader);
+    shader->use();
+
+    update_material(material);
+
+    auto const visible_offset_uniform = shader->get_uniform<i32>("visibleOffset");
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_instance_buffer);
+
+    for (u32 i = 0; i < material->instance_batches.size(); ++i)
+    {
+        auto const& indirect_batch = m_indirect_batches[i];
+
+        if (indirect_batch.instance_count == 0)
+            continue;
+
+        shader->set(visible_offset_uniform, static_cast<i32>(indirect_batch.visible_offset));
+
+        auto const meshes = material->instance_batches[i].first_drawable->get_meshes();
+        for (u32 j = 0; j < meshes.size(); ++j)
         {
-            material->model_matrices.emplace_back(material->drawables[i]->entity->transform->get_model_matrix());
+            meshes[j]->draw_indirect(get_commands_offset() + (indirect_batch.first_command + j) * sizeof(GLDrawElementsIndirectCommand));
         }
     }
 
-    // Free visible_instances memory
-    delete[] visible_instances;
+    // Instance buffers bound by drawables are read from their start
+    shader->set(visible_offset_uniform, 0);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
 
-    material->shader->use();
+void RendererGL::draw_debug_lines(std::span<DebugVertex const> const vertices, glm::mat4 const& projection_view) const
+{
+    if (m_debug_vertex_buffer == 0)
+    {
+        glGenBuffers(1, &m_debug_vertex_buffer);
+        glGenVertexArrays(1, &m_debug_vertex_array);
+    }
 
-    // Pass model matrices of visible instances to the GPU
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_gpu_instancing_ssbo);
-    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, material->model_matrices.size() * sizeof(glm::mat4), material->model_matrices.data());
+    // Previous contents are orphaned, so writing lines of the frame never waits for the GPU to finish drawing the last ones
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_debug_vertex_buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(vertices.size_bytes()), vertices.data(), GL_STREAM_DRAW);
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    RendererStatistics::add_buffer_upload();
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, static_cast<u32>(StorageBufferBinding::DebugVertices), m_debug_vertex_buffer);
+
+    auto const shader = std::static_pointer_cast<ShaderGL>(m_debug_line_shader);
+    shader->use();
+    shader->set(m_debug_projection_view_uniform, projection_view);
+
+    // Vertices are read from the storage buffer by their index, but drawing still needs a bound vertex array
+    glBindVertexArray(m_debug_vertex_array);
+    glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(vertices.size()));
+    RendererStatistics::add_draw_call(0);
+    glBindVertexArray(0);
+}
+
+void RendererGL::draw_ui_batches(std::span<UIVertex const> const vertices, std::span<UIBatch const> const batches) const
+{
+    if (m_ui_vertex_buffer == 0)
+    {
+        glGenBuffers(1, &m_ui_vertex_buffer);
+        glGenVertexArrays(1, &m_ui_vertex_array);
+    }
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_ui_vertex_buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(vertices.size_bytes()), vertices.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    RendererStatistics::add_buffer_upload();
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, static_cast<u32>(StorageBufferBinding::UIVertices), m_ui_vertex_buffer);
+
+    // UI batch shader is already bound by the render queue, quads are drawn over the scene in the order they were batched in
+    glDisable(GL_DEPTH_TEST);
+    glBindVertexArray(m_ui_vertex_array);
+    glActiveTexture(GL_TEXTURE0);
+
+    for (auto const& batch : batches)
+    {
+        glBindTexture(GL_TEXTURE_2D, batch.texture->id);
+        RendererStatistics::add_texture_binds(1);
+
+        glDrawArrays(GL_TRIANGLES, static_cast<GLint>(batch.first_vertex), static_cast<GLsizei>(batch.vertex_count));
+        RendererStatistics::add_draw_call(batch.vertex_count);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindVertexArray(0);
+    glEnable(GL_DEPTH_TEST);
+}
+
+void RendererGL::begin_gpu_frame() const
+{
+    auto& queries = get_current_gpu_timer_queries();
+
+    if (!queries.is_created)
+    {
+        glGenQueries(statistics_pass_count, queries.pass_begin.data());
+        glGenQueries(statistics_pass_count, queries.pass_end.data());
+        queries.is_created = true;
+    }
+    else if (queries.is_pending)
+    {
+        resolve_gpu_timer_queries(queries);
+    }
+
+    queries.frame = RendererStatistics::get_frame();
+    queries.is_pass_issued.fill(false);
+    queries.is_pending = true;
+}
+
+void RendererGL::end_gpu_frame() const
+{
+}
+
+void RendererGL::begin_gpu_pass(StatisticsPass const pass) const
+{
+    glQueryCounter(get_current_gpu_timer_queries().pass_begin[static_cast<u32>(pass)], GL_TIMESTAMP);
+}
+
+void RendererGL::end_gpu_pass(StatisticsPass const pass) const
+{
+    auto& queries = get_current_gpu_timer_queries();
+    glQueryCounter(queries.pass_end[static_cast<u32>(pass)], GL_TIMESTAMP);
+    queries.is_pass_issued[static_cast<u32>(pass)] = true;
+}
+
+void RendererGL::resolve_gpu_timer_queries(GpuTimerQueries& queries) const
+{
+    queries.is_pending = false;
+
+    for (u32 i = 0; i < statistics_pass_count; ++i)
+    {
+        if (!queries.is_pass_issued[i])
+            continue;
+
+        // End timestamp is written after the begin one, so both are available once the end one is
+        GLint is_available = GL_FALSE;
+        glGetQueryObjectiv(queries.pass_end[i], GL_QUERY_RESULT_AVAILABLE, &is_available);
+
+        if (is_available == GL_FALSE)
+            continue;
+
+        GLuint64 begin = 0;
+        GLuint64 end = 0;
+        glGetQueryObjectui64v(queries.pass_begin[i], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(queries.pass_end[i], GL_QUERY_RESULT, &end);
+
+        // Timestamps are in nanoseconds
+        RendererStatistics::set_gpu_time(queries.frame, static_cast<StatisticsPass>(i), static_cast<double>(end - begin) / 1000000.0);
+    }
+}
+
+RendererGL::GpuTimerQueries& RendererGL::get_current_gpu_timer_queries() const
+{
+    return m_gpu_timer_queries[RendererStatistics::get_frame() % gpu_timer_frames];
 }
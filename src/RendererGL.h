@@ -1,9 +1,13 @@
 #pragma once
 
+#include <array>
+#include <vector>
+
 #include <glad/glad.h>
 
 #include "AK/Badge.h"
 #include "Renderer.h"
+#include "ShaderGL.h"
 
 class RendererGL final : public Renderer
 {
@@ -14,6 +18,7 @@ public:
     ~RendererGL() override = default;
 
     virtual void begin_frame() const override;
+    virtual void end_frame() const override;
     virtual void render_shadow_maps() const override;
 
     virtual void set_rasterizer_draw_type(RasterizerDrawType const rasterizer_draw_type) override;
@@ -24,18 +29,133 @@ protected:
                                glm::mat4 const& projection_view_no_translation) const override;
     virtual void update_material(std::shared_ptr<Material> const& material) const override;
     virtual void update_object(std::shared_ptr<Drawable> const& drawable, std::shared_ptr<Material> const& material,
-                               glm::mat4 const& projection_view) const override;
+                               glm::mat4 const& projection_view, ObjectConstants const& constants) const override;
 
     virtual void unbind_material(std::shared_ptr<Material> const& material) const override;
+    virtual void draw_instance_batches(std::shared_ptr<Material> const& material, glm::mat4 const& projection_view) const override;
+    virtual void bind_universal_resources() const override;
+
+    virtual void begin_gpu_frame() const override;
+    virtual void end_gpu_frame() const override;
+    virtual void begin_gpu_pass(StatisticsPass const pass) const override;
+    virtual void end_gpu_pass(StatisticsPass const pass) const override;
 
 private:
     virtual void initialize_global_renderer_settings() override;
     virtual void initialize_buffers(size_t const max_size) override;
     virtual void perform_frustum_culling(std::shared_ptr<Material> const& material) const override;
 
-    std::shared_ptr<Shader> m_frustum_culling_shader = {};
+    // GPU culled instancing. Instances of every instanced material drawn during a frame are written once into a persistently
+    // mapped buffer, split into instance_buffer_regions regions guarded by fences, so the CPU never overwrites instances
+    // the GPU might still read. Culling compacts indices of visible instances of every batch and counts them directly in
+    // indirect draw commands, so nothing is read back.
+    struct IndirectBatch
+    {
+        u32 instance_count = 0;
+        u32 visible_offset = 0;
+        u32 first_command = 0;
+        u32 command_count = 0;
+    };
+
+    // Recreates the instance buffer when it can't fit the instances and commands, written instances start over in it
+    void reserve_instancing_buffers(size_t const instance_count, size_t const command_count) const;
+    void wait_for_instance_region() const;
+
+    // Every region holds model matrices, culling data of instances and draw commands, in that order
+    [[nodiscard]] size_t get_models_size() const;
+    [[nodiscard]] size_t get_instances_size() const;
+    [[nodiscard]] size_t get_instance_region_size() const;
+    [[nodiscard]] size_t get_models_offset() const;
+    [[nodiscard]] size_t get_instances_offset() const;
+    [[nodiscard]] size_t get_commands_offset() const;
+
+    virtual void draw_debug_lines(std::span<DebugVertex const> const vertices, glm::mat4 const& projection_view) const override;
+    virtual void draw_ui_batches(std::span<UIVertex const> const vertices, std::span<UIBatch const> const batches) const override;
+
+    // Uniform blocks mirror the DX11 constant buffers. Camera and light blocks are set per shader, material blocks per material
+    // and object blocks per draw, while samplers stay plain uniforms of the shaders.
+    void update_uniform_buffer(UniformBlockBinding const binding, void const* data, size_t const size) const;
+
+    template<typename T>
+    void update_uniform_buffer(UniformBlockBinding const binding, T const& data) const
+    {
+        update_uniform_buffer(binding, &data, sizeof(T));
+    }
+
+    // Replaces contents of a storage buffer, which is created on first use, and binds it
+    void update_storage_buffer(StorageBufferBinding const binding, GLuint& buffer, void const* data, size_t const size) const;
+
+    // Timestamp queries of a single frame, reused gpu_timer_frames frames later. Results that aren't available by then are dropped,
+    // so reading them back never stalls the CPU.
+    struct GpuTimerQueries
+    {
+        std::array<GLuint, statistics_pass_count> pass_begin = {};
+        std::array<GLuint, statistics_pass_count> pass_end = {};
+        std::array<bool, statistics_pass_count> is_pass_issued = {};
+        u64 frame = 0;
+        bool is_pending = false;
+        bool is_created = false;
+    };
+
+    void resolve_gpu_timer_queries(GpuTimerQueries& queries) const;
+    [[nodiscard]] GpuTimerQueries& get_current_gpu_timer_queries() const;
+
+    void resolve_uniform_handles() const;
+
+    std::shared_ptr<ShaderGL> m_frustum_culling_shader = {};
+    mutable UniformHandle<glm::vec4> m_frustum_planes_uniform = {};
+    mutable UniformHandle<i32> m_first_instance_uniform = {};
+    mutable UniformHandle<i32> m_instance_count_uniform = {};
+
+    // Programs the handles were looked up in
+    mutable u32 m_resolved_frustum_culling_program = 0;
+    mutable u32 m_resolved_debug_line_program = 0;
+
+    inline static u32 constexpr uniform_block_count = 4;
+    std::array<GLuint, uniform_block_count> m_uniform_buffers = {};
+
+    // Last uploaded contents of the shared blocks
+    mutable UniformBufferCamera m_camera_uniforms = {};
+    mutable UniformBufferLight m_light_uniforms = {};
+
+    inline static u32 constexpr instance_buffer_regions = 3;
+    inline static u32 constexpr culling_group_size = 1024;
+
+    mutable GLuint m_instance_buffer = {};
+    mutable GLuint m_visible_instances_buffer = {};
+    mutable size_t m_instance_capacity = 0;
+    mutable size_t m_command_capacity = 0;
+
+    // Mapped instance buffer. Without persistent mapping (OpenGL 4.4) instances are written to the staging copy and uploaded
+    // with glBufferSubData() instead.
+    mutable u8* m_instance_data = nullptr;
+    mutable std::vector<u8> m_instance_staging = {};
+    bool m_is_persistently_mapped = false;
+    GLint m_storage_buffer_offset_alignment = 1;
+
+    mutable std::array<GLsync, instance_buffer_regions> m_instance_region_fences = {};
+    mutable u32 m_instance_region = 0;
+    mutable size_t m_written_instances = 0;
+    mutable size_t m_written_commands = 0;
+
+    // Batches of the last culled material
+    mutable std::vector<IndirectBatch> m_indirect_batches = {};
+
+    mutable std::array<GpuTimerQueries, gpu_timer_frames> m_gpu_timer_queries = {};
+
+    mutable GLuint m_debug_vertex_buffer = 0;
+    mutable GLuint m_debug_vertex_array = 0;
+    mutable UniformHandle<glm::mat4> m_debug_projection_view_uniform = {};
+
+    // Vertices of a UI group, read by their index like the vertices of debug lines
+    mutable GLuint m_ui_vertex_buffer = 0;
+    mutable GLuint m_ui_vertex_array = 0;
 
-    GLuint m_gpu_instancing_ssbo = {};
-    GLuint m_bounding_boxes_ssbo = {};
-    GLuint m_visible_instances_ssbo = {};
+    // Clustered lighting, all lights and their clusters are uploaded once per frame, see Renderer::assign_light_clusters()
+    mutable std::vector<GLPointLight> m_point_light_data = {};
+    mutable std::vector<GLSpotLight> m_spot_light_data = {};
+    mutable GLuint m_point_light_buffer = 0;
+    mutable GLuint m_spot_light_buffer = 0;
+    mutable GLuint m_light_cluster_buffer = 0;
+    mutable GLuint m_light_index_buffer = 0;
 };
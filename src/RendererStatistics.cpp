@@ -0,0 +1,190 @@
+#include "RendererStatistics.h"
+
+#include <format>
+#include <fstream>
+#include <utility>
+
+#include "Debug.h"
+
+void RendererStatistics::begin_frame()
+{
+    m_frame += 1;
+    m_current = {};
+    m_current.frame = m_frame;
+    m_is_frame_active = true;
+    m_frame_start = Clock::now();
+}
+
+void RendererStatistics::end_frame()
+{
+    if (!m_is_frame_active)
+        return;
+
+    m_current.cpu_ms = std::chrono::duration<double, std::milli>(Clock::now() - m_frame_start).count();
+    m_is_frame_active = false;
+
+    m_history.emplace_back(m_current);
+
+    while (m_history.size() > m_max_history_frames)
+    {
+        m_history.pop_front();
+    }
+}
+
+void RendererStatistics::begin_pass(StatisticsPass const pass)
+{
+    m_pass_start[static_cast<u32>(pass)] = Clock::now();
+}
+
+void RendererStatistics::end_pass(StatisticsPass const pass)
+{
+    auto const index = static_cast<u32>(pass);
+    m_current.passes[index].cpu_ms += std::chrono::duration<double, std::milli>(Clock::now() - m_pass_start[index]).count();
+}
+
+void RendererStatistics::set_gpu_time(u64 const frame, StatisticsPass const pass, double const milliseconds)
+{
+    FrameStatistics* statistics = find_frame(frame);
+
+    if (statistics == nullptr)
+        return;
+
+    statistics->passes[static_cast<u32>(pass)].gpu_ms = milliseconds;
+    statistics->has_gpu_times = true;
+
+    statistics->gpu_ms = 0.0;
+    for (auto const& pass_statistics : statistics->passes)
+    {
+        statistics->gpu_ms += pass_statistics.gpu_ms;
+    }
+}
+
+void RendererStatistics::add_draw_call(u32 const index_count, u32 const instance_count)
+{
+    m_current.draw_calls += 1;
+    m_current.triangles += static_cast<u64>(index_count / 3) * instance_count;
+}
+
+void RendererStatistics::add_buffer_upload()
+{
+    m_current.buffer_uploads += 1;
+}
+
+void RendererStatistics::add_texture_binds(u32 const count)
+{
+    m_current.texture_binds += count;
+}
+
+void RendererStatistics::add_shader_switch()
+{
+    m_current.shader_switches += 1;
+}
+
+u64 RendererStatistics::get_frame()
+{
+    return m_frame;
+}
+
+FrameStatistics const& RendererStatistics::get_last_frame()
+{
+    static FrameStatistics constexpr empty = {};
+
+    if (m_history.empty())
+        return empty;
+
+    return m_history.back();
+}
+
+std::deque<FrameStatistics> const& RendererStatistics::get_history()
+{
+    return m_history;
+}
+
+void RendererStatistics::set_max_history_frames(u32 const frames)
+{
+    m_max_history_frames = frames;
+
+    while (m_history.size() > m_max_history_frames)
+    {
+        m_history.pop_front();
+    }
+}
+
+bool RendererStatistics::write_csv(std::string const& path)
+{
+    std::ofstream file(path);
+
+    if (!file.is_open())
+    {
+        Debug::log(std::format("Could not open {} for writing renderer statistics.", path), DebugType::Error);
+        return false;
+    }
+
+    file << "frame,cpu_ms,gpu_ms,draw_calls,triangles,buffer_uploads,texture_binds,shader_switches";
+
+    for (u32 i = 0; i < statistics_pass_count; ++i)
+    {
+        std::string_view const name = get_pass_name(static_cast<StatisticsPass>(i));
+        file << std::format(",{}_cpu_ms,{}_gpu_ms", name, name);
+    }
+
+    file << "\n";
+
+    // Frames without GPU times have empty GPU columns, so they aren't mistaken for frames which took no GPU time
+    for (auto const& frame : m_history)
+    {
+        std::string const gpu_ms = frame.has_gpu_times ? std::format("{:.4f}", frame.gpu_ms) : "";
+        file << std::format("{},{:.4f},{},{},{},{},{},{}", frame.frame, frame.cpu_ms, gpu_ms, frame.draw_calls, frame.triangles,
+                            frame.buffer_uploads, frame.texture_binds, frame.shader_switches);
+
+        for (auto const& pass : frame.passes)
+        {
+            std::string const pass_gpu_ms = frame.has_gpu_times ? std::format("{:.4f}", pass.gpu_ms) : "";
+            file << std::format(",{:.4f},{}", pass.cpu_ms, pass_gpu_ms);
+        }
+
+        file << "\n";
+    }
+
+    return true;
+}
+
+std::string_view RendererStatistics::get_pass_name(StatisticsPass const pass)
+{
+    switch (pass)
+    {
+    case StatisticsPass::Culling:
+        return "culling";
+    case StatisticsPass::Shadows:
+        return "shadows";
+    case StatisticsPass::RenderQueue:
+        return "render_queue";
+    case StatisticsPass::Geometry:
+        return "geometry";
+    case StatisticsPass::SSAO:
+        return "ssao";
+    case StatisticsPass::Lighting:
+        return "lighting";
+    case StatisticsPass::Forward:
+        return "forward";
+    case StatisticsPass::CustomBeforeAA:
+        return "custom_before_aa";
+    case StatisticsPass::AA:
+        return "aa";
+    case StatisticsPass::CustomAfterAA:
+        return "custom_after_aa";
+    default:
+        std::unreachable();
+    }
+}
+
+FrameStatistics* RendererStatistics::find_frame(u64 const frame)
+{
+    if (m_is_frame_active && m_current.frame == frame)
+        return &m_current;
+
+    if (m_history.empty() || frame < m_history.front().frame || frame > m_history.back().frame)
+        return nullptr;
+
+    return &m_history[frame - m_history.front().frame];
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <string>
+#include <string_view>
+
+#include "AK/Types.h"
+
+// Sections of a frame rendered by Renderer::render(), timed separately on the CPU and the GPU
+enum class StatisticsPass : u8
+{
+    Culling,
+    Shadows,
+    RenderQueue,
+    Geometry,
+    SSAO,
+    Lighting,
+    Forward,
+    CustomBeforeAA,
+    AA,
+    CustomAfterAA,
+    Count,
+};
+
+inline constexpr u32 statistics_pass_count = static_cast<u32>(StatisticsPass::Count);
+
+struct PassStatistics
+{
+    double cpu_ms = 0.0;
+    double gpu_ms = 0.0;
+};
+
+struct FrameStatistics
+{
+    u64 frame = 0;
+    double cpu_ms = 0.0;
+    double gpu_ms = 0.0;
+
+    // GPU times are read back a few frames later, until then they are zero
+    bool has_gpu_times = false;
+
+    u32 draw_calls = 0;
+    u64 triangles = 0;
+    u32 buffer_uploads = 0;
+    u32 texture_binds = 0;
+    u32 shader_switches = 0;
+
+    std::array<PassStatistics, statistics_pass_count> passes = {};
+};
+
+// Statistics of the frames rendered by the renderer. Counters are incremented by the rendering code on the main thread
+// where the API calls are issued (draws, constant buffer maps or uniform buffer updates, texture binds and shader switches).
+// Last max_history_frames frames are kept, so they can be plotted in the editor or written to a CSV file.
+// It doesn't depend on any rendering API, backends only report GPU times of passes through set_gpu_time().
+class RendererStatistics
+{
+public:
+    static void begin_frame();
+    static void end_frame();
+
+    static void begin_pass(StatisticsPass const pass);
+    static void end_pass(StatisticsPass const pass);
+
+    // Can be called for any frame still kept in the history
+    static void set_gpu_time(u64 const frame, StatisticsPass const pass, double const milliseconds);
+
+    static void add_draw_call(u32 const index_count, u32 const instance_count = 1);
+    static void add_buffer_upload();
+    static void add_texture_binds(u32 const count);
+    static void add_shader_switch();
+
+    // Index of the frame being rendered, or of the last rendered frame outside of begin_frame() and end_frame()
+    [[nodiscard]] static u64 get_frame();
+
+    // Last rendered frame, zeroed when nothing was rendered yet
+    [[nodiscard]] static FrameStatistics const& get_last_frame();
+    [[nodiscard]] static std::deque<FrameStatistics> const& get_history();
+
+    static void set_max_history_frames(u32 const frames);
+
+    // Writes one line per frame of the history, with per pass columns after the frame totals
+    static bool write_csv(std::string const& path);
+
+    [[nodiscard]] static std::string_view get_pass_name(StatisticsPass const pass);
+
+private:
+    [[nodiscard]] static FrameStatistics* find_frame(u64 const frame);
+
+    using Clock = std::chrono::steady_clock;
+
+    inline static std::deque<FrameStatistics> m_history = {};
+    inline static FrameStatistics m_current = {};
+    inline static u64 m_frame = 0;
+    inline static bool m_is_frame_active = false;
+    inline static u32 m_max_history_frames = 300;
+
+    inline static Clock::time_point m_frame_start = {};
+    inline static std::array<Clock::time_point, statistics_pass_count> m_pass_start = {};
+};
@@ -87,6 +87,61 @@ std::shared_ptr<Texture> ResourceManager::load_cubemap(std::string const& path,
     return resource_ptr;
 }
 
+std::shared_ptr<Texture> ResourceManager::load_texture_from_memory(std::string const& name, u8 const* data, u32 const width,
+                                                                   u32 const height, TextureSettings const& settings)
+{
+    std::stringstream stream;
+    stream << name;
+    std::string const& key = generate_key(stream);
+    std::shared_ptr<Texture> resource_ptr = get_from_vector<Texture>(key);
+
+    if (resource_ptr != nullptr)
+        return resource_ptr;
+
+    resource_ptr = TextureLoader::get_instance()->load_texture_from_memory(name, data, width, height, settings);
+    m_textures.emplace_back(resource_ptr);
+    names_to_textures.insert(std::make_pair(key, m_textures.size() - 1));
+
+    return resource_ptr;
+}
+
+std::shared_ptr<GlyphAtlas> ResourceManager::load_glyph_atlas(std::string const& font_path, float const pixel_size)
+{
+    std::stringstream stream;
+    stream << font_path << pixel_size;
+    std::string const& key = generate_key(stream);
+    auto resource_ptr = get_from_vector<GlyphAtlas>(key);
+
+    if (resource_ptr != nullptr)
+        return resource_ptr;
+
+    resource_ptr = GlyphAtlas::create(font_path, pixel_size);
+
+    // Fonts that failed to load aren't kept, so they are reported every time they're used
+    if (resource_ptr == nullptr)
+        return nullptr;
+
+    m_glyph_atlases.emplace_back(resource_ptr);
+    names_to_glyph_atlases.insert(std::make_pair(key, m_glyph_atlases.size() - 1));
+
+    return resource_ptr;
+}
+
+std::shared_ptr<Texture> ResourceManager::load_glyph_atlas_texture(GlyphAtlas const& atlas)
+{
+    TextureSettings texture_settings = {};
+    texture_settings.wrap_mode_x = TextureWrapMode::ClampToEdge;
+    texture_settings.wrap_mode_y = TextureWrapMode::ClampToEdge;
+    texture_settings.wrap_mode_z = TextureWrapMode::ClampToEdge;
+    texture_settings.generate_mipmaps = false;
+    texture_settings.flip_vertically = false;
+
+    std::stringstream stream;
+    stream << "GLYPH_ATLAS" << atlas.get_font_path() << atlas.get_pixel_size();
+
+    return load_texture_from_memory(stream.str(), atlas.get_pixels().data(), atlas.get_width(), atlas.get_height(), texture_settings);
+}
+
 std::shared_ptr<Shader> ResourceManager::load_shader(std::string const& compute_path)
 {
     std::stringstream stream;
@@ -163,7 +218,7 @@ std::shared_ptr<Shader> ResourceManager::load_shader(std::string const& vertex_p
 std::shared_ptr<Mesh> ResourceManager::load_mesh(u32 const array_id, std::string const& name, std::vector<Vertex> const& vertices,
                                                  std::vector<u32> const& indices, std::vector<std::shared_ptr<Texture>> const& textures,
                                                  DrawType const draw_type, std::shared_ptr<Material> const& material,
-                                                 DrawFunctionType const draw_function)
+                                                 DrawFunctionType const draw_function, bool const cpu_access)
 {
     std::stringstream stream;
     stream << name << array_id;
@@ -188,7 +243,7 @@ std::shared_ptr<Mesh> ResourceManager::load_mesh(u32 const array_id, std::string
     if (resource_ptr != nullptr)
         return resource_ptr;
 
-    resource_ptr = MeshFactory::create(vertices, indices, textures, draw_type, material, draw_function);
+    resource_ptr = MeshFactory::create(vertices, indices, textures, draw_type, material, draw_function, cpu_access);
     m_meshes.emplace_back(resource_ptr);
     names_to_meshes.insert(std::make_pair(key, m_meshes.size() - 1));
 
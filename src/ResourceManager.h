@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "AK/Types.h"
+#include "GlyphAtlas.h"
 #include "Mesh.h"
 #include "Model.h"
 #include "Shader.h"
@@ -30,6 +31,15 @@ public:
                                           TextureSettings const& settings = {});
     std::shared_ptr<Texture> load_cubemap(std::string const& path, TextureType const type, TextureSettings const& settings = {});
 
+    // Textures created from data in memory are only identified by their name, the data of a name is expected to never change
+    std::shared_ptr<Texture> load_texture_from_memory(std::string const& name, u8 const* data, u32 const width, u32 const height,
+                                                      TextureSettings const& settings = {});
+
+    std::shared_ptr<GlyphAtlas> load_glyph_atlas(std::string const& font_path, float const pixel_size);
+
+    // Texture of the atlas pixels, created once per atlas
+    std::shared_ptr<Texture> load_glyph_atlas_texture(GlyphAtlas const& atlas);
+
     std::shared_ptr<Shader> load_shader(std::string const& compute_path);
     std::shared_ptr<Shader> load_shader(std::string const& vertex_path, std::string const& fragment_path);
     std::shared_ptr<Shader> load_shader(std::string const& vertex_path, std::string const& fragment_path, std::string const& geometry_path);
@@ -39,7 +49,7 @@ public:
     std::shared_ptr<Mesh> load_mesh(u32 const array_id, std::string const& name, std::vector<Vertex> const& vertices,
                                     std::vector<u32> const& indices, std::vector<std::shared_ptr<Texture>> const& textures,
                                     DrawType const draw_type, std::shared_ptr<Material> const& material,
-                                    DrawFunctionType const draw_function = DrawFunctionType::Indexed);
+                                    DrawFunctionType const draw_function = DrawFunctionType::Indexed, bool const cpu_access = false);
 
     void reset_state() const;
 
@@ -80,6 +90,15 @@ private:
                 return m_shaders[id];
             }
         }
+        else if constexpr (std::is_same_v<T, GlyphAtlas>)
+        {
+            auto const it = names_to_glyph_atlases.find(key);
+            if (it != names_to_glyph_atlases.end())
+            {
+                id = it->second;
+                return m_glyph_atlases[id];
+            }
+        }
 
         return nullptr;
     }
@@ -90,11 +109,13 @@ private:
     std::vector<std::shared_ptr<Texture>> m_textures = {};
     std::vector<std::shared_ptr<Mesh>> m_meshes = {};
     std::vector<std::shared_ptr<Shader>> m_shaders = {};
+    std::vector<std::shared_ptr<GlyphAtlas>> m_glyph_atlases = {};
 
     // KEYS (usually generated from path and optionally additional data) | INDICES, in a respective vector.
     std::unordered_map<std::string, u16> names_to_textures = {};
     std::unordered_map<std::string, u16> names_to_meshes = {};
     std::unordered_map<std::string, u16> names_to_shaders = {};
+    std::unordered_map<std::string, u16> names_to_glyph_atlases = {};
 
     inline static std::shared_ptr<ResourceManager> m_instance;
 };
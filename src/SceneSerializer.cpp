@@ -28,6 +28,7 @@
 #include "Floater.h"
 #include "FloatersManager.h"
 #include "FloeButton.h"
+#include "FoliageScatter.h"
 #include "Game/Clock.h"
 #include "Game/Credits.h"
 #include "Game/Customer.h"
@@ -56,6 +57,7 @@
 #include "Game/Thanks.h"
 #include "Game/Truther.h"
 #include "Game/WheatOverlay.h"
+#include "Grass.h"
 #include "Komiks/Cow.h"
 #include "Komiks/CowManager.h"
 #include "Komiks/JeepReflector.h"
@@ -280,6 +282,33 @@ void SceneSerializer::auto_serialize_component(YAML::Emitter& out, std::shared_p
         if (auto const model = std::dynamic_pointer_cast<class Model>(component); model != nullptr)
         {
             // # Put new Model kid here
+            if (auto const grass = std::dynamic_pointer_cast<class Grass>(component); grass != nullptr)
+            {
+                out << YAML::Key << "ComponentName" << YAML::Value << "GrassComponent";
+                out << YAML::Key << "guid" << YAML::Value << grass->guid;
+        #if EDITOR
+                out << YAML::Key << "custom_name" << YAML::Value << grass->get_custom_name();
+        #endif
+                out << YAML::Key << "diffuse_texture_path" << YAML::Value << grass->diffuse_texture_path;
+                out << YAML::Key << "area_size" << YAML::Value << grass->area_size;
+                out << YAML::Key << "density" << YAML::Value << grass->density;
+                out << YAML::Key << "density_map_path" << YAML::Value << grass->density_map_path;
+                out << YAML::Key << "seed" << YAML::Value << grass->seed;
+            }
+            else
+            if (auto const foliagescatter = std::dynamic_pointer_cast<class FoliageScatter>(component); foliagescatter != nullptr)
+            {
+                out << YAML::Key << "ComponentName" << YAML::Value << "FoliageScatterComponent";
+                out << YAML::Key << "guid" << YAML::Value << foliagescatter->guid;
+        #if EDITOR
+                out << YAML::Key << "custom_name" << YAML::Value << foliagescatter->get_custom_name();
+        #endif
+                out << YAML::Key << "area_size" << YAML::Value << foliagescatter->area_size;
+                out << YAML::Key << "density" << YAML::Value << foliagescatter->density;
+                out << YAML::Key << "density_map_path" << YAML::Value << foliagescatter->density_map_path;
+                out << YAML::Key << "seed" << YAML::Value << foliagescatter->seed;
+            }
+            else
             if (auto const water = std::dynamic_pointer_cast<class Water>(component); water != nullptr)
             {
                 out << YAML::Key << "ComponentName" << YAML::Value << "WaterComponent";
@@ -542,6 +571,7 @@ void SceneSerializer::auto_serialize_component(YAML::Emitter& out, std::shared_p
         out << YAML::Key << "volume" << YAML::Value << sound->volume;
         out << YAML::Key << "play_on_awake" << YAML::Value << sound->play_on_awake;
         out << YAML::Key << "is_positional" << YAML::Value << sound->is_positional;
+        out << YAML::Key << "load_policy" << YAML::Value << sound->load_policy;
         out << YAML::EndMap;
     }
     else
@@ -1491,6 +1521,96 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
         }
     }
         else
+    if (component_name == "GrassComponent")
+    {
+        if (first_pass)
+        {
+            auto const deserialized_component = Grass::create();
+            deserialized_component->guid = component["guid"].as<std::string>();
+#if EDITOR
+            Editor::Editor::get_instance()->set_component_custom_name(deserialized_component->guid, component["custom_name"].as<std::string>());
+#endif
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Grass>(get_from_pool(component["guid"].as<std::string>()));
+            if (component["diffuse_texture_path"].IsDefined())
+            {
+                deserialized_component->diffuse_texture_path = component["diffuse_texture_path"].as<std::string>();
+            }
+            if (component["area_size"].IsDefined())
+            {
+                deserialized_component->area_size = component["area_size"].as<glm::vec2>();
+            }
+            if (component["density"].IsDefined())
+            {
+                deserialized_component->density = component["density"].as<float>();
+            }
+            if (component["density_map_path"].IsDefined())
+            {
+                deserialized_component->density_map_path = component["density_map_path"].as<std::string>();
+            }
+            if (component["seed"].IsDefined())
+            {
+                deserialized_component->seed = component["seed"].as<u32>();
+            }
+            if (component["model_path"].IsDefined())
+            {
+                deserialized_component->model_path = component["model_path"].as<std::string>();
+            }
+            if (component["material"].IsDefined())
+            {
+                deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
+            }
+            deserialized_entity->add_component(deserialized_component);
+            deserialized_component->reprepare();
+        }
+    }
+        else
+    if (component_name == "FoliageScatterComponent")
+    {
+        if (first_pass)
+        {
+            auto const deserialized_component = FoliageScatter::create();
+            deserialized_component->guid = component["guid"].as<std::string>();
+#if EDITOR
+            Editor::Editor::get_instance()->set_component_custom_name(deserialized_component->guid, component["custom_name"].as<std::string>());
+#endif
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class FoliageScatter>(get_from_pool(component["guid"].as<std::string>()));
+            if (component["area_size"].IsDefined())
+            {
+                deserialized_component->area_size = component["area_size"].as<glm::vec2>();
+            }
+            if (component["density"].IsDefined())
+            {
+                deserialized_component->density = component["density"].as<float>();
+            }
+            if (component["density_map_path"].IsDefined())
+            {
+                deserialized_component->density_map_path = component["density_map_path"].as<std::string>();
+            }
+            if (component["seed"].IsDefined())
+            {
+                deserialized_component->seed = component["seed"].as<u32>();
+            }
+            if (component["model_path"].IsDefined())
+            {
+                deserialized_component->model_path = component["model_path"].as<std::string>();
+            }
+            if (component["material"].IsDefined())
+            {
+                deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
+            }
+            deserialized_entity->add_component(deserialized_component);
+            deserialized_component->reprepare();
+        }
+    }
+        else
     if (component_name == "SpriteComponent")
     {
         if (first_pass)
@@ -2174,6 +2294,10 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->is_positional = component["is_positional"].as<bool>();
             }
+            if (component["load_policy"].IsDefined())
+            {
+                deserialized_component->load_policy = component["load_policy"].as<SoundLoadPolicy>();
+            }
             deserialized_entity->add_component(deserialized_component);
             deserialized_component->reprepare();
         }
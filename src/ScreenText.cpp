@@ -1,12 +1,11 @@
 #include "ScreenText.h"
 
-#include "AK/AK.h"
-#include "AK/Math.h"
 #include "Editor.h"
 #include "Entity.h"
-#include "RendererDX11.h"
+#include "Renderer.h"
 #include "ResourceManager.h"
 #include "ShaderFactory.h"
+#include "UIBatcher.h"
 
 #if EDITOR
 #include "imgui_stdlib.h"
@@ -25,7 +24,7 @@ std::shared_ptr<ScreenText> ScreenText::create()
     ui_material->casts_shadows = false;
 
     auto text = std::make_shared<ScreenText>(AK::Badge<ScreenText> {}, ui_material, "Example text", glm::vec2(0, 0), 40, 0xff0099ff,
-                                             FW1_RESTORESTATE | FW1_CENTER | FW1_VCENTER);
+                                             TextFlags::Center | TextFlags::VerticalCenter);
 
     return text;
 }
@@ -39,26 +38,10 @@ std::shared_ptr<ScreenText> ScreenText::create(std::shared_ptr<Material> const&
 
 ScreenText::ScreenText(AK::Badge<ScreenText>, std::shared_ptr<Material> const& material, std::string const& content,
                        glm::vec2 const& position, float const font_size, u32 const color, u16 const flags)
-    : Drawable(material), text(content), position(position), font_size(font_size), color(color),
-      flags(flags | FW1_RESTORESTATE) // Restore DX11 state by default
+    : Drawable(material), text(content), position(position), font_size(font_size), color(color), flags(flags)
 {
 }
 
-ScreenText::~ScreenText()
-{
-    if (m_font_wrapper)
-        m_font_wrapper->Release();
-
-    if (m_d_write_factory)
-        m_d_write_factory->Release();
-
-    if (m_d_write_text_format)
-        m_d_write_text_format->Release();
-
-    if (m_d_write_text_layout)
-        m_d_write_text_layout->Release();
-}
-
 void ScreenText::initialize()
 {
     Drawable::initialize();
@@ -72,9 +55,6 @@ void ScreenText::initialize()
         }
     }
 
-    m_viewport = get_viewport();
-
-    refresh_font_settings();
     refresh_layout();
 }
 
@@ -107,23 +87,25 @@ void ScreenText::on_disabled()
 
 void ScreenText::draw() const
 {
-    glm::vec3 const entity_pos = entity->transform->get_position();
-    glm::vec2 const screen_size = {Renderer::get_instance()->screen_width, Renderer::get_instance()->screen_height};
+    // Glyphs are drawn by the renderer's UI batcher, see add_ui_quads()
+}
 
-    glm::vec2 pos_to_draw = {AK::Math::map_range_clamped(-1.0f, 1.0f, 0, screen_size.x, entity_pos.x),
-                             screen_size.y - AK::Math::map_range_clamped(-1.0f, 1.0f, 0, screen_size.y, entity_pos.y)};
+std::shared_ptr<Texture> ScreenText::get_ui_texture() const
+{
+    return m_atlas_texture;
+}
 
-    if (m_align_to_center)
-    {
-        pos_to_draw = {AK::Math::map_range_clamped(-1.0f, 3.0f, 0, screen_size.x, entity_pos.x),
-                       screen_size.y - AK::Math::map_range_clamped(-1.0f, 3.0f, 0, screen_size.y, entity_pos.y + 2.0f)};
+void ScreenText::add_ui_quads(UIBatcher& batcher, i32 const render_order) const
+{
+    if (m_layout == nullptr)
+        return;
 
-        glm::vec2 const align_offset = {pos_to_draw.x - m_layout_width * 0.5f, pos_to_draw.y - m_layout_height * 0.5f};
-        pos_to_draw += align_offset;
-    }
+    // Entity position is given in normalized device coordinates, the text is aligned around it
+    glm::vec3 const entity_position = entity->transform->get_position();
+    glm::vec2 const screen_size = {static_cast<float>(Renderer::screen_width), static_cast<float>(Renderer::screen_height)};
+    glm::vec2 const anchor = glm::vec2(entity_position.x * 0.5f + 0.5f, 0.5f - entity_position.y * 0.5f) * screen_size;
 
-    m_font_wrapper->DrawTextLayout(RendererDX11::get_instance_dx11()->get_device_context(), m_d_write_text_layout, pos_to_draw.x,
-                                   pos_to_draw.y, color, flags);
+    batcher.add_text(render_order, m_atlas_texture, *m_layout, anchor, font_size / m_atlas->get_pixel_size(), color, screen_size);
 }
 
 #if EDITOR
@@ -176,19 +158,21 @@ void ScreenText::custom_draw_editor()
 
     ImGui::InputText("Text", &text);
 
-    set_text(text);
+    i32 alignment_flags = flags;
+    ImGui::CheckboxFlags("Align to Center", &alignment_flags, TextFlags::Center);
+    ImGui::CheckboxFlags("Align to Vertical Center", &alignment_flags, TextFlags::VerticalCenter);
+    flags = static_cast<u16>(alignment_flags);
 
-    ImGui::Checkbox("Align to Center", &m_align_to_center);
     ImGuiEx::draw_ptr("Button ref", button_ref);
 
-    realign_text(m_align_to_center);
+    set_text(text);
 }
 #endif
 
 void ScreenText::update()
 {
-    set_text(text);
-    realign_text(m_align_to_center);
+    // Fields can also be changed directly, e.g. the font size
+    refresh_layout();
 }
 
 void ScreenText::hover()
@@ -217,91 +201,43 @@ void ScreenText::set_text(std::string const& new_content)
     refresh_layout();
 }
 
-void ScreenText::realign_text(bool const center) const
+// Atlases are shared by all texts of the same font and size, only the first text using them bakes their glyphs
+void ScreenText::refresh_font_settings()
 {
-    if (center)
-    {
-        HRESULT hr = m_d_write_text_layout->SetTextAlignment(DWRITE_TEXT_ALIGNMENT_CENTER);
-        assert(SUCCEEDED(hr));
+    m_atlas_font_name = font_name;
+    m_atlas_bold = bold;
+    m_atlas_pixel_size = GlyphAtlas::round_pixel_size(font_size);
 
-        hr = m_d_write_text_layout->SetParagraphAlignment(DWRITE_PARAGRAPH_ALIGNMENT_CENTER);
-        assert(SUCCEEDED(hr));
-    }
-    else
-    {
-        HRESULT hr = m_d_write_text_layout->SetTextAlignment(DWRITE_TEXT_ALIGNMENT_JUSTIFIED);
-        assert(SUCCEEDED(hr));
-
-        hr = m_d_write_text_layout->SetParagraphAlignment(DWRITE_PARAGRAPH_ALIGNMENT_NEAR);
-        assert(SUCCEEDED(hr));
-    }
-}
+    m_atlas = nullptr;
+    m_atlas_texture = nullptr;
+    m_layout = nullptr;
 
-// This function is expensive
-void ScreenText::refresh_font_settings()
-{
-    if (m_d_write_factory != nullptr)
-    {
-        m_d_write_factory->Release();
-        m_d_write_factory = nullptr;
-    }
+    std::string const font_path = Renderer::find_font_path(font_name, bold);
 
-    if (m_d_write_text_format != nullptr)
+    if (font_path.empty())
     {
-        m_d_write_text_format->Release();
-        m_d_write_text_format = nullptr;
+        Debug::log("Font " + font_name + " used by a screen text is not loaded.", DebugType::Error);
+        return;
     }
 
-    HRESULT hr = FW1CreateFactory(FW1_VERSION, &m_FW1_factory);
-    assert(SUCCEEDED(hr));
-
-    hr = DWriteCreateFactory(DWRITE_FACTORY_TYPE_SHARED, __uuidof(IDWriteFactory), reinterpret_cast<IUnknown**>(&m_d_write_factory));
-    assert(SUCCEEDED(hr));
+    m_atlas = ResourceManager::get_instance().load_glyph_atlas(font_path, m_atlas_pixel_size);
 
-    m_d_write_factory->CreateTextFormat(AK::string_to_wstring(font_name).c_str(), // Font family name
-                                        nullptr, // Font collection (NULL for the system font collection)
-                                        bold ? DWRITE_FONT_WEIGHT_BOLD : DWRITE_FONT_WEIGHT_REGULAR, DWRITE_FONT_STYLE_NORMAL,
-                                        DWRITE_FONT_STRETCH_NORMAL,
-                                        font_size, // Font size
-                                        L"pl-PL", // Locale
-                                        &m_d_write_text_format);
-    assert(SUCCEEDED(hr));
-
-    hr = m_FW1_factory->CreateFontWrapper(RendererDX11::get_instance_dx11()->get_device(), AK::string_to_wstring(font_name).c_str(),
-                                          &m_font_wrapper);
-    assert(SUCCEEDED(hr));
-
-    m_FW1_factory->Release();
-}
-
-D3D11_VIEWPORT ScreenText::get_viewport()
-{
-    UINT num_viewports = 1;
-    D3D11_VIEWPORT viewports[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
-    RendererDX11::get_instance_dx11()->get_device_context()->RSGetViewports(&num_viewports, viewports);
-    return viewports[0];
+    if (m_atlas != nullptr)
+        m_atlas_texture = ResourceManager::get_instance().load_glyph_atlas_texture(*m_atlas);
 }
 
 void ScreenText::refresh_layout()
 {
-    if (m_d_write_text_layout != nullptr)
-    {
-        m_d_write_text_layout->Release();
-        m_d_write_text_layout = nullptr;
-    }
-
-    // Create a new text layout with the updated content
-    HRESULT hr = m_d_write_factory->CreateTextLayout(AK::string_to_wstring(text).data(), text.size(), m_d_write_text_format, m_layout_width,
-                                                     m_layout_height, &m_d_write_text_layout);
-    assert(SUCCEEDED(hr));
+    if (font_name != m_atlas_font_name || bold != m_atlas_bold || GlyphAtlas::round_pixel_size(font_size) != m_atlas_pixel_size)
+        refresh_font_settings();
 
-    realign_text(m_align_to_center);
-    DWRITE_TEXT_RANGE tr = {};
-    tr.length = 256;
-    tr.startPosition = 0;
+    if (m_atlas == nullptr)
+        return;
 
-    hr = m_d_write_text_layout->SetFontSize(font_size, tr);
-    assert(SUCCEEDED(hr));
+    if (m_layout != nullptr && text == m_layout_text && flags == m_layout_flags)
+        return;
 
-    realign_text(m_align_to_center);
+    m_layout = m_layout_cache.get(m_atlas, text, flags);
+    m_layout_text = text;
+    m_layout_flags = flags;
 }
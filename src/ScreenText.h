@@ -2,14 +2,11 @@
 
 #include "Button.h"
 #include "Drawable.h"
-#include "RendererDX11.h"
-
-#include <FW1FontWrapper.h>
-
-#include <dwrite.h>
-
-#pragma comment(lib, "Dwrite")
+#include "GlyphAtlas.h"
+#include "TextLayout.h"
 
+// Text drawn on screen with glyphs baked from res/fonts, batched together with the rest of the UI.
+// Text is only laid out again when its content, font or alignment changes.
 CUSTOM_EDITOR_ONLY
 class ScreenText final : public Drawable
 {
@@ -20,7 +17,6 @@ public:
 
     ScreenText(AK::Badge<ScreenText>, std::shared_ptr<Material> const& material, std::string const& content, glm::vec2 const& position,
                float const font_size, u32 const color, u16 const flags);
-    ~ScreenText() override;
 
     virtual void initialize() override;
 
@@ -32,6 +28,9 @@ public:
     virtual void draw() const override;
     virtual void update() override;
 
+    [[nodiscard]] virtual std::shared_ptr<Texture> get_ui_texture() const override;
+    virtual void add_ui_quads(UIBatcher& batcher, i32 const render_order) const override;
+
 #if EDITOR
     virtual void draw_editor() override;
 #endif
@@ -47,7 +46,6 @@ public:
 
     // This can be updated.
     void set_text(std::string const& new_content);
-    void realign_text(bool const center) const;
     void refresh_font_settings();
 
     // Text properties
@@ -55,26 +53,27 @@ public:
     glm::vec2 position = {};
     float font_size = 40;
     u32 color = 0;
-    u16 flags = 0; //  Stores flags such as FW1_CENTER | FW1_VCENTER. FW1_RESTORESTATE is set by default.
+    u16 flags = 0; // Stores alignment flags such as TextFlags::Center | TextFlags::VerticalCenter.
     std::string font_name = {};
     bool bold = false;
 
     std::weak_ptr<Button> button_ref = {};
 
 private:
-    static D3D11_VIEWPORT get_viewport();
     void refresh_layout();
 
-    // DWrite and FW1 variables
-    IFW1Factory* m_FW1_factory = nullptr;
-    IFW1FontWrapper* m_font_wrapper = nullptr;
-    IDWriteFactory* m_d_write_factory = nullptr;
-    IDWriteTextFormat* m_d_write_text_format = nullptr;
-    IDWriteTextLayout* m_d_write_text_layout = nullptr;
-    float m_layout_width = 2048.0f;
-    float m_layout_height = 2048.0f;
-    bool m_align_to_center = true;
-
-    // DirectX stuff
-    D3D11_VIEWPORT m_viewport = {};
+    std::shared_ptr<GlyphAtlas> m_atlas = {};
+    std::shared_ptr<Texture> m_atlas_texture = {};
+
+    // Font the atlas was loaded for, also kept when it failed to load so it's only reported once
+    std::string m_atlas_font_name = {};
+    bool m_atlas_bold = false;
+    float m_atlas_pixel_size = 0.0f;
+
+    std::shared_ptr<TextLayout const> m_layout = {};
+    std::string m_layout_text = {};
+    u16 m_layout_flags = 0;
+
+    // Texts with the same content share their layout
+    inline static TextLayoutCache m_layout_cache = {};
 };
@@ -1,5 +1,10 @@
 #include "Shader.h"
 
+bool Shader::reads_instance_models() const
+{
+    return m_reads_instance_models;
+}
+
 std::string Shader::get_vertex_path()
 {
     return m_vertex_path;
@@ -26,6 +26,23 @@ public:
     void virtual set_mat4(std::string const& name, glm::mat4 const value) const = 0;
     void virtual load_shader() = 0;
 
+    // Compiles binaries of all stages into the shader cache without creating any API objects, so it can be called
+    // from worker threads before load_shader(). Returns false and appends compilation errors when any stage fails.
+    bool virtual compile(std::string& errors)
+    {
+        return true;
+    }
+
+    // Shaders that can't compile on worker threads are only compiled by load_shader(), on the main thread
+    bool virtual compiles_on_worker_threads() const
+    {
+        return true;
+    }
+
+    // Whether the vertex shader takes model matrices of instances from instance buffers, so instanced draws of drawables
+    // drawing many instances by themselves place every instance on its own
+    [[nodiscard]] bool reads_instance_models() const;
+
     std::string get_vertex_path();
     std::string get_fragment_path();
     std::string get_geometry_path();
@@ -50,6 +67,9 @@ protected:
     std::string m_fragment_path = {};
     std::string m_geometry_path = {};
 
+    // Set by the backends from the reflection of the vertex shader, whenever it's loaded
+    bool m_reads_instance_models = false;
+
 private:
     friend class SceneSerializer;
 };
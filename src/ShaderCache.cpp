@@ -0,0 +1,81 @@
+#include "ShaderCache.h"
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <system_error>
+#include <thread>
+
+#include "AK/AK.h"
+
+u64 ShaderCache::make_key(std::initializer_list<std::string_view> const parts)
+{
+    // Two 32-bit hashes with different seeds, every part is hashed with the hash of the previous parts as a seed
+    u32 low = 0x9747b28c;
+    u32 high = 0x5bd1e995;
+
+    for (auto const& part : parts)
+    {
+        // Length is hashed as well, so parts moved between neighbours produce a different key
+        u64 const size = part.size();
+        low = AK::murmur_hash(reinterpret_cast<u8 const*>(&size), sizeof(size), low);
+        high = AK::murmur_hash(reinterpret_cast<u8 const*>(&size), sizeof(size), high);
+
+        low = AK::murmur_hash(reinterpret_cast<u8 const*>(part.data()), part.size(), low);
+        high = AK::murmur_hash(reinterpret_cast<u8 const*>(part.data()), part.size(), high);
+    }
+
+    return static_cast<u64>(high) << 32 | low;
+}
+
+bool ShaderCache::load(u64 const key, std::vector<u8>& data)
+{
+    std::ifstream file(get_entry_path(key), std::ios::binary | std::ios::ate);
+
+    if (!file.is_open())
+        return false;
+
+    std::streamsize const file_size = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    data.resize(static_cast<size_t>(file_size));
+
+    if (!file.read(reinterpret_cast<char*>(data.data()), file_size))
+    {
+        data.clear();
+        return false;
+    }
+
+    return !data.empty();
+}
+
+bool ShaderCache::store(u64 const key, std::span<u8 const> const data)
+{
+    std::error_code error = {};
+    std::filesystem::create_directories(m_compiled_path, error);
+
+    std::string const path = get_entry_path(key);
+    std::string const temporary_path = std::format("{}.{}.tmp", path, std::hash<std::thread::id> {}(std::this_thread::get_id()));
+
+    // Written to a temporary file first, so a crash can't leave a truncated entry behind. Temporary files are per thread,
+    // so the same shader compiled on two threads at once doesn't corrupt the entry.
+    {
+        std::ofstream file(temporary_path, std::ios::binary);
+
+        if (!file.is_open())
+            return false;
+
+        file.write(reinterpret_cast<char const*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+        if (!file)
+            return false;
+    }
+
+    std::filesystem::rename(temporary_path, path, error);
+    return !error;
+}
+
+std::string ShaderCache::get_entry_path(u64 const key)
+{
+    return std::format("{}{:016x}.bin", m_compiled_path, key);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "AK/Types.h"
+
+// Persistent cache of compiled shaders (DXBC blobs for DX11, program binaries for OpenGL) stored in res/shaders/compiled.
+// Entries are keyed by a hash of everything that affects the compiled output: source with all of its includes, defines,
+// entry point, profile or driver. Changed shaders get a new key, so stale entries are never loaded.
+// It doesn't depend on any rendering API and can be used from multiple threads, as long as each thread stores different keys.
+class ShaderCache
+{
+public:
+    [[nodiscard]] static u64 make_key(std::initializer_list<std::string_view> const parts);
+
+    static bool load(u64 const key, std::vector<u8>& data);
+    static bool store(u64 const key, std::span<u8 const> const data);
+
+private:
+    [[nodiscard]] static std::string get_entry_path(u64 const key);
+
+    // NOTE: Do not use constexpr here! The string will not live until runtime because of that.
+    //       https://developercommunity.visualstudio.com/t/c20-constexpr-stdstring-with-static-is-not-working/1441363
+    inline static std::string m_compiled_path = "./res/shaders/compiled/";
+};
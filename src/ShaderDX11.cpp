@@ -3,15 +3,25 @@
 #include "AK/AK.h"
 #include "Renderer.h"
 #include "RendererDX11.h"
+#include "ShaderCache.h"
 
 #include <d3dcommon.h>
+#include <d3d11shader.h>
 #include <d3dcompiler.h>
 #pragma comment(lib, "d3dcompiler")
+#pragma comment(lib, "dxguid")
 
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <execution>
 #include <filesystem>
+#include <format>
 #include <fstream>
 #include <iostream>
+#include <string_view>
+#include <tuple>
+#include <vector>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -41,146 +51,287 @@ ShaderDX11::ShaderDX11(AK::Badge<ShaderFactory>, std::string const& vertex_path,
 
 void ShaderDX11::load_shader()
 {
-    HRESULT hr;
-    // Load vertex shader
-    ID3DBlob* vs_blob;
+    std::string errors = {};
+    ID3DBlob* vs_blob = compile_stage(m_vertex_path, "vs_main", "vs_5_0", errors);
+
+    if (vs_blob == nullptr)
     {
-        ID3DBlob* shader_compile_errors_blob;
+        std::cout << errors << "\n";
+        return;
+    }
 
-        std::wstring const vertex_path_final = std::wstring(m_vertex_path.begin(), m_vertex_path.end());
-        size_t size = 0;
-        char const* shader_source = read_hlsl_shader_from_file(m_vertex_path, &size);
-        hr = D3DPreprocess(shader_source, size, m_vertex_path.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, &vs_blob,
-                           &shader_compile_errors_blob);
+    ID3DBlob* ps_blob = compile_stage(m_fragment_path, "ps_main", "ps_5_0", errors);
 
-        delete[] shader_source;
+    if (ps_blob == nullptr)
+    {
+        std::cout << errors << "\n";
+        vs_blob->Release();
+        return;
+    }
 
-        if (FAILED(hr))
-        {
-            char const* error_string = nullptr;
-            if (hr == HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND))
-            {
-                error_string = "Error. Vertex shader file not found.";
-            }
-            else if (shader_compile_errors_blob)
-            {
-                error_string = static_cast<char const*>(shader_compile_errors_blob->GetBufferPointer());
-                shader_compile_errors_blob->Release();
-            }
-
-            std::cout << error_string << "\n";
-            return;
-        }
+    auto const device = RendererDX11::get_instance_dx11()->get_device();
 
-        std::string const hash =
-            std::to_string(AK::murmur_hash(static_cast<u8*>(vs_blob->GetBufferPointer()), vs_blob->GetBufferSize(), 0));
+    ID3D11VertexShader* vertex_shader = nullptr;
+    HRESULT hr = device->CreateVertexShader(vs_blob->GetBufferPointer(), vs_blob->GetBufferSize(), nullptr, &vertex_shader);
 
-        if (!read_file_to_blob(m_vertex_path + hash + "vs_main", &vs_blob))
-        {
-            hr = D3DCompile(vs_blob->GetBufferPointer(), vs_blob->GetBufferSize(), nullptr, nullptr, nullptr, "vs_main", "vs_5_0", 0, 0,
-                            &vs_blob, &shader_compile_errors_blob);
+    if (FAILED(hr))
+    {
+        std::cout << "Error. Vertex shader creation failed."
+                  << "\n";
+        vs_blob->Release();
+        ps_blob->Release();
+        return;
+    }
 
-            if (FAILED(hr))
-            {
-                auto const error_string = static_cast<char const*>(shader_compile_errors_blob->GetBufferPointer());
-                std::cout << error_string << "\n";
-                return;
-            }
+    ID3D11PixelShader* pixel_shader = nullptr;
+    hr = device->CreatePixelShader(ps_blob->GetBufferPointer(), ps_blob->GetBufferSize(), nullptr, &pixel_shader);
+    ps_blob->Release();
 
-            save_compiled_shader(m_vertex_path + hash + "vs_main", vs_blob);
-        }
+    if (FAILED(hr))
+    {
+        std::cout << "Error. Fragment shader creation failed."
+                  << "\n";
+        vertex_shader->Release();
+        vs_blob->Release();
+        return;
+    }
+
+    // Previous shaders are only replaced once both stages are valid, so a failed reload keeps the old ones working
+    release_shaders();
+    m_vertex_shader = vertex_shader;
+    m_pixel_shader = pixel_shader;
+
+    // Shaders which take their model matrix from get_model_matrix() in vertex_decoding.hlsl bind the instance buffer
+    m_reads_instance_models = false;
+
+    ID3D11ShaderReflection* reflection = nullptr;
+    if (SUCCEEDED(D3DReflect(vs_blob->GetBufferPointer(), vs_blob->GetBufferSize(), IID_ID3D11ShaderReflection,
+                             reinterpret_cast<void**>(&reflection))))
+    {
+        D3D11_SHADER_INPUT_BIND_DESC bind_desc = {};
+        m_reads_instance_models = SUCCEEDED(reflection->GetResourceBindingDescByName("instance_models", &bind_desc));
+        reflection->Release();
+    }
+
+    {
+        std::array<D3D11_INPUT_ELEMENT_DESC, 3> constexpr input_element_desc = {
+            {{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+             {"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+             {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0}}};
+
+        // Packed vertices are expanded to floats by the input assembler, vertex shaders only have to dequantize them
+        std::array<D3D11_INPUT_ELEMENT_DESC, 3> constexpr packed_input_element_desc = {
+            {{"POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+             {"NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+             {"TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0}}};
+
+        hr = device->CreateInputLayout(input_element_desc.data(), input_element_desc.size(), vs_blob->GetBufferPointer(),
+                                       vs_blob->GetBufferSize(), &m_input_layouts[static_cast<u8>(VertexFormat::Full)]);
+        assert(SUCCEEDED(hr));
+
+        hr = device->CreateInputLayout(packed_input_element_desc.data(), packed_input_element_desc.size(), vs_blob->GetBufferPointer(),
+                                       vs_blob->GetBufferSize(), &m_input_layouts[static_cast<u8>(VertexFormat::Packed)]);
+        assert(SUCCEEDED(hr));
+
+        vs_blob->Release();
+    }
+}
+
+bool ShaderDX11::compile(std::string& errors)
+{
+    bool compiled = true;
+
+    for (auto const& [path, entry_point, profile] : {std::tuple {m_vertex_path, "vs_main", "vs_5_0"},
+                                                     std::tuple {m_fragment_path, "ps_main", "ps_5_0"}})
+    {
+        if (path.empty())
+            continue;
 
-        hr = RendererDX11::get_instance_dx11()->get_device()->CreateVertexShader(vs_blob->GetBufferPointer(), vs_blob->GetBufferSize(),
-                                                                                 nullptr, &m_vertex_shader);
-        if (FAILED(hr))
+        if (ID3DBlob* blob = compile_stage(path, entry_point, profile, errors); blob != nullptr)
+        {
+            blob->Release();
+        }
+        else
         {
-            std::cout << "Error. Vertex shader creation failed."
-                      << "\n";
-            vs_blob->Release();
-            return;
+            compiled = false;
         }
     }
 
-    // Load pixel shader
-    ID3DBlob* ps_blob;
+    return compiled;
+}
+
+void ShaderDX11::precompile(std::string const& directory)
+{
+    struct Stage
+    {
+        std::string path;
+        char const* entry_point;
+        char const* profile;
+    };
+
+    std::vector<Stage> stages = {};
+
+    for (auto const& entry : std::filesystem::directory_iterator(directory))
     {
-        ID3DBlob* shader_compile_errors_blob;
+        if (!entry.is_regular_file() || entry.path().extension() != ".hlsl")
+            continue;
 
-        auto const pixel_path_final = std::wstring(m_fragment_path.begin(), m_fragment_path.end());
+        std::string const path = entry.path().string();
         size_t size = 0;
-        auto const shader_source = read_hlsl_shader_from_file(m_fragment_path, &size);
-        hr = D3DPreprocess(shader_source, size, m_fragment_path.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, &ps_blob,
-                           &shader_compile_errors_blob);
+        char const* shader_source = read_hlsl_shader_from_file(path, &size);
+
+        if (shader_source == nullptr)
+            continue;
+
+        // Files without entry points are only included by other shaders
+        std::string_view const source = {shader_source, size};
+
+        if (source.find("vs_main") != std::string_view::npos)
+        {
+            stages.emplace_back(path, "vs_main", "vs_5_0");
+        }
+
+        if (source.find("ps_main") != std::string_view::npos)
+        {
+            stages.emplace_back(path, "ps_main", "ps_5_0");
+        }
 
         delete[] shader_source;
+    }
 
-        if (FAILED(hr))
+    std::for_each(std::execution::par, stages.begin(), stages.end(), [](Stage const& stage) {
+        std::string errors = {};
+
+        if (ID3DBlob* blob = compile_stage(stage.path, stage.entry_point, stage.profile, errors); blob != nullptr)
+        {
+            blob->Release();
+        }
+        else
         {
-            char const* error_string = nullptr;
-
-            if (hr == HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND))
-            {
-                error_string = "Error. Fragment shader file not found.";
-            }
-            else if (shader_compile_errors_blob)
-            {
-                error_string = static_cast<char const*>(shader_compile_errors_blob->GetBufferPointer());
-                shader_compile_errors_blob->Release();
-            }
-
-            std::cout << error_string << "\n";
-            return;
+            std::cout << errors << "\n";
         }
+    });
+}
+
+ID3DBlob* ShaderDX11::compile_stage(std::string const& path, char const* entry_point, char const* profile, std::string& errors,
+                                    D3D_SHADER_MACRO const* defines)
+{
+    ID3DBlob* preprocessed_blob = nullptr;
+    ID3DBlob* shader_compile_errors_blob = nullptr;
+
+    size_t size = 0;
+    char const* shader_source = read_hlsl_shader_from_file(path, &size);
+
+    if (shader_source == nullptr)
+    {
+        errors += std::format("Error. Shader file {} not found.\n", path);
+        return nullptr;
+    }
+
+    // Preprocessed source contains all included files, so the cache key changes whenever any of them does
+    HRESULT hr = D3DPreprocess(shader_source, size, path.c_str(), defines, D3D_COMPILE_STANDARD_FILE_INCLUDE, &preprocessed_blob,
+                               &shader_compile_errors_blob);
 
-        std::string const hash =
-            std::to_string(AK::murmur_hash(static_cast<u8*>(ps_blob->GetBufferPointer()), ps_blob->GetBufferSize(), 0));
+    delete[] shader_source;
 
-        if (!read_file_to_blob(m_fragment_path + hash + "ps_main", &ps_blob))
+    if (FAILED(hr))
+    {
+        if (shader_compile_errors_blob != nullptr)
         {
-            hr = D3DCompile(ps_blob->GetBufferPointer(), ps_blob->GetBufferSize(), nullptr, nullptr, nullptr, "ps_main", "ps_5_0", 0, 0,
-                            &ps_blob, &shader_compile_errors_blob);
+            errors += static_cast<char const*>(shader_compile_errors_blob->GetBufferPointer());
+            shader_compile_errors_blob->Release();
+        }
 
-            if (FAILED(hr))
-            {
-                auto const error_string = static_cast<char const*>(shader_compile_errors_blob->GetBufferPointer());
-                std::cout << error_string << "\n";
-                return;
-            }
+        return nullptr;
+    }
+
+    std::string defines_key = {};
+    for (D3D_SHADER_MACRO const* define = defines; define != nullptr && define->Name != nullptr; ++define)
+    {
+        defines_key += std::format("{}={};", define->Name, define->Definition != nullptr ? define->Definition : "");
+    }
 
-            save_compiled_shader(m_vertex_path + hash + "ps_main", ps_blob);
+    std::string_view const preprocessed_source = {static_cast<char const*>(preprocessed_blob->GetBufferPointer()),
+                                                  preprocessed_blob->GetBufferSize()};
+    u64 const key = ShaderCache::make_key({preprocessed_source, defines_key, entry_point, profile});
+
+    std::vector<u8> cached_bytecode = {};
+    ID3DBlob* bytecode_blob = nullptr;
+
+    if (ShaderCache::load(key, cached_bytecode) && SUCCEEDED(D3DCreateBlob(cached_bytecode.size(), &bytecode_blob)))
+    {
+        std::memcpy(bytecode_blob->GetBufferPointer(), cached_bytecode.data(), cached_bytecode.size());
+        preprocessed_blob->Release();
+        return bytecode_blob;
+    }
+
+    // Defines are already applied by the preprocessor
+    hr = D3DCompile(preprocessed_blob->GetBufferPointer(), preprocessed_blob->GetBufferSize(), path.c_str(), nullptr, nullptr,
+                    entry_point, profile, 0, 0, &bytecode_blob, &shader_compile_errors_blob);
+
+    preprocessed_blob->Release();
+
+    if (FAILED(hr))
+    {
+        if (shader_compile_errors_blob != nullptr)
+        {
+            errors += static_cast<char const*>(shader_compile_errors_blob->GetBufferPointer());
+            shader_compile_errors_blob->Release();
         }
 
-        hr = RendererDX11::get_instance_dx11()->get_device()->CreatePixelShader(ps_blob->GetBufferPointer(), ps_blob->GetBufferSize(),
-                                                                                nullptr, &m_pixel_shader);
+        return nullptr;
+    }
+
+    ShaderCache::store(key, {static_cast<u8 const*>(bytecode_blob->GetBufferPointer()), bytecode_blob->GetBufferSize()});
+
+    return bytecode_blob;
+}
 
-        if (FAILED(hr))
+void ShaderDX11::release_shaders()
+{
+    for (auto& input_layout : m_input_layouts)
+    {
+        if (input_layout != nullptr)
         {
-            std::cout << "Error. Fragment shader creation failed."
-                      << "\n";
-            ps_blob->Release();
-            return;
+            input_layout->Release();
+            input_layout = nullptr;
         }
     }
 
+    if (m_vertex_shader != nullptr)
     {
-        std::array<D3D11_INPUT_ELEMENT_DESC, 3> constexpr input_element_desc = {
-            {{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
-             {"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
-             {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0}}};
+        m_vertex_shader->Release();
+        m_vertex_shader = nullptr;
+    }
 
-        HRESULT const hr = RendererDX11::get_instance_dx11()->get_device()->CreateInputLayout(
-            input_element_desc.data(), input_element_desc.size(), vs_blob->GetBufferPointer(), vs_blob->GetBufferSize(), &m_input_layout);
-        assert(SUCCEEDED(hr));
-        vs_blob->Release();
+    if (m_pixel_shader != nullptr)
+    {
+        m_pixel_shader->Release();
+        m_pixel_shader = nullptr;
     }
 }
 
 void ShaderDX11::use() const
 {
     auto const instance = RendererDX11::get_instance_dx11();
-    instance->get_device_context()->IASetInputLayout(m_input_layout);
+    instance->get_device_context()->IASetInputLayout(m_input_layouts[static_cast<u8>(VertexFormat::Full)]);
     instance->get_device_context()->VSSetShader(m_vertex_shader, nullptr, 0);
     instance->get_device_context()->PSSetShader(m_pixel_shader, nullptr, 0);
+
+    m_used_shader = this;
+    m_used_vertex_format = VertexFormat::Full;
+
+    RendererStatistics::add_shader_switch();
+}
+
+void ShaderDX11::set_vertex_format(VertexFormat const vertex_format)
+{
+    if (m_used_shader == nullptr || m_used_vertex_format == vertex_format)
+        return;
+
+    RendererDX11::get_instance_dx11()->get_device_context()->IASetInputLayout(
+        m_used_shader->m_input_layouts[static_cast<u8>(vertex_format)]);
+    m_used_vertex_format = vertex_format;
 }
 
 void ShaderDX11::set_bool(std::string const& name, bool const value) const
@@ -238,90 +389,3 @@ char* ShaderDX11::read_hlsl_shader_from_file(std::string const& path, size_t* p_
     *p_size = 0;
     return nullptr;
 }
-
-bool ShaderDX11::save_compiled_shader(std::string const& path, ID3DBlob* p_blob)
-{
-    size_t const last_slash_pos = path.find_last_of('/');
-    std::string const filename = path.substr(last_slash_pos + 1);
-    std::string const full_path = m_compiled_path + filename;
-
-    std::filesystem::path const directory = m_compiled_path;
-
-    if (!std::filesystem::exists(directory))
-    {
-        std::filesystem::create_directories(directory);
-    }
-
-    if (!p_blob)
-    {
-        std::cerr << "Invalid ID3DBlob pointer." << std::endl;
-        return false;
-    }
-
-    std::ofstream file(full_path, std::ios::binary);
-
-    if (!file.is_open())
-    {
-        std::cerr << "Failed to open file: " << full_path << std::endl;
-        return false;
-    }
-
-    file.write(static_cast<char const*>(p_blob->GetBufferPointer()), p_blob->GetBufferSize());
-
-    if (!file)
-    {
-        std::cerr << "Failed to write to file: " << full_path << std::endl;
-        return false;
-    }
-
-    file.close();
-
-    return true;
-}
-
-bool ShaderDX11::read_file_to_blob(std::string const& path, ID3DBlob** pp_blob)
-{
-    size_t const last_slash_pos = path.find_last_of('/');
-    std::string const filename = path.substr(last_slash_pos + 1);
-    std::string const full_path = m_compiled_path + filename;
-
-    std::filesystem::path const directory = m_compiled_path;
-
-    if (!std::filesystem::exists(directory))
-    {
-        std::filesystem::create_directories(directory);
-    }
-
-    if (!pp_blob)
-    {
-        return false;
-    }
-
-    std::ifstream file(full_path, std::ios::binary | std::ios::ate);
-
-    if (!file.is_open())
-    {
-        return false;
-    }
-
-    std::streamsize const file_size = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    HRESULT const hr = D3DCreateBlob(file_size, pp_blob);
-
-    if (FAILED(hr))
-    {
-        std::cerr << "Failed to create blob." << std::endl;
-        return false;
-    }
-
-    if (!file.read(static_cast<char*>((*pp_blob)->GetBufferPointer()), file_size))
-    {
-        std::cerr << "Failed to read file: " << full_path << std::endl;
-        (*pp_blob)->Release();
-        *pp_blob = nullptr;
-        return false;
-    }
-
-    return true;
-}
@@ -2,8 +2,11 @@
 
 #include <d3d11.h>
 
+#include <array>
+
 #include "AK/Badge.h"
 #include "Shader.h"
+#include "Vertex.h"
 
 class ShaderFactory;
 
@@ -25,19 +28,32 @@ public:
     void virtual set_vec4(std::string const& name, glm::vec4 const value) const override;
     void virtual set_mat4(std::string const& name, glm::mat4 const value) const override;
     void virtual load_shader() override;
+    bool virtual compile(std::string& errors) override;
+
+    // Compiles every vertex and pixel shader in the directory that isn't in the shader cache yet, in parallel.
+    // Shaders created afterwards load their bytecode from the cache.
+    static void precompile(std::string const& directory);
+
+    // Switches the input layout of the currently used shader to match the vertex format of the mesh about to be drawn
+    static void set_vertex_format(VertexFormat const vertex_format);
 
 private:
     i32 virtual attach(char const* path, i32 type) const override;
 
     static char* read_hlsl_shader_from_file(std::string const& path, size_t* p_size);
-    static bool save_compiled_shader(std::string const& path, ID3DBlob* blob);
-    static bool read_file_to_blob(std::string const& path, ID3DBlob** pp_blob);
 
-    ID3D11InputLayout* m_input_layout = nullptr;
+    // Loads bytecode of a single stage from the shader cache, or compiles and stores it there. Returns nullptr and appends
+    // compilation errors on failure. Doesn't touch the device, so it can be called from worker threads.
+    [[nodiscard]] static ID3DBlob* compile_stage(std::string const& path, char const* entry_point, char const* profile,
+                                                 std::string& errors, D3D_SHADER_MACRO const* defines = nullptr);
+
+    void release_shaders();
+
+    // One input layout per VertexFormat
+    std::array<ID3D11InputLayout*, 2> m_input_layouts = {};
     ID3D11VertexShader* m_vertex_shader = nullptr;
     ID3D11PixelShader* m_pixel_shader = nullptr;
 
-    // NOTE: Do not use constexpr here! The string will not live until runtime because of that.
-    //       https://developercommunity.visualstudio.com/t/c20-constexpr-stdstring-with-static-is-not-working/1441363
-    inline static std::string m_compiled_path = "./res/shaders/compiled/";
+    inline static ShaderDX11 const* m_used_shader = nullptr;
+    inline static VertexFormat m_used_vertex_format = VertexFormat::Full;
 };
@@ -1,25 +1,42 @@
 #include "ShaderGL.h"
 
+#include <algorithm>
+#include <cstring>
+#include <format>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "Debug.h"
+#include "RendererStatistics.h"
+#include "ShaderCache.h"
+
 ShaderGL::ShaderGL(AK::Badge<ShaderFactory>, std::string const& compute_path) : Shader(compute_path)
 {
     char const* compute_path_c_str = m_compute_path.c_str();
 
     program_id = glCreateProgram();
 
+    u64 const cache_key = make_program_key({&m_compute_path});
+
+    if (load_program_binary(cache_key))
+    {
+        reflect_program();
+        return;
+    }
+
     i32 const compute_shader_id = attach(compute_path_c_str, GL_COMPUTE_SHADER);
 
     if (compute_shader_id == -1)
         return;
 
+    glProgramParameteri(program_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     glLinkProgram(program_id);
 
     i32 success = 0;
@@ -34,6 +51,9 @@ ShaderGL::ShaderGL(AK::Badge<ShaderFactory>, std::string const& compute_path) :
         return;
     }
 
+    store_program_binary(cache_key);
+    reflect_program();
+
     glDeleteShader(compute_shader_id);
 }
 
@@ -45,6 +65,14 @@ ShaderGL::ShaderGL(AK::Badge<ShaderFactory>, std::string const& vertex_path, std
 
     program_id = glCreateProgram();
 
+    u64 const cache_key = make_program_key({&m_vertex_path, &m_fragment_path});
+
+    if (load_program_binary(cache_key))
+    {
+        reflect_program();
+        return;
+    }
+
     i32 const vertex_shader_id = attach(vertex_path_c_str, GL_VERTEX_SHADER);
 
     if (vertex_shader_id == -1)
@@ -55,6 +83,7 @@ ShaderGL::ShaderGL(AK::Badge<ShaderFactory>, std::string const& vertex_path, std
     if (fragment_shader_id == -1)
         return;
 
+    glProgramParameteri(program_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     glLinkProgram(program_id);
 
     i32 success = 0;
@@ -69,6 +98,9 @@ ShaderGL::ShaderGL(AK::Badge<ShaderFactory>, std::string const& vertex_path, std
         return;
     }
 
+    store_program_binary(cache_key);
+    reflect_program();
+
     glDeleteShader(vertex_shader_id);
     glDeleteShader(fragment_shader_id);
 }
@@ -83,6 +115,14 @@ ShaderGL::ShaderGL(AK::Badge<ShaderFactory>, std::string const& vertex_path, std
 
     program_id = glCreateProgram();
 
+    u64 const cache_key = make_program_key({&m_vertex_path, &m_fragment_path, &m_geometry_path});
+
+    if (load_program_binary(cache_key))
+    {
+        reflect_program();
+        return;
+    }
+
     i32 const vertex_shader_id = attach(vertex_path_c_str, GL_VERTEX_SHADER);
 
     if (vertex_shader_id == -1)
@@ -98,6 +138,7 @@ ShaderGL::ShaderGL(AK::Badge<ShaderFactory>, std::string const& vertex_path, std
     if (geometry_shader_id == -1)
         return;
 
+    glProgramParameteri(program_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     glLinkProgram(program_id);
 
     i32 success = 0;
@@ -112,6 +153,9 @@ ShaderGL::ShaderGL(AK::Badge<ShaderFactory>, std::string const& vertex_path, std
         return;
     }
 
+    store_program_binary(cache_key);
+    reflect_program();
+
     glDeleteShader(vertex_shader_id);
     glDeleteShader(fragment_shader_id);
     glDeleteShader(geometry_shader_id);
@@ -128,6 +172,14 @@ ShaderGL::ShaderGL(AK::Badge<ShaderFactory>, std::string const& vertex_path, std
 
     program_id = glCreateProgram();
 
+    u64 const cache_key = make_program_key({&m_vertex_path, &m_tessellation_control_path, &m_tessellation_evaluation_path, &m_fragment_path});
+
+    if (load_program_binary(cache_key))
+    {
+        reflect_program();
+        return;
+    }
+
     i32 const vertex_shader_id = attach(vertex_path_c_str, GL_VERTEX_SHADER);
 
     if (vertex_shader_id == -1)
@@ -148,6 +200,7 @@ ShaderGL::ShaderGL(AK::Badge<ShaderFactory>, std::string const& vertex_path, std
     if (tessellation_evaluation_shader_id == -1)
         return;
 
+    glProgramParameteri(program_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     glLinkProgram(program_id);
 
     i32 success = 0;
@@ -162,6 +215,9 @@ ShaderGL::ShaderGL(AK::Badge<ShaderFactory>, std::string const& vertex_path, std
         return;
     }
 
+    store_program_binary(cache_key);
+    reflect_program();
+
     glDeleteShader(vertex_shader_id);
     glDeleteShader(fragment_shader_id);
     glDeleteShader(tessellation_control_shader_id);
@@ -221,38 +277,346 @@ i32 ShaderGL::attach(char const* path, i32 const type) const
 void ShaderGL::use() const
 {
     glUseProgram(program_id);
+    RendererStatistics::add_shader_switch();
 }
 
 void ShaderGL::set_bool(std::string const& name, bool const value) const
 {
-    glUniform1i(glGetUniformLocation(program_id, name.c_str()), static_cast<i32>(value));
+    set(UniformHandle<bool> {get_uniform_location(name)}, value);
 }
 
 void ShaderGL::set_int(std::string const& name, i32 const value) const
 {
-    glUniform1i(glGetUniformLocation(program_id, name.c_str()), value);
+    set(UniformHandle<i32> {get_uniform_location(name)}, value);
 }
 
 void ShaderGL::set_float(std::string const& name, float const value) const
 {
-    glUniform1f(glGetUniformLocation(program_id, name.c_str()), value);
+    set(UniformHandle<float> {get_uniform_location(name)}, value);
 }
 
 void ShaderGL::set_vec3(std::string const& name, glm::vec3 const value) const
 {
-    glUniform3fv(glGetUniformLocation(program_id, name.c_str()), 1, glm::value_ptr(value));
+    set(UniformHandle<glm::vec3> {get_uniform_location(name)}, value);
 }
 
 void ShaderGL::set_vec4(std::string const& name, glm::vec4 const value) const
 {
-    glUniform4fv(glGetUniformLocation(program_id, name.c_str()), 1, glm::value_ptr(value));
+    set(UniformHandle<glm::vec4> {get_uniform_location(name)}, value);
 }
 
 void ShaderGL::set_mat4(std::string const& name, glm::mat4 const value) const
 {
-    glUniformMatrix4fv(glGetUniformLocation(program_id, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));
+    set(UniformHandle<glm::mat4> {get_uniform_location(name)}, value);
+}
+
+void ShaderGL::set(UniformHandle<bool> const handle, bool const value) const
+{
+    glProgramUniform1i(program_id, handle.location, static_cast<i32>(value));
+}
+
+void ShaderGL::set(UniformHandle<i32> const handle, i32 const value) const
+{
+    glProgramUniform1i(program_id, handle.location, value);
+}
+
+void ShaderGL::set(UniformHandle<float> const handle, float const value) const
+{
+    glProgramUniform1f(program_id, handle.location, value);
+}
+
+void ShaderGL::set(UniformHandle<glm::vec3> const handle, glm::vec3 const& value) const
+{
+    glProgramUniform3fv(program_id, handle.location, 1, glm::value_ptr(value));
+}
+
+void ShaderGL::set(UniformHandle<glm::vec4> const handle, glm::vec4 const& value) const
+{
+    glProgramUniform4fv(program_id, handle.location, 1, glm::value_ptr(value));
+}
+
+void ShaderGL::set(UniformHandle<glm::mat4> const handle, glm::mat4 const& value) const
+{
+    glProgramUniformMatrix4fv(program_id, handle.location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void ShaderGL::set(UniformHandle<glm::vec4> const handle, std::span<glm::vec4 const> const values) const
+{
+    if (values.empty())
+        return;
+
+    glProgramUniform4fv(program_id, handle.location, static_cast<GLsizei>(values.size()), glm::value_ptr(values.front()));
+}
+
+i32 ShaderGL::get_uniform_location(std::string_view const name) const
+{
+    auto const it = m_uniform_locations.find(name);
+    return it != m_uniform_locations.end() ? it->second : -1;
+}
+
+i32 ShaderGL::get_uniform_block_index(std::string_view const name) const
+{
+    auto const it = m_uniform_blocks.find(name);
+    return it != m_uniform_blocks.end() ? it->second.index : -1;
+}
+
+i32 ShaderGL::get_uniform_block_size(std::string_view const name) const
+{
+    auto const it = m_uniform_blocks.find(name);
+    return it != m_uniform_blocks.end() ? it->second.size : 0;
 }
 
 void ShaderGL::load_shader()
 {
+    // Compiled from source again, on the main thread which owns the GL context. Shaders that fail keep their previous program.
+    std::string errors = {};
+    u32 const program = create_program(errors);
+
+    if (program == 0)
+    {
+        Debug::log(std::format("Shader {} failed to compile:\n{}", m_compute_path.empty() ? m_vertex_path : m_compute_path, errors),
+                   DebugType::Error);
+        return;
+    }
+
+    glDeleteProgram(program_id);
+    program_id = program;
+
+    reflect_program();
+}
+
+bool ShaderGL::compiles_on_worker_threads() const
+{
+    return false;
+}
+
+u32 ShaderGL::create_program(std::string& errors) const
+{
+    std::vector<std::pair<std::string const*, GLenum>> stages = {};
+
+    if (!m_compute_path.empty())
+    {
+        stages.emplace_back(&m_compute_path, GL_COMPUTE_SHADER);
+    }
+    else
+    {
+        stages.emplace_back(&m_vertex_path, GL_VERTEX_SHADER);
+        stages.emplace_back(&m_tessellation_control_path, GL_TESS_CONTROL_SHADER);
+        stages.emplace_back(&m_tessellation_evaluation_path, GL_TESS_EVALUATION_SHADER);
+        stages.emplace_back(&m_geometry_path, GL_GEOMETRY_SHADER);
+        stages.emplace_back(&m_fragment_path, GL_FRAGMENT_SHADER);
+    }
+
+    std::erase_if(stages, [](auto const& stage) { return stage.first->empty(); });
+
+    u32 const program = glCreateProgram();
+    std::vector<u32> shader_ids = {};
+    bool is_compiled = true;
+
+    for (auto const& [path, type] : stages)
+    {
+        std::ifstream file(*path);
+
+        if (!file.is_open())
+        {
+            errors += std::format("Could not open {}.\n", *path);
+            is_compiled = false;
+            continue;
+        }
+
+        std::stringstream stream;
+        stream << file.rdbuf();
+
+        std::string const code = stream.str();
+        char const* shader_code = code.c_str();
+
+        u32 const shader_id = glCreateShader(type);
+        glShaderSource(shader_id, 1, &shader_code, nullptr);
+        glCompileShader(shader_id);
+        shader_ids.emplace_back(shader_id);
+
+        i32 success = 0;
+        glGetShaderiv(shader_id, GL_COMPILE_STATUS, &success);
+
+        if (!success)
+        {
+            errors += std::format("{}:\n{}\n", *path, get_info_log(shader_id, false));
+            is_compiled = false;
+            continue;
+        }
+
+        glAttachShader(program, shader_id);
+    }
+
+    if (is_compiled)
+    {
+        glLinkProgram(program);
+
+        i32 success = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+
+        if (!success)
+        {
+            errors += std::format("Linking failed:\n{}\n", get_info_log(program, true));
+            is_compiled = false;
+        }
+    }
+
+    // Shaders are only flagged for deletion while attached, they are deleted together with the program
+    for (u32 const shader_id : shader_ids)
+    {
+        glDeleteShader(shader_id);
+    }
+
+    if (!is_compiled)
+    {
+        glDeleteProgram(program);
+        return 0;
+    }
+
+    return program;
+}
+
+std::string ShaderGL::get_info_log(u32 const object, bool const is_program)
+{
+    i32 length = 0;
+
+    if (is_program)
+        glGetProgramiv(object, GL_INFO_LOG_LENGTH, &length);
+    else
+        glGetShaderiv(object, GL_INFO_LOG_LENGTH, &length);
+
+    std::string log(static_cast<size_t>(std::max(length, 1)), '\0');
+
+    if (is_program)
+        glGetProgramInfoLog(object, length, nullptr, log.data());
+    else
+        glGetShaderInfoLog(object, length, nullptr, log.data());
+
+    // Length includes the null terminator
+    log.resize(std::max(length, 1) - 1);
+    return log;
+}
+
+u64 ShaderGL::make_program_key(std::initializer_list<std::string const*> const paths)
+{
+    // Program binaries are only valid for the driver which created them
+    std::string_view const vendor = reinterpret_cast<char const*>(glGetString(GL_VENDOR));
+    std::string_view const renderer = reinterpret_cast<char const*>(glGetString(GL_RENDERER));
+    std::string_view const version = reinterpret_cast<char const*>(glGetString(GL_VERSION));
+
+    std::string sources = {};
+
+    for (auto const* path : paths)
+    {
+        std::ifstream file(*path, std::ios::binary);
+        std::stringstream stream;
+        stream << file.rdbuf();
+
+        std::string const source = stream.str();
+        sources += std::format("{}:{}:{}", *path, source.size(), source);
+    }
+
+    return ShaderCache::make_key({vendor, renderer, version, sources});
+}
+
+bool ShaderGL::load_program_binary(u64 const key) const
+{
+    std::vector<u8> data = {};
+
+    if (!ShaderCache::load(key, data) || data.size() <= sizeof(GLenum))
+        return false;
+
+    GLenum format = 0;
+    std::memcpy(&format, data.data(), sizeof(GLenum));
+
+    glProgramBinary(program_id, format, data.data() + sizeof(GLenum), static_cast<GLsizei>(data.size() - sizeof(GLenum)));
+
+    // Drivers may reject binaries even with a matching version, the program is then compiled from source
+    i32 success = 0;
+    glGetProgramiv(program_id, GL_LINK_STATUS, &success);
+    return success != 0;
+}
+
+void ShaderGL::store_program_binary(u64 const key) const
+{
+    i32 length = 0;
+    glGetProgramiv(program_id, GL_PROGRAM_BINARY_LENGTH, &length);
+
+    if (length <= 0)
+        return;
+
+    std::vector<u8> data(sizeof(GLenum) + length);
+    GLenum format = 0;
+
+    glGetProgramBinary(program_id, length, nullptr, &format, data.data() + sizeof(GLenum));
+    std::memcpy(data.data(), &format, sizeof(GLenum));
+
+    ShaderCache::store(key, data);
+}
+
+void ShaderGL::reflect_program()
+{
+    m_uniform_locations.clear();
+    m_uniform_blocks.clear();
+
+    i32 uniform_count = 0;
+    i32 max_name_length = 0;
+    glGetProgramiv(program_id, GL_ACTIVE_UNIFORMS, &uniform_count);
+    glGetProgramiv(program_id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_name_length);
+
+    std::string name(static_cast<size_t>(max_name_length), '\0');
+
+    for (i32 i = 0; i < uniform_count; ++i)
+    {
+        GLsizei length = 0;
+        i32 size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program_id, i, max_name_length, &length, &size, &type, name.data());
+
+        std::string const uniform_name = name.substr(0, length);
+
+        // Members of uniform blocks don't have locations, they are set through uniform buffers
+        i32 const location = glGetUniformLocation(program_id, uniform_name.c_str());
+
+        if (location == -1)
+            continue;
+
+        m_uniform_locations.emplace(uniform_name, location);
+
+        // Arrays of basic types are reported once, as their first element
+        if (!uniform_name.ends_with("[0]"))
+            continue;
+
+        std::string const array_name = uniform_name.substr(0, uniform_name.size() - 3);
+        m_uniform_locations.emplace(array_name, location);
+
+        for (i32 element = 1; element < size; ++element)
+        {
+            std::string const element_name = std::format("{}[{}]", array_name, element);
+            m_uniform_locations.emplace(element_name, glGetUniformLocation(program_id, element_name.c_str()));
+        }
+    }
+
+    i32 block_count = 0;
+    i32 max_block_name_length = 0;
+    glGetProgramiv(program_id, GL_ACTIVE_UNIFORM_BLOCKS, &block_count);
+    glGetProgramiv(program_id, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &max_block_name_length);
+
+    name.assign(static_cast<size_t>(max_block_name_length), '\0');
+
+    for (i32 i = 0; i < block_count; ++i)
+    {
+        GLsizei length = 0;
+        glGetActiveUniformBlockName(program_id, i, max_block_name_length, &length, name.data());
+
+        UniformBlock block = {};
+        block.index = i;
+        glGetActiveUniformBlockiv(program_id, i, GL_UNIFORM_BLOCK_DATA_SIZE, &block.size);
+
+        m_uniform_blocks.emplace(name.substr(0, length), block);
+    }
+
+    // Storage block of model matrices bound by instance buffers, see foliage.vert
+    m_reads_instance_models = glGetProgramResourceIndex(program_id, GL_SHADER_STORAGE_BLOCK, "modelsBuffer") != GL_INVALID_INDEX;
 }
@@ -1,10 +1,31 @@
 #pragma once
 
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+
 #include "AK/Badge.h"
 #include "Shader.h"
 
 class ShaderFactory;
 
+// Location of a uniform of type T, resolved once with ShaderGL::get_uniform(), so it can be set without any string work.
+// Locations of uniforms which aren't active in the program are -1 and setting them does nothing, same as in OpenGL.
+template<typename T>
+struct UniformHandle
+{
+    i32 location = -1;
+
+    [[nodiscard]] bool is_valid() const
+    {
+        return location != -1;
+    }
+};
+
 class ShaderGL final : public Shader
 {
 public:
@@ -22,8 +43,65 @@ public:
     void virtual set_vec3(std::string const& name, glm::vec3 const value) const override;
     void virtual set_vec4(std::string const& name, glm::vec4 const value) const override;
     void virtual set_mat4(std::string const& name, glm::mat4 const value) const override;
+    // Compiles and links the program again from source, used when reloading shaders
     void virtual load_shader() override;
+    bool virtual compiles_on_worker_threads() const override;
+
+    template<typename T>
+    [[nodiscard]] UniformHandle<T> get_uniform(std::string_view const name) const
+    {
+        return {get_uniform_location(name)};
+    }
+
+    void set(UniformHandle<bool> const handle, bool const value) const;
+    void set(UniformHandle<i32> const handle, i32 const value) const;
+    void set(UniformHandle<float> const handle, float const value) const;
+    void set(UniformHandle<glm::vec3> const handle, glm::vec3 const& value) const;
+    void set(UniformHandle<glm::vec4> const handle, glm::vec4 const& value) const;
+    void set(UniformHandle<glm::mat4> const handle, glm::mat4 const& value) const;
+
+    // Sets consecutive elements of an array uniform, starting at the element of the handle
+    void set(UniformHandle<glm::vec4> const handle, std::span<glm::vec4 const> const values) const;
+
+    // Uniforms and uniform blocks are reflected once the program is linked, so looking them up never calls into the driver.
+    // Elements of arrays can be looked up both by their full name, like "lights[1]", and by the name of the array.
+    [[nodiscard]] i32 get_uniform_location(std::string_view const name) const;
+
+    // Returns -1 for uniform blocks which aren't active in the program
+    [[nodiscard]] i32 get_uniform_block_index(std::string_view const name) const;
+    [[nodiscard]] i32 get_uniform_block_size(std::string_view const name) const;
 
 private:
     i32 virtual attach(char const* path, i32 type) const override;
+
+    // Programs are loaded from binaries in the shader cache when none of their stages changed. GL contexts are bound
+    // to a single thread, so unlike DX11 changed programs can't be compiled on worker threads.
+    [[nodiscard]] static u64 make_program_key(std::initializer_list<std::string const*> const paths);
+    [[nodiscard]] bool load_program_binary(u64 const key) const;
+    void store_program_binary(u64 const key) const;
+
+    void reflect_program();
+
+    // Returns 0 and appends compilation and linking errors when any stage fails
+    [[nodiscard]] u32 create_program(std::string& errors) const;
+    [[nodiscard]] static std::string get_info_log(u32 const object, bool const is_program);
+
+    struct StringHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view const value) const
+        {
+            return std::hash<std::string_view> {}(value);
+        }
+    };
+
+    struct UniformBlock
+    {
+        i32 index = -1;
+        i32 size = 0;
+    };
+
+    std::unordered_map<std::string, i32, StringHash, std::equal_to<>> m_uniform_locations = {};
+    std::unordered_map<std::string, UniformBlock, StringHash, std::equal_to<>> m_uniform_blocks = {};
 };
@@ -0,0 +1,227 @@
+#include "ShaderHotReload.h"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <system_error>
+
+#include "Debug.h"
+#include "Shader.h"
+
+void ShaderDependencyGraph::update_file(std::string const& path)
+{
+    remove_file(path);
+
+    std::vector<std::string> includes = parse_includes(path);
+
+    for (auto const& include : includes)
+    {
+        m_included_by[include].insert(path);
+    }
+
+    m_includes[path] = std::move(includes);
+}
+
+void ShaderDependencyGraph::remove_file(std::string const& path)
+{
+    auto const it = m_includes.find(path);
+
+    if (it == m_includes.end())
+        return;
+
+    for (auto const& include : it->second)
+    {
+        m_included_by[include].erase(path);
+    }
+
+    m_includes.erase(it);
+}
+
+std::unordered_set<std::string> ShaderDependencyGraph::get_affected_files(std::vector<std::string> const& changed_files) const
+{
+    std::unordered_set<std::string> affected = {};
+    std::vector<std::string> stack = changed_files;
+
+    while (!stack.empty())
+    {
+        std::string const path = std::move(stack.back());
+        stack.pop_back();
+
+        if (!affected.insert(path).second)
+            continue;
+
+        if (auto const it = m_included_by.find(path); it != m_included_by.end())
+        {
+            stack.insert(stack.end(), it->second.begin(), it->second.end());
+        }
+    }
+
+    return affected;
+}
+
+std::string ShaderDependencyGraph::normalize_path(std::string const& path)
+{
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+std::vector<std::string> ShaderDependencyGraph::parse_includes(std::string const& path)
+{
+    std::vector<std::string> includes = {};
+    std::ifstream file(path);
+
+    if (!file.is_open())
+        return includes;
+
+    std::filesystem::path const directory = std::filesystem::path(path).parent_path();
+    std::string line;
+
+    while (std::getline(file, line))
+    {
+        size_t const directive_start = line.find_first_not_of(" \t");
+
+        if (directive_start == std::string::npos || line.compare(directive_start, 8, "#include") != 0)
+            continue;
+
+        size_t const name_start = line.find('"', directive_start + 8);
+        size_t const name_end = name_start == std::string::npos ? std::string::npos : line.find('"', name_start + 1);
+
+        if (name_end == std::string::npos)
+            continue;
+
+        std::string const name = line.substr(name_start + 1, name_end - name_start - 1);
+        includes.emplace_back(normalize_path((directory / name).string()));
+    }
+
+    return includes;
+}
+
+void ShaderHotReload::update(std::vector<std::shared_ptr<Shader>> const& shaders)
+{
+    if (m_job.valid())
+    {
+        if (m_job.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return;
+
+        ReloadResult result = m_job.get();
+        m_state = std::move(result.state);
+
+        for (auto const& error : result.errors)
+        {
+            Debug::log(error, DebugType::Error);
+        }
+
+        // Bytecode is already in the shader cache, so loading only creates the new programs and swaps them with the old ones
+        for (auto const& shader : result.compiled_shaders)
+        {
+            shader->load_shader();
+        }
+
+        // OpenGL programs can only be compiled here, errors are reported by load_shader()
+        for (auto const& shader : result.main_thread_shaders)
+        {
+            shader->load_shader();
+        }
+
+        if (!result.changed_files.empty())
+        {
+            Debug::log(std::format("Shader files changed: {}, reloaded shaders: {}", result.changed_files.size(),
+                                   result.compiled_shaders.size() + result.main_thread_shaders.size()));
+        }
+    }
+
+    auto const now = std::chrono::steady_clock::now();
+
+    if (now - m_last_check < check_interval)
+        return;
+
+    m_last_check = now;
+    m_job = std::async(std::launch::async, &ShaderHotReload::check_and_compile, std::move(m_state), shaders);
+}
+
+ShaderHotReload::ReloadResult ShaderHotReload::check_and_compile(WatchState state, std::vector<std::shared_ptr<Shader>> const shaders)
+{
+    ReloadResult result = {};
+    bool const is_first_check = state.write_times.empty();
+
+    std::unordered_set<std::string> existing_files = {};
+
+    for (auto const* directory : watched_directories)
+    {
+        std::error_code error = {};
+
+        for (auto const& entry : std::filesystem::directory_iterator(directory, error))
+        {
+            if (!entry.is_regular_file(error))
+                continue;
+
+            std::string const path = ShaderDependencyGraph::normalize_path(entry.path().string());
+            auto const write_time = entry.last_write_time(error);
+
+            if (error)
+                continue;
+
+            existing_files.insert(path);
+
+            auto const it = state.write_times.find(path);
+
+            if (it != state.write_times.end() && it->second == write_time)
+                continue;
+
+            state.write_times[path] = write_time;
+            state.dependencies.update_file(path);
+
+            if (!is_first_check)
+            {
+                result.changed_files.emplace_back(path);
+            }
+        }
+    }
+
+    // Removed files affect the shaders which included them as well, they will fail to compile and report it
+    std::erase_if(state.write_times, [&](auto const& write_time) {
+        if (existing_files.contains(write_time.first))
+            return false;
+
+        state.dependencies.remove_file(write_time.first);
+        result.changed_files.emplace_back(write_time.first);
+        return true;
+    });
+
+    if (!result.changed_files.empty())
+    {
+        std::unordered_set<std::string> const affected_files = state.dependencies.get_affected_files(result.changed_files);
+
+        for (auto const& shader : shaders)
+        {
+            std::array const paths = {shader->get_vertex_path(), shader->get_fragment_path(), shader->get_geometry_path(),
+                                      shader->get_tessellation_control_path(), shader->get_tessellation_evaluation_path()};
+
+            bool const is_affected = std::ranges::any_of(paths, [&](std::string const& path) {
+                return !path.empty() && affected_files.contains(ShaderDependencyGraph::normalize_path(path));
+            });
+
+            if (!is_affected)
+                continue;
+
+            if (!shader->compiles_on_worker_threads())
+            {
+                result.main_thread_shaders.emplace_back(shader);
+                continue;
+            }
+
+            std::string errors = {};
+
+            if (shader->compile(errors))
+            {
+                result.compiled_shaders.emplace_back(shader);
+            }
+            else
+            {
+                result.errors.emplace_back(std::format("Shader {} failed to compile:\n{}", shader->get_vertex_path(), errors));
+            }
+        }
+    }
+
+    result.state = std::move(state);
+    return result;
+}
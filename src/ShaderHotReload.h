@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class Shader;
+
+// Shader files and the files they #include. A shader only has to be recompiled when one of the files it includes,
+// directly or through other includes, has changed. It doesn't depend on any rendering API.
+class ShaderDependencyGraph
+{
+public:
+    // Parses #include directives of the file, replacing its previous dependencies
+    void update_file(std::string const& path);
+    void remove_file(std::string const& path);
+
+    // Changed files together with every file including any of them, directly or not
+    [[nodiscard]] std::unordered_set<std::string> get_affected_files(std::vector<std::string> const& changed_files) const;
+
+    [[nodiscard]] static std::string normalize_path(std::string const& path);
+
+    // Included paths are relative to the directory of the including file, same as in D3D_COMPILE_STANDARD_FILE_INCLUDE
+    [[nodiscard]] static std::vector<std::string> parse_includes(std::string const& path);
+
+private:
+    std::unordered_map<std::string, std::vector<std::string>> m_includes = {};
+    std::unordered_map<std::string, std::unordered_set<std::string>> m_included_by = {};
+};
+
+// Watches shader files for changes while the editor is running. Files are checked and affected shaders are compiled
+// into the shader cache on a background thread, so the editor never waits for them. Compiled shaders are swapped
+// on the main thread in update() once all of their stages compiled. OpenGL shaders can't be compiled on other threads,
+// so they are only found on the background thread and compiled in update(). Shaders that failed keep their previous programs
+// and errors are reported through Debug::log.
+class ShaderHotReload
+{
+public:
+    // Has to be called on the main thread, once per frame
+    void update(std::vector<std::shared_ptr<Shader>> const& shaders);
+
+private:
+    struct WatchState
+    {
+        ShaderDependencyGraph dependencies = {};
+        std::unordered_map<std::string, std::filesystem::file_time_type> write_times = {};
+    };
+
+    struct ReloadResult
+    {
+        WatchState state = {};
+        std::vector<std::string> changed_files = {};
+        std::vector<std::shared_ptr<Shader>> compiled_shaders = {};
+
+        // Affected shaders which have to be compiled on the main thread, e.g. OpenGL programs
+        std::vector<std::shared_ptr<Shader>> main_thread_shaders = {};
+        std::vector<std::string> errors = {};
+    };
+
+    // Runs on a background thread. The first run only records write times and builds the dependency graph.
+    [[nodiscard]] static ReloadResult check_and_compile(WatchState state, std::vector<std::shared_ptr<Shader>> const shaders);
+
+    // Watch state is moved into the background job and moved back once it finishes
+    WatchState m_state = {};
+    std::future<ReloadResult> m_job = {};
+    std::chrono::steady_clock::time_point m_last_check = {};
+
+    inline static std::chrono::milliseconds constexpr check_interval = std::chrono::milliseconds(500);
+    inline static std::array<char const*, 2> constexpr watched_directories = {"./res/shaders/", "./res/shaders/glsl/"};
+};
@@ -25,6 +25,7 @@ SkyboxDX11::SkyboxDX11(AK::Badge<SkyboxFactory>, std::shared_ptr<Material> const
 void SkyboxDX11::bind()
 {
     RendererDX11::get_instance_dx11()->get_device_context()->PSSetShaderResources(15, 1, &m_texture->shader_resource_view);
+    RendererStatistics::add_texture_binds(1);
 }
 
 void SkyboxDX11::unbind()
@@ -50,6 +51,7 @@ void SkyboxDX11::draw() const
     device_context->IASetVertexBuffers(0, 1, m_vertex_buffer->get_address_of(), m_vertex_buffer->stride_ptr(), &offset);
     device_context->IASetIndexBuffer(m_index_buffer->get(), DXGI_FORMAT_R32_UINT, 0);
     device_context->DrawIndexed(m_index_buffer->buffer_size(), 0, 0);
+    RendererStatistics::add_draw_call(m_index_buffer->buffer_size());
 
     unbind_texture();
 }
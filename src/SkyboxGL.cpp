@@ -3,6 +3,7 @@
 #include <glad/glad.h>
 
 #include "Globals.h"
+#include "RendererStatistics.h"
 
 #if EDITOR
 #include "imgui_extensions.h"
@@ -39,9 +40,11 @@ void SkyboxGL::draw() const
     glActiveTexture(GL_TEXTURE0);
     material->shader->set_int("skybox", 0);
     glBindTexture(GL_TEXTURE_CUBE_MAP, m_texture->id);
+    RendererStatistics::add_texture_binds(1);
 
     // Draw mesh
     glDrawArrays(GL_TRIANGLES, 0, 36);
+    RendererStatistics::add_draw_call(36);
 
     glActiveTexture(GL_TEXTURE0);
 
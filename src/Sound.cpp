@@ -1,9 +1,12 @@
 #include "Sound.h"
 
+#include "AssetPreloader.h"
+#include "Debug.h"
 #include "Engine.h"
 #include "Entity.h"
 
 #if EDITOR
+#include <array>
 #include <imgui_stdlib.h>
 #endif
 
@@ -11,8 +14,6 @@
 #include "imgui_extensions.h"
 #endif
 
-// TODO: Add an option to load sounds from files at the start of the game
-
 std::shared_ptr<Sound> Sound::create()
 {
     auto sound = std::make_shared<Sound>(AK::Badge<Sound> {});
@@ -25,7 +26,10 @@ std::shared_ptr<Sound> Sound::create()
 std::shared_ptr<Sound> Sound::create(std::string const& path)
 {
     std::shared_ptr<Sound> sound = std::make_shared<Sound>(AK::Badge<Sound> {});
-    ma_sound_init_from_file(&Engine::audio_engine, path.c_str(), 0, nullptr, nullptr, &sound->m_internal_sound);
+    sound->path = path;
+
+    if (sound->init_internal_sound() != MA_SUCCESS)
+        Debug::log("Sound failed to load at path: " + path, DebugType::Error);
 
     sound->set_can_tick(true);
 
@@ -36,7 +40,10 @@ std::shared_ptr<Sound> Sound::create(std::string const& path, glm::vec3 const di
                                      ma_attenuation_model const attenuation)
 {
     std::shared_ptr<Sound> sound = std::make_shared<Sound>(AK::Badge<Sound> {});
-    ma_sound_init_from_file(&Engine::audio_engine, path.c_str(), 0, nullptr, nullptr, &sound->m_internal_sound);
+    sound->path = path;
+
+    if (sound->init_internal_sound() != MA_SUCCESS)
+        Debug::log("Sound failed to load at path: " + path, DebugType::Error);
 
     ma_sound_set_attenuation_model(&sound->m_internal_sound, attenuation);
     ma_sound_set_direction(&sound->m_internal_sound, direction.x, direction.y, direction.z);
@@ -76,6 +83,35 @@ std::shared_ptr<Sound> Sound::play_sound_at_location(std::string const& path, gl
     return sound;
 }
 
+std::shared_ptr<Sound> Sound::play_music(std::string const& path, u64 const crossfade_milliseconds)
+{
+    auto const previous_music = m_music.lock();
+
+    if (previous_music != nullptr && previous_music->path == path && !previous_music->m_destroy_when_stopped)
+        return previous_music;
+
+    auto music = create(path);
+
+    if (previous_music != nullptr)
+    {
+        previous_music->stop_with_fade(crossfade_milliseconds);
+        previous_music->m_destroy_when_stopped = true;
+
+        // Fade is set before starting, so the first frames aren't played at full volume
+        ma_sound_set_fade_in_milliseconds(&music->m_internal_sound, 0.0f, 1.0f, crossfade_milliseconds);
+    }
+
+    ma_sound_set_looping(&music->m_internal_sound, true);
+    ma_sound_start(&music->m_internal_sound);
+
+    auto const e = Entity::create("Music");
+    e->add_component<Sound>(music);
+
+    m_music = music;
+
+    return music;
+}
+
 void Sound::awake()
 {
     if (play_on_awake)
@@ -117,6 +153,14 @@ void Sound::custom_draw_editor()
     }
 
     ImGui::Checkbox("Play on Awake", &play_on_awake);
+
+    std::array const load_policies = {"Default", "Preload", "Stream"};
+    i32 current_item_index = static_cast<i32>(load_policy);
+    if (ImGui::Combo("Load Policy", &current_item_index, load_policies.data(), load_policies.size()))
+    {
+        load_policy = static_cast<SoundLoadPolicy>(current_item_index);
+        reprepare();
+    }
 }
 #endif
 
@@ -128,7 +172,7 @@ void Sound::reprepare()
     {
         ma_sound_uninit(&m_internal_sound);
 
-        auto const result = ma_sound_init_from_file(&Engine::audio_engine, path.c_str(), 0, nullptr, nullptr, &m_internal_sound);
+        auto const result = init_internal_sound();
 
         if (result != MA_SUCCESS)
         {
@@ -187,11 +231,25 @@ void Sound::update()
         ma_sound_set_position(&m_internal_sound, position.x, position.y, position.z);
     }
 
-    // Cleanup if the sound has ended. Note that for looping sounds atEnd is never true.
-    if (m_internal_sound.atEnd)
+    // Cleanup if the sound has ended. Note that for looping sounds atEnd is never true, they are only cleaned up
+    // when they were stopped to be destroyed.
+    if (m_internal_sound.atEnd || (m_destroy_when_stopped && !ma_sound_is_playing(&m_internal_sound)))
     {
         ma_sound_uninit(&m_internal_sound);
 
         entity->destroy_immediate();
     }
 }
+
+ma_result Sound::init_internal_sound()
+{
+    SoundLoadPolicy policy = load_policy;
+
+    if (policy == SoundLoadPolicy::Default)
+        policy = Engine::asset_preloader->get_sound_load_policy(path);
+
+    // Streams are also opened on the job thread, so starting long music doesn't stall the frame
+    ma_uint32 const flags = policy == SoundLoadPolicy::Stream ? MA_SOUND_FLAG_STREAM | MA_SOUND_FLAG_ASYNC : MA_SOUND_FLAG_DECODE;
+
+    return ma_sound_init_from_file(&Engine::audio_engine, path.c_str(), flags, nullptr, nullptr, &m_internal_sound);
+}
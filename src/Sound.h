@@ -7,6 +7,16 @@
 #include "AK/Types.h"
 #include "Component.h"
 
+enum class SoundLoadPolicy
+{
+    // Decided by the asset manifest, see AssetPreloader::get_sound_load_policy()
+    Default,
+    // Whole file is decoded when the sound is loaded and shared by every sound playing it
+    Preload,
+    // Decoded on miniaudio's job thread while playing, only a couple of pages of frames are kept in memory at once
+    Stream,
+};
+
 CUSTOM_EDITOR_ONLY
 class Sound final : public Component
 {
@@ -15,12 +25,16 @@ public:
     static std::shared_ptr<Sound> create(std::string const& path);
     static std::shared_ptr<Sound> create(std::string const& path, glm::vec3 const direction, float const rolloff = 0.5f,
                                          ma_attenuation_model const attenuation = ma_attenuation_model_inverse);
+    // Both create a new entity and open the file on every call. One-shot sounds played often should use SoundPool instead.
     static std::shared_ptr<Sound> play_sound(std::string const& path, bool const loop = false);
     static std::shared_ptr<Sound> play_sound_at_location(std::string const& path, glm::vec3 const position, glm::vec3 direction,
                                                          float rolloff = 0.5f,
                                                          ma_attenuation_model attenuation = ma_attenuation_model_inverse,
                                                          bool const loop = false);
 
+    // Looping music, crossfaded with the music that was playing before, which is destroyed once it fades out
+    static std::shared_ptr<Sound> play_music(std::string const& path, u64 const crossfade_milliseconds = default_crossfade_milliseconds);
+
     explicit Sound(AK::Badge<Sound>)
     {
     }
@@ -51,7 +65,15 @@ public:
     float volume = 1.0f;
     bool play_on_awake = false;
     bool is_positional = false;
+    SoundLoadPolicy load_policy = SoundLoadPolicy::Default;
+
+    inline static u64 constexpr default_crossfade_milliseconds = 2000;
 
 private:
+    [[nodiscard]] ma_result init_internal_sound();
+
     ma_sound m_internal_sound = {};
+    bool m_destroy_when_stopped = false;
+
+    inline static std::weak_ptr<Sound> m_music = {};
 };
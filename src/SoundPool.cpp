@@ -0,0 +1,327 @@
+#include "SoundPool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "Debug.h"
+
+void SoundVoice::set_volume(float const volume) const
+{
+    if (auto* voice = SoundPool::get_instance().get_voice(*this))
+        ma_sound_set_volume(&voice->sound, volume);
+}
+
+void SoundVoice::stop() const
+{
+    if (auto* voice = SoundPool::get_instance().get_voice(*this))
+        ma_sound_stop(&voice->sound);
+}
+
+void SoundVoice::stop_with_fade(u64 const milliseconds) const
+{
+    if (auto* voice = SoundPool::get_instance().get_voice(*this))
+        ma_sound_stop_with_fade_in_milliseconds(&voice->sound, milliseconds);
+}
+
+bool SoundVoice::is_playing() const
+{
+    auto const* voice = SoundPool::get_instance().get_voice(*this);
+    return voice != nullptr && ma_sound_is_playing(&voice->sound);
+}
+
+SoundPool& SoundPool::get_instance()
+{
+    static SoundPool instance;
+    return instance;
+}
+
+void SoundPool::initialize(ma_engine* engine)
+{
+    m_engine = engine;
+    m_sample_rate = ma_engine_get_sample_rate(engine);
+
+    ma_data_source_config config = ma_data_source_config_init();
+    config.vtable = &voice_vtable;
+
+    for (u32 i = 0; i < m_voices.size(); ++i)
+    {
+        Voice& voice = m_voices[i];
+        voice.channels = i < mono_voice_count ? 1 : 2;
+
+        if (ma_data_source_init(&config, &voice.data_source) != MA_SUCCESS)
+        {
+            Debug::log("Could not create a sound pool voice.", DebugType::Error);
+            continue;
+        }
+
+        if (ma_sound_init_from_data_source(engine, &voice, 0, nullptr, &voice.sound) != MA_SUCCESS)
+        {
+            Debug::log("Could not create a sound pool voice.", DebugType::Error);
+            ma_data_source_uninit(&voice.data_source);
+            continue;
+        }
+
+        voice.is_initialized = true;
+    }
+}
+
+void SoundPool::uninitialize()
+{
+    for (auto& voice : m_voices)
+    {
+        if (!voice.is_initialized)
+            continue;
+
+        // Sound is detached from the audio thread first, so nothing reads the voice or its clip anymore
+        ma_sound_uninit(&voice.sound);
+        ma_data_source_uninit(&voice.data_source);
+
+        voice.is_initialized = false;
+        voice.requested_clip = nullptr;
+        voice.request = 0;
+        voice.clip = nullptr;
+        voice.played_request = 0;
+        voice.cursor = 0;
+
+        // Handles to the voice stay invalid after initializing again
+        ++voice.generation;
+    }
+
+    m_clips.clear();
+    m_engine = nullptr;
+}
+
+std::shared_ptr<AudioClip> SoundPool::load_clip(std::string const& path)
+{
+    if (auto const it = m_clips.find(path); it != m_clips.end())
+        return it->second;
+
+    if (m_engine == nullptr)
+    {
+        Debug::log("Sound clip " + path + " can't be loaded without an audio engine.", DebugType::Error);
+        return nullptr;
+    }
+
+    // Clips are converted to the format of the engine, so voices never have to resample them
+    ma_decoder_config config = ma_decoder_config_init(ma_format_f32, 0, m_sample_rate);
+    ma_decoder decoder = {};
+
+    if (ma_decoder_init_file(path.c_str(), &config, &decoder) != MA_SUCCESS)
+    {
+        Debug::log("Sound clip failed to load at path: " + path, DebugType::Error);
+
+        // Only reported once, the clip is usually loaded by every instance of a component
+        m_clips.emplace(path, nullptr);
+        return nullptr;
+    }
+
+    if (decoder.outputChannels > max_clip_channels)
+    {
+        ma_decoder_uninit(&decoder);
+
+        config.channels = max_clip_channels;
+
+        if (ma_decoder_init_file(path.c_str(), &config, &decoder) != MA_SUCCESS)
+        {
+            Debug::log("Sound clip failed to load at path: " + path, DebugType::Error);
+            m_clips.emplace(path, nullptr);
+            return nullptr;
+        }
+    }
+
+    auto clip = std::make_shared<AudioClip>();
+    clip->path = path;
+    clip->channels = decoder.outputChannels;
+
+    // Length isn't known up front for every format, frames are then read until the end
+    ma_uint64 length = 0;
+    if (ma_decoder_get_length_in_pcm_frames(&decoder, &length) == MA_SUCCESS)
+        clip->frames.reserve(length * clip->channels);
+
+    std::array<float, 4096> chunk = {};
+    ma_uint64 const chunk_frame_count = chunk.size() / clip->channels;
+
+    while (true)
+    {
+        ma_uint64 frames_read = 0;
+        ma_result const result = ma_decoder_read_pcm_frames(&decoder, chunk.data(), chunk_frame_count, &frames_read);
+
+        clip->frames.insert(clip->frames.end(), chunk.data(), chunk.data() + frames_read * clip->channels);
+
+        if (result != MA_SUCCESS || frames_read < chunk_frame_count)
+            break;
+    }
+
+    ma_decoder_uninit(&decoder);
+
+    clip->frame_count = clip->frames.size() / clip->channels;
+
+    m_clips.emplace(path, clip);
+
+    return clip;
+}
+
+std::vector<std::shared_ptr<AudioClip>> SoundPool::load_clips(std::string const& path_prefix, u32 const count,
+                                                              std::string const& extension)
+{
+    std::vector<std::shared_ptr<AudioClip>> clips = {};
+    clips.reserve(count);
+
+    for (u32 i = 1; i <= count; ++i)
+    {
+        clips.emplace_back(load_clip(path_prefix + std::to_string(i) + extension));
+    }
+
+    return clips;
+}
+
+SoundVoice SoundPool::play(std::shared_ptr<AudioClip> const& clip, float const volume, SoundPriority const priority)
+{
+    if (clip == nullptr)
+        return {};
+
+    Voice* voice = acquire_voice(*clip, priority);
+
+    if (voice == nullptr)
+        return {};
+
+    // Same as sounds that aren't positional, see Sound::awake()
+    ma_sound_set_attenuation_model(&voice->sound, ma_attenuation_model_linear);
+    ma_sound_set_position(&voice->sound, 0.0f, 0.0f, 0.0f);
+    ma_sound_set_direction(&voice->sound, 0.0f, 0.0f, -1.0f);
+    ma_sound_set_rolloff(&voice->sound, 1.0f);
+
+    return start_voice(*voice, *clip, volume, priority);
+}
+
+SoundVoice SoundPool::play_at_location(std::shared_ptr<AudioClip> const& clip, glm::vec3 const& position, glm::vec3 const& direction,
+                                       float const volume, SoundPriority const priority, float const rolloff,
+                                       ma_attenuation_model const attenuation)
+{
+    if (clip == nullptr)
+        return {};
+
+    Voice* voice = acquire_voice(*clip, priority);
+
+    if (voice == nullptr)
+        return {};
+
+    ma_sound_set_attenuation_model(&voice->sound, attenuation);
+    ma_sound_set_position(&voice->sound, position.x, position.y, position.z);
+    ma_sound_set_direction(&voice->sound, direction.x, direction.y, direction.z);
+    ma_sound_set_rolloff(&voice->sound, rolloff);
+
+    return start_voice(*voice, *clip, volume, priority);
+}
+
+SoundPool::Voice* SoundPool::acquire_voice(AudioClip const& clip, SoundPriority const priority)
+{
+    Voice* stolen_voice = nullptr;
+
+    for (auto& voice : m_voices)
+    {
+        if (!voice.is_initialized || voice.channels != clip.channels)
+            continue;
+
+        if (!ma_sound_is_playing(&voice.sound))
+            return &voice;
+
+        if (voice.priority > priority)
+            continue;
+
+        if (stolen_voice == nullptr || voice.priority < stolen_voice->priority
+            || (voice.priority == stolen_voice->priority && voice.play_order < stolen_voice->play_order))
+        {
+            stolen_voice = &voice;
+        }
+    }
+
+    return stolen_voice;
+}
+
+SoundPool::Voice* SoundPool::get_voice(SoundVoice const& handle)
+{
+    if (handle.index >= m_voices.size())
+        return nullptr;
+
+    Voice& voice = m_voices[handle.index];
+
+    if (!voice.is_initialized || voice.generation != handle.generation)
+        return nullptr;
+
+    return &voice;
+}
+
+SoundVoice SoundPool::start_voice(Voice& voice, AudioClip const& clip, float const volume, SoundPriority const priority)
+{
+    ma_sound_stop(&voice.sound);
+
+    voice.requested_clip.store(&clip, std::memory_order_relaxed);
+    voice.request.fetch_add(1, std::memory_order_release);
+
+    ++voice.generation;
+    voice.priority = priority;
+    voice.play_order = ++m_play_count;
+
+    // Clear a fade out and a scheduled stop left by the previous sound
+    ma_sound_set_fade_in_pcm_frames(&voice.sound, 1.0f, 1.0f, 0);
+    ma_sound_set_stop_time_in_pcm_frames(&voice.sound, std::numeric_limits<ma_uint64>::max());
+
+    ma_sound_set_volume(&voice.sound, volume);
+    ma_sound_start(&voice.sound);
+
+    return {static_cast<u32>(&voice - m_voices.data()), voice.generation};
+}
+
+ma_result SoundPool::on_voice_read(ma_data_source* data_source, void* frames_out, ma_uint64 const frame_count, ma_uint64* frames_read)
+{
+    auto* voice = static_cast<Voice*>(data_source);
+
+    // Clip is only swapped here, so the game thread never changes it in the middle of a read
+    if (u32 const request = voice->request.load(std::memory_order_acquire); request != voice->played_request)
+    {
+        voice->played_request = request;
+        voice->clip = voice->requested_clip.load(std::memory_order_relaxed);
+        voice->cursor = 0;
+    }
+
+    u64 frames_to_read = 0;
+
+    if (voice->clip != nullptr && voice->cursor < voice->clip->frame_count)
+    {
+        frames_to_read = std::min<u64>(frame_count, voice->clip->frame_count - voice->cursor);
+
+        std::memcpy(frames_out, voice->clip->frames.data() + voice->cursor * voice->channels,
+                    frames_to_read * voice->channels * sizeof(float));
+
+        voice->cursor += frames_to_read;
+    }
+
+    if (frames_read != nullptr)
+        *frames_read = frames_to_read;
+
+    return frames_to_read < frame_count ? MA_AT_END : MA_SUCCESS;
+}
+
+// Only called by miniaudio when a sound that reached its end is started again, the audio thread doesn't read the voice then
+ma_result SoundPool::on_voice_seek(ma_data_source* data_source, ma_uint64 const frame_index)
+{
+    auto* voice = static_cast<Voice*>(data_source);
+    voice->cursor = frame_index;
+
+    return MA_SUCCESS;
+}
+
+ma_result SoundPool::on_voice_get_data_format(ma_data_source* data_source, ma_format* format, ma_uint32* channels, ma_uint32* sample_rate,
+                                              ma_channel* channel_map, size_t const channel_map_capacity)
+{
+    auto const* voice = static_cast<Voice const*>(data_source);
+
+    *format = ma_format_f32;
+    *channels = voice->channels;
+    *sample_rate = get_instance().m_sample_rate;
+    ma_channel_map_init_standard(ma_standard_channel_map_default, channel_map, channel_map_capacity, voice->channels);
+
+    return MA_SUCCESS;
+}
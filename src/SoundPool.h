@@ -0,0 +1,129 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec3.hpp>
+#include <miniaudio.h>
+
+#include "AK/Types.h"
+
+// Whole clip decoded once to 32 bit float frames at the sample rate of the audio engine
+struct AudioClip
+{
+    std::string path = {};
+    std::vector<float> frames = {};
+    u32 channels = 0;
+    u64 frame_count = 0;
+};
+
+// When every voice is playing, a new sound steals the voice of the lowest priority that isn't higher than its own,
+// the oldest one if there are more of them. Sounds are dropped if every voice plays something more important.
+enum class SoundPriority : u8
+{
+    Low,
+    Normal,
+    High,
+};
+
+// Handle to a voice playing a sound. Calls on it are ignored once the voice starts playing another sound.
+struct SoundVoice
+{
+    void set_volume(float const volume) const;
+    void stop() const;
+    void stop_with_fade(u64 const milliseconds) const;
+    [[nodiscard]] bool is_playing() const;
+
+    u32 index = invalid_index;
+    u32 generation = 0;
+
+    inline static u32 constexpr invalid_index = 0xFFFFFFFF;
+};
+
+// One-shot sounds played from clips decoded up front, on a fixed set of voices created together with the audio engine.
+// Playing a sound doesn't read any file, create any entity or allocate any memory, unlike Sound::play_sound().
+// Clips should be loaded together with a level, usually in awake() of the component that plays them.
+class SoundPool
+{
+public:
+    SoundPool(SoundPool const&) = delete;
+    void operator=(SoundPool const&) = delete;
+
+    static SoundPool& get_instance();
+
+    // Voices live as long as the audio engine, initialize right after it's created and uninitialize right before it's destroyed.
+    // Loaded clips are released when uninitializing.
+    void initialize(ma_engine* engine);
+    void uninitialize();
+
+    // Decodes the clip the first time it's loaded, returns nullptr if it can't be decoded.
+    // Game code should keep the returned clip, so playing it doesn't even look it up.
+    std::shared_ptr<AudioClip> load_clip(std::string const& path);
+
+    // Loads variants of a clip numbered from 1, e.g. "./res/audio/crash" with a count of 2 loads crash1.wav and crash2.wav
+    std::vector<std::shared_ptr<AudioClip>> load_clips(std::string const& path_prefix, u32 const count,
+                                                       std::string const& extension = ".wav");
+
+    SoundVoice play(std::shared_ptr<AudioClip> const& clip, float const volume = 1.0f,
+                    SoundPriority const priority = SoundPriority::Normal);
+    SoundVoice play_at_location(std::shared_ptr<AudioClip> const& clip, glm::vec3 const& position, glm::vec3 const& direction,
+                                float const volume = 1.0f, SoundPriority const priority = SoundPriority::Normal, float const rolloff = 0.5f,
+                                ma_attenuation_model const attenuation = ma_attenuation_model_inverse);
+
+    // Clips with more channels are mixed down to stereo
+    inline static u32 constexpr mono_voice_count = 24;
+    inline static u32 constexpr stereo_voice_count = 8;
+    inline static u32 constexpr max_clip_channels = 2;
+
+private:
+    friend struct SoundVoice;
+
+    struct Voice
+    {
+        // Has to be the first member, the voice itself is the data source of its sound
+        ma_data_source_base data_source = {};
+        ma_sound sound = {};
+        u32 channels = 0;
+        bool is_initialized = false;
+
+        // Written by the game thread when the voice starts playing a new clip, picked up by the audio thread on its next read
+        std::atomic<AudioClip const*> requested_clip = nullptr;
+        std::atomic<u32> request = 0;
+
+        // Only used by the audio thread
+        AudioClip const* clip = nullptr;
+        u32 played_request = 0;
+        u64 cursor = 0;
+
+        // Only used by the game thread
+        u32 generation = 0;
+        SoundPriority priority = SoundPriority::Low;
+        u64 play_order = 0;
+    };
+
+    SoundPool() = default;
+
+    Voice* acquire_voice(AudioClip const& clip, SoundPriority const priority);
+    Voice* get_voice(SoundVoice const& handle);
+    SoundVoice start_voice(Voice& voice, AudioClip const& clip, float const volume, SoundPriority const priority);
+
+    static ma_result on_voice_read(ma_data_source* data_source, void* frames_out, ma_uint64 frame_count, ma_uint64* frames_read);
+    static ma_result on_voice_seek(ma_data_source* data_source, ma_uint64 frame_index);
+    static ma_result on_voice_get_data_format(ma_data_source* data_source, ma_format* format, ma_uint32* channels, ma_uint32* sample_rate,
+                                              ma_channel* channel_map, size_t channel_map_capacity);
+
+    inline static ma_data_source_vtable const voice_vtable = {
+        &SoundPool::on_voice_read, &SoundPool::on_voice_seek, &SoundPool::on_voice_get_data_format, nullptr, nullptr, nullptr, 0};
+
+    ma_engine* m_engine = nullptr;
+    u32 m_sample_rate = 0;
+
+    std::array<Voice, mono_voice_count + stereo_voice_count> m_voices = {};
+    u64 m_play_count = 0;
+
+    std::unordered_map<std::string, std::shared_ptr<AudioClip>> m_clips = {};
+};
@@ -22,7 +22,7 @@ public:
     virtual void custom_draw_editor() override;
 #endif
 
-    void set_render_target_for_shadow_mapping() const;
+    void set_render_target_for_shadow_mapping(bool const clear = true) const;
     glm::mat4 get_projection_view_matrix();
     glm::mat4 get_rotated_inverse_model_matrix() const;
     glm::mat4 get_rotated_model_matrix() const;
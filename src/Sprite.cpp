@@ -48,18 +48,37 @@ void Sprite::prepare()
 {
     if (material->is_gpu_instanced)
     {
-        if (material->first_drawable != nullptr)
+        if (!material->add_to_instance_batch(std::dynamic_pointer_cast<Drawable>(shared_from_this()), diffuse_texture_path))
             return;
-
-        material->first_drawable = std::dynamic_pointer_cast<Drawable>(shared_from_this());
     }
 
+    TextureSettings texture_settings = {};
+    texture_settings.wrap_mode_x = TextureWrapMode::ClampToEdge;
+    texture_settings.wrap_mode_y = TextureWrapMode::ClampToEdge;
+
+    m_texture = nullptr;
+
+    if (!diffuse_texture_path.empty())
+        m_texture = ResourceManager::get_instance().load_texture(diffuse_texture_path, std::nullopt, texture_settings);
+
+    // Sprites drawn with the UI shader are screen space quads, same as buttons and panels
+    m_is_ui_sprite = material->shader->get_vertex_path() == "./res/shaders/ui.hlsl";
+
     m_meshes.emplace_back(create_sprite());
 }
 
-std::shared_ptr<Mesh> Sprite::create_sprite() const
+std::shared_ptr<Texture> Sprite::get_ui_texture() const
+{
+    return m_is_ui_sprite ? m_texture : nullptr;
+}
+
+bool Sprite::is_cullable() const
 {
+    return !m_is_ui_sprite && Model::is_cullable();
+}
 
+std::shared_ptr<Mesh> Sprite::create_sprite() const
+{
     std::vector<Vertex> const vertices = {
         {glm::vec3(-1.0f, -1.0f, 0.0f), {}, {0.0f, 0.0f}}, // bottom left
         {glm::vec3(1.0f, -1.0f, 0.0f), {}, {1.0f, 0.0f}}, // bottom right
@@ -71,15 +90,8 @@ std::shared_ptr<Mesh> Sprite::create_sprite() const
 
     std::vector<std::shared_ptr<Texture>> textures;
 
-    std::vector<std::shared_ptr<Texture>> diffuse_maps = {};
-    TextureSettings texture_settings = {};
-    texture_settings.wrap_mode_x = TextureWrapMode::ClampToEdge;
-    texture_settings.wrap_mode_y = TextureWrapMode::ClampToEdge;
-
-    if (!diffuse_texture_path.empty())
-        diffuse_maps.emplace_back(ResourceManager::get_instance().load_texture(diffuse_texture_path, std::nullopt, texture_settings));
-
-    textures.insert(textures.end(), diffuse_maps.begin(), diffuse_maps.end());
+    if (m_texture != nullptr)
+        textures.emplace_back(m_texture);
 
     return ResourceManager::get_instance().load_mesh(m_meshes.size(), diffuse_texture_path, vertices, indices, textures, m_draw_type,
                                                      material);
@@ -19,8 +19,16 @@ public:
 
     virtual void prepare() override;
 
+    virtual std::shared_ptr<Texture> get_ui_texture() const override;
+
+    // Bounds of UI sprites are built from their screen space transform, so they can't be tested against the frustum
+    virtual bool is_cullable() const override;
+
     std::string diffuse_texture_path = "";
 
 private:
     [[nodiscard]] std::shared_ptr<Mesh> create_sprite() const;
+
+    std::shared_ptr<Texture> m_texture = {};
+    bool m_is_ui_sprite = false;
 };
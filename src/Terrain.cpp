@@ -1,9 +1,19 @@
 #include "Terrain.h"
 
+#include <algorithm>
+#include <chrono>
+#include <execution>
 #include <iostream>
+#include <limits>
 #include <stb_image.h>
 
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include "Camera.h"
+#include "Entity.h"
 #include "MeshFactory.h"
+#include "Renderer.h"
 #include "ResourceManager.h"
 
 #if EDITOR
@@ -19,10 +29,22 @@ std::shared_ptr<Terrain> Terrain::create(std::shared_ptr<Material> const& materi
     return terrain;
 }
 
-Terrain::Terrain(AK::Badge<Terrain>, std::shared_ptr<Material> const& material, bool const use_gpu, std::string const& height_map_path)
-    : Model(material), m_use_gpu(use_gpu), m_height_map_path(height_map_path)
+std::shared_ptr<Terrain> Terrain::create_chunked(std::shared_ptr<Material> const& material, std::string const& height_map_path)
 {
-    if (use_gpu)
+    auto terrain = std::make_shared<Terrain>(AK::Badge<Terrain> {}, material, false, height_map_path, true);
+
+    terrain->prepare();
+
+    return terrain;
+}
+
+Terrain::Terrain(AK::Badge<Terrain>, std::shared_ptr<Material> const& material, bool const use_gpu, std::string const& height_map_path,
+                 bool const use_chunks)
+    : Model(material), m_use_gpu(use_gpu && !use_chunks), m_use_chunks(use_chunks), m_height_map_path(height_map_path)
+{
+    if (m_use_chunks)
+        m_draw_type = DrawType::Triangles;
+    else if (m_use_gpu)
         m_draw_type = DrawType::Patches;
     else
         m_draw_type = DrawType::TriangleStrip;
@@ -30,6 +52,12 @@ Terrain::Terrain(AK::Badge<Terrain>, std::shared_ptr<Material> const& material,
 
 void Terrain::draw() const
 {
+    if (m_use_chunks)
+    {
+        draw_tiles();
+        return;
+    }
+
     assert(m_meshes.size() == 1);
 
     if (m_use_gpu)
@@ -54,7 +82,9 @@ void Terrain::prepare()
     }
     else
     {
-        if (m_use_gpu)
+        if (m_use_chunks)
+            create_tiles();
+        else if (m_use_gpu)
             m_meshes.emplace_back(create_terrain_from_height_map_gpu());
         else
             m_meshes.emplace_back(create_terrain_from_height_map());
@@ -159,9 +189,6 @@ std::shared_ptr<Mesh> Terrain::create_terrain_from_height_map()
     std::vector<Vertex> vertices = {};
     vertices.reserve(height * width);
 
-    float constexpr y_scale = 64.0f / 256.0f;
-    float constexpr y_shift = 16.0f;
-
     for (u32 i = 0; i < height; ++i)
     {
         for (u32 k = 0; k < width; ++k)
@@ -196,10 +223,363 @@ std::shared_ptr<Mesh> Terrain::create_terrain_from_height_map()
     return ResourceManager::get_instance().load_mesh(m_meshes.size(), m_height_map_path, vertices, indices, {}, m_draw_type, material);
 }
 
+void Terrain::calculate_bounding_box()
+{
+    if (!m_use_chunks)
+    {
+        Model::calculate_bounding_box();
+        return;
+    }
+
+    if (m_tiles.empty())
+        return;
+
+    bounds = m_tiles[0].local_bounds;
+
+    for (auto const& tile : m_tiles)
+        bounds = BoundingBox::merge(bounds, tile.local_bounds);
+}
+
+void Terrain::adjust_bounding_box()
+{
+    if (!m_use_chunks)
+    {
+        Model::adjust_bounding_box();
+        return;
+    }
+
+    if (m_tiles.empty())
+        return;
+
+    glm::mat4 const model_matrix = entity->transform->get_model_matrix();
+
+    for (auto& tile : m_tiles)
+        tile.bounds = tile.local_bounds.transform(model_matrix);
+
+    bounds = m_tiles[0].bounds;
+
+    for (auto const& tile : m_tiles)
+        bounds = BoundingBox::merge(bounds, tile.bounds);
+}
+
+BoundingBox Terrain::get_adjusted_bounding_box(glm::mat4 const& model_matrix) const
+{
+    if (!m_use_chunks)
+        return Model::get_adjusted_bounding_box(model_matrix);
+
+    if (m_tiles.empty())
+        return {};
+
+    BoundingBox local_bounds = m_tiles[0].local_bounds;
+
+    for (auto const& tile : m_tiles)
+        local_bounds = BoundingBox::merge(local_bounds, tile.local_bounds);
+
+    return local_bounds.transform(model_matrix);
+}
+
+bool Terrain::is_cullable() const
+{
+    if (!m_use_chunks)
+        return Model::is_cullable();
+
+    return !m_tiles.empty();
+}
+
+float Terrain::HeightMap::get_height(i32 const x, i32 const z) const
+{
+    u32 const clamped_x = static_cast<u32>(std::clamp(x, 0, static_cast<i32>(width) - 1));
+    u32 const clamped_z = static_cast<u32>(std::clamp(z, 0, static_cast<i32>(height) - 1));
+
+    return heights[clamped_x + width * clamped_z];
+}
+
+glm::vec3 Terrain::HeightMap::get_position(u32 const x, u32 const z) const
+{
+    // Same layout as the strips of create_terrain_from_height_map()
+    return {-static_cast<float>(width) / 2.0f + static_cast<float>(x), heights[x + width * z],
+            -static_cast<float>(height) / 2.0f + static_cast<float>(z)};
+}
+
+glm::vec3 Terrain::HeightMap::get_normal(u32 const x, u32 const z) const
+{
+    auto const i = static_cast<i32>(x);
+    auto const k = static_cast<i32>(z);
+
+    // Central differences, texels are one unit apart
+    return glm::normalize(glm::vec3(get_height(i - 1, k) - get_height(i + 1, k), 2.0f, get_height(i, k - 1) - get_height(i, k + 1)));
+}
+
+std::shared_ptr<Terrain::HeightMap const> Terrain::load_height_map(std::string const& path)
+{
+    stbi_set_flip_vertically_on_load(true);
+
+    i32 width, height, number_of_components;
+    unsigned char* data = stbi_load(path.c_str(), &width, &height, &number_of_components, 0);
+
+    if (data == nullptr)
+    {
+        std::cout << "Height map failed to load at path: " << path << '\n';
+        return nullptr;
+    }
+
+    auto height_map = std::make_shared<HeightMap>();
+    height_map->width = static_cast<u32>(width);
+    height_map->height = static_cast<u32>(height);
+    height_map->heights.resize(static_cast<size_t>(width) * height);
+
+    for (size_t i = 0; i < height_map->heights.size(); ++i)
+    {
+        height_map->heights[i] = static_cast<float>(data[i * number_of_components]) * y_scale - y_shift;
+    }
+
+    stbi_image_free(data);
+
+    return height_map;
+}
+
+void Terrain::create_tiles()
+{
+    // Waits for builds of previous tiles to finish
+    m_pending_builds.clear();
+    m_tiles.clear();
+
+    m_height_map = load_height_map(m_height_map_path);
+
+    if (m_height_map == nullptr || m_height_map->width < 2 || m_height_map->height < 2)
+        return;
+
+    u32 const quads_x = m_height_map->width - 1;
+    u32 const quads_z = m_height_map->height - 1;
+
+    m_tiles.reserve(static_cast<size_t>((quads_x + tile_size - 1) / tile_size) * ((quads_z + tile_size - 1) / tile_size));
+
+    for (u32 z = 0; z < quads_z; z += tile_size)
+    {
+        for (u32 x = 0; x < quads_x; x += tile_size)
+        {
+            Tile tile = {};
+            tile.first_x = x;
+            tile.first_z = z;
+            tile.size_x = std::min(tile_size, quads_x - x);
+            tile.size_z = std::min(tile_size, quads_z - z);
+
+            // Bounds cover all texels of the tile, so they hold for every level of detail
+            float min_height = std::numeric_limits<float>::max();
+            float max_height = std::numeric_limits<float>::lowest();
+
+            for (u32 tile_z = z; tile_z <= z + tile.size_z; ++tile_z)
+            {
+                for (u32 tile_x = x; tile_x <= x + tile.size_x; ++tile_x)
+                {
+                    float const height = m_height_map->get_height(static_cast<i32>(tile_x), static_cast<i32>(tile_z));
+                    min_height = std::min(min_height, height);
+                    max_height = std::max(max_height, height);
+                }
+            }
+
+            glm::vec3 const first_corner = m_height_map->get_position(x, z);
+            glm::vec3 const last_corner = m_height_map->get_position(x + tile.size_x, z + tile.size_z);
+
+            tile.local_bounds = {glm::vec3(first_corner.x, min_height - skirt_depth, first_corner.z),
+                                 glm::vec3(last_corner.x, max_height, last_corner.z)};
+            tile.bounds = tile.local_bounds;
+
+            m_tiles.emplace_back(tile);
+        }
+    }
+
+    // Coarsest levels are built right away, so every tile can be drawn from the first frame
+    std::vector<TileGeometry> coarsest_lods(m_tiles.size());
+
+    std::for_each(std::execution::par, m_tiles.begin(), m_tiles.end(), [&](Tile const& tile) {
+        coarsest_lods[&tile - m_tiles.data()] =
+            build_tile_geometry(m_height_map, tile.first_x, tile.first_z, tile.size_x, tile.size_z, lod_count - 1);
+    });
+
+    for (u32 i = 0; i < m_tiles.size(); ++i)
+    {
+        m_tiles[i].lods[lod_count - 1] = create_tile_mesh(i, lod_count - 1, coarsest_lods[i]);
+    }
+}
+
+void Terrain::draw_tiles() const
+{
+    collect_pending_builds();
+
+    if (m_tiles.empty())
+        return;
+
+    Frustum const frustum = Renderer::get_instance()->get_culling_frustum();
+    glm::vec3 const camera_position = Camera::get_main_camera()->get_position();
+
+    for (u32 i = 0; i < m_tiles.size(); ++i)
+    {
+        auto const& tile = m_tiles[i];
+
+        if (!tile.bounds.is_in_frustum(frustum))
+            continue;
+
+        u32 const lod = select_lod(tile, camera_position);
+
+        if (tile.lods[lod] == nullptr)
+            request_tile_lod(i, lod);
+
+        auto const mesh = get_closest_lod(tile, lod);
+
+        if (mesh != nullptr)
+            mesh->draw();
+    }
+}
+
+void Terrain::collect_pending_builds() const
+{
+    std::erase_if(m_pending_builds, [this](PendingBuild& build) {
+        if (build.geometry.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return false;
+
+        auto& tile = m_tiles[build.tile_index];
+        tile.lods[build.lod] = create_tile_mesh(build.tile_index, build.lod, build.geometry.get());
+        tile.is_lod_pending[build.lod] = false;
+
+        return true;
+    });
+}
+
+void Terrain::request_tile_lod(u32 const tile_index, u32 const lod) const
+{
+    auto& tile = m_tiles[tile_index];
+
+    if (tile.is_lod_pending[lod] || m_pending_builds.size() >= max_pending_builds)
+        return;
+
+    tile.is_lod_pending[lod] = true;
+
+    m_pending_builds.push_back({tile_index, lod,
+                                std::async(std::launch::async, &Terrain::build_tile_geometry, m_height_map, tile.first_x, tile.first_z,
+                                           tile.size_x, tile.size_z, lod)});
+}
+
+std::shared_ptr<Mesh> Terrain::create_tile_mesh(u32 const tile_index, u32 const lod, TileGeometry const& geometry) const
+{
+    return ResourceManager::get_instance().load_mesh(tile_index * lod_count + lod, m_height_map_path + "_tile", geometry.vertices,
+                                                     geometry.indices, {}, m_draw_type, material);
+}
+
+u32 Terrain::select_lod(Tile const& tile, glm::vec3 const& camera_position)
+{
+    glm::vec3 const closest_point = glm::clamp(camera_position, tile.bounds.min, tile.bounds.max);
+    float const distance = glm::distance(camera_position, closest_point);
+
+    u32 lod = 0;
+    float lod_end = lod_distance;
+
+    while (lod < lod_count - 1 && distance > lod_end)
+    {
+        lod += 1;
+        lod_end *= 2.0f;
+    }
+
+    return lod;
+}
+
+std::shared_ptr<Mesh> Terrain::get_closest_lod(Tile const& tile, u32 const lod)
+{
+    for (u32 coarser = lod; coarser < lod_count; ++coarser)
+    {
+        if (tile.lods[coarser] != nullptr)
+            return tile.lods[coarser];
+    }
+
+    for (u32 finer = lod; finer > 0; --finer)
+    {
+        if (tile.lods[finer - 1] != nullptr)
+            return tile.lods[finer - 1];
+    }
+
+    return nullptr;
+}
+
+Terrain::TileGeometry Terrain::build_tile_geometry(std::shared_ptr<HeightMap const> const height_map, u32 const first_x,
+                                                   u32 const first_z, u32 const size_x, u32 const size_z, u32 const lod)
+{
+    u32 const step = 1u << lod;
+    u32 const samples_x = (size_x + step - 1) / step + 1;
+    u32 const samples_z = (size_z + step - 1) / step + 1;
+
+    TileGeometry geometry = {};
+    geometry.vertices.reserve(samples_x * samples_z + 2 * (samples_x + samples_z));
+    geometry.indices.reserve((samples_x - 1) * (samples_z - 1) * 6 + 4 * (samples_x + samples_z) * 6);
+
+    float const last_x = static_cast<float>(height_map->width - 1);
+    float const last_z = static_cast<float>(height_map->height - 1);
+
+    for (u32 i = 0; i < samples_z; ++i)
+    {
+        for (u32 k = 0; k < samples_x; ++k)
+        {
+            // Last samples are clamped to the tile edge, so edges of all levels line up at tile corners
+            u32 const x = first_x + std::min(k * step, size_x);
+            u32 const z = first_z + std::min(i * step, size_z);
+
+            geometry.vertices.push_back({height_map->get_position(x, z), height_map->get_normal(x, z),
+                                         glm::vec2(static_cast<float>(x) / last_x, static_cast<float>(z) / last_z)});
+        }
+    }
+
+    for (u32 i = 0; i < samples_z - 1; ++i)
+    {
+        for (u32 k = 0; k < samples_x - 1; ++k)
+        {
+            u32 const top_left = k + samples_x * i;
+            u32 const top_right = top_left + 1;
+            u32 const bottom_left = top_left + samples_x;
+            u32 const bottom_right = bottom_left + 1;
+
+            geometry.indices.insert(geometry.indices.end(), {top_left, bottom_left, top_right, top_right, bottom_left, bottom_right});
+        }
+    }
+
+    // Skirts are seen from both sides depending on which neighbour has a coarser level, so they are drawn double sided
+    auto const add_skirt = [&](u32 const first, u32 const count, u32 const stride) {
+        u32 const first_skirt_vertex = static_cast<u32>(geometry.vertices.size());
+
+        for (u32 i = 0; i < count; ++i)
+        {
+            Vertex skirt_vertex = geometry.vertices[first + i * stride];
+            skirt_vertex.position.y -= skirt_depth;
+            geometry.vertices.push_back(skirt_vertex);
+        }
+
+        for (u32 i = 0; i < count - 1; ++i)
+        {
+            u32 const top_a = first + i * stride;
+            u32 const top_b = first + (i + 1) * stride;
+            u32 const bottom_a = first_skirt_vertex + i;
+            u32 const bottom_b = bottom_a + 1;
+
+            geometry.indices.insert(geometry.indices.end(), {top_a, top_b, bottom_a, top_b, bottom_b, bottom_a, top_a, bottom_a, top_b,
+                                                             top_b, bottom_a, bottom_b});
+        }
+    };
+
+    add_skirt(0, samples_x, 1);
+    add_skirt(samples_x * (samples_z - 1), samples_x, 1);
+    add_skirt(0, samples_z, samples_x);
+    add_skirt(samples_x - 1, samples_z, samples_x);
+
+    return geometry;
+}
+
 #if EDITOR
 void Terrain::draw_editor()
 {
     Model::draw_editor();
 
+    if (m_use_chunks)
+    {
+        ImGui::DragFloat("LOD distance", &lod_distance, 1.0f, 1.0f, 10000.0f);
+        ImGui::Text("Tiles: %u, building: %u", static_cast<u32>(m_tiles.size()), static_cast<u32>(m_pending_builds.size()));
+    }
 }
 #endif
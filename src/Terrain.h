@@ -1,6 +1,9 @@
 #pragma once
 
+#include <array>
+#include <future>
 #include <string>
+#include <vector>
 
 #include "Model.h"
 
@@ -15,21 +18,107 @@ public:
     static std::shared_ptr<Terrain> create(std::shared_ptr<Material> const& material, bool const use_gpu,
                                            std::string const& height_map_path = "");
 
+    // Terrain split into tiles of tile_size quads. Every tile is culled on its own and drawn with a level of detail chosen
+    // by its distance to the main camera. Levels of detail are built lazily on worker threads, only the coarsest one
+    // of every tile is built upfront.
+    static std::shared_ptr<Terrain> create_chunked(std::shared_ptr<Material> const& material, std::string const& height_map_path);
+
     explicit Terrain(AK::Badge<Terrain>, std::shared_ptr<Material> const& material, bool const use_gpu,
-                     std::string const& height_map_path = "");
+                     std::string const& height_map_path = "", bool const use_chunks = false);
 
     virtual void draw() const override;
 
     virtual void prepare() override;
 
+    virtual void calculate_bounding_box() override;
+    virtual void adjust_bounding_box() override;
+    virtual BoundingBox get_adjusted_bounding_box(glm::mat4 const& model_matrix) const override;
+    virtual bool is_cullable() const override;
+
+    // Every level of detail halves the resolution of the previous one
+    inline static u32 constexpr lod_count = 4;
+    inline static u32 constexpr tile_size = 64;
+
+    // Distance from the main camera at which tiles switch from the most detailed level, doubled for every next level
+    inline static float lod_distance = 64.0f;
+
 private:
+    struct HeightMap
+    {
+        u32 width = 0;
+        u32 height = 0;
+        std::vector<float> heights = {};
+
+        [[nodiscard]] float get_height(i32 const x, i32 const z) const;
+        [[nodiscard]] glm::vec3 get_position(u32 const x, u32 const z) const;
+        [[nodiscard]] glm::vec3 get_normal(u32 const x, u32 const z) const;
+    };
+
+    struct TileGeometry
+    {
+        std::vector<Vertex> vertices = {};
+        std::vector<u32> indices = {};
+    };
+
+    struct Tile
+    {
+        u32 first_x = 0;
+        u32 first_z = 0;
+        u32 size_x = 0;
+        u32 size_z = 0;
+
+        BoundingBox local_bounds = {};
+        BoundingBox bounds = {};
+
+        std::array<std::shared_ptr<Mesh>, lod_count> lods = {};
+        std::array<bool, lod_count> is_lod_pending = {};
+    };
+
+    struct PendingBuild
+    {
+        u32 tile_index = 0;
+        u32 lod = 0;
+        std::future<TileGeometry> geometry = {};
+    };
+
     [[nodiscard]] std::shared_ptr<Mesh> create_terrain_from_height_map_gpu() const;
     [[nodiscard]] std::shared_ptr<Mesh> create_terrain_from_height_map();
 
+    [[nodiscard]] static std::shared_ptr<HeightMap const> load_height_map(std::string const& path);
+
+    void create_tiles();
+    void draw_tiles() const;
+
+    // Meshes are created on the main thread, once worker threads finish building their geometry
+    void collect_pending_builds() const;
+    void request_tile_lod(u32 const tile_index, u32 const lod) const;
+    [[nodiscard]] std::shared_ptr<Mesh> create_tile_mesh(u32 const tile_index, u32 const lod, TileGeometry const& geometry) const;
+
+    [[nodiscard]] static u32 select_lod(Tile const& tile, glm::vec3 const& camera_position);
+
+    // Wanted level if it's built, otherwise the closest built one, preferring coarser levels
+    [[nodiscard]] static std::shared_ptr<Mesh> get_closest_lod(Tile const& tile, u32 const lod);
+
+    // Tile grid sampled every 2^lod texels, with skirts hanging from its edges to hide cracks between tiles of different levels
+    [[nodiscard]] static TileGeometry build_tile_geometry(std::shared_ptr<HeightMap const> const height_map, u32 const first_x,
+                                                          u32 const first_z, u32 const size_x, u32 const size_z, u32 const lod);
+
     bool m_use_gpu = true;
+    bool m_use_chunks = false;
 
     u32 m_strips_count = 0;
     u32 m_vertices_per_strip = 0;
 
     std::string m_height_map_path;
+
+    std::shared_ptr<HeightMap const> m_height_map = {};
+    mutable std::vector<Tile> m_tiles = {};
+    mutable std::vector<PendingBuild> m_pending_builds = {};
+
+    // Builds running on worker threads at the same time
+    inline static u32 constexpr max_pending_builds = 4;
+
+    inline static float constexpr y_scale = 64.0f / 256.0f;
+    inline static float constexpr y_shift = 16.0f;
+    inline static float constexpr skirt_depth = 2.0f;
 };
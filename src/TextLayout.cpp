@@ -0,0 +1,197 @@
+#include "TextLayout.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "GlyphAtlas.h"
+
+TextLayout TextLayout::create(GlyphAtlas const& atlas, std::string_view const text, u16 const flags)
+{
+    struct Line
+    {
+        u32 first_glyph = 0;
+        float width = 0.0f;
+    };
+
+    TextLayout layout = {};
+    layout.glyphs.reserve(text.size());
+
+    std::vector<Line> lines = {{}};
+
+    glm::vec2 pen = {0.0f, atlas.get_ascent()};
+    u32 previous_codepoint = 0;
+
+    size_t offset = 0;
+    while (offset < text.size())
+    {
+        u32 const codepoint = decode_utf8(text, offset);
+
+        if (codepoint == '\r')
+            continue;
+
+        if (codepoint == '\n')
+        {
+            lines.back().width = pen.x;
+            lines.push_back({static_cast<u32>(layout.glyphs.size()), 0.0f});
+
+            pen = {0.0f, pen.y + atlas.get_line_height()};
+            previous_codepoint = 0;
+            continue;
+        }
+
+        if (previous_codepoint != 0)
+            pen.x += atlas.get_kerning(previous_codepoint, codepoint);
+
+        Glyph const& glyph = atlas.get_glyph(codepoint);
+
+        // Whitespace only moves the pen
+        if (glyph.max.x > glyph.min.x && glyph.max.y > glyph.min.y)
+            layout.glyphs.push_back({pen + glyph.min, pen + glyph.max, glyph.uv_min, glyph.uv_max});
+
+        pen.x += glyph.advance;
+        previous_codepoint = codepoint;
+    }
+
+    lines.back().width = pen.x;
+
+    layout.line_count = static_cast<u32>(lines.size());
+    layout.size.x = std::ranges::max(lines, {}, &Line::width).width;
+    layout.size.y = static_cast<float>(lines.size()) * atlas.get_line_height();
+
+    glm::vec2 anchor_offset = {0.0f, 0.0f};
+
+    if (flags & TextFlags::Center)
+        anchor_offset.x = -layout.size.x * 0.5f;
+    else if (flags & TextFlags::Right)
+        anchor_offset.x = -layout.size.x;
+
+    if (flags & TextFlags::VerticalCenter)
+        anchor_offset.y = -layout.size.y * 0.5f;
+    else if (flags & TextFlags::Bottom)
+        anchor_offset.y = -layout.size.y;
+
+    for (u32 i = 0; i < lines.size(); ++i)
+    {
+        u32 const end_glyph = i + 1 < lines.size() ? lines[i + 1].first_glyph : static_cast<u32>(layout.glyphs.size());
+
+        glm::vec2 offset = anchor_offset;
+
+        if (flags & TextFlags::Center)
+            offset.x += (layout.size.x - lines[i].width) * 0.5f;
+        else if (flags & TextFlags::Right)
+            offset.x += layout.size.x - lines[i].width;
+
+        for (u32 glyph = lines[i].first_glyph; glyph < end_glyph; ++glyph)
+        {
+            layout.glyphs[glyph].min += offset;
+            layout.glyphs[glyph].max += offset;
+        }
+    }
+
+    return layout;
+}
+
+u32 TextLayout::decode_utf8(std::string_view const text, size_t& offset)
+{
+    u32 constexpr replacement_character = 0xFFFD;
+
+    u8 const lead = static_cast<u8>(text[offset]);
+
+    u32 length = 0;
+    u32 codepoint = 0;
+
+    if (lead < 0x80)
+    {
+        offset += 1;
+        return lead;
+    }
+
+    if ((lead & 0xE0) == 0xC0)
+    {
+        length = 2;
+        codepoint = lead & 0x1F;
+    }
+    else if ((lead & 0xF0) == 0xE0)
+    {
+        length = 3;
+        codepoint = lead & 0x0F;
+    }
+    else if ((lead & 0xF8) == 0xF0)
+    {
+        length = 4;
+        codepoint = lead & 0x07;
+    }
+    else
+    {
+        offset += 1;
+        return replacement_character;
+    }
+
+    if (offset + length > text.size())
+    {
+        offset += 1;
+        return replacement_character;
+    }
+
+    for (u32 i = 1; i < length; ++i)
+    {
+        u8 const continuation = static_cast<u8>(text[offset + i]);
+
+        if ((continuation & 0xC0) != 0x80)
+        {
+            offset += 1;
+            return replacement_character;
+        }
+
+        codepoint = (codepoint << 6) | (continuation & 0x3F);
+    }
+
+    offset += length;
+
+    // Overlong encodings, surrogates and codepoints past the last one
+    u32 constexpr min_codepoints[] = {0, 0, 0x80, 0x800, 0x10000};
+    if (codepoint < min_codepoints[length] || (codepoint >= 0xD800 && codepoint <= 0xDFFF) || codepoint > 0x10FFFF)
+        return replacement_character;
+
+    return codepoint;
+}
+
+std::shared_ptr<TextLayout const> TextLayoutCache::get(std::shared_ptr<GlyphAtlas> const& atlas, std::string const& text,
+                                                       u16 const flags)
+{
+    Key key = {atlas, text, static_cast<u16>(flags & TextFlags::AlignmentMask)};
+
+    if (auto const it = m_layouts.find(key); it != m_layouts.end())
+        return it->second;
+
+    if (m_layouts.size() >= max_cached_layouts)
+        drop_unused_layouts();
+
+    std::shared_ptr<TextLayout const> layout = std::make_shared<TextLayout>(TextLayout::create(*atlas, text, key.flags));
+    m_layouts.emplace(std::move(key), layout);
+
+    return layout;
+}
+
+void TextLayoutCache::clear()
+{
+    m_layouts.clear();
+}
+
+u32 TextLayoutCache::get_size() const
+{
+    return static_cast<u32>(m_layouts.size());
+}
+
+size_t TextLayoutCache::KeyHash::operator()(Key const& key) const
+{
+    size_t const text_hash = std::hash<std::string> {}(key.text);
+    size_t const atlas_hash = std::hash<GlyphAtlas const*> {}(key.atlas.get());
+
+    return text_hash ^ (atlas_hash + 0x9e3779b9 + (text_hash << 6) + (text_hash >> 2)) ^ key.flags;
+}
+
+void TextLayoutCache::drop_unused_layouts()
+{
+    std::erase_if(m_layouts, [](auto const& entry) { return entry.second.use_count() == 1; });
+}
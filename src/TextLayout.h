@@ -0,0 +1,92 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "AK/Types.h"
+
+class GlyphAtlas;
+
+// Alignment of a text relative to its anchor. Values are the same as the alignment flags of FW1, which drew screen texts before,
+// so flags saved in scenes keep their meaning.
+namespace TextFlags
+{
+
+inline u16 constexpr Left = 0x0;
+inline u16 constexpr Center = 0x1;
+inline u16 constexpr Right = 0x2;
+inline u16 constexpr Top = 0x0;
+inline u16 constexpr VerticalCenter = 0x4;
+inline u16 constexpr Bottom = 0x8;
+
+inline u16 constexpr AlignmentMask = Center | Right | VerticalCenter | Bottom;
+
+}
+
+// Quad of a single glyph in pixels, relative to the anchor of the text, with y pointing down
+struct LayoutGlyph
+{
+    glm::vec2 min = {};
+    glm::vec2 max = {};
+    glm::vec2 uv_min = {};
+    glm::vec2 uv_max = {};
+};
+
+// Glyph quads of a whole text, laid out once and drawn every frame until the text changes.
+// Only depends on the glyph atlas, so it doesn't need a window or a renderer.
+struct TextLayout
+{
+    // Text is UTF-8, lines are separated by '\n'. Codepoints without a glyph in the atlas are drawn as its replacement glyph.
+    // Lines are aligned to each other and the whole text to its anchor, as given by the alignment flags.
+    [[nodiscard]] static TextLayout create(GlyphAtlas const& atlas, std::string_view const text, u16 const flags);
+
+    // Returns the codepoint starting at the offset and moves the offset past it. Invalid sequences are skipped byte by byte
+    // and returned as U+FFFD.
+    [[nodiscard]] static u32 decode_utf8(std::string_view const text, size_t& offset);
+
+    std::vector<LayoutGlyph> glyphs = {};
+
+    // Width of the widest line and height of all lines
+    glm::vec2 size = {};
+    u32 line_count = 0;
+};
+
+// Layouts shared by all texts with the same string, atlas and alignment. Texts only ask for a layout when they change,
+// e.g. a clock only once per second, and get an already laid out one if any other text used the same string.
+// Layouts nobody holds anymore are dropped once the cache grows past max_cached_layouts.
+class TextLayoutCache
+{
+public:
+    [[nodiscard]] std::shared_ptr<TextLayout const> get(std::shared_ptr<GlyphAtlas> const& atlas, std::string const& text,
+                                                        u16 const flags);
+
+    void clear();
+
+    [[nodiscard]] u32 get_size() const;
+
+    inline static u32 constexpr max_cached_layouts = 256;
+
+private:
+    struct Key
+    {
+        std::shared_ptr<GlyphAtlas> atlas = {};
+        std::string text = {};
+        u16 flags = 0;
+
+        bool operator==(Key const& other) const = default;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(Key const& key) const;
+    };
+
+    void drop_unused_layouts();
+
+    std::unordered_map<Key, std::shared_ptr<TextLayout const>, KeyHash> m_layouts = {};
+};
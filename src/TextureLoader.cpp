@@ -42,3 +42,12 @@ std::shared_ptr<Texture> TextureLoader::load_cubemap(std::string const& path, Te
     return std::make_shared<Texture>(id, width, height, number_of_components, type, texture_2d, shader_resource_view, image_sampler_state,
                                      path);
 }
+
+std::shared_ptr<Texture> TextureLoader::load_texture_from_memory(std::string const& name, u8 const* data, u32 const width,
+                                                                 u32 const height, TextureSettings const& settings)
+{
+    auto const [id, texture_width, texture_height, number_of_components, texture_2d, shader_resource_view, image_sampler_state] =
+        texture_from_memory(data, width, height, settings);
+    return std::make_shared<Texture>(id, texture_width, texture_height, number_of_components, TextureType::Diffuse, texture_2d,
+                                     shader_resource_view, image_sampler_state, name);
+}
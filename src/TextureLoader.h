@@ -45,10 +45,15 @@ private:
                                                         TextureSettings const& settings = {});
     [[nodiscard]] std::shared_ptr<Texture> load_cubemap(std::string const& path, TextureType const type,
                                                         TextureSettings const& settings = {});
+    [[nodiscard]] std::shared_ptr<Texture> load_texture_from_memory(std::string const& name, u8 const* data, u32 const width,
+                                                                    u32 const height, TextureSettings const& settings = {});
 
     TextureData virtual texture_from_file(std::string const& path, TextureSettings const settings) = 0;
     TextureData virtual cubemap_from_files(std::vector<std::string> const& paths, TextureSettings const settings) = 0;
     TextureData virtual cubemap_from_file(std::string const& path, TextureSettings const settings) = 0;
 
+    // Data is 8 bit RGBA, uploaded as is without any color space conversion. First row is the top of the texture.
+    TextureData virtual texture_from_memory(u8 const* data, u32 const width, u32 const height, TextureSettings const settings) = 0;
+
     friend class ResourceManager;
 };
@@ -138,6 +138,61 @@ TextureData TextureLoaderDX11::cubemap_from_file(std::string const& path, Textur
     return texture_data;
 }
 
+TextureData TextureLoaderDX11::texture_from_memory(u8 const* data, u32 const width, u32 const height, TextureSettings const settings)
+{
+    auto const device = RendererDX11::get_instance_dx11()->get_device();
+    u32 constexpr number_of_components = 4;
+
+    // Unlike images loaded from files, the data is not treated as sRGB
+    D3D11_TEXTURE2D_DESC image_texture_desc = {};
+    image_texture_desc.Width = width;
+    image_texture_desc.Height = height;
+    image_texture_desc.MipLevels = 1;
+    image_texture_desc.ArraySize = 1;
+    image_texture_desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    image_texture_desc.SampleDesc.Count = 1;
+    image_texture_desc.SampleDesc.Quality = 0;
+    image_texture_desc.Usage = D3D11_USAGE_IMMUTABLE;
+    image_texture_desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    D3D11_SUBRESOURCE_DATA image_subresource_data = {};
+    image_subresource_data.pSysMem = data;
+    image_subresource_data.SysMemPitch = width * number_of_components;
+
+    ID3D11Texture2D* image_texture = nullptr;
+    HRESULT hr = device->CreateTexture2D(&image_texture_desc, &image_subresource_data, &image_texture);
+    assert(SUCCEEDED(hr));
+
+    ID3D11ShaderResourceView* texture_resource = nullptr;
+    hr = device->CreateShaderResourceView(image_texture, nullptr, &texture_resource);
+    assert(SUCCEEDED(hr));
+
+    D3D11_SAMPLER_DESC image_sampler_desc = {};
+    image_sampler_desc.Filter = convert_filtering_mode(settings.filtering_min, settings.filtering_max, settings.filtering_mipmap);
+    image_sampler_desc.AddressU = convert_wrap_mode(settings.wrap_mode_x);
+    image_sampler_desc.AddressV = convert_wrap_mode(settings.wrap_mode_y);
+    image_sampler_desc.AddressW = convert_wrap_mode(settings.wrap_mode_z);
+    image_sampler_desc.MipLODBias = 0.0f;
+    image_sampler_desc.MaxAnisotropy = 1;
+    image_sampler_desc.ComparisonFunc = D3D11_COMPARISON_NEVER;
+    image_sampler_desc.MinLOD = 0;
+    image_sampler_desc.MaxLOD = FLT_MAX;
+
+    ID3D11SamplerState* image_sampler_state = nullptr;
+    hr = device->CreateSamplerState(&image_sampler_desc, &image_sampler_state);
+    assert(SUCCEEDED(hr));
+
+    TextureData texture_data;
+    texture_data.id = 0;
+    texture_data.texture_2d = image_texture;
+    texture_data.shader_resource_view = texture_resource;
+    texture_data.image_sampler_state = image_sampler_state;
+    texture_data.height = height;
+    texture_data.width = width;
+    texture_data.number_of_components = number_of_components;
+    return texture_data;
+}
+
 D3D11_TEXTURE_ADDRESS_MODE TextureLoaderDX11::convert_wrap_mode(TextureWrapMode const wrap_mode)
 {
     switch (wrap_mode)
@@ -119,6 +119,38 @@ TextureData TextureLoaderGL::cubemap_from_file(std::string const& path, TextureS
     return {};
 }
 
+TextureData TextureLoaderGL::texture_from_memory(u8 const* data, u32 const width, u32 const height, TextureSettings const settings)
+{
+    u32 texture_id;
+    glGenTextures(1, &texture_id);
+
+    glBindTexture(GL_TEXTURE_2D, texture_id);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, static_cast<GLsizei>(width), static_cast<GLsizei>(height), 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                 data);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    if (settings.generate_mipmaps)
+    {
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
+    else
+    {
+        // Otherwise mipmap filtering would sample levels that don't exist and the texture would be incomplete
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, convert_wrap_mode(settings.wrap_mode_x));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, convert_wrap_mode(settings.wrap_mode_y));
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, convert_filtering_mode(settings.filtering_min, settings.filtering_mipmap));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, convert_filtering_mode(settings.filtering_max, settings.filtering_mipmap));
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    return {texture_id, width, height, 4};
+}
+
 GLint TextureLoaderGL::convert_wrap_mode(TextureWrapMode const wrap_mode)
 {
     switch (wrap_mode)
@@ -13,6 +13,7 @@ private:
     virtual TextureData texture_from_file(std::string const& path, TextureSettings const settings) override;
     virtual TextureData cubemap_from_files(std::vector<std::string> const& paths, TextureSettings const settings) override;
     virtual TextureData cubemap_from_file(std::string const& path, TextureSettings const settings) override;
+    virtual TextureData texture_from_memory(u8 const* data, u32 const width, u32 const height, TextureSettings const settings) override;
 
     static GLint convert_wrap_mode(TextureWrapMode const wrap_mode);
     static GLint convert_filtering_mode(TextureFiltering const texture_filtering, TextureFiltering const mipmap_filtering);
@@ -0,0 +1,116 @@
+#include "UIBatcher.h"
+
+#include <algorithm>
+#include <array>
+
+#include <glm/vec4.hpp>
+
+#include "Material.h"
+#include "TextLayout.h"
+#include "Texture.h"
+
+void UIBatcher::clear()
+{
+    m_quads.clear();
+    m_vertices.clear();
+    m_batches.clear();
+    m_groups.clear();
+}
+
+void UIBatcher::add_quad(i32 const render_order, std::shared_ptr<Texture> const& texture, glm::mat4 const& model)
+{
+    // Same quad as the meshes of UI drawables, which the UI shader transforms by the model matrix only
+    Quad quad = {render_order, texture.get()};
+    quad.corners[0] = {glm::vec3(model * glm::vec4(-1.0f, -1.0f, 0.0f, 1.0f)), {0.0f, 0.0f}};
+    quad.corners[1] = {glm::vec3(model * glm::vec4(1.0f, -1.0f, 0.0f, 1.0f)), {1.0f, 0.0f}};
+    quad.corners[2] = {glm::vec3(model * glm::vec4(1.0f, 1.0f, 0.0f, 1.0f)), {1.0f, 1.0f}};
+    quad.corners[3] = {glm::vec3(model * glm::vec4(-1.0f, 1.0f, 0.0f, 1.0f)), {0.0f, 1.0f}};
+
+    m_quads.emplace_back(quad);
+}
+
+void UIBatcher::add_text(i32 const render_order, std::shared_ptr<Texture> const& texture, TextLayout const& layout,
+                         glm::vec2 const& anchor, float const scale, u32 const color, glm::vec2 const& screen_size)
+{
+    glm::vec2 const to_ndc = glm::vec2(2.0f, -2.0f) / screen_size;
+
+    for (auto const& glyph : layout.glyphs)
+    {
+        // Layouts point y down, same as rows of the atlas
+        glm::vec2 const min = (anchor + glyph.min * scale) * to_ndc + glm::vec2(-1.0f, 1.0f);
+        glm::vec2 const max = (anchor + glyph.max * scale) * to_ndc + glm::vec2(-1.0f, 1.0f);
+
+        Quad quad = {render_order, texture.get()};
+        quad.corners[0] = {{min.x, max.y, 0.0f}, {glyph.uv_min.x, glyph.uv_max.y}, color, 1};
+        quad.corners[1] = {{max.x, max.y, 0.0f}, glyph.uv_max, color, 1};
+        quad.corners[2] = {{max.x, min.y, 0.0f}, {glyph.uv_max.x, glyph.uv_min.y}, color, 1};
+        quad.corners[3] = {{min.x, min.y, 0.0f}, glyph.uv_min, color, 1};
+
+        m_quads.emplace_back(quad);
+    }
+}
+
+void UIBatcher::build(std::shared_ptr<Shader> const& shader)
+{
+    // Quads of a render order keep the order they were added in, so overlapping ones are always drawn the same way around.
+    // Consecutive quads sharing a texture still end up in one batch.
+    std::ranges::stable_sort(m_quads, {}, &Quad::render_order);
+
+    // Two triangles of a quad, from its corners
+    std::array<u32, vertices_per_quad> constexpr quad_corners = {0, 1, 2, 0, 2, 3};
+
+    m_vertices.reserve(m_quads.size() * vertices_per_quad);
+
+    for (auto const& quad : m_quads)
+    {
+        if (m_groups.empty() || m_groups.back().material->get_render_order() != quad.render_order)
+        {
+            auto& material = m_materials[quad.render_order];
+
+            if (material == nullptr)
+            {
+                material = Material::create(shader, quad.render_order);
+                material->casts_shadows = false;
+            }
+
+            m_groups.push_back({material, static_cast<u32>(m_batches.size()), 0, static_cast<u32>(m_vertices.size()), 0});
+        }
+
+        UIGroup& group = m_groups.back();
+
+        if (group.batch_count == 0 || m_batches.back().texture != quad.texture)
+        {
+            m_batches.push_back({quad.texture, group.vertex_count, 0});
+            group.batch_count += 1;
+        }
+
+        for (u32 const corner : quad_corners)
+        {
+            m_vertices.emplace_back(quad.corners[corner]);
+        }
+
+        m_batches.back().vertex_count += vertices_per_quad;
+        group.vertex_count += vertices_per_quad;
+    }
+}
+
+std::span<UIGroup const> UIBatcher::get_groups() const
+{
+    return m_groups;
+}
+
+UIGroup const* UIBatcher::find_group(std::shared_ptr<Material> const& material) const
+{
+    auto const it = std::ranges::find(m_groups, material, &UIGroup::material);
+    return it != m_groups.end() ? &*it : nullptr;
+}
+
+std::span<UIVertex const> UIBatcher::get_vertices(UIGroup const& group) const
+{
+    return std::span<UIVertex const>(m_vertices).subspan(group.first_vertex, group.vertex_count);
+}
+
+std::span<UIBatch const> UIBatcher::get_batches(UIGroup const& group) const
+{
+    return std::span<UIBatch const>(m_batches).subspan(group.first_batch, group.batch_count);
+}
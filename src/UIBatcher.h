@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include "AK/Types.h"
+
+class Material;
+class Shader;
+struct Texture;
+struct TextLayout;
+
+// Position is already in normalized device coordinates. Colors are packed as 0xAABBGGRR, same as debug colors.
+// Vertices of quads are tinted by their color, vertices of text take their color as is and only coverage from the texture.
+struct UIVertex
+{
+    glm::vec3 position = {};
+    glm::vec2 uv = {};
+    u32 color = 0xffffffff;
+    u32 is_text = 0;
+};
+
+// Consecutive quads sharing a texture, drawn with a single draw call. First vertex is relative to the group of the batch.
+struct UIBatch
+{
+    Texture const* texture = nullptr;
+    u32 first_vertex = 0;
+    u32 vertex_count = 0;
+};
+
+// Batches of a single render order. The material is only used to place the group in the render queue, between other drawables
+// of the same pass, so UI drawn one by one (e.g. screen texts) still ends up above or below the batched quads.
+struct UIGroup
+{
+    std::shared_ptr<Material> material = {};
+    u32 first_batch = 0;
+    u32 batch_count = 0;
+    u32 first_vertex = 0;
+    u32 vertex_count = 0;
+};
+
+// Collects screen space quads of UI drawables (buttons, panels, sprites drawn with the UI shader and glyphs of screen texts) every frame.
+// Quads are grouped by their render order, so a whole group is uploaded into one dynamic vertex buffer and drawn with a draw call
+// per run of quads sharing a texture, without any per object constant uploads.
+// Quads of a group keep the order they were added in, e.g. glyphs of a text or all quads of an element end up in a single batch.
+class UIBatcher
+{
+public:
+    void clear();
+    void add_quad(i32 const render_order, std::shared_ptr<Texture> const& texture, glm::mat4 const& model);
+
+    // Anchor is given in pixels from the top left corner of the screen, glyphs of the layout are scaled around it
+    void add_text(i32 const render_order, std::shared_ptr<Texture> const& texture, TextLayout const& layout, glm::vec2 const& anchor,
+                  float const scale, u32 const color, glm::vec2 const& screen_size);
+
+    // Sorts all quads added this frame and writes their vertices. Materials of groups are created with the given shader
+    // the first time their render order is used and then kept, so render queue packets of groups are the same every frame.
+    void build(std::shared_ptr<Shader> const& shader);
+
+    [[nodiscard]] std::span<UIGroup const> get_groups() const;
+    [[nodiscard]] UIGroup const* find_group(std::shared_ptr<Material> const& material) const;
+
+    [[nodiscard]] std::span<UIVertex const> get_vertices(UIGroup const& group) const;
+    [[nodiscard]] std::span<UIBatch const> get_batches(UIGroup const& group) const;
+
+    inline static u32 constexpr vertices_per_quad = 6;
+
+private:
+    // Corners go counter-clockwise, starting at the bottom left one
+    struct Quad
+    {
+        i32 render_order = 0;
+        Texture const* texture = nullptr;
+        std::array<UIVertex, 4> corners = {};
+    };
+
+    std::vector<Quad> m_quads = {};
+    std::vector<UIVertex> m_vertices = {};
+    std::vector<UIBatch> m_batches = {};
+    std::vector<UIGroup> m_groups = {};
+
+    std::unordered_map<i32, std::shared_ptr<Material>> m_materials = {};
+};
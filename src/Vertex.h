@@ -3,9 +3,29 @@
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 
+#include "AK/Types.h"
+
 struct Vertex
 {
     glm::vec3 position;
     glm::vec3 normal;
     glm::vec2 texture_coordinates;
 };
+
+// Compressed alternative to Vertex, decoded in the vertex shader.
+// Position is quantized to 16 bits per axis relative to the mesh bounds (R16G16B16A16_UNORM, w is unused),
+// normal is octahedral encoded (R16G16_SNORM) and texture coordinates are half floats (R16G16_FLOAT).
+struct PackedVertex
+{
+    u64 position;
+    u32 normal;
+    u32 texture_coordinates;
+};
+
+static_assert(sizeof(PackedVertex) == 16);
+
+enum class VertexFormat : u8
+{
+    Full,
+    Packed,
+};
@@ -1,11 +1,15 @@
 #include "VertexBufferDX11.h"
 
-VertexBufferDX11::VertexBufferDX11(ID3D11Device* device, Vertex const* data, u32 const vertices_count) : m_buffer_size(vertices_count)
+VertexBufferDX11::VertexBufferDX11(ID3D11Device* device, Vertex const* data, u32 const vertices_count)
+    : VertexBufferDX11(device, data, vertices_count, sizeof(Vertex))
 {
-    m_stride = sizeof(Vertex);
+}
 
+VertexBufferDX11::VertexBufferDX11(ID3D11Device* device, void const* data, u32 const vertices_count, u32 const stride)
+    : m_stride(stride), m_buffer_size(vertices_count)
+{
     D3D11_BUFFER_DESC vertex_buffer_desc = {};
-    vertex_buffer_desc.ByteWidth = sizeof(Vertex) * vertices_count;
+    vertex_buffer_desc.ByteWidth = stride * vertices_count;
     vertex_buffer_desc.Usage = D3D11_USAGE_IMMUTABLE;
     vertex_buffer_desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
 
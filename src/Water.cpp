@@ -149,6 +149,12 @@ void Water::reprepare()
     prepare();
 }
 
+bool Water::is_cullable() const
+{
+    // Waves displace vertices in the vertex shader, so mesh bounds don't contain the whole surface
+    return false;
+}
+
 #if EDITOR
 void Water::draw_editor()
 {
@@ -336,6 +342,7 @@ void Water::set_constant_buffer() const
 
     HRESULT hr = renderer->get_device_context()->Map(m_constant_buffer_wave, 0, D3D11_MAP_WRITE_DISCARD, 0, &wave_buffer_resource);
     assert(SUCCEEDED(hr));
+    RendererStatistics::add_buffer_upload();
 
     CopyMemory(wave_buffer_resource.pData, &wave_buffer, sizeof(ConstantBufferWave));
 
@@ -345,6 +352,7 @@ void Water::set_constant_buffer() const
     D3D11_MAPPED_SUBRESOURCE water_buffer_resource = {};
     hr = renderer->get_device_context()->Map(m_constant_buffer_water, 0, D3D11_MAP_WRITE_DISCARD, 0, &water_buffer_resource);
     assert(SUCCEEDED(hr));
+    RendererStatistics::add_buffer_upload();
     CopyMemory(water_buffer_resource.pData, &m_ps_buffer, sizeof(ConstantBufferWater));
     renderer->get_device_context()->Unmap(m_constant_buffer_water, 0);
     renderer->get_device_context()->PSSetConstantBuffers(4, 1, &m_constant_buffer_water);
@@ -19,6 +19,8 @@ public:
     virtual void prepare() override;
     virtual void reprepare() override;
 
+    virtual bool is_cullable() const override;
+
 #if EDITOR
     virtual void draw_editor() override;
 #endif
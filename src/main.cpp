@@ -1,4 +1,9 @@
 #include "Engine.h"
+#include "EventBenchmark.h"
+#include "Renderer.h"
+
+#include <string>
+#include <string_view>
 
 #define FORCE_DEDICATED_GPU 1
 
@@ -17,8 +22,32 @@ extern "C"
 }
 #endif
 
-i32 main(i32, char**)
+i32 main(i32 const argc, char** argv)
 {
+    for (i32 i = 1; i < argc; ++i)
+    {
+        if (std::string_view(argv[i]) == "--benchmark" && i + 1 < argc)
+        {
+            Engine::benchmark_frames = static_cast<u32>(std::stoul(argv[++i]));
+
+            if (i + 1 < argc)
+            {
+                Engine::benchmark_statistics_path = argv[++i];
+            }
+        }
+        else if (std::string_view(argv[i]) == "--linear-culling")
+        {
+            Renderer::linear_culling = true;
+        }
+        else if (std::string_view(argv[i]) == "--benchmark-events")
+        {
+            // Next argument is only the output path when it isn't another option
+            bool const has_path = i + 1 < argc && argv[i + 1][0] != '-';
+            std::string const path = has_path ? argv[i + 1] : "./event_benchmark.csv";
+            return EventBenchmark::run(path) ? 0 : 1;
+        }
+    }
+
     if (auto const result = Engine::initialize(); result != 0)
         return result;
 
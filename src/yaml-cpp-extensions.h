@@ -15,6 +15,7 @@
 #include "DialogueObject.h"
 #include "FloatersManager.h"
 #include "SceneSerializer.h"
+#include "Sound.h"
 #include <Game/Factory.h>
 #include <Game/ShipSpawner.h>
 
@@ -337,6 +338,28 @@ struct convert<ConstantBufferWater>
     }
 };
 
+template<>
+struct convert<SoundLoadPolicy>
+{
+    static Node encode(SoundLoadPolicy const rhs)
+    {
+        Node node;
+        node.push_back(to_integral(rhs));
+        return node;
+    }
+
+    static bool decode(Node const& node, SoundLoadPolicy& rhs)
+    {
+        if (!node.IsScalar())
+        {
+            return false;
+        }
+
+        rhs = static_cast<SoundLoadPolicy>(node.as<int>());
+        return true;
+    }
+};
+
 template<>
 struct convert<FactoryType>
 {
@@ -740,6 +763,13 @@ inline Emitter& operator<<(YAML::Emitter& out, ColliderType2D const& v)
     return out;
 }
 
+inline Emitter& operator<<(YAML::Emitter& out, SoundLoadPolicy const& v)
+{
+    out << YAML::Flow;
+    out << to_integral(v);
+    return out;
+}
+
 inline Emitter& operator<<(YAML::Emitter& out, FactoryType const& v)
 {
     out << YAML::Flow;
@@ -0,0 +1,275 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include "BoundingVolumeHierarchy.h"
+#include "Bounds.h"
+#include "Frustum.h"
+#include "FrustumCuller.h"
+#include "Test.h"
+
+namespace
+{
+
+// Objects of the tree, also kept in a plain list so every query can be compared to testing all of them one by one
+class World
+{
+public:
+    explicit World(u32 const seed) : m_random(seed)
+    {
+    }
+
+    void insert()
+    {
+        u32 const id = static_cast<u32>(m_bounds.size());
+
+        m_bounds.emplace_back(make_random_box());
+        m_proxies.emplace_back(m_tree.insert(m_bounds[id], id));
+        m_is_alive.emplace_back(true);
+    }
+
+    void remove(u32 const id)
+    {
+        m_tree.remove(m_proxies[id]);
+        m_is_alive[id] = false;
+    }
+
+    bool move(u32 const id, glm::vec3 const offset)
+    {
+        m_bounds[id] = {m_bounds[id].min + offset, m_bounds[id].max + offset};
+        return m_tree.move(m_proxies[id], m_bounds[id]);
+    }
+
+    [[nodiscard]] BoundingBox make_random_box()
+    {
+        std::uniform_real_distribution<float> position_distribution(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> size_distribution(0.1f, 4.0f);
+
+        glm::vec3 const min = {position_distribution(m_random), position_distribution(m_random), position_distribution(m_random)};
+        glm::vec3 const size = {size_distribution(m_random), size_distribution(m_random), size_distribution(m_random)};
+
+        return {min, min + size};
+    }
+
+    [[nodiscard]] glm::vec3 make_random_point(float const range)
+    {
+        std::uniform_real_distribution<float> distribution(-range, range);
+        return {distribution(m_random), distribution(m_random), distribution(m_random)};
+    }
+
+    [[nodiscard]] u32 get_random_alive_id()
+    {
+        while (true)
+        {
+            u32 const id = m_random() % m_bounds.size();
+
+            if (m_is_alive[id])
+                return id;
+        }
+    }
+
+    template<typename Predicate>
+    [[nodiscard]] std::vector<u32> brute_force(Predicate&& predicate) const
+    {
+        std::vector<u32> ids = {};
+
+        for (u32 id = 0; id < m_bounds.size(); ++id)
+        {
+            if (m_is_alive[id] && predicate(m_bounds[id]))
+                ids.emplace_back(id);
+        }
+
+        return ids;
+    }
+
+    // Compares every kind of query with the brute force result
+    void check_queries()
+    {
+        std::vector<u32> ids = {};
+        auto const collect = [&](u32 const id) { ids.emplace_back(id); };
+        auto const sorted = [&] {
+            std::ranges::sort(ids);
+            return std::exchange(ids, {});
+        };
+
+        for (u32 i = 0; i < 10; ++i)
+        {
+            glm::vec3 const eye = make_random_point(100.0f);
+            glm::mat4 const projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.5f, 80.0f);
+            glm::mat4 const view = glm::lookAt(eye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+            Frustum const frustum = Frustum::from_projection_view(projection * view);
+
+            m_tree.query(frustum, collect);
+            CHECK(sorted() == brute_force([&](BoundingBox const& box) { return FrustumCuller::is_visible(box, frustum); }));
+
+            BoundingBox const query_box = {make_random_point(100.0f), 30.0f, 40.0f, 50.0f};
+
+            m_tree.query(query_box, collect);
+            CHECK(sorted() == brute_force([&](BoundingBox const& box) {
+                      return glm::all(glm::lessThanEqual(box.min, query_box.max)) && glm::all(glm::lessThanEqual(query_box.min, box.max));
+                  }));
+
+            glm::vec3 const center = make_random_point(100.0f);
+            float const radius = 25.0f;
+
+            m_tree.query_sphere(center, radius, collect);
+            CHECK(sorted() == brute_force([&](BoundingBox const& box) {
+                      glm::vec3 const closest = glm::clamp(center, box.min, box.max);
+                      return glm::dot(closest - center, closest - center) <= radius * radius;
+                  }));
+
+            glm::vec3 const origin = make_random_point(100.0f);
+            glm::vec3 const direction = glm::normalize(make_random_point(1.0f) + glm::vec3(0.01f));
+            float const max_distance = 150.0f;
+
+            std::vector<std::pair<u32, float>> hits = {};
+            m_tree.query_ray(origin, direction, max_distance, [&](u32 const id, float const distance) { hits.emplace_back(id, distance); });
+            std::ranges::sort(hits);
+
+            std::vector<std::pair<u32, float>> expected_hits = {};
+
+            for (u32 const id : brute_force([&](BoundingBox const&) { return true; }))
+            {
+                if (float distance = 0.0f; intersects_ray(origin, direction, max_distance, m_bounds[id], distance))
+                    expected_hits.emplace_back(id, distance);
+            }
+
+            CHECK(hits.size() == expected_hits.size());
+
+            for (u32 hit = 0; hit < std::min(hits.size(), expected_hits.size()); ++hit)
+            {
+                CHECK(hits[hit].first == expected_hits[hit].first);
+                CHECK(std::abs(hits[hit].second - expected_hits[hit].second) < 0.001f);
+            }
+        }
+
+        u32 const alive_count = static_cast<u32>(brute_force([](BoundingBox const&) { return true; }).size());
+        CHECK(m_tree.size() == alive_count);
+
+        // Tree is kept balanced, so its height only grows with the logarithm of the object count
+        if (alive_count > 1)
+            CHECK(m_tree.get_height() <= 2 * static_cast<i32>(std::ceil(std::log2(static_cast<float>(alive_count)))) + 1);
+
+        for (u32 id = 0; id < m_bounds.size(); ++id)
+        {
+            if (!m_is_alive[id])
+                continue;
+
+            CHECK(m_tree.get_data(m_proxies[id]) == id);
+            CHECK(m_tree.get_bounds(m_proxies[id]).min == m_bounds[id].min);
+            CHECK(m_tree.get_bounds(m_proxies[id]).max == m_bounds[id].max);
+        }
+    }
+
+private:
+    // Slab test, written separately from the tree on purpose
+    [[nodiscard]] static bool intersects_ray(glm::vec3 const& origin, glm::vec3 const& direction, float const max_distance,
+                                             BoundingBox const& box, float& distance)
+    {
+        float enter = 0.0f;
+        float exit = max_distance;
+
+        for (i32 axis = 0; axis < 3; ++axis)
+        {
+            float const t0 = (box.min[axis] - origin[axis]) / direction[axis];
+            float const t1 = (box.max[axis] - origin[axis]) / direction[axis];
+
+            enter = std::max(enter, std::min(t0, t1));
+            exit = std::min(exit, std::max(t0, t1));
+        }
+
+        distance = enter;
+        return enter <= exit;
+    }
+
+    std::mt19937 m_random;
+
+    BoundingVolumeHierarchy<u32> m_tree = {};
+    std::vector<BoundingBox> m_bounds = {};
+    std::vector<i32> m_proxies = {};
+    std::vector<bool> m_is_alive = {};
+};
+
+void test_insert()
+{
+    World world(21);
+
+    for (u32 i = 0; i < 1000; ++i)
+        world.insert();
+
+    world.check_queries();
+}
+
+void test_remove()
+{
+    World world(22);
+
+    for (u32 i = 0; i < 1000; ++i)
+        world.insert();
+
+    for (u32 i = 0; i < 600; ++i)
+        world.remove(world.get_random_alive_id());
+
+    world.check_queries();
+
+    // Nodes of removed objects are reused
+    for (u32 i = 0; i < 300; ++i)
+        world.insert();
+
+    world.check_queries();
+}
+
+void test_remove_all()
+{
+    World world(23);
+
+    for (u32 i = 0; i < 10; ++i)
+        world.insert();
+
+    for (u32 id = 0; id < 10; ++id)
+        world.remove(id);
+
+    world.check_queries();
+
+    world.insert();
+    world.check_queries();
+}
+
+void test_move()
+{
+    World world(24);
+
+    for (u32 i = 0; i < 1000; ++i)
+        world.insert();
+
+    // Moving within the fattened bounds only updates the exact bounds of the leaf
+    u32 const id = world.get_random_alive_id();
+    CHECK(!world.move(id, glm::vec3(BoundingVolumeHierarchy<u32>::fat_margin * 0.5f, 0.0f, 0.0f)));
+    CHECK(world.move(id, glm::vec3(50.0f, 0.0f, 0.0f)));
+
+    for (u32 frame = 0; frame < 10; ++frame)
+    {
+        for (u32 i = 0; i < 200; ++i)
+            (void)world.move(world.get_random_alive_id(), world.make_random_point(frame % 2 == 0 ? 0.2f : 30.0f));
+
+        world.check_queries();
+    }
+}
+
+}
+
+i32 main()
+{
+    Test::run("Queries after inserting match brute force", test_insert);
+    Test::run("Queries after removing match brute force", test_remove);
+    Test::run("Removing every object empties the tree", test_remove_all);
+    Test::run("Queries after moving match brute force", test_move);
+
+    return Test::get_exit_code();
+}
@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/mat4x4.hpp>
+
+#include "CommandList.h"
+#include "RenderQueue.h"
+#include "Test.h"
+
+namespace
+{
+
+// Submits packets straight to a backend, the way passes were drawn before command lists
+class DirectBackend final : public RenderQueueBackend
+{
+public:
+    DirectBackend(CommandListBackend& backend, std::span<glm::mat4 const> const model_matrices, glm::mat4 const& projection_view)
+        : m_backend(backend), m_model_matrices(model_matrices), m_projection_view(projection_view)
+    {
+    }
+
+    virtual void bind_shader(std::shared_ptr<Shader> const& shader) override
+    {
+        m_backend.bind_shader(shader);
+    }
+
+    virtual void bind_material(std::shared_ptr<Material> const& material) override
+    {
+        m_backend.bind_material(material);
+    }
+
+    virtual void unbind_material(std::shared_ptr<Material> const& material) override
+    {
+        m_backend.unbind_material(material);
+    }
+
+    virtual void draw(RenderPacket const& packet) override
+    {
+        if (packet.drawable == nullptr)
+        {
+            m_backend.draw_instanced(*packet.material);
+            return;
+        }
+
+        m_backend.draw(*packet.drawable, *packet.material,
+                       CommandList::make_object_constants(m_model_matrices[packet.push_index], m_projection_view));
+    }
+
+private:
+    CommandListBackend& m_backend;
+    std::span<glm::mat4 const> m_model_matrices;
+    glm::mat4 const& m_projection_view;
+};
+
+// Queue of a frame with a few shaders and materials shared by many drawables, instanced materials and transparent draws
+struct Frame
+{
+    explicit Frame(u32 const seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> depth_distribution(0.0f, 1.0f);
+
+        for (u32 i = 0; i < shader_count; ++i)
+            shaders.emplace_back(Test::make_fake_object<Shader>(i));
+
+        for (u32 i = 0; i < material_count; ++i)
+            materials.emplace_back(Test::make_fake_object<Material>(i));
+
+        for (u32 i = 0; i < drawable_count; ++i)
+            drawables.emplace_back(Test::make_fake_object<Drawable>(i));
+
+        projection_view = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f)
+                        * glm::lookAt(glm::vec3(0.0f, 2.0f, 5.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+        for (u32 i = 0; i < drawable_count; ++i)
+        {
+            u32 const material_id = random() % material_count;
+            u32 const shader_id = material_id % shader_count;
+            float const depth = depth_distribution(random);
+            RenderPass const pass = random() % 2 == 0 ? RenderPass::Geometry : RenderPass::Forward;
+
+            // Last materials are transparent, same as forward rendered materials drawn back-to-front
+            u64 const key = material_id >= material_count - 2
+                              ? RenderQueue::make_transparent_key(pass, 0, shader_id, material_id, depth)
+                              : RenderQueue::make_opaque_key(pass, 0, shader_id, material_id, i, depth);
+
+            model_matrices.resize(queue.size());
+            model_matrices.emplace_back(glm::translate(glm::mat4(1.0f), glm::vec3(static_cast<float>(i), depth, -depth)));
+
+            queue.push({key, &shaders[shader_id], &materials[material_id], &drawables[i]});
+        }
+
+        // Instanced materials are a single packet without a drawable
+        for (u32 i = 0; i < 3; ++i)
+        {
+            u64 const key = RenderQueue::make_opaque_key(RenderPass::Forward, 0, i, i, 0, 0.0f);
+            queue.push({key, &shaders[i], &materials[i]});
+        }
+
+        queue.sort();
+    }
+
+    inline static u32 constexpr shader_count = 4;
+    inline static u32 constexpr material_count = 10;
+    inline static u32 constexpr drawable_count = 500;
+
+    std::vector<std::shared_ptr<Shader>> shaders = {};
+    std::vector<std::shared_ptr<Material>> materials = {};
+    std::vector<std::shared_ptr<Drawable>> drawables = {};
+
+    std::vector<glm::mat4> model_matrices = {};
+    glm::mat4 projection_view = {};
+
+    RenderQueue queue = {};
+};
+
+std::string submit_directly(Frame const& frame, std::span<RenderPacket const> const packets)
+{
+    NullCommandListBackend backend = {};
+    DirectBackend direct_backend = {backend, frame.model_matrices, frame.projection_view};
+
+    RenderQueue::submit(packets, direct_backend);
+
+    return backend.get_log();
+}
+
+// Only the draws, as recording a pass in chunks binds the state again at the start of every chunk
+std::string get_draws(std::string const& log)
+{
+    std::istringstream stream(log);
+    std::string draws = {};
+
+    for (std::string line; std::getline(stream, line);)
+    {
+        if (line.starts_with("draw"))
+            draws += line + '\n';
+    }
+
+    return draws;
+}
+
+void test_replay_matches_direct_submission()
+{
+    Frame const frame(1);
+
+    for (auto const pass : {RenderPass::Geometry, RenderPass::Forward})
+    {
+        auto const packets = frame.queue.get_packets(pass);
+
+        CommandList list = {};
+        list.record(pass, packets, frame.model_matrices, frame.projection_view);
+
+        NullCommandListBackend backend = {};
+        list.replay(backend);
+
+        CHECK(!packets.empty());
+        CHECK(list.get_pass() == pass);
+        CHECK(list.get_statistics().packets == packets.size());
+        CHECK(backend.get_log() == submit_directly(frame, packets));
+    }
+}
+
+void test_recorded_constants()
+{
+    Frame const frame(2);
+    auto const packets = frame.queue.get_packets(RenderPass::Geometry);
+
+    CommandList list = {};
+    list.record(RenderPass::Geometry, packets, frame.model_matrices, frame.projection_view);
+
+    u32 draw_index = 0;
+
+    for (auto const& command : list.get_commands())
+    {
+        if (command.type != DrawCommandType::DrawObject)
+            continue;
+
+        // Draw commands keep the order of the packets, which don't have any instanced ones in the geometry pass
+        RenderPacket const& packet = packets[draw_index++];
+        ObjectConstants const& constants = list.get_constants()[command.constants_index];
+
+        CHECK(command.drawable == packet.drawable);
+        CHECK(constants.model == frame.model_matrices[packet.push_index]);
+        CHECK(constants.projection_view_model == frame.projection_view * frame.model_matrices[packet.push_index]);
+    }
+
+    CHECK(draw_index == packets.size());
+    CHECK(list.get_constants().size() == packets.size());
+}
+
+void test_parallel_chunks_match_direct_submission()
+{
+    u32 constexpr chunk_size = 64;
+
+    Frame const frame(3);
+
+    for (auto const pass : {RenderPass::Geometry, RenderPass::Forward})
+    {
+        auto const packets = frame.queue.get_packets(pass);
+
+        std::vector<std::span<RenderPacket const>> chunks = {};
+
+        for (size_t offset = 0; offset < packets.size(); offset += chunk_size)
+            chunks.emplace_back(packets.subspan(offset, std::min<size_t>(chunk_size, packets.size() - offset)));
+
+        // Same as the renderer, every chunk is recorded on a worker thread and the lists are replayed in order afterwards
+        std::vector<CommandList> lists(chunks.size());
+
+        {
+            std::vector<std::jthread> workers = {};
+
+            for (size_t i = 0; i < chunks.size(); ++i)
+            {
+                workers.emplace_back([&, i] { lists[i].record(pass, chunks[i], frame.model_matrices, frame.projection_view); });
+            }
+        }
+
+        NullCommandListBackend backend = {};
+
+        for (auto const& list : lists)
+            list.replay(backend);
+
+        // Backend numbers objects by their first use, so both logs have to be written by a single backend each
+        NullCommandListBackend direct_backend = {};
+        DirectBackend chunked_direct_backend = {direct_backend, frame.model_matrices, frame.projection_view};
+
+        for (auto const& chunk : chunks)
+            RenderQueue::submit(chunk, chunked_direct_backend);
+
+        CHECK(chunks.size() > 1);
+        CHECK(backend.get_log() == direct_backend.get_log());
+        CHECK(get_draws(backend.get_log()) == get_draws(submit_directly(frame, packets)));
+    }
+}
+
+void test_null_backend_ids()
+{
+    auto const shader = Test::make_fake_object<Shader>(0);
+    auto const material = Test::make_fake_object<Material>(0);
+    auto const other_material = Test::make_fake_object<Material>(1);
+
+    NullCommandListBackend backend = {};
+    backend.bind_shader(shader);
+    backend.bind_material(other_material);
+    backend.unbind_material(other_material);
+    backend.bind_material(material);
+    backend.draw_instanced(material);
+
+    CHECK(backend.get_log() == "bind_shader 0\nbind_material 1\nunbind_material 1\nbind_material 2\ndraw_instanced 2\n");
+
+    backend.clear();
+    backend.bind_material(material);
+
+    CHECK(backend.get_log() == "bind_material 0\n");
+}
+
+}
+
+i32 main()
+{
+    Test::run("Replaying a recorded pass matches direct submission", test_replay_matches_direct_submission);
+    Test::run("Recorded constants match model matrices of packets", test_recorded_constants);
+    Test::run("Chunks recorded in parallel match direct submission", test_parallel_chunks_match_direct_submission);
+    Test::run("Null backend numbers objects by their first use", test_null_backend_ids);
+
+    return Test::get_exit_code();
+}
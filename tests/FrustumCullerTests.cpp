@@ -0,0 +1,172 @@
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include "Bounds.h"
+#include "Frustum.h"
+#include "FrustumCuller.h"
+#include "Test.h"
+
+namespace
+{
+
+// Camera at the origin looking down -Z with a 90 degree field of view, so the frustum is 20 units wide at the depth of 10
+Frustum make_perspective_frustum()
+{
+    glm::mat4 const projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+    glm::mat4 const view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+    return Frustum::from_projection_view(projection * view);
+}
+
+Frustum make_orthographic_frustum()
+{
+    glm::mat4 const projection = glm::ortho(-20.0f, 20.0f, -10.0f, 10.0f, 1.0f, 50.0f);
+    glm::mat4 const view = glm::lookAt(glm::vec3(5.0f, 20.0f, 5.0f), glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+
+    return Frustum::from_projection_view(projection * view);
+}
+
+BoundingBox make_box(glm::vec3 const center, float const extents)
+{
+    return {center - glm::vec3(extents), center + glm::vec3(extents)};
+}
+
+std::vector<u32> cull(std::vector<BoundingBox> const& boxes, Frustum const& frustum)
+{
+    FrustumCuller culler = {};
+
+    for (auto const& box : boxes)
+        culler.add(box);
+
+    std::vector<u32> visible_indices = {};
+    culler.cull(frustum, visible_indices);
+
+    return visible_indices;
+}
+
+void test_planes_are_normalized_and_face_inside()
+{
+    Frustum const frustum = make_perspective_frustum();
+    std::array const planes = {frustum.left_plane, frustum.right_plane, frustum.top_plane,
+                               frustum.bottom_plane, frustum.near_plane, frustum.far_plane};
+
+    glm::vec3 const inside_point = {0.0f, 0.0f, -10.0f};
+
+    for (auto const& plane : planes)
+    {
+        CHECK(std::abs(glm::length(plane.normal) - 1.0f) < 0.0001f);
+        CHECK(glm::dot(plane.normal, inside_point) + plane.distance > 0.0f);
+    }
+}
+
+void test_boxes_outside_every_plane_are_rejected()
+{
+    Frustum const frustum = make_perspective_frustum();
+
+    // One box past each of the planes: left, right, top, bottom, near (behind the camera) and far
+    std::vector const outside_boxes = {
+        make_box({-50.0f, 0.0f, -10.0f}, 1.0f), make_box({50.0f, 0.0f, -10.0f}, 1.0f), make_box({0.0f, 50.0f, -10.0f}, 1.0f),
+        make_box({0.0f, -50.0f, -10.0f}, 1.0f), make_box({0.0f, 0.0f, 5.0f}, 1.0f),    make_box({0.0f, 0.0f, -150.0f}, 1.0f),
+    };
+
+    // Boxes inside the frustum and crossing each of the planes
+    std::vector const visible_boxes = {
+        make_box({0.0f, 0.0f, -10.0f}, 1.0f),  make_box({-10.0f, 0.0f, -10.0f}, 1.0f), make_box({10.0f, 0.0f, -10.0f}, 1.0f),
+        make_box({0.0f, 10.0f, -10.0f}, 1.0f), make_box({0.0f, -10.0f, -10.0f}, 1.0f), make_box({0.0f, 0.0f, 0.0f}, 1.0f),
+        make_box({0.0f, 0.0f, -100.0f}, 1.0f),
+    };
+
+    for (auto const& box : outside_boxes)
+    {
+        CHECK(!FrustumCuller::is_visible(box, frustum));
+        CHECK(!box.is_in_frustum(frustum));
+    }
+
+    for (auto const& box : visible_boxes)
+    {
+        CHECK(FrustumCuller::is_visible(box, frustum));
+        CHECK(box.is_in_frustum(frustum));
+    }
+
+    CHECK(cull(outside_boxes, frustum).empty());
+    CHECK(cull(visible_boxes, frustum) == std::vector<u32>({0, 1, 2, 3, 4, 5, 6}));
+}
+
+void test_batches_match_scalar_test()
+{
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> position_distribution(-60.0f, 60.0f);
+    std::uniform_real_distribution<float> extents_distribution(0.1f, 5.0f);
+
+    // Count that isn't a multiple of the batch size, so the last partial batch is tested as well
+    u32 constexpr box_count = 1001;
+
+    std::vector<BoundingBox> boxes = {};
+
+    for (u32 i = 0; i < box_count; ++i)
+    {
+        glm::vec3 const center = {position_distribution(random), position_distribution(random), position_distribution(random)};
+        boxes.emplace_back(make_box(center, extents_distribution(random)));
+    }
+
+    for (auto const& frustum : {make_perspective_frustum(), make_orthographic_frustum()})
+    {
+        std::vector<u32> expected_indices = {};
+
+        for (u32 i = 0; i < box_count; ++i)
+        {
+            bool const is_visible = FrustumCuller::is_visible(boxes[i], frustum);
+
+            CHECK(is_visible == boxes[i].is_in_frustum(frustum));
+
+            if (is_visible)
+                expected_indices.emplace_back(i);
+        }
+
+        std::vector<u32> const visible_indices = cull(boxes, frustum);
+
+        CHECK(!visible_indices.empty());
+        CHECK(visible_indices.size() < box_count);
+        CHECK(visible_indices == expected_indices);
+    }
+}
+
+void test_always_visible_entries()
+{
+    Frustum const frustum = make_perspective_frustum();
+
+    FrustumCuller culler = {};
+    CHECK(culler.add(make_box({0.0f, 0.0f, 5.0f}, 1.0f)) == 0);
+    CHECK(culler.add_always_visible() == 1);
+    CHECK(culler.add(make_box({0.0f, 0.0f, -10.0f}, 1.0f)) == 2);
+    CHECK(culler.size() == 3);
+
+    std::vector<u32> visible_indices = {};
+    culler.cull(frustum, visible_indices);
+
+    CHECK(visible_indices == std::vector<u32>({1, 2}));
+
+    culler.clear();
+    culler.cull(frustum, visible_indices);
+
+    CHECK(culler.size() == 0);
+    CHECK(visible_indices.empty());
+}
+
+}
+
+i32 main()
+{
+    Test::run("Frustum planes are normalized and face inside", test_planes_are_normalized_and_face_inside);
+    Test::run("Boxes outside every plane are rejected", test_boxes_outside_every_plane_are_rejected);
+    Test::run("Batched test matches the scalar one", test_batches_match_scalar_test);
+    Test::run("Always visible entries pass every frustum", test_always_visible_entries);
+
+    return Test::get_exit_code();
+}
@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include "LightClusters.h"
+#include "Test.h"
+
+namespace
+{
+
+float constexpr near_plane = 0.1f;
+float constexpr far_plane = 100.0f;
+
+// Camera at the origin looking down -Z
+struct View
+{
+    View()
+    {
+        clusters.set_projection(projection, near_plane, far_plane);
+    }
+
+    // Same lookup as get_light_cluster() in lighting_calculations.hlsl
+    [[nodiscard]] u32 get_cluster_index(glm::vec3 const& world_position) const
+    {
+        glm::vec4 const view_position = view * glm::vec4(world_position, 1.0f);
+        glm::vec4 const clip_position = projection * view_position;
+        glm::vec2 const ndc = glm::vec2(clip_position.x, clip_position.y) / clip_position.w;
+
+        glm::vec2 const tile = glm::clamp((ndc * 0.5f + 0.5f) * glm::vec2(LightClusters::tiles_x, LightClusters::tiles_y), glm::vec2(0.0f),
+                                          glm::vec2(LightClusters::tiles_x - 1, LightClusters::tiles_y - 1));
+        float const slice = std::floor(std::log(-view_position.z) * clusters.get_depth_scale() + clusters.get_depth_bias());
+
+        return clusters.get_cluster_index(static_cast<u32>(tile.x), static_cast<u32>(tile.y),
+                                          static_cast<u32>(std::clamp(slice, 0.0f, LightClusters::depth_slices - 1.0f)));
+    }
+
+    [[nodiscard]] std::vector<u32> get_point_lights(u32 const entry) const
+    {
+        LightCluster const& cluster = clusters.get_clusters()[entry];
+        auto const begin = clusters.get_light_indices().begin() + cluster.offset;
+
+        return {begin, begin + cluster.point_light_count};
+    }
+
+    [[nodiscard]] std::vector<u32> get_spot_lights(u32 const entry) const
+    {
+        LightCluster const& cluster = clusters.get_clusters()[entry];
+        auto const begin = clusters.get_light_indices().begin() + cluster.offset + cluster.point_light_count;
+
+        return {begin, begin + cluster.spot_light_count};
+    }
+
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, near_plane, far_plane);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    LightClusters clusters = {};
+};
+
+bool contains(std::vector<u32> const& lights, u32 const light)
+{
+    return std::ranges::find(lights, light) != lights.end();
+}
+
+void test_lights_are_assigned_to_their_clusters()
+{
+    View view = {};
+
+    std::vector<ClusterLight> const point_lights = {{{2.0f, 1.0f, -10.0f}, 1.5f}, {{-8.0f, -3.0f, -40.0f}, 4.0f}};
+    std::vector<ClusterLight> const spot_lights = {{{0.0f, 0.0f, -5.0f}, 2.0f}};
+
+    view.clusters.assign(view.view, point_lights, spot_lights);
+
+    for (u32 i = 0; i < point_lights.size(); ++i)
+    {
+        CHECK(view.clusters.is_point_light_visible(i));
+        CHECK(contains(view.get_point_lights(view.get_cluster_index(point_lights[i].position)), i));
+    }
+
+    CHECK(view.clusters.is_spot_light_visible(0));
+    CHECK(contains(view.get_spot_lights(view.get_cluster_index(spot_lights[0].position)), 0));
+
+    // Far away from the first light, but still in the view
+    u32 const distant_cluster = view.get_cluster_index({-8.0f, -3.0f, -40.0f});
+    CHECK(!contains(view.get_point_lights(distant_cluster), 0));
+    CHECK(view.get_spot_lights(distant_cluster).empty());
+}
+
+void test_lights_outside_of_the_view_are_not_visible()
+{
+    View view = {};
+
+    // Behind the camera, beyond the far plane, without any range and outside of the side planes
+    std::vector<ClusterLight> const point_lights = {
+        {{0.0f, 0.0f, 5.0f}, 2.0f}, {{0.0f, 0.0f, -150.0f}, 10.0f}, {{0.0f, 0.0f, -10.0f}, 0.0f}, {{50.0f, 0.0f, -10.0f}, 5.0f}};
+
+    view.clusters.assign(view.view, point_lights, {});
+
+    for (u32 i = 0; i < point_lights.size(); ++i)
+        CHECK(!view.clusters.is_point_light_visible(i));
+
+    CHECK(view.clusters.get_light_indices().empty());
+}
+
+void test_tiles_have_lights_of_all_their_slices()
+{
+    View view = {};
+
+    std::mt19937 random(31);
+    std::uniform_real_distribution<float> position_distribution(-30.0f, 30.0f);
+    std::uniform_real_distribution<float> depth_distribution(-90.0f, 5.0f);
+    std::uniform_real_distribution<float> range_distribution(0.5f, 15.0f);
+
+    auto const make_lights = [&](u32 const count) {
+        std::vector<ClusterLight> lights(count);
+
+        for (auto& light : lights)
+        {
+            light.position = {position_distribution(random), position_distribution(random), depth_distribution(random)};
+            light.range = range_distribution(random);
+        }
+
+        return lights;
+    };
+
+    std::vector<ClusterLight> const point_lights = make_lights(100);
+    std::vector<ClusterLight> const spot_lights = make_lights(50);
+
+    view.clusters.assign(view.view, point_lights, spot_lights);
+
+    CHECK(view.clusters.get_clusters().size() == LightClusters::entry_count);
+
+    std::vector<u8> is_point_light_in_cluster(point_lights.size(), 0);
+    std::vector<u8> is_spot_light_in_cluster(spot_lights.size(), 0);
+
+    for (u32 y = 0; y < LightClusters::tiles_y; ++y)
+    {
+        for (u32 x = 0; x < LightClusters::tiles_x; ++x)
+        {
+            std::vector<u32> expected_point_lights = {};
+            std::vector<u32> expected_spot_lights = {};
+
+            for (u32 slice = 0; slice < LightClusters::depth_slices; ++slice)
+            {
+                u32 const cluster = view.clusters.get_cluster_index(x, y, slice);
+
+                for (u32 const light : view.get_point_lights(cluster))
+                {
+                    expected_point_lights.emplace_back(light);
+                    is_point_light_in_cluster[light] = 1;
+                }
+
+                for (u32 const light : view.get_spot_lights(cluster))
+                {
+                    expected_spot_lights.emplace_back(light);
+                    is_spot_light_in_cluster[light] = 1;
+                }
+            }
+
+            // Every light is listed in a tile once, even if it is in many of its slices
+            auto const unique = [](std::vector<u32> lights) {
+                std::ranges::sort(lights);
+                lights.erase(std::ranges::unique(lights).begin(), lights.end());
+                return lights;
+            };
+
+            std::vector<u32> tile_point_lights = view.get_point_lights(view.clusters.get_tile_index(x, y));
+            std::vector<u32> tile_spot_lights = view.get_spot_lights(view.clusters.get_tile_index(x, y));
+
+            CHECK(unique(tile_point_lights) == unique(expected_point_lights));
+            CHECK(unique(tile_spot_lights) == unique(expected_spot_lights));
+            CHECK(unique(tile_point_lights).size() == tile_point_lights.size());
+            CHECK(unique(tile_spot_lights).size() == tile_spot_lights.size());
+        }
+    }
+
+    for (u32 i = 0; i < point_lights.size(); ++i)
+        CHECK(view.clusters.is_point_light_visible(i) == (is_point_light_in_cluster[i] != 0));
+
+    for (u32 i = 0; i < spot_lights.size(); ++i)
+        CHECK(view.clusters.is_spot_light_visible(i) == (is_spot_light_in_cluster[i] != 0));
+}
+
+void test_light_range()
+{
+    // Attenuated intensity at the range is the threshold
+    float const range = LightClusters::calculate_light_range(1.0f, 0.09f, 0.032f, 1.0f, 0.01f);
+    CHECK(std::abs(1.0f / (1.0f + 0.09f * range + 0.032f * range * range) - 0.01f) < 0.0001f);
+
+    CHECK(LightClusters::calculate_light_range(1.0f, 0.09f, 0.032f, 0.0f) == 0.0f);
+}
+
+}
+
+i32 main()
+{
+    Test::run("Lights are assigned to the clusters they are in", test_lights_are_assigned_to_their_clusters);
+    Test::run("Lights outside of the view aren't assigned to any cluster", test_lights_outside_of_the_view_are_not_visible);
+    Test::run("Tiles have the lights of all of their depth slices", test_tiles_have_lights_of_all_their_slices);
+    Test::run("Light range is where attenuation reaches the threshold", test_light_range);
+
+    return Test::get_exit_code();
+}
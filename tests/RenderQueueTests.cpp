@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "RenderQueue.h"
+#include "Test.h"
+
+namespace
+{
+
+// Drawables identify packets between frames, shaders and materials are only compared when submitting
+struct Scene
+{
+    explicit Scene(u32 const drawable_count)
+    {
+        shader = Test::make_fake_object<Shader>(0);
+        material = Test::make_fake_object<Material>(0);
+
+        for (u32 i = 0; i < drawable_count; ++i)
+            drawables.emplace_back(Test::make_fake_object<Drawable>(i));
+    }
+
+    void push_frame(RenderQueue& queue, std::span<u64 const> const keys) const
+    {
+        queue.clear();
+
+        for (u32 i = 0; i < keys.size(); ++i)
+            queue.push({keys[i], &shader, &material, &drawables[i]});
+
+        queue.sort();
+    }
+
+    std::shared_ptr<Shader> shader = {};
+    std::shared_ptr<Material> material = {};
+    std::vector<std::shared_ptr<Drawable>> drawables = {};
+};
+
+// Keys from a small range, so many packets share their keys
+std::vector<u64> make_keys(std::mt19937& random, u32 const count, u64 const distinct_keys)
+{
+    std::vector<u64> keys(count);
+
+    for (auto& key : keys)
+        key = random() % distinct_keys;
+
+    return keys;
+}
+
+// Push indices in the order expected from a stable sort of the keys
+std::vector<u32> get_expected_order(std::span<u64 const> const keys)
+{
+    std::vector<u32> order(keys.size());
+
+    for (u32 i = 0; i < order.size(); ++i)
+        order[i] = i;
+
+    std::ranges::stable_sort(order, {}, [&](u32 const index) { return keys[index]; });
+
+    return order;
+}
+
+std::vector<u32> get_order(RenderQueue const& queue)
+{
+    std::vector<u32> order = {};
+
+    for (auto const& packet : queue.get_packets(RenderPass::Geometry))
+        order.emplace_back(packet.push_index);
+
+    return order;
+}
+
+void test_radix_sort_is_stable()
+{
+    std::mt19937 random(11);
+
+    for (u32 const count : {0u, 1u, 2u, 7u, 1000u})
+    {
+        // Keys spread over all digits, but share a few values
+        std::vector<u64> keys = make_keys(random, count, 16);
+
+        for (auto& key : keys)
+            key = (key << 40) | (key << 20) | key;
+
+        std::vector<RenderPacket> packets(count);
+
+        for (u32 i = 0; i < count; ++i)
+            packets[i] = {.sort_key = keys[i], .push_index = i};
+
+        std::vector<RenderPacket> scratch = {};
+        RenderQueue::radix_sort(packets, scratch);
+
+        std::vector<u32> order = {};
+
+        for (auto const& packet : packets)
+            order.emplace_back(packet.push_index);
+
+        CHECK(order == get_expected_order(keys));
+    }
+}
+
+void test_incremental_sort_matches_radix_sort()
+{
+    u32 constexpr packet_count = 500;
+
+    std::mt19937 random(12);
+    Scene const scene(packet_count);
+
+    std::vector<u64> keys = make_keys(random, packet_count, 64);
+
+    RenderQueue queue = {};
+    scene.push_frame(queue, keys);
+
+    CHECK(!queue.was_sorted_incrementally());
+    CHECK(get_order(queue) == get_expected_order(keys));
+
+    // Every frame a few packets change their keys, often to the key of another packet, so ties are reordered by push indices
+    for (u32 frame = 0; frame < 20; ++frame)
+    {
+        for (u32 i = 0; i < 10; ++i)
+            keys[random() % packet_count] = random() % 64;
+
+        scene.push_frame(queue, keys);
+
+        CHECK(queue.was_sorted_incrementally());
+        CHECK(get_order(queue) == get_expected_order(keys));
+    }
+
+    // Same keys as in the previous frame
+    scene.push_frame(queue, keys);
+
+    CHECK(queue.was_sorted_incrementally());
+    CHECK(get_order(queue) == get_expected_order(keys));
+}
+
+void test_incremental_sort_falls_back_to_radix_sort()
+{
+    u32 constexpr packet_count = 500;
+
+    std::mt19937 random(13);
+    Scene const scene(packet_count);
+
+    std::vector<u64> keys = make_keys(random, packet_count, 1000);
+
+    RenderQueue queue = {};
+    scene.push_frame(queue, keys);
+
+    // Reversing the order moves every packet across the whole queue
+    std::ranges::sort(keys, std::greater {});
+    scene.push_frame(queue, keys);
+
+    CHECK(!queue.was_sorted_incrementally());
+    CHECK(get_order(queue) == get_expected_order(keys));
+
+    // Different packets than in the previous frame can't reuse its order
+    std::vector<u64> const fewer_keys(keys.begin(), keys.end() - 1);
+    scene.push_frame(queue, fewer_keys);
+
+    CHECK(!queue.was_sorted_incrementally());
+    CHECK(get_order(queue) == get_expected_order(fewer_keys));
+}
+
+void test_insertion_sort_gives_up()
+{
+    std::vector<RenderPacket> packets = {};
+
+    for (u32 i = 0; i < 100; ++i)
+        packets.push_back({.sort_key = 100 - i, .push_index = i});
+
+    std::vector<RenderPacket> partially_sorted = packets;
+    CHECK(!RenderQueue::insertion_sort(partially_sorted, 10));
+
+    CHECK(RenderQueue::insertion_sort(packets, 100 * 100));
+    CHECK(std::ranges::is_sorted(packets, {}, &RenderPacket::sort_key));
+}
+
+}
+
+i32 main()
+{
+    Test::run("Radix sort keeps the push order of equal keys", test_radix_sort_is_stable);
+    Test::run("Incremental sort gives the same order as radix sort", test_incremental_sort_matches_radix_sort);
+    Test::run("Incremental sort falls back to radix sort", test_incremental_sort_falls_back_to_radix_sort);
+    Test::run("Insertion sort gives up after too many moves", test_insertion_sort_gives_up);
+
+    return Test::get_exit_code();
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <source_location>
+#include <string_view>
+
+#include "AK/Types.h"
+
+// Minimal checks for the test executables. Every failed check is printed with its location and makes the executable
+// return a non-zero exit code, which is what CTest looks at.
+namespace Test
+{
+
+inline u32 failed_checks = 0;
+
+inline bool check(bool const condition, std::string_view const expression,
+                  std::source_location const location = std::source_location::current())
+{
+    if (!condition)
+    {
+        std::cout << std::format("{}:{}: Check failed: {}\n", location.file_name(), location.line(), expression);
+        failed_checks++;
+    }
+
+    return condition;
+}
+
+// Runs a single test case, so failures are reported together with the name of the case they come from
+template<typename F>
+void run(std::string_view const name, F&& test_case)
+{
+    u32 const failed_before = failed_checks;
+
+    test_case();
+
+    std::cout << std::format("[{}] {}\n", failed_checks == failed_before ? "PASSED" : "FAILED", name);
+}
+
+// Object that is only compared by its address and never dereferenced, e.g. a shader or a drawable referenced by render packets.
+// Objects of the same type and index share their address.
+template<typename T>
+[[nodiscard]] std::shared_ptr<T> make_fake_object(u32 const index)
+{
+    static std::array<std::byte, 4096> storage = {};
+    assert(index < storage.size());
+
+    return std::shared_ptr<T>(std::shared_ptr<T> {}, reinterpret_cast<T*>(&storage[index]));
+}
+
+[[nodiscard]] inline i32 get_exit_code()
+{
+    return failed_checks == 0 ? 0 : 1;
+}
+
+}
+
+#define CHECK(expression) Test::check(static_cast<bool>(expression), #expression)
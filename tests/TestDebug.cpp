@@ -0,0 +1,10 @@
+#include "Debug.h"
+
+#include <format>
+#include <iostream>
+
+// Tests only link the engine sources they test, so messages are printed right away instead of being shown by the editor
+void Debug::log(std::string const& message, DebugType type)
+{
+    std::cout << std::format("{}{}\n", type == DebugType::Error ? "Error: " : type == DebugType::Warning ? "Warning: " : "Log: ", message);
+}
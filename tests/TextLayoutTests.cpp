@@ -0,0 +1,200 @@
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GlyphAtlas.h"
+#include "TextLayout.h"
+#include "Test.h"
+
+namespace
+{
+
+// Font with a kerning table, e.g. "AV" is drawn tighter than its advances
+std::string const font_path = std::string(RESOURCE_PATH) + "/fonts/KG The Last Time.ttf";
+
+bool is_near(float const a, float const b)
+{
+    return std::abs(a - b) < 0.001f;
+}
+
+void test_cache_hits()
+{
+    auto const atlas = GlyphAtlas::create(font_path, 32.0f);
+
+    if (!CHECK(atlas != nullptr))
+        return;
+
+    TextLayoutCache cache = {};
+
+    auto const layout = cache.get(atlas, "Hello", TextFlags::Left);
+
+    CHECK(layout != nullptr);
+    CHECK(cache.get(atlas, "Hello", TextFlags::Left) == layout);
+    CHECK(cache.get_size() == 1);
+
+    // Flags other than the alignment don't change the layout
+    CHECK(cache.get(atlas, "Hello", TextFlags::Left | 0x100) == layout);
+    CHECK(cache.get_size() == 1);
+}
+
+void test_invalidation()
+{
+    auto const atlas = GlyphAtlas::create(font_path, 32.0f);
+
+    // Texts of other sizes use atlases baked at other pixel sizes
+    auto const larger_atlas = GlyphAtlas::create(font_path, 64.0f);
+
+    if (!CHECK(atlas != nullptr && larger_atlas != nullptr))
+        return;
+
+    TextLayoutCache cache = {};
+
+    auto const layout = cache.get(atlas, "Hello", TextFlags::Left);
+    auto const changed_text_layout = cache.get(atlas, "Hello!", TextFlags::Left);
+    auto const changed_alignment_layout = cache.get(atlas, "Hello", TextFlags::Center);
+    auto const changed_size_layout = cache.get(larger_atlas, "Hello", TextFlags::Left);
+
+    CHECK(changed_text_layout != layout);
+    CHECK(changed_alignment_layout != layout);
+    CHECK(changed_size_layout != layout);
+    CHECK(cache.get_size() == 4);
+
+    CHECK(changed_text_layout->size.x > layout->size.x);
+    CHECK(changed_size_layout->size.x > layout->size.x * 1.8f);
+    CHECK(changed_size_layout->size.y > layout->size.y * 1.8f);
+
+    // Changing the text back gets the first layout again
+    CHECK(cache.get(atlas, "Hello", TextFlags::Left) == layout);
+
+    cache.clear();
+    CHECK(cache.get_size() == 0);
+    CHECK(cache.get(atlas, "Hello", TextFlags::Left) != layout);
+}
+
+void test_unused_layouts_are_dropped()
+{
+    auto const atlas = GlyphAtlas::create(font_path, 16.0f);
+
+    if (!CHECK(atlas != nullptr))
+        return;
+
+    TextLayoutCache cache = {};
+
+    auto const held_layout = cache.get(atlas, "Held", TextFlags::Left);
+
+    for (u32 i = 1; i < TextLayoutCache::max_cached_layouts; ++i)
+        (void)cache.get(atlas, std::to_string(i), TextFlags::Left);
+
+    CHECK(cache.get_size() == TextLayoutCache::max_cached_layouts);
+
+    // Only the layout still held by a text survives
+    (void)cache.get(atlas, "One too many", TextFlags::Left);
+
+    CHECK(cache.get_size() == 2);
+    CHECK(cache.get(atlas, "Held", TextFlags::Left) == held_layout);
+}
+
+void test_line_breaking()
+{
+    auto const atlas = GlyphAtlas::create(font_path, 32.0f);
+
+    if (!CHECK(atlas != nullptr))
+        return;
+
+    Glyph const& a = atlas->get_glyph('A');
+    Glyph const& b = atlas->get_glyph('B');
+    Glyph const& c = atlas->get_glyph('C');
+
+    float const first_line_width = a.advance + atlas->get_kerning('A', 'B') + b.advance;
+
+    TextLayout const layout = TextLayout::create(*atlas, "AB\r\nC", TextFlags::Left);
+
+    CHECK(layout.line_count == 2);
+    CHECK(is_near(layout.size.x, first_line_width));
+    CHECK(is_near(layout.size.y, 2.0f * atlas->get_line_height()));
+
+    if (CHECK(layout.glyphs.size() == 3))
+    {
+        // Second line starts again at the anchor, one line lower
+        CHECK(is_near(layout.glyphs[2].min.x, c.min.x));
+        CHECK(is_near(layout.glyphs[2].min.y, atlas->get_ascent() + atlas->get_line_height() + c.min.y));
+    }
+
+    // Right aligned lines end at the anchor
+    TextLayout const right_layout = TextLayout::create(*atlas, "AB\nC", TextFlags::Right | TextFlags::Bottom);
+
+    if (CHECK(right_layout.glyphs.size() == 3))
+    {
+        CHECK(is_near(right_layout.glyphs[0].min.x, -first_line_width + a.min.x));
+        CHECK(is_near(right_layout.glyphs[2].min.x, -c.advance + c.min.x));
+        CHECK(is_near(right_layout.glyphs[0].min.y, atlas->get_ascent() - right_layout.size.y + a.min.y));
+    }
+
+    // Empty lines only move the pen down
+    TextLayout const empty_line_layout = TextLayout::create(*atlas, "A\n\nB\n", TextFlags::Left);
+
+    CHECK(empty_line_layout.line_count == 4);
+    CHECK(empty_line_layout.glyphs.size() == 2);
+}
+
+void test_kerning_advance()
+{
+    auto const atlas = GlyphAtlas::create(font_path, 32.0f);
+
+    if (!CHECK(atlas != nullptr))
+        return;
+
+    float const kerning = atlas->get_kerning('A', 'V');
+    Glyph const& a = atlas->get_glyph('A');
+    Glyph const& v = atlas->get_glyph('V');
+
+    CHECK(kerning < 0.0f);
+
+    TextLayout const layout = TextLayout::create(*atlas, "AV", TextFlags::Left);
+
+    if (CHECK(layout.glyphs.size() == 2))
+    {
+        CHECK(is_near(layout.glyphs[0].min.x, a.min.x));
+        CHECK(is_near(layout.glyphs[1].min.x, a.advance + kerning + v.min.x));
+    }
+
+    CHECK(is_near(layout.size.x, a.advance + kerning + v.advance));
+
+    // Line breaks reset the previous codepoint, so there is no kerning across lines
+    TextLayout const broken_layout = TextLayout::create(*atlas, "A\nV", TextFlags::Left);
+
+    if (CHECK(broken_layout.glyphs.size() == 2))
+        CHECK(is_near(broken_layout.glyphs[1].min.x, v.min.x));
+}
+
+void test_utf8_decoding()
+{
+    // "ą", a character outside of the atlas and an invalid continuation byte
+    std::string const text = "\xC4\x85\xF0\x9F\x99\x82\xC4x";
+
+    size_t offset = 0;
+
+    CHECK(TextLayout::decode_utf8(text, offset) == 0x105);
+    CHECK(offset == 2);
+    CHECK(TextLayout::decode_utf8(text, offset) == 0x1F642);
+    CHECK(offset == 6);
+    CHECK(TextLayout::decode_utf8(text, offset) == 0xFFFD);
+    CHECK(offset == 7);
+    CHECK(TextLayout::decode_utf8(text, offset) == 'x');
+    CHECK(offset == text.size());
+}
+
+}
+
+i32 main()
+{
+    Test::run("Same text gets the cached layout", test_cache_hits);
+    Test::run("Changing text, alignment or size gets another layout", test_invalidation);
+    Test::run("Unused layouts are dropped when the cache is full", test_unused_layouts_are_dropped);
+    Test::run("Lines are broken and aligned", test_line_breaking);
+    Test::run("Pen advances by the kerning of glyph pairs", test_kerning_advance);
+    Test::run("UTF-8 is decoded", test_utf8_decoding);
+
+    return Test::get_exit_code();
+}